@@ -131,6 +131,18 @@ CFLAGS += -DGUID_PROVIDER_LOCID_SIZE=10
 # multiple slots
 # CFLAGS += -DOCR_MAX_MULTI_SLOT=1
 
+# Enables anonymous leaf EDTs (EDT_PROP_ANON). Such EDTs are not
+# registered with the GUID provider and their metadata is recycled
+# through a per-worker pool. Else the property is ignored.
+# Only the shared-memory HC policy honors the property: distributed
+# and TG policies route messages by GUID.
+ifneq (,$(filter $(OCR_TYPE),x86 x86-newlib x86-phi))
+CFLAGS += -DENABLE_EDT_ANON
+endif
+
+# Maximum number of anonymous EDT metadata cached per worker
+# CFLAGS += -DEDT_ANON_POOL_MAX=64
+
 # **** Datablocks (DBs) parameters ****
 
 # Enables runtime code that checks for the eager datablock hint
@@ -140,6 +152,17 @@ CFLAGS += -DALLOW_EAGER_DB
 
 CFLAGS += -DENABLE_LAZY_DB
 
+# Enables a lock-free path for local read acquire and release of
+# lockable datablocks while they are only shared locally in CONST mode.
+# Ignored when resiliency or statistics are enabled.
+CFLAGS += -DENABLE_LOCKABLE_DB_FASTPATH
+
+# Collects per lockable DB access statistics (acquires, contention, wait
+# time per mode, bytes sent to other PDs). They are aggregated per creating
+# EDT template and dumped with the hottest DBs in 'DbStatsNode<location>'
+# at shutdown. Disables the lock-free path above.
+# CFLAGS += -DDB_STATS_LOCKABLE
+
 # **** Debugging parameters ****
 
 # Maximum number of characters handled by a single PRINTF
@@ -897,6 +920,11 @@ ifneq (,$(findstring -DOCR_ASSERT, $(CFLAGS)))
 	$(AT)$(shell echo "#define OCR_ASSERT" >> $@)
 	$(AT)$(shell echo "#endif" >> $@)
 endif
+ifneq (,$(findstring -DENABLE_EDT_ANON, $(CFLAGS)))
+	$(AT)$(shell echo "#ifndef ENABLE_EDT_ANON" >> $@)
+	$(AT)$(shell echo "#define ENABLE_EDT_ANON" >> $@)
+	$(AT)$(shell echo "#endif" >> $@)
+endif
 ifneq (,$(findstring -DOCR_TRACE_BINARY, $(CFLAGS)))
 	$(AT)$(shell echo "#ifndef OCR_TRACE_BINARY" >> $@)
 	$(AT)$(shell echo "#define OCR_TRACE_BINARY" >> $@)
@@ -28,11 +28,27 @@
 // Comm-api
 #define ENABLE_COMM_API_DELEGATE
 #define ENABLE_COMM_API_SIMPLE
+// Credit-based flow control of the requests sent between policy domains
+#define ENABLE_COMM_API_FLOW_CONTROL
 
 // Comm-platform
 #define ENABLE_COMM_PLATFORM_NULL
 #define ENABLE_COMM_PLATFORM_MPI
 #define ENABLE_COMM_PLATFORM_MPI_PROBE
+// Compress large DB payloads sent by the MPI comm-platform
+#define ENABLE_MPI_COMPRESSION
+// Pack small one-way messages sent by the MPI comm-platform per destination
+#define ENABLE_MPI_AGGREGATION
+// Send small policy messages in a compact variable-length encoding in the MPI comm-platform
+#define ENABLE_MPI_COMPACT_MSG
+// Several comm-workers, each driving its own MPI comm-platform instance
+#define ENABLE_MPI_SHARDS
+// Send DB metadata communications in their own lane in the MPI comm-platform
+#define ENABLE_MPI_LANES
+// Send large DB payloads from the DB's memory in the MPI comm-platform (others copy them)
+#define ENABLE_DB_ZERO_COPY
+// Policy domains of a node communicating through shared memory
+#define ENABLE_COMM_PLATFORM_SHM
 
 // Comp-platform
 #define ENABLE_COMP_PLATFORM_PTHREAD
@@ -43,10 +59,18 @@
 // Datablock
 #define ENABLE_DATABLOCK_REGULAR
 #define ENABLE_DATABLOCK_LOCKABLE
+#define ENABLE_DATABLOCK_SINGLE_ASSIGN
 #define ENABLE_EXTENSION_DB_INFO
+#define ENABLE_EXTENSION_DB_PARTITION
+#define ENABLE_EXTENSION_DB_DIRTY_RANGE
+#define ENABLE_EXTENSION_DB_COPY_ON_WRITE
+#define ENABLE_DB_REPLICA_CACHE
+#define ENABLE_DB_PREFETCH
 
 // Event
 #define ENABLE_EVENT_HC
+// Satisfy the remote waiters of an event with one message per PD
+#define ENABLE_EVENT_SATISFY_BATCH
 
 // External things (mostly needed by the INI parser)
 #define ENABLE_EXTERNAL_DICTIONARY
@@ -157,6 +181,9 @@
 // Runtime extension support
 #define ENABLE_EXTENSION_RTITF
 
+// Parallel-for with lazy range splitting, loops stay in the calling PD
+#define ENABLE_EXTENSION_PARALLEL_FOR
+
 // Performance monitoring
 //#define ENABLE_EXTENSION_PERF
 
@@ -41,6 +41,7 @@
 // Datablock
 #define ENABLE_DATABLOCK_REGULAR
 #define ENABLE_DATABLOCK_LOCKABLE
+#define ENABLE_DATABLOCK_SINGLE_ASSIGN
 #define ENABLE_EXTENSION_DB_INFO
 
 // Event
@@ -139,6 +140,18 @@
 // GUID labeling extension
 #define ENABLE_EXTENSION_LABELING
 
+// Parallel-for with lazy range splitting
+#define ENABLE_EXTENSION_PARALLEL_FOR
+
+// Zero-copy data block partitions
+#define ENABLE_EXTENSION_DB_PARTITION
+
+// Delta write back of the declared dirty ranges of data blocks
+#define ENABLE_EXTENSION_DB_DIRTY_RANGE
+
+// Copy-on-write data blocks, writers do not wait for readers
+#define ENABLE_EXTENSION_DB_COPY_ON_WRITE
+
 // Performance monitoring
 //#define ENABLE_EXTENSION_PERF
 
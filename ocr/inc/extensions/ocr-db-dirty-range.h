@@ -0,0 +1,66 @@
+/**
+ * @brief Extension to declare the modified ranges of a data block.
+ **/
+
+/*
+ * This file is subject to the license agreement located in the file LICENSE
+ * and cannot be distributed without it. This notice cannot be
+ * removed or modified.
+ */
+
+#ifndef __OCR_DB_DIRTY_RANGE_H__
+#define __OCR_DB_DIRTY_RANGE_H__
+
+#ifdef ENABLE_EXTENSION_DB_DIRTY_RANGE
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @ingroup OCRExt
+ * @{
+ */
+/**
+ * @defgroup OCRExtDbDirtyRange Data block dirty ranges
+ * @brief Reduce write back traffic of sparsely modified data blocks
+ *
+ * When a data block acquired in a writable mode from another policy
+ * domain is released, its whole payload is normally shipped back to the
+ * owner. If the ranges modified while the data block was acquired are
+ * declared, only these ranges are shipped and patched in at the owner.
+ *
+ * @{
+ **/
+
+/**
+ * @brief Declares a range of an acquired data block as modified
+ *
+ * This call is advisory: it is a no-op when the data block is local or
+ * when its implementation does not track dirty ranges. Once a range has
+ * been declared for a data block, every modification made to it by EDTs
+ * of the current policy domain must be declared before the data block is
+ * released; undeclared modifications may be lost. When too many
+ * disjoint ranges are declared, the whole data block is written back.
+ *
+ * @param[in] db           Data block currently acquired by the caller
+ * @param[in] offset       Offset in bytes of the modified range
+ * @param[in] size         Size in bytes of the modified range
+ *
+ * @return a status code:
+ *      - 0: successful
+ *      - OCR_EINVAL: db is not a valid data block or the range is
+ *        out of bounds
+ */
+u8 ocrDbMarkDirty(ocrGuid_t db, u64 offset, u64 size);
+
+/**
+ * @}
+ * @}
+ */
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ENABLE_EXTENSION_DB_DIRTY_RANGE */
+#endif /* __OCR_DB_DIRTY_RANGE_H__ */
@@ -0,0 +1,80 @@
+/**
+ * @brief Extension to partition a data block into zero-copy views.
+ **/
+
+/*
+ * This file is subject to the license agreement located in the file LICENSE
+ * and cannot be distributed without it. This notice cannot be
+ * removed or modified.
+ */
+
+#ifndef __OCR_DB_PARTITION_H__
+#define __OCR_DB_PARTITION_H__
+
+#ifdef ENABLE_EXTENSION_DB_PARTITION
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @ingroup OCRExt
+ * @{
+ */
+/**
+ * @defgroup OCRExtDbPartition Data block partitions
+ * @brief Split a data block into data blocks viewing slices of its payload
+ *
+ * A partition is a data block in its own right: it has its own GUID and
+ * is acquired and released independently of its parent and siblings.
+ * Partitions share the parent's memory, no data is copied when they are
+ * created or acquired locally. When a partition is acquired from another
+ * policy domain, only its slice is transferred.
+ *
+ * @{
+ **/
+
+/**
+ * @brief Creates partitions of a data block
+ *
+ * Partition 'i' views the 'sizes[i]' bytes of 'db' starting at 'offsets[i]'.
+ * Slices may overlap; it is up to the user to acquire overlapping partitions
+ * in compatible modes.
+ *
+ * The parent data block is held in DB_MODE_RW on behalf of the partitions,
+ * or in DB_MODE_CONST if it is currently acquired in that mode. Each
+ * partition drops its hold when it is destroyed. Until every partition
+ * has been destroyed, the parent's memory is not freed, even if the parent
+ * is destroyed first, and its acquires in modes that conflict with the
+ * hold are deferred.
+ *
+ * @param[in] db           Data block to partition
+ * @param[in] partc        Number of partitions to create
+ * @param[in] offsets      Offset in bytes of each partition in db
+ * @param[in] sizes        Size in bytes of each partition
+ * @param[out] partitions  GUIDs of the partitions created
+ *
+ * @return a status code:
+ *      - 0: successful
+ *      - OCR_EINVAL: db is not a valid data block or a slice is
+ *        empty or out of bounds
+ *      - OCR_EACCES: db is currently acquired in DB_MODE_EW
+ *      - OCR_ENOTSUP: db cannot be partitioned by its implementation or
+ *        is not owned by the current policy domain
+ *
+ * @warning The parent must not be accessed through pointers obtained
+ * before the call while partitions are acquired in DB_MODE_RW or
+ * DB_MODE_EW
+ */
+u8 ocrDbPartition(ocrGuid_t db, u32 partc, u64 *offsets, u64 *sizes, ocrGuid_t *partitions);
+
+/**
+ * @}
+ * @}
+ */
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ENABLE_EXTENSION_DB_PARTITION */
+#endif /* __OCR_DB_PARTITION_H__ */
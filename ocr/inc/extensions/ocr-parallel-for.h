@@ -0,0 +1,90 @@
+/**
+ * @brief OCR parallel-for extension. This is an experimental feature
+ **/
+
+/*
+ * This file is subject to the license agreement located in the file LICENSE
+ * and cannot be distributed without it. This notice cannot be
+ * removed or modified.
+ */
+
+#ifndef __OCR_PARALLEL_FOR_H__
+#define __OCR_PARALLEL_FOR_H__
+#ifdef ENABLE_EXTENSION_PARALLEL_FOR
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "ocr-types.h"
+
+/**
+ * @ingroup OCRExt
+ * @{
+ */
+/**
+ * @defgroup OCRExtParallelFor Parallel loops
+ * @brief API to express a loop as a single, lazily split, range task
+ *
+ * A parallel loop starts as a single range EDT covering the whole
+ * iteration space. The range is only split when another worker is
+ * actually looking for work: the owner of a range executes it chunk
+ * by chunk while thieves split off the upper half of what remains.
+ * There is therefore no need to pick a grain size up-front to get
+ * parallelism and the scheduler's deques are not flooded with one EDT
+ * per chunk.
+ *
+ * @note The range descriptors are shared in memory between the owner
+ * and thieves so all the EDTs of a loop execute within the policy
+ * domain that called ocrParallelFor().
+ *
+ * @{
+ **/
+
+/**
+ * @brief Executes a loop body over the iteration range [lo, hi)
+ *
+ * 'funcPtr' is invoked once per chunk with:
+ *   - paramc = paramc + 2
+ *   - paramv[0] and paramv[1] the bounds [start, end) of the chunk
+ *   - paramv[2..] a copy of 'paramv'
+ *   - depc/depv the data blocks 'depv' acquired in the default mode
+ * Chunks may execute concurrently; the value returned by 'funcPtr'
+ * is ignored.
+ *
+ * @param[out] outputEvent  If non-NULL, returns the GUID of an event
+ *                          satisfied once all the iterations have
+ *                          executed. It behaves like the output event of
+ *                          a finish EDT.
+ * @param[in] funcPtr       Loop body
+ * @param[in] lo            First iteration
+ * @param[in] hi            One past the last iteration
+ * @param[in] grain         Minimum number of iterations executed by a
+ *                          single invocation of 'funcPtr'. 0 lets the
+ *                          runtime pick a value based on the number of
+ *                          workers
+ * @param[in] paramc        Number of user parameters
+ * @param[in] paramv        User parameters passed to every chunk
+ * @param[in] depc          Number of dependences
+ * @param[in] depv          GUIDs of the dependences. Must be known
+ *                          (non-NULL) if depc is not 0
+ *
+ * @return a status code:
+ *      - 0: successful
+ *      - OCR_EINVAL: invalid arguments
+ *      - Error codes returned by ocrEdtCreate()
+ **/
+u8 ocrParallelFor(ocrGuid_t *outputEvent, ocrEdt_t funcPtr, u64 lo, u64 hi, u64 grain,
+                  u32 paramc, u64 *paramv, u32 depc, ocrGuid_t *depv);
+
+/**
+ * @}
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ENABLE_EXTENSION_PARALLEL_FOR */
+#endif /* __OCR_PARALLEL_FOR_H__ */
@@ -170,6 +170,14 @@ typedef enum {
                                                *   implemented consistently.
                                                */
 #define DB_PROP_NO_HINT       ((u16)0x40) /**< Property for a data block indicating no hints can be set on the datablock */
+#ifdef ENABLE_EXTENSION_DB_COPY_ON_WRITE
+#define DB_PROP_COPY_ON_WRITE ((u16)0x80) /**< Property for a data block indicating that a writer
+                                           *   acquiring it while it is held in DB_MODE_CONST gets
+                                           *   a copy instead of waiting. Readers keep the previous
+                                           *   version; the writer's version becomes the data block's
+                                           *   content once all of them have released it.
+                                           */
+#endif
 
 /**
  * @}
@@ -209,6 +217,12 @@ typedef struct {
 #define EDT_PROP_NO_HINT ((u16) 0x2) /**< Property bits indicating the EDT does not take hints */
 #define EDT_PROP_LONG    ((u16) 0x4) /**< Property bits indicating a long running EDT */
 #define EDT_PROP_OEVT_VALID ((u16) 0x8) /** Property bits indicating an already initialized output event */
+#define EDT_PROP_ANON    ((u16) 0x10) /**< Property bits indicating an anonymous leaf EDT. Such an EDT
+                                        *   cannot be referenced by its GUID: all its dependences must be
+                                        *   given at creation (NULL_GUID or data blocks) and no GUID is
+                                        *   returned to the caller. The runtime may ignore this property,
+                                        *   ocrCurrentEdtGet returns NULL_GUID when it does not.
+                                        */
 
 /**
  * @brief Constant indicating that the number of parameters or dependences
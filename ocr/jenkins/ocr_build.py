@@ -102,6 +102,21 @@ job_ocr_build_x86_pthread_mpi = {
                  'PATH': '${MPI_ROOT}/bin:'+os.environ['PATH'],}
 }
 
+# Collective events are not part of the default build. Installed
+# separately so that the regular x86-mpi regressions are not affected.
+job_ocr_build_x86_pthread_mpi_colevt = {
+    'name': 'ocr-build-x86-mpi-colevt',
+    'keywords': ('percommit', ),
+    'depends': ('__alternate ocr-init',),
+    'jobtype': 'ocr-build',
+    'run-args': 'x86-mpi',
+    'sandbox': ('inherit0',),
+    'env-vars': {'MPI_ROOT': '/opt/intel/tools/impi/5.1.1.109/intel64',
+                 'PATH': '${MPI_ROOT}/bin:'+os.environ['PATH'],
+                 'OCR_INSTALL': '${JJOB_SHARED_HOME}/ocr/ocr/install-colevt',
+                 'CFLAGS_USER': '-DENABLE_EXTENSION_DISTRIBUTED_LABELED -DENABLE_EXTENSION_COLLECTIVE_EVT -DENABLE_EXTENSION_MULTI_OUTPUT_SLOT',}
+}
+
 job_ocr_build_x86_pthread_gasnet = {
     'name': 'ocr-build-x86-gasnet',
     'keywords': ('percommit', ),
@@ -115,6 +130,22 @@ job_ocr_build_x86_pthread_gasnet = {
                  'GASNET_TYPE': 'par'}
 }
 
+# Single node build on the SMP conduit, the PDs are processes sharing
+# memory. Installed separately from the ibv build.
+job_ocr_build_x86_pthread_gasnet_smp = {
+    'name': 'ocr-build-x86-gasnet-smp',
+    'keywords': ('percommit', ),
+    'depends': ('__alternate ocr-init',),
+    'jobtype': 'ocr-build',
+    'run-args': 'x86-gasnet',
+    'sandbox': ('inherit0',),
+    'env-vars': {'GASNET_ROOT': '/opt/rice/GASNet/1.24.0-impi',
+                 'PATH': '${GASNET_ROOT}/bin:'+os.environ['PATH'],
+                 'OCR_INSTALL': '${JJOB_SHARED_HOME}/ocr/ocr/install-gasnet-smp',
+                 'GASNET_CONDUIT': 'smp',
+                 'GASNET_TYPE': 'par'}
+}
+
 job_ocr_build_x86_pthread_tg = {
     'name': 'ocr-build-tg-x86',
     'keywords': ('percommit', ),
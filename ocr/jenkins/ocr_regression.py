@@ -68,6 +68,15 @@ job_ocr_regression_x86_pthread_x86_lockableDB = {
     'sandbox': ('inherit0',)
 }
 
+# Same with single-assignment DBs handled by their dedicated factory
+job_ocr_regression_x86_pthread_x86_singleAssign_lockableDB = {
+    'name': 'ocr-regression-x86-singleAssign-lockableDB',
+    'depends': ('ocr-build-x86',),
+    'jobtype': 'ocr-regression',
+    'run-args': 'x86 jenkins-common-8w-lockableDB-singleAssign.cfg lockableDB',
+    'sandbox': ('inherit0',)
+}
+
 #job_ocr_regression_x86_pthread_tg_regularDB = {
 #    'name': 'ocr-regression-tg-x86-regularDB',
 #    'depends': ('ocr-build-tg-x86',),
@@ -108,6 +117,99 @@ job_ocr_regression_x86_pthread_mpi_lockableDB = {
                  'LD_LIBRARY_PATH': '${MPI_ROOT}/lib64',}
 }
 
+#TODO: not sure how to not hardcode MPI_ROOT here
+# Same with a flow control window small enough for requests to wait for credits
+job_ocr_regression_x86_pthread_mpi_credits_lockableDB = {
+    'name': 'ocr-regression-x86-mpi-credits-lockableDB',
+    'depends': ('ocr-build-x86-mpi',),
+    'jobtype': 'ocr-regression',
+    'run-args': 'x86-mpi jenkins-x86-mpi-credits.cfg lockableDB',
+    'sandbox': ('inherit0',),
+    'env-vars': {'MPI_ROOT': '/opt/intel/tools/impi/5.1.1.109/intel64',
+                 'PATH': '${MPI_ROOT}/bin:'+os.environ['PATH'],
+                 'LD_LIBRARY_PATH': '${MPI_ROOT}/lib64',}
+}
+
+#TODO: not sure how to not hardcode MPI_ROOT here
+# Same with a replica cache small enough for replicas to be evicted
+job_ocr_regression_x86_pthread_mpi_replicacache_lockableDB = {
+    'name': 'ocr-regression-x86-mpi-replicacache-lockableDB',
+    'depends': ('ocr-build-x86-mpi',),
+    'jobtype': 'ocr-regression',
+    'run-args': 'x86-mpi jenkins-x86-mpi-replicacache.cfg lockableDB',
+    'sandbox': ('inherit0',),
+    'env-vars': {'MPI_ROOT': '/opt/intel/tools/impi/5.1.1.109/intel64',
+                 'PATH': '${MPI_ROOT}/bin:'+os.environ['PATH'],
+                 'LD_LIBRARY_PATH': '${MPI_ROOT}/lib64',}
+}
+
+#TODO: not sure how to not hardcode MPI_ROOT here
+# Same with two comm-workers, each one driving its own MPI comm-platform
+job_ocr_regression_x86_pthread_mpi_shards_lockableDB = {
+    'name': 'ocr-regression-x86-mpi-shards-lockableDB',
+    'depends': ('ocr-build-x86-mpi',),
+    'jobtype': 'ocr-regression',
+    'run-args': 'x86-mpi jenkins-x86-mpi-shards.cfg lockableDB',
+    'sandbox': ('inherit0',),
+    'env-vars': {'MPI_ROOT': '/opt/intel/tools/impi/5.1.1.109/intel64',
+                 'PATH': '${MPI_ROOT}/bin:'+os.environ['PATH'],
+                 'LD_LIBRARY_PATH': '${MPI_ROOT}/lib64',
+                 'OCR_MPI_THREAD_LEVEL': 'multiple',}
+}
+
+#TODO: not sure how to not hardcode MPI_ROOT here
+# Same with single-assignment DBs handled by their dedicated factory
+job_ocr_regression_x86_pthread_mpi_singleAssign_lockableDB = {
+    'name': 'ocr-regression-x86-mpi-singleAssign-lockableDB',
+    'depends': ('ocr-build-x86-mpi',),
+    'jobtype': 'ocr-regression',
+    'run-args': 'x86-mpi jenkins-x86-mpi-singleAssign.cfg lockableDB',
+    'sandbox': ('inherit0',),
+    'env-vars': {'MPI_ROOT': '/opt/intel/tools/impi/5.1.1.109/intel64',
+                 'PATH': '${MPI_ROOT}/bin:'+os.environ['PATH'],
+                 'LD_LIBRARY_PATH': '${MPI_ROOT}/lib64',}
+}
+
+#TODO: not sure how to not hardcode MPI_ROOT here
+job_ocr_regression_x86_pthread_mpi_colevt_lockableDB = {
+    'name': 'ocr-regression-x86-mpi-colevt-lockableDB',
+    'depends': ('ocr-build-x86-mpi-colevt',),
+    'jobtype': 'ocr-regression',
+    'run-args': 'x86-mpi jenkins-x86-mpi.cfg lockableDB',
+    'sandbox': ('inherit0',),
+    'env-vars': {'MPI_ROOT': '/opt/intel/tools/impi/5.1.1.109/intel64',
+                 'PATH': '${MPI_ROOT}/bin:'+os.environ['PATH'],
+                 'LD_LIBRARY_PATH': '${MPI_ROOT}/lib64',
+                 'OCR_INSTALL': '${JJOB_SHARED_HOME}/ocr/ocr/install-colevt',
+                 'TEST_OPTIONS_EXTRA': '-ext_collective_evt',}
+}
+
+#TODO: not sure how to not hardcode MPI_ROOT here
+# Same build, the PDs of the node talk through the shared-memory comm-platform
+job_ocr_regression_x86_pthread_mpi_shm_lockableDB = {
+    'name': 'ocr-regression-x86-mpi-shm-lockableDB',
+    'depends': ('ocr-build-x86-mpi',),
+    'jobtype': 'ocr-regression',
+    'run-args': 'x86-mpi mach-x86-shm-affinity-8w-lockableDB.cfg lockableDB',
+    'sandbox': ('inherit0',),
+    'env-vars': {'MPI_ROOT': '/opt/intel/tools/impi/5.1.1.109/intel64',
+                 'PATH': '${MPI_ROOT}/bin:'+os.environ['PATH'],
+                 'LD_LIBRARY_PATH': '${MPI_ROOT}/lib64',}
+}
+
+#TODO: not sure how to not hardcode MPI_ROOT here
+# Same as above with the links between the PDs emulating a network
+job_ocr_regression_x86_pthread_mpi_shm_emul_lockableDB = {
+    'name': 'ocr-regression-x86-mpi-shm-emul-lockableDB',
+    'depends': ('ocr-build-x86-mpi',),
+    'jobtype': 'ocr-regression',
+    'run-args': 'x86-mpi mach-x86-shm-emul-affinity-8w-lockableDB.cfg lockableDB',
+    'sandbox': ('inherit0',),
+    'env-vars': {'MPI_ROOT': '/opt/intel/tools/impi/5.1.1.109/intel64',
+                 'PATH': '${MPI_ROOT}/bin:'+os.environ['PATH'],
+                 'LD_LIBRARY_PATH': '${MPI_ROOT}/lib64',}
+}
+
 #TODO: not sure how to not hardcode MPI_ROOT here
 # Bug #945 re-enable when tests are fixed
 #job_ocr_regression_x86_pthread_mpi_st_lockableDB = {
@@ -138,3 +240,21 @@ job_ocr_regression_x86_pthread_gasnet_lockableDB = {
                  # picked up by non-regression test script
                  'OCR_LDFLAGS': '-L${GASNET_ROOT}/lib -lgasnet-${GASNET_CONDUIT}-${GASNET_TYPE} ${GASNET_EXTRA_LIBS}',}
 }
+
+#TODO: not sure how to not hardcode GASNET_ROOT here
+# The PDs are processes forked on the node by the SMP conduit
+job_ocr_regression_x86_pthread_gasnet_smp_lockableDB = {
+    'name': 'ocr-regression-x86-gasnet-smp-lockableDB',
+    'depends': ('ocr-build-x86-gasnet-smp',),
+    'jobtype': 'ocr-regression',
+    'run-args': 'x86-gasnet jenkins-x86-gasnet.cfg lockableDB',
+    'sandbox': ('inherit0',),
+    'env-vars': {'GASNET_ROOT': '/opt/rice/GASNet/1.24.0-impi',
+                 'PATH': '${GASNET_ROOT}/bin:'+os.environ['PATH'],
+                 'OCR_INSTALL': '${JJOB_SHARED_HOME}/ocr/ocr/install-gasnet-smp',
+                 'GASNET_CONDUIT': 'smp',
+                 'GASNET_TYPE': 'par',
+                 'GASNET_EXTRA_LIBS': '-L/usr/lib64 -lrt',
+                 # picked up by non-regression test script
+                 'OCR_LDFLAGS': '-L${GASNET_ROOT}/lib -lgasnet-${GASNET_CONDUIT}-${GASNET_TYPE} ${GASNET_EXTRA_LIBS}',}
+}
@@ -8,7 +8,8 @@ if [ $1 == "_params" ]; then
 else
     # ARGS: OCR_TYPE CFG_FILE DB_IMPL
     OCR_TYPE=$1
-    export OCR_INSTALL=${JJOB_SHARED_HOME}/ocr/ocr/install
+    # Jobs testing a non-default build point OCR_INSTALL to its install
+    export OCR_INSTALL=${OCR_INSTALL:-${JJOB_SHARED_HOME}/ocr/ocr/install}
     export PATH=${OCR_INSTALL}/bin:$PATH
     export LD_LIBRARY_PATH=${OCR_INSTALL}/lib:${LD_LIBRARY_PATH}
 
@@ -27,11 +28,11 @@ else
 
     if [[ "${OCR_TYPE}" == "x86" ]]; then
         # Also tests legacy and rt-api supports => these MUST be built by default for OCR x86
-        TEST_OPTIONS="-ext_rtapi -ext_legacy -ext_params_evt -ext_counted_evt -ext_channel_evt"
+        TEST_OPTIONS="-ext_rtapi -ext_legacy -ext_params_evt -ext_counted_evt -ext_channel_evt -ext_parallel_for -ext_db_partition -ext_db_dirty_range -ext_db_copy_on_write"
     fi
 
     if [[ "${OCR_TYPE}" == "x86-mpi" ]]; then
-        TEST_OPTIONS="-ext_rtapi -ext_params_evt -ext_counted_evt -ext_channel_evt -ext_labeling"
+        TEST_OPTIONS="-ext_rtapi -ext_params_evt -ext_counted_evt -ext_channel_evt -ext_labeling -ext_parallel_for -ext_db_partition -ext_db_dirty_range -ext_db_copy_on_write"
     fi
 
     if [[ "${OCR_TYPE}" == "tg" ]]; then
@@ -41,9 +42,18 @@ else
         fi
     fi
 
+    # Options of the extensions a job's build enables on top of the default ones
+    TEST_OPTIONS+=" ${TEST_OPTIONS_EXTRA}"
+
     OCR_TYPE=${OCR_TYPE} ./ocrTests ${TEST_OPTIONS} -unstablefile unstable.${OCR_TYPE}-${DB_IMPL}
     RES=$?
 
+    # Policy messages round trip through their compact encoding
+    if [[ $RES -eq 0 && ( "${OCR_TYPE}" == "x86" || "${OCR_TYPE}" == "x86-mpi" ) ]]; then
+        make -C compact-msg-check OCR_TYPE=${OCR_TYPE} OCR_INSTALL=${OCR_INSTALL} check
+        RES=$?
+    fi
+
     #Conditionally execute to preserve logs if previous run failed.
     if [[ $RES -eq 0 ]]; then
         #TODO: Disable performance test for x86-gasnet, tg-x86, tg
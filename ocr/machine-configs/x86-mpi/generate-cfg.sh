@@ -33,9 +33,29 @@ done
 # Jenkins config
 ARGS="--guid LABELED --target ${PLATFORM} --scheduler PLACEMENT_AFFINITY --threads 8 --remove-destination"
 $CFG_SCRIPT ${ARGS} --output jenkins-x86-${PLATFORM}.cfg
+$CFG_SCRIPT ${ARGS} --dbsa --output jenkins-x86-${PLATFORM}-singleAssign.cfg
+
+# Jenkins config with a small flow control window
+$CFG_SCRIPT ${ARGS} --credits 4 --output jenkins-x86-${PLATFORM}-credits.cfg
+
+# Jenkins config with a replica cache small enough to evict
+$CFG_SCRIPT ${ARGS} --replicacache 262144 --output jenkins-x86-${PLATFORM}-replicacache.cfg
+
+# Jenkins config with two comm-workers, needs OCR_MPI_THREAD_LEVEL=multiple
+$CFG_SCRIPT ${ARGS} --commworkers 2 --output jenkins-x86-${PLATFORM}-shards.cfg
 
 # Jenkins ST config
 ARGS="--guid COUNTED_MAP --target ${PLATFORM} --scheduler ST --threads 8 --remove-destination"
 $CFG_SCRIPT ${ARGS} --output jenkins-x86-${PLATFORM}-st.cfg
 
+# Shared memory between the PDs of a node
+ARGS="--guid COUNTED_MAP --target shm --scheduler PLACEMENT_AFFINITY  --remove-destination"
+for c in `echo "2 4 8"`; do
+    $CFG_SCRIPT ${ARGS} --threads ${c} --output mach-x86-shm-affinity-${c}w-lockableDB.cfg
+done
+
+# Shared memory with emulated links between the PDs
+ARGS="--guid COUNTED_MAP --target shm --scheduler PLACEMENT_AFFINITY --latency 20000 --jitter 10000 --bandwidth 1000 --seed 1 --remove-destination"
+$CFG_SCRIPT ${ARGS} --threads 8 --output mach-x86-shm-emul-affinity-8w-lockableDB.cfg
+
 unset CFG_SCRIPT
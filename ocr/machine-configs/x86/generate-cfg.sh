@@ -2,6 +2,7 @@
 
 export CFG_SCRIPT=../../scripts/Configs/config-generator.py
 $CFG_SCRIPT --threads 8 --output jenkins-common-8w-lockableDB.cfg --remove-destination
+$CFG_SCRIPT --threads 8 --dbsa --output jenkins-common-8w-lockableDB-singleAssign.cfg --remove-destination
 $CFG_SCRIPT --threads 8 --dbtype Regular --output jenkins-common-8w-regularDB.cfg --remove-destination
 $CFG_SCRIPT --threads 1 --dbtype Regular --output mach-hc-1w.cfg --remove-destination
 $CFG_SCRIPT --threads 2 --dbtype Regular --output mach-hc-2w.cfg --remove-destination
@@ -16,7 +16,7 @@ parser.add_argument('--guid', dest='guid', default='PTR', choices=['PTR', 'COUNT
                    help='guid type to use (default: PTR)')
 parser.add_argument('--platform', dest='platform', default='X86', choices=['X86', 'FSIM'],
                    help='platform type to use (default: X86)')
-parser.add_argument('--target', dest='target', default='x86', choices=['x86', 'fsim', 'mpi', 'mpi_probe', 'gasnet'],
+parser.add_argument('--target', dest='target', default='x86', choices=['x86', 'fsim', 'mpi', 'mpi_probe', 'gasnet', 'shm'],
                    help='target type to use (default: X86)')
 parser.add_argument('--threads', dest='threads', type=int, default=4,
                    help='number of threads available to OCR (default: 4)')
@@ -28,12 +28,28 @@ parser.add_argument('--sysworker', dest='sysworker', action='store_true',
                    help='use 1 worker exclusively for system activities (e.g., tracing) (default: no)')
 parser.add_argument('--mtworker', dest='mtworker', action='store_true',
                    help='Temporary flag to activate MT-based communication worker(default: no)')
+parser.add_argument('--commworkers', dest='commworkers', type=int, default=1,
+                   help='number of communication workers for distributed targets, each one drives its own comm-platform; MPI needs OCR_MPI_THREAD_LEVEL=multiple when more than 1 (default: 1)')
+parser.add_argument('--credits', dest='credits', type=int, default=-1,
+                   help='number of requests a PD may have in flight to each peer for distributed targets, 0 for unlimited (default: runtime default)')
+parser.add_argument('--latency', dest='latency', type=int, default=0,
+                   help='latency (in ns) of the emulated links between ranks of the shm target (default: 0)')
+parser.add_argument('--jitter', dest='jitter', type=int, default=0,
+                   help='upper bound (in ns) of the random delay added by the emulated links of the shm target (default: 0)')
+parser.add_argument('--bandwidth', dest='bandwidth', type=int, default=0,
+                   help='bandwidth (in MB/s) of the emulated links of the shm target, 0 for unlimited (default: 0)')
+parser.add_argument('--seed', dest='seed', type=int, default=0,
+                   help='seed of the jitter of the emulated links of the shm target (default: 0)')
 parser.add_argument('--alloc', dest='alloc', default='32',
                    help='size (in MB) of memory available for app use (default: 32)')
 parser.add_argument('--alloctype', dest='alloctype', default='mallocproxy', choices=['quick', 'mallocproxy', 'tlsf', 'simple'],
                    help='type of allocator to use (default: mallocproxy)')
 parser.add_argument('--dbtype', dest='dbtype', default='Lockable', choices=['Lockable', 'Regular'],
                    help='type of datablocks to use (default: Lockable)')
+parser.add_argument('--dbsa', dest='dbsa', action='store_true',
+                   help='add a SingleAssign datablock factory for DB_PROP_SINGLE_ASSIGNMENT datablocks (default: no)')
+parser.add_argument('--replicacache', dest='replicacache', type=int, default=-1,
+                   help='bytes of read-only copies of remote Lockable datablocks a PD may keep, 0 to disable (default: runtime default)')
 parser.add_argument('--scheduler', dest='scheduler', default='HC', choices=['HC', 'PRIORITY', 'PLACEMENT_AFFINITY', 'LEGACY', 'ST', 'STATIC'],
                    help='scheduler heuristic (default: HC)')
 parser.add_argument('--dequetype', dest='dequetype', default='WORK_STEALING_DEQUE', choices=['WORK_STEALING_DEQUE', 'LOCKED_DEQUE'],
@@ -50,23 +66,45 @@ platform = args.platform
 target = args.target.upper()
 if target == 'GASNET':
     target = 'GASNet'
+if target == 'SHM':
+    target = 'Shm'
 threads = args.threads
 binding = args.binding
 numa = args.numa
 alloc = args.alloc
 alloctype = args.alloctype
 dbtype = args.dbtype
+dbsa = args.dbsa
+replicacache = args.replicacache
 scheduler = args.scheduler
 dequetype = args.dequetype
 outputfilename = args.output
 rmdest = args.rmdest
 sysworker = args.sysworker
 mtworker = args.mtworker
+commworkers = args.commworkers
+credits = args.credits
+latency = args.latency
+jitter = args.jitter
+bandwidth = args.bandwidth
+seed = args.seed
 
 if sysworker == True and platform != 'X86':
     print 'Sysworker currently supported only with platform x86'
     sys.exit(0)
 
+if commworkers < 1 or (commworkers > 1 and commworkers >= threads):
+    print 'Number of communication workers must be between 1 and the number of threads minus one'
+    sys.exit(0)
+
+if (latency != 0 or jitter != 0 or bandwidth != 0) and target != 'Shm':
+    print 'Link emulation is only supported with the shm target'
+    sys.exit(0)
+
+if commworkers > 1 and mtworker == True:
+    print 'Several communication workers are not supported with the MT-based communication worker'
+    sys.exit(0)
+
 def GenerateVersion(output):
     version = "1.1.0"
     output.write("[General]\n\tversion\t=\t%s\n\n" % (version))
@@ -101,7 +139,13 @@ def GeneratePd(output, pdtype, dbtype, threads):
 def GenerateCommon(output, pdtype, dbtype):
     output.write("[TaskType0]\n\tname=\t%s\n\n" % (pdtype))
     output.write("[TaskTemplateType0]\n\tname=\t%s\n\n" % (pdtype))
-    output.write("[DataBlockType0]\n\tname=\t%s\n\n" % (dbtype))
+    output.write("[DataBlockType0]\n\tname=\t%s\n" % (dbtype))
+    if replicacache >= 0:
+        # Budget of the read-only replica cache
+        output.write("\treplicacache\t=\t%d\n" % (replicacache))
+    output.write("\n")
+    if dbsa:
+        output.write("[DataBlockType1]\n\tname=\t%s\n\n" % ("SingleAssign"))
     output.write("[EventType0]\n\tname=\t%s\n\n" % (pdtype))
     output.write("\n#======================================================\n")
 
@@ -130,24 +174,36 @@ def GenerateMem(output, size, count, alloctype):
 def GenerateComm(output, comms, pdtype, threads):
     output.write("\n#======================================================\n")
     if pdtype == 'HCDist':
+        # The first 'commworkers' workers are communication workers,
+        # each one with its own comm-platform
+        commIds = "0" if commworkers == 1 else "0-%d" % (commworkers-1)
         output.write("[CommApiType0]\n\tname\t=\t%s\n" % ("Simple"))
+        if credits >= 0:
+            # Flow control window per peer
+            output.write("\tcredits\t=\t%d\n" % (credits))
         output.write("[CommApiInst0]\n")
-        output.write("\tid\t=\t0\n")
+        output.write("\tid\t=\t%s\n" % (commIds))
         output.write("\ttype\t=\t%s\n" % ("Simple"))
-        output.write("\tcommplatform\t=\t0\n")
+        output.write("\tcommplatform\t=\t%s\n" % (commIds))
         output.write("[CommApiType1]\n\tname\t=\t%s\n" % ("Delegate"))
         output.write("[CommApiInst1]\n")
-        output.write("\tid\t=\t1-%d\n" % (threads-1))
+        output.write("\tid\t=\t%d-%d\n" % (commworkers, threads-1))
         output.write("\ttype\t=\t%s\n" % ("Delegate"))
-        output.write("\tcommplatform\t=\t1-%d\n" % (threads-1))
+        output.write("\tcommplatform\t=\t%d-%d\n" % (commworkers, threads-1))
         output.write("\n#======================================================\n")
         output.write("[CommPlatformType0]\n\tname\t=\t%s\n" % ("None"))
         output.write("[CommPlatformInst0]\n")
-        output.write("\tid\t=\t1-%d\n" % (threads-1))
+        output.write("\tid\t=\t%d-%d\n" % (commworkers, threads-1))
         output.write("\ttype\t=\t%s\n" % ("None"))
         output.write("[CommPlatformType1]\n\tname\t=\t%s\n" % (comms))
+        if latency != 0 or jitter != 0 or bandwidth != 0:
+            # Emulated links between the ranks
+            output.write("\tlatency\t=\t%d\n" % (latency))
+            output.write("\tjitter\t=\t%d\n" % (jitter))
+            output.write("\tbandwidth\t=\t%d\n" % (bandwidth))
+            output.write("\tseed\t=\t%d\n" % (seed))
         output.write("[CommPlatformInst1]\n")
-        output.write("\tid\t=\t0\n")
+        output.write("\tid\t=\t%s\n" % (commIds))
         output.write("\ttype\t=\t%s\n" % (comms))
     else:
         output.write("[CommPlatformType0]\n\tname\t=\t%s\n" % ("None"))
@@ -228,24 +284,42 @@ def GenerateComp(output, pdtype, threads, binding, numa, sysworker, schedtype):
     output.write("\ttype\t=\t%s\n" % (masterWorkerType))
     output.write("\tworkertype\t=\tmaster\n")
     output.write("\tcomptarget\t=\t0\n")
-    if threads > 1:
+    # Additional communication workers for distributed
+    firstSlave = 1
+    nextInst = 1
+    if (pdtype == 'HCDist') and (commworkers > 1):
+        output.write("[WorkerInst%d]\n" % (nextInst))
+        if commworkers == 2:
+            output.write("\tid\t=\t1\n")
+        else:
+            output.write("\tid\t=\t1-%d\n" % (commworkers-1))
+        output.write("\ttype\t=\t%s\n" % (masterWorkerType))
+        output.write("\tworkertype\t=\tslave\n")
+        if commworkers == 2:
+            output.write("\tcomptarget\t=\t1\n")
+        else:
+            output.write("\tcomptarget\t=\t1-%d\n" % (commworkers-1))
+        firstSlave = commworkers
+        nextInst = nextInst + 1
+    if threads > firstSlave:
         if (pdtype == 'HCDist'): # Need a second type for distributed
             output.write("[WorkerType1]\n\tname\t=\tHC\n")
-        output.write("[WorkerInst1]\n")
+        output.write("[WorkerInst%d]\n" % (nextInst))
         if sysworker:
-            output.write("\tid\t=\t1-%d\n" % (threads-2))
+            output.write("\tid\t=\t%d-%d\n" % (firstSlave, threads-2))
         else:
-            output.write("\tid\t=\t1-%d\n" % (threads-1))
+            output.write("\tid\t=\t%d-%d\n" % (firstSlave, threads-1))
         output.write("\ttype\t=\tHC\n")
         output.write("\tworkertype\t=\tslave\n")
         if sysworker:
-            output.write("\tcomptarget\t=\t1-%d\n" % (threads-2))
+            output.write("\tcomptarget\t=\t%d-%d\n" % (firstSlave, threads-2))
         else:
-            output.write("\tcomptarget\t=\t1-%d\n" % (threads-1))
+            output.write("\tcomptarget\t=\t%d-%d\n" % (firstSlave, threads-1))
+        nextInst = nextInst + 1
 
         if sysworker:
             output.write("[WorkerType2]\n\tname\t=\tSYSTEM\n")
-            output.write("[WorkerInst2]\n")
+            output.write("[WorkerInst%d]\n" % (nextInst))
             output.write("\tid\t=\t%d\n" % (threads-1))
             output.write("\ttype\t=\tSYSTEM\n")
             output.write("\tworkertype\t=\tsystem\n")
@@ -390,7 +464,7 @@ def GenerateConfig(filehandle, guid, platform, target, threads, binding, numa, s
         GeneratePd(filehandle, "XE", dbtype, threads)
         GenerateCommon(filehandle, "HC", dbtype)
         GenerateMem(filehandle, alloc, 1, alloctype)
-    elif (target=='MPI') or (target=='GASNet') or (target=='MPI_PROBE'):
+    elif (target=='MPI') or (target=='GASNet') or (target=='MPI_PROBE') or (target=='Shm'):
         # catch default value errors for distributed
         if dbtype != 'Lockable':
             print 'error: target ', target, ' only supports Lockable datablocks; received ', dbtype
@@ -75,6 +75,7 @@ ocrMessageTypes = [
 ["PD_MSG_DEP_REGSIGNALER",              "0x82080"],
 ["PD_MSG_DEP_REGWAITER",                "0x83080"],
 ["PD_MSG_DEP_SATISFY",                  "0x104080"],
+["PD_MSG_DEP_SATISFY_MULTI",            "0xc9080"],
 ["PD_MSG_DEP_UNREGSIGNALER",            "0x85080"],
 ["PD_MSG_DEP_UNREGWAITER",              "0x86080"],
 ["PD_MSG_DEP_DYNADD",                   "0x87080"],
@@ -89,6 +90,7 @@ ocrMessageTypes = [
 ["PD_MSG_MGT_UNREGISTER",               "0x2200"],
 ["PD_MSG_MGT_MONITOR_PROGRESS",         "0x3200"],
 ["PD_MSG_MGT_RL_NOTIFY",                "0x4200"],
+["PD_MSG_MGT_FLOW_CREDIT",              "0x5200"],
 # ["PD_MSG_HINT_OP",                      "0x400"],
 ["PD_MSG_HINT_SET",                     "0x41400"],
 ["PD_MSG_HINT_GET",                     "0x42400"],
@@ -0,0 +1,219 @@
+/*
+ * This file is subject to the license agreement located in the file LICENSE
+ * and cannot be distributed without it. This notice cannot be
+ * removed or modified.
+ */
+
+#include "ocr-config.h"
+#ifdef ENABLE_EXTENSION_PARALLEL_FOR
+
+#include "debug.h"
+#include "extensions/ocr-parallel-for.h"
+#ifdef ENABLE_EXTENSION_AFFINITY
+#include "extensions/ocr-affinity.h"
+#include "extensions/ocr-hints.h"
+#endif
+#include "ocr-edt.h"
+#include "ocr-errors.h"
+#include "ocr-hal.h"
+#include "ocr-policy-domain.h"
+#include "ocr-types.h"
+
+#include "utils/profiler/profiler.h"
+
+#define DEBUG_TYPE API
+
+// Number of chunks per worker the default grain size aims for
+#ifndef PARALLEL_FOR_CHUNKS_PER_WORKER
+#define PARALLEL_FOR_CHUNKS_PER_WORKER 8
+#endif
+
+// Layout of the paramv of a range EDT. The body's paramv follows
+// the header: [start, end, user parameters...]
+#define PFOR_PARAM_FUNC   0
+#define PFOR_PARAM_GRAIN  1
+#define PFOR_PARAM_VICTIM 2
+#define PFOR_PARAM_HEADER 3
+
+/**
+ * @brief Iterations a range EDT has not executed yet
+ *
+ * The owner takes chunks from the bottom while split stubs take
+ * the upper half. The descriptor is freed by the last of the owner
+ * and the stubs referencing it.
+ */
+typedef struct _pforRange_t {
+    lock_t lock;
+    u64 lo;
+    u64 hi;
+    volatile u32 refs;
+} pforRange_t;
+
+static ocrGuid_t parallelForRangeEdt(u32 paramc, u64 *paramv, u32 depc, ocrEdtDep_t depv[]);
+
+// Range EDTs share their descriptors through memory: keep them in the
+// current policy domain. Returns the hint to create them with.
+static ocrHint_t * pforHint(ocrHint_t *hint) {
+#ifdef ENABLE_EXTENSION_AFFINITY
+    ocrGuid_t curAffinity;
+    if ((ocrAffinityGetCurrent(&curAffinity) == 0) && (ocrHintInit(hint, OCR_HINT_EDT_T) == 0) &&
+        (ocrSetHintValue(hint, OCR_HINT_EDT_AFFINITY, ocrAffinityToHintValue(curAffinity)) == 0)) {
+        return hint;
+    }
+#endif
+    return NULL_HINT;
+}
+
+static void pforRangeRelease(ocrPolicyDomain_t *pd, pforRange_t *range) {
+    if (hal_xadd32(&range->refs, -1) == 1) {
+        pd->fcts.pdFree(pd, range);
+    }
+}
+
+/**
+ * @brief Pushes a stub that splits 'victim' if it gets to execute
+ * while the victim still has work left.
+ *
+ * The stub is a range EDT acquiring the same data blocks as the
+ * current one. If nobody steals it, it is picked up by the owner's
+ * worker once the owner is done and finds nothing left to split.
+ */
+static u8 pforSpawnStub(pforRange_t *victim, u32 paramc, u64 *paramv, u32 depc, ocrEdtDep_t depv[]) {
+    ocrGuid_t templateGuid, stubGuid;
+    ocrHint_t hint;
+    u8 returnCode = ocrEdtTemplateCreate(&templateGuid, parallelForRangeEdt, paramc, depc);
+    if (returnCode)
+        return returnCode;
+    hal_xadd32(&victim->refs, 1);
+    u64 prevVictim = paramv[PFOR_PARAM_VICTIM];
+    paramv[PFOR_PARAM_VICTIM] = (u64) victim;
+    returnCode = ocrEdtCreate(&stubGuid, templateGuid, paramc, paramv, depc, NULL,
+                              EDT_PROP_NONE, pforHint(&hint), NULL);
+    paramv[PFOR_PARAM_VICTIM] = prevVictim;
+    if (returnCode == 0) {
+        u32 i;
+        for (i = 0; i < depc; ++i) {
+            ocrAddDependence(depv[i].guid, stubGuid, i, depv[i].mode);
+        }
+    } else {
+        hal_xadd32(&victim->refs, -1);
+    }
+    ocrEdtTemplateDestroy(templateGuid);
+    return returnCode;
+}
+
+static ocrGuid_t parallelForRangeEdt(u32 paramc, u64 *paramv, u32 depc, ocrEdtDep_t depv[]) {
+    ocrPolicyDomain_t *pd = NULL;
+    getCurrentEnv(&pd, NULL, NULL, NULL);
+    ocrEdt_t funcPtr = (ocrEdt_t) paramv[PFOR_PARAM_FUNC];
+    u64 grain = paramv[PFOR_PARAM_GRAIN];
+    u32 bodyParamc = paramc - PFOR_PARAM_HEADER;
+    u64 *bodyParamv = &paramv[PFOR_PARAM_HEADER];
+    pforRange_t *victim = (pforRange_t *) paramv[PFOR_PARAM_VICTIM];
+    u64 lo = bodyParamv[0];
+    u64 hi = bodyParamv[1];
+    if (victim != NULL) {
+        // Split stub: steal the upper half of what the victim has left
+        bool rearm = false;
+        hal_lock(&victim->lock);
+        lo = victim->lo;
+        hi = victim->hi;
+        if (((hi - lo) >> 1) >= grain) {
+            lo += (hi - lo) >> 1;
+            victim->hi = lo;
+            rearm = (((lo - victim->lo) >> 1) >= grain);
+        } else {
+            lo = hi;
+        }
+        hal_unlock(&victim->lock);
+        if (rearm) {
+            // Give other thieves a chance to split the victim as well
+            pforSpawnStub(victim, paramc, paramv, depc, depv);
+        }
+        pforRangeRelease(pd, victim);
+        if (lo == hi)
+            return NULL_GUID;
+        paramv[PFOR_PARAM_VICTIM] = 0;
+        DPRINTF(DEBUG_LVL_VVERB, "parallelFor: split off [%"PRIu64", %"PRIu64")\n", lo, hi);
+    }
+
+    if (((hi - lo) >> 1) < grain) {
+        // Not worth splitting
+        bodyParamv[0] = lo;
+        bodyParamv[1] = hi;
+        funcPtr(bodyParamc, bodyParamv, depc, depv);
+        return NULL_GUID;
+    }
+
+    pforRange_t *range = (pforRange_t *) pd->fcts.pdMalloc(pd, sizeof(pforRange_t));
+    range->lock = INIT_LOCK;
+    range->lo = lo;
+    range->hi = hi;
+    range->refs = 1;
+    if (pforSpawnStub(range, paramc, paramv, depc, depv)) {
+        DPRINTF(DEBUG_LVL_WARN, "parallelFor: unable to create split stub, executing range sequentially\n");
+    }
+    while (true) {
+        hal_lock(&range->lock);
+        lo = range->lo;
+        hi = range->hi;
+        if ((hi - lo) > grain)
+            hi = lo + grain;
+        range->lo = hi;
+        hal_unlock(&range->lock);
+        if (lo == hi)
+            break;
+        bodyParamv[0] = lo;
+        bodyParamv[1] = hi;
+        funcPtr(bodyParamc, bodyParamv, depc, depv);
+    }
+    pforRangeRelease(pd, range);
+    return NULL_GUID;
+}
+
+u8 ocrParallelFor(ocrGuid_t *outputEvent, ocrEdt_t funcPtr, u64 lo, u64 hi, u64 grain,
+                  u32 paramc, u64 *paramv, u32 depc, ocrGuid_t *depv) {
+    START_PROFILE(api_ocrParallelFor);
+    DPRINTF(DEBUG_LVL_INFO, "ENTER ocrParallelFor(func=%p, lo=%"PRIu64", hi=%"PRIu64", grain=%"PRIu64
+            ", paramc=%"PRIu32", depc=%"PRIu32")\n", funcPtr, lo, hi, grain, paramc, depc);
+    if ((funcPtr == NULL) || (lo > hi) || ((paramc != 0) && (paramv == NULL)) ||
+        ((depc != 0) && (depv == NULL))) {
+        DPRINTF(DEBUG_LVL_WARN, "EXIT ocrParallelFor: invalid arguments\n");
+        RETURN_PROFILE(OCR_EINVAL);
+    }
+    if (grain == 0) {
+        ocrPolicyDomain_t *pd = NULL;
+        getCurrentEnv(&pd, NULL, NULL, NULL);
+        grain = (hi - lo) / (PARALLEL_FOR_CHUNKS_PER_WORKER * pd->workerCount);
+        if (grain == 0)
+            grain = 1;
+    }
+
+    u32 rangeParamc = PFOR_PARAM_HEADER + 2 + paramc;
+    u64 rangeParamv[rangeParamc];
+    rangeParamv[PFOR_PARAM_FUNC] = (u64) funcPtr;
+    rangeParamv[PFOR_PARAM_GRAIN] = grain;
+    rangeParamv[PFOR_PARAM_VICTIM] = 0;
+    rangeParamv[PFOR_PARAM_HEADER] = lo;
+    rangeParamv[PFOR_PARAM_HEADER + 1] = hi;
+    u32 i;
+    for (i = 0; i < paramc; ++i) {
+        rangeParamv[PFOR_PARAM_HEADER + 2 + i] = paramv[i];
+    }
+
+    // The root range EDT is a finish EDT: its output event is satisfied once
+    // every split stub, and therefore every chunk, has executed.
+    ocrGuid_t templateGuid, rootGuid;
+    ocrHint_t hint;
+    u8 returnCode = ocrEdtTemplateCreate(&templateGuid, parallelForRangeEdt, rangeParamc, depc);
+    if (returnCode == 0) {
+        returnCode = ocrEdtCreate(&rootGuid, templateGuid, rangeParamc, rangeParamv, depc, depv,
+                                  EDT_PROP_FINISH, pforHint(&hint), outputEvent);
+        ocrEdtTemplateDestroy(templateGuid);
+    }
+    DPRINTF_COND_LVL(returnCode, DEBUG_LVL_WARN, DEBUG_LVL_INFO,
+                     "EXIT ocrParallelFor -> %"PRIu32"\n", returnCode);
+    RETURN_PROFILE(returnCode);
+}
+
+#endif /* ENABLE_EXTENSION_PARALLEL_FOR */
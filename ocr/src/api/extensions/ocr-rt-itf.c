@@ -65,6 +65,13 @@ u8 ocrCurrentEdtGet(ocrGuid_t *curEdt) {
     if(curEdt == NULL)
         return OCR_EINVAL;
     getCurrentEnv(NULL, NULL, &task, NULL);
+#ifdef ENABLE_EDT_ANON
+    // Anonymous EDTs cannot be referenced, their sentinel GUID is not handed out
+    if ((task != NULL) && (task->flags & OCR_TASK_FLAG_ANON)) {
+        *curEdt = NULL_GUID;
+        return 0;
+    }
+#endif
     *curEdt = (task) ? task->guid : NULL_GUID;
     return 0;
 }
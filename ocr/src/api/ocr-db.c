@@ -21,6 +21,13 @@
 #include "ocr-statistics.h"
 #endif
 
+#ifdef ENABLE_EXTENSION_DB_PARTITION
+#include "extensions/ocr-db-partition.h"
+#endif
+#ifdef ENABLE_EXTENSION_DB_DIRTY_RANGE
+#include "extensions/ocr-db-dirty-range.h"
+#endif
+
 #include "utils/profiler/profiler.h"
 
 #define DEBUG_TYPE API
@@ -311,6 +318,108 @@ u8 ocrDbGetSize(ocrGuid_t db, u64 *size) {
 }
 #endif /* ENABLE_EXTENSION_DB_INFO */
 
+#ifdef ENABLE_EXTENSION_DB_PARTITION
+u8 ocrDbPartition(ocrGuid_t db, u32 partc, u64 *offsets, u64 *sizes, ocrGuid_t *partitions) {
+    START_PROFILE(api_ocrDbPartition);
+
+    DPRINTF(DEBUG_LVL_INFO, "ENTER ocrDbPartition(guid="GUIDF", partc=%"PRIu32")\n", GUIDA(db), partc);
+
+    ocrAssert(!(ocrGuidIsError(db)));
+    ocrAssert(!(ocrGuidIsUninitialized(db)));
+    if (ocrGuidIsNull(db) || (partc == 0) || (offsets == NULL) || (sizes == NULL) || (partitions == NULL)) {
+        RETURN_PROFILE(OCR_EINVAL);
+    }
+
+    ocrPolicyDomain_t *pd = NULL;
+    PD_MSG_STACK(msg);
+    getCurrentEnv(&pd, NULL, NULL, &msg);
+#define PD_MSG (&msg)
+#define PD_TYPE PD_MSG_GUID_INFO
+    msg.type = PD_MSG_GUID_INFO | PD_MSG_REQUEST | PD_MSG_REQ_RESPONSE;
+    PD_MSG_FIELD_IO(guid.guid) = db;
+    PD_MSG_FIELD_IO(guid.metaDataPtr) = NULL;
+    PD_MSG_FIELD_I(properties) = RMETA_GUIDPROP;
+    u8 returnCode = pd->fcts.processMessage(pd, &msg, true);
+    //Warning PD_MSG_GUID_INFO returns GUID properties as 'returnDetail', not error code
+    if(returnCode != 0) {
+        RETURN_PROFILE(returnCode);
+    }
+    ocrDataBlock_t *myDb = PD_MSG_FIELD_IO(guid.metaDataPtr);
+#undef PD_TYPE
+#undef PD_MSG
+
+    if (!myDb) {
+        // Did not find meta data for the given data block guid
+        RETURN_PROFILE(OCR_EINVAL);
+    }
+
+    ocrDataBlockFactory_t * factory = (ocrDataBlockFactory_t *) pd->factories[myDb->fctId];
+    if (factory->fcts.partition == NULL) {
+        returnCode = OCR_ENOTSUP;
+    } else {
+        returnCode = factory->fcts.partition(myDb, partc, offsets, sizes, partitions);
+    }
+
+    DPRINTF_COND_LVL(returnCode, DEBUG_LVL_WARN, DEBUG_LVL_INFO,
+                     "EXIT ocrDbPartition(guid="GUIDF", partc=%"PRIu32") -> %"PRIu32"\n",
+                     GUIDA(db), partc, returnCode);
+
+    RETURN_PROFILE(returnCode);
+}
+#endif /* ENABLE_EXTENSION_DB_PARTITION */
+
+#ifdef ENABLE_EXTENSION_DB_DIRTY_RANGE
+u8 ocrDbMarkDirty(ocrGuid_t db, u64 offset, u64 size) {
+    START_PROFILE(api_ocrDbMarkDirty);
+
+    DPRINTF(DEBUG_LVL_INFO, "ENTER ocrDbMarkDirty(guid="GUIDF", offset=%"PRIu64", size=%"PRIu64")\n",
+            GUIDA(db), offset, size);
+
+    ocrAssert(!(ocrGuidIsError(db)));
+    ocrAssert(!(ocrGuidIsUninitialized(db)));
+    if (ocrGuidIsNull(db)) {
+        RETURN_PROFILE(OCR_EINVAL);
+    }
+
+    ocrPolicyDomain_t *pd = NULL;
+    PD_MSG_STACK(msg);
+    getCurrentEnv(&pd, NULL, NULL, &msg);
+#define PD_MSG (&msg)
+#define PD_TYPE PD_MSG_GUID_INFO
+    msg.type = PD_MSG_GUID_INFO | PD_MSG_REQUEST | PD_MSG_REQ_RESPONSE;
+    PD_MSG_FIELD_IO(guid.guid) = db;
+    PD_MSG_FIELD_IO(guid.metaDataPtr) = NULL;
+    PD_MSG_FIELD_I(properties) = RMETA_GUIDPROP;
+    u8 returnCode = pd->fcts.processMessage(pd, &msg, true);
+    //Warning PD_MSG_GUID_INFO returns GUID properties as 'returnDetail', not error code
+    if(returnCode != 0) {
+        RETURN_PROFILE(returnCode);
+    }
+    ocrDataBlock_t *myDb = PD_MSG_FIELD_IO(guid.metaDataPtr);
+#undef PD_TYPE
+#undef PD_MSG
+
+    if (!myDb) {
+        // Did not find meta data for the given data block guid
+        RETURN_PROFILE(OCR_EINVAL);
+    }
+
+    // Dirty ranges are only hints, implementations may ignore them
+    ocrDataBlockFactory_t * factory = (ocrDataBlockFactory_t *) pd->factories[myDb->fctId];
+    if (factory->fcts.markDirty != NULL) {
+        returnCode = factory->fcts.markDirty(myDb, offset, size);
+    } else if ((offset > myDb->size) || (size > (myDb->size - offset))) {
+        returnCode = OCR_EINVAL;
+    }
+
+    DPRINTF_COND_LVL(returnCode, DEBUG_LVL_WARN, DEBUG_LVL_INFO,
+                     "EXIT ocrDbMarkDirty(guid="GUIDF", offset=%"PRIu64", size=%"PRIu64") -> %"PRIu32"\n",
+                     GUIDA(db), offset, size, returnCode);
+
+    RETURN_PROFILE(returnCode);
+}
+#endif /* ENABLE_EXTENSION_DB_DIRTY_RANGE */
+
 u8 ocrDbMalloc(ocrGuid_t guid, u64 size, void** addr) {
     return OCR_EINVAL; /* not yet implemented */
 }
@@ -315,6 +315,19 @@ u8 ocrEdtCreate(ocrGuid_t* edtGuidPtr, ocrGuid_t templateGuid,
         RETURN_PROFILE(OCR_EINVAL);
     }
 
+#ifdef ENABLE_EDT_ANON
+    if(properties & EDT_PROP_ANON) {
+        if(properties & GUID_PROP_IS_LABELED) {
+            DPRINTF(DEBUG_LVL_WARN, "Ignoring EDT_PROP_ANON for ocrEdtCreate since GUID is labeled\n");
+            properties &= ~EDT_PROP_ANON;
+        } else if(edtGuidPtr != NULL) {
+            // Anonymous EDTs cannot be referenced, never hand out a GUID
+            *edtGuidPtr = NULL_GUID;
+            edtGuidPtr = NULL;
+        }
+    }
+#endif
+
     bool reqResponse = false;
     if((properties & GUID_PROP_IS_LABELED)) {
         if(depv != NULL) {
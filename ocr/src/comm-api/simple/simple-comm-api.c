@@ -56,10 +56,152 @@ u8 simpleCommApiInitHandle(ocrCommApi_t *self, ocrMsgHandle_t *handle) {
     return OCR_ENOTSUP;
 }
 
+/**
+ * @brief Hands a persistent message to the comm-platform and
+ * associates the communication with the handle, if any.
+ */
+static u8 postMessage(ocrCommApi_t *self, ocrLocation_t target, ocrPolicyMsg_t *message,
+                      ocrMsgHandle_t **handle, u32 properties) {
+    ocrCommApiSimple_t * commApiSimple = (ocrCommApiSimple_t *) self;
+    // This is weird but otherwise the compiler complains...
+    u64 id = 0;
+
+    u8 ret = self->commPlatform->fcts.sendMessage(self->commPlatform, target, message,
+                                                  &id, properties, SIMPLE_COMM_NO_MASK);
+    if (ret == 0) {
+        if (handle != NULL) {
+            if (*handle == NULL) {
+                // Handle creation requested
+                *handle = createMsgHandler(self, message);
+            }
+            //Message sent (potentially not yet received at destination)
+            (*handle)->status = HDL_SEND_OK;
+            // Associate id with handle
+            hashtableNonConcPut(commApiSimple->handleMap, (void *) id, *handle);
+        } // else: No handle requested
+    } else {
+        // Error occurred while sending, set handler status if any
+        if ((handle != NULL) && (*handle != NULL)) {
+            (*handle)->status = HDL_SEND_ERR;
+        }
+        // Assert for now since we don't really handle errors in upper-layers
+        ocrAssert(ret == 0);
+    }
+    return ret;
+}
+
+#ifdef ENABLE_COMM_API_FLOW_CONTROL
+
+typedef struct _simpleCommPending_t {
+    ocrPolicyMsg_t * msg;
+    ocrMsgHandle_t * handle;    // Handle to associate with the communication, if any
+    u32 properties;
+    struct _simpleCommPending_t * next;
+} simpleCommPending_t;
+
+/**
+ * @brief Returns true if sending 'msg' takes a credit
+ *
+ * Responses are paced by the requests. Runlevel notifications
+ * must go out for the PDs to shut down.
+ */
+static bool needsCredit(ocrPolicyMsg_t * msg) {
+    u32 type = msg->type & PD_MSG_TYPE_ONLY;
+    return (msg->type & PD_MSG_REQUEST) && (type != PD_MSG_MGT_RL_NOTIFY) && (type != PD_MSG_MGT_FLOW_CREDIT);
+}
+
+/**
+ * @brief Posts the messages waiting for 'target' as long as there are credits
+ */
+static void sendPending(ocrCommApiSimple_t * commApiSimple, ocrLocation_t target) {
+    ocrPolicyDomain_t * pd = commApiSimple->base.pd;
+    u64 idx = (u64) target;
+    while ((commApiSimple->pendingHead[idx] != NULL) && (commApiSimple->sendCredits[idx] != 0)) {
+        simpleCommPending_t * pending = commApiSimple->pendingHead[idx];
+        commApiSimple->sendCredits[idx]--;
+        commApiSimple->pendingHead[idx] = pending->next;
+        if (pending->next == NULL) {
+            commApiSimple->pendingTail[idx] = NULL;
+        }
+        commApiSimple->pendingCount--;
+        postMessage((ocrCommApi_t *) commApiSimple, target, pending->msg,
+                    (pending->handle != NULL) ? &pending->handle : NULL, pending->properties);
+        pd->fcts.pdFree(pd, pending);
+    }
+}
+
+/**
+ * @brief Gives 'credits' back to 'source' once enough of them are owed
+ *
+ * Credits go back in batches of half the window
+ */
+static void returnCredits(ocrCommApiSimple_t * commApiSimple, ocrLocation_t source, u32 credits) {
+    u64 idx = (u64) source;
+    ocrAssert(idx < commApiSimple->locationCount);
+    commApiSimple->owedCredits[idx] += credits;
+    if (commApiSimple->owedCredits[idx] >= ((commApiSimple->credits + 1) / 2)) {
+        ocrPolicyMsg_t * creditMsg = allocateNewMessage((ocrCommApi_t *) commApiSimple, sizeof(ocrPolicyMsg_t));
+        getCurrentEnv(NULL, NULL, NULL, creditMsg);
+        creditMsg->destLocation = source;
+#define PD_MSG (creditMsg)
+#define PD_TYPE PD_MSG_MGT_FLOW_CREDIT
+        creditMsg->type = PD_MSG_MGT_FLOW_CREDIT | PD_MSG_REQUEST;
+        PD_MSG_FIELD_I(credits) = commApiSimple->owedCredits[idx];
+#undef PD_MSG
+#undef PD_TYPE
+        commApiSimple->owedCredits[idx] = 0;
+        commApiSimple->creditMsgCount++;
+        // One-way messages are heap-allocated copies owned by the comm-platform
+        postMessage((ocrCommApi_t *) commApiSimple, source, creditMsg, NULL, PERSIST_MSG_PROP);
+    }
+}
+
+/**
+ * @brief Accounts for a credit message received from another PD
+ *
+ * Returns true if the message was a credit message, which is consumed here.
+ */
+static bool receiveCredits(ocrCommApiSimple_t * commApiSimple, ocrPolicyMsg_t * msg) {
+    ocrPolicyDomain_t * pd = commApiSimple->base.pd;
+    ocrLocation_t src = msg->srcLocation;
+    u64 idx = (u64) src;
+    ocrAssert(idx < commApiSimple->locationCount);
+    if ((msg->type & PD_MSG_TYPE_ONLY) == PD_MSG_MGT_FLOW_CREDIT) {
+#define PD_MSG (msg)
+#define PD_TYPE PD_MSG_MGT_FLOW_CREDIT
+        commApiSimple->sendCredits[idx] += PD_MSG_FIELD_I(credits);
+#undef PD_MSG
+#undef PD_TYPE
+        ocrAssert(commApiSimple->sendCredits[idx] <= commApiSimple->credits);
+        pd->fcts.pdFree(pd, msg);
+        sendPending(commApiSimple, src);
+        return true;
+    }
+    return false;
+}
+#endif
+
 u8 sendMessageSimpleCommApi(ocrCommApi_t *self, ocrLocation_t target, ocrPolicyMsg_t *message,
                         ocrMsgHandle_t **handle, u32 properties) {
     START_PROFILE(commapi_sendMessageSimpleCommApi);
-    ocrCommApiSimple_t * commApiSimple = (ocrCommApiSimple_t *) self;
+    ocrCommApiSimple_t * commApiSimple __attribute__((unused)) = (ocrCommApiSimple_t *) self;
+
+#ifdef ENABLE_COMM_API_FLOW_CONTROL
+    // Credits of the requests the PD started processing, see returnFlowCredit
+    if ((message->type & PD_MSG_TYPE_ONLY) == PD_MSG_MGT_FLOW_CREDIT) {
+        if (commApiSimple->credits != 0) {
+#define PD_MSG (message)
+#define PD_TYPE PD_MSG_MGT_FLOW_CREDIT
+            returnCredits(commApiSimple, target, PD_MSG_FIELD_I(credits));
+#undef PD_MSG
+#undef PD_TYPE
+        }
+        if (properties & PERSIST_MSG_PROP) {
+            self->pd->fcts.pdFree(self->pd, message);
+        }
+        RETURN_PROFILE(0);
+    }
+#endif
 
     // Debug and check if we should push this in the in/out patch or runlevel
     if (!(properties & PERSIST_MSG_PROP)) {
@@ -79,30 +221,41 @@ u8 sendMessageSimpleCommApi(ocrCommApi_t *self, ocrLocation_t target, ocrPolicyM
 
     }
 
-    // This is weird but otherwise the compiler complains...
-    u64 id = 0;
-
-    u8 ret = self->commPlatform->fcts.sendMessage(self->commPlatform, target, message,
-                                                  &id, properties, SIMPLE_COMM_NO_MASK);
-    if (ret == 0) {
-        if (handle != NULL) {
-            if (*handle == NULL) {
-                // Handle creation requested
+#ifdef ENABLE_COMM_API_FLOW_CONTROL
+    if ((commApiSimple->credits != 0) && needsCredit(message)) {
+        u64 idx = (u64) target;
+        ocrAssert(idx < commApiSimple->locationCount);
+        // Requests to a peer go out in order: wait behind the ones already waiting.
+        // Other messages do not wait, the peer may need a response to give
+        // credits back.
+        if ((commApiSimple->pendingHead[idx] != NULL) || (commApiSimple->sendCredits[idx] == 0)) {
+            ocrPolicyDomain_t * pd = self->pd;
+            simpleCommPending_t * pending = pd->fcts.pdMalloc(pd, sizeof(simpleCommPending_t));
+            if ((handle != NULL) && (*handle == NULL)) {
                 *handle = createMsgHandler(self, message);
             }
-            //Message sent (potentially not yet received at destination)
-            (*handle)->status = HDL_SEND_OK;
-            // Associate id with handle
-            hashtableNonConcPut(commApiSimple->handleMap, (void *) id, *handle);
-        } // else: No handle requested
-    } else {
-        // Error occurred while sending, set handler status if any
-        if ((handle != NULL) && (*handle != NULL)) {
-            (*handle)->status = HDL_SEND_ERR;
+            pending->msg = message;
+            pending->handle = (handle != NULL) ? *handle : NULL;
+            pending->properties = properties;
+            pending->next = NULL;
+            if (commApiSimple->pendingTail[idx] == NULL) {
+                commApiSimple->pendingHead[idx] = pending;
+            } else {
+                commApiSimple->pendingTail[idx]->next = pending;
+            }
+            commApiSimple->pendingTail[idx] = pending;
+            commApiSimple->pendingCount++;
+            commApiSimple->stallCount++;
+            if (handle != NULL) {
+                (*handle)->status = HDL_SEND_OK;
+            }
+            RETURN_PROFILE(0);
         }
-        // Assert for now since we don't really handle errors in upper-layers
-        ocrAssert(ret == 0);
+        commApiSimple->sendCredits[idx]--;
     }
+#endif
+
+    u8 ret = postMessage(self, target, message, handle, properties);
     RETURN_PROFILE(ret);
 }
 
@@ -126,6 +279,19 @@ u8 pollMessageSimpleCommApi(ocrCommApi_t *self, ocrMsgHandle_t **handle) {
     //IMPL: by contract commPlatform only poll and return recvs.
     //They can be incoming request or response. (but not outgoing req/resp ack)
     u8 ret = self->commPlatform->fcts.pollMessage(self->commPlatform, &msg, SIMPLE_COMM_NO_PROP, SIMPLE_COMM_NO_MASK);
+#ifdef ENABLE_COMM_API_FLOW_CONTROL
+    if (commApiSimple->credits != 0) {
+        // Credit messages are not handed out
+        while ((ret == POLL_MORE_MESSAGE) && receiveCredits(commApiSimple, msg)) {
+            msg = NULL;
+            ret = self->commPlatform->fcts.pollMessage(self->commPlatform, &msg, SIMPLE_COMM_NO_PROP, SIMPLE_COMM_NO_MASK);
+        }
+        // Messages waiting for credits are outgoing too
+        if ((commApiSimple->pendingCount != 0) && ((ret & POLL_NO_OUTGOING_MESSAGE) == POLL_NO_OUTGOING_MESSAGE)) {
+            ret = (ret & ~POLL_NO_OUTGOING_MESSAGE) | POLL_NO_MESSAGE;
+        }
+    }
+#endif
     if (ret == POLL_MORE_MESSAGE) {
         ocrAssert((handle != NULL) && (*handle == NULL));
         if (msg->type & PD_MSG_REQUEST) {
@@ -211,11 +377,48 @@ u8 simpleCommApiSwitchRunlevel(ocrCommApi_t *self, ocrPolicyDomain_t *PD, ocrRun
             ocrCommApiSimple_t * commApiSimple = (ocrCommApiSimple_t *) self;
             commApiSimple->handleMap = newHashtableModulo(self->pd, HANDLE_MAP_BUCKETS);
         }
+#ifdef ENABLE_COMM_API_FLOW_CONTROL
+        // The comm-platform knows the PD's neighbors once it is past RL_GUID_OK
+        if ((properties & RL_BRING_UP) && RL_IS_LAST_PHASE_UP(PD, RL_GUID_OK, phase)) {
+            ocrCommApiSimple_t * commApiSimple = (ocrCommApiSimple_t *) self;
+            if (commApiSimple->credits != 0) {
+                u32 count = PD->neighborCount + 1;
+                u32 i;
+                u64 arraySize = count * sizeof(u32);
+                u64 listSize = count * sizeof(simpleCommPending_t *);
+                u8 * arrays = PD->fcts.pdMalloc(PD, (2 * arraySize) + (2 * listSize));
+                commApiSimple->locationCount = count;
+                commApiSimple->sendCredits = (u32 *) arrays;
+                commApiSimple->owedCredits = (u32 *) (arrays + arraySize);
+                commApiSimple->pendingHead = (simpleCommPending_t **) (arrays + (2 * arraySize));
+                commApiSimple->pendingTail = (simpleCommPending_t **) (arrays + (2 * arraySize) + listSize);
+                for (i = 0; i < count; i++) {
+                    commApiSimple->sendCredits[i] = commApiSimple->credits;
+                    commApiSimple->owedCredits[i] = 0;
+                    commApiSimple->pendingHead[i] = NULL;
+                    commApiSimple->pendingTail[i] = NULL;
+                }
+            }
+        }
+#endif
         if ((properties & RL_TEAR_DOWN) && RL_IS_LAST_PHASE_DOWN(PD, RL_GUID_OK, phase)) {
             //BUG #527: memory reclaim: would like to make sure this is empty, otherwise it probably
             //means there are pending communication so we shouldn't be in tear down.
             ocrCommApiSimple_t * commApiSimple = (ocrCommApiSimple_t *) self;
             destructHashtable(commApiSimple->handleMap, NULL, NULL);
+#ifdef ENABLE_COMM_API_FLOW_CONTROL
+            if (commApiSimple->sendCredits != NULL) {
+                ocrAssert(commApiSimple->pendingCount == 0);
+                DPRINTF(DEBUG_LVL_INFO, "comm-api: %"PRIu64" messages waited for credits, %"PRIu64" credit messages sent\n",
+                        commApiSimple->stallCount, commApiSimple->creditMsgCount);
+                // A single allocation backs all the per-location arrays
+                PD->fcts.pdFree(PD, commApiSimple->sendCredits);
+                commApiSimple->sendCredits = NULL;
+                commApiSimple->owedCredits = NULL;
+                commApiSimple->pendingHead = NULL;
+                commApiSimple->pendingTail = NULL;
+            }
+#endif
         }
         break;
     case RL_COMPUTE_OK:
@@ -249,6 +452,17 @@ void initializeCommApiSimple(ocrCommApiFactory_t * factory, ocrCommApi_t* self,
     initializeCommApiOcr(factory, self, perInstance);
     ocrCommApiSimple_t * commApiSimple = (ocrCommApiSimple_t*) self;
     commApiSimple->handleMap = NULL;
+#ifdef ENABLE_COMM_API_FLOW_CONTROL
+    commApiSimple->credits = ((ocrCommApiFactorySimple_t *) factory)->credits;
+    commApiSimple->locationCount = 0;
+    commApiSimple->sendCredits = NULL;
+    commApiSimple->owedCredits = NULL;
+    commApiSimple->pendingHead = NULL;
+    commApiSimple->pendingTail = NULL;
+    commApiSimple->pendingCount = 0;
+    commApiSimple->stallCount = 0;
+    commApiSimple->creditMsgCount = 0;
+#endif
 }
 
 /******************************************************/
@@ -266,6 +480,10 @@ ocrCommApiFactory_t *newCommApiFactorySimple(ocrParamList_t *perType) {
     base->instantiate = newCommApiSimple;
     base->initialize = initializeCommApiSimple;
     base->destruct = destructCommApiFactorySimple;
+#ifdef ENABLE_COMM_API_FLOW_CONTROL
+    ((ocrCommApiFactorySimple_t *) base)->credits = (perType != NULL) ?
+        ((paramListCommApiFactSimple_t *) perType)->credits : COMM_API_CREDITS;
+#endif
 
     base->apiFcts.destruct = FUNC_ADDR(void (*)(ocrCommApi_t*), simpleCommApiDestruct);
     base->apiFcts.switchRunlevel = FUNC_ADDR(u8 (*)(ocrCommApi_t*, ocrPolicyDomain_t*, ocrRunlevel_t,
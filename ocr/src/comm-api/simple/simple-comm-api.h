@@ -4,6 +4,17 @@
  * Restrictions:
  *   - cannot poll on a specific handle
  *   - can only wait on the handle of the last sendMessage
+ *
+ * With ENABLE_COMM_API_FLOW_CONTROL, requests between policy domains are
+ * subject to a credit-based flow control: a PD holds a number of credits
+ * for each peer and spends one per request it sends. Once out of credits,
+ * requests to that peer wait in order in the comm-api. The peer gives
+ * credits back in PD_MSG_MGT_FLOW_CREDIT messages once its policy domain
+ * starts processing the requests, so that they also bound the requests the
+ * peer's PD has queued. The PD notes each request it starts processing to
+ * the comm-api with a local PD_MSG_MGT_FLOW_CREDIT message, see
+ * returnFlowCredit. Credits do not wait for the processing to complete as
+ * it may block on the requesting peer.
  **/
 
 /*
@@ -23,16 +34,49 @@
 #include "utils/ocr-utils.h"
 #include "utils/hashtable.h"
 
+#ifdef ENABLE_COMM_API_FLOW_CONTROL
+// Requests a PD may send to a peer before getting credits back, which bounds
+// what the peer buffers and queues for it. Set through the 'credits' key of the comm-api
+// type section, 0 disables the flow control.
+#ifndef COMM_API_CREDITS
+#define COMM_API_CREDITS 512
+#endif
+
+struct _simpleCommPending_t;
+#endif
+
 typedef struct {
     ocrCommApiFactory_t base;
+#ifdef ENABLE_COMM_API_FLOW_CONTROL
+    u32 credits;
+#endif
 } ocrCommApiFactorySimple_t;
 
 typedef struct {
     ocrCommApi_t base;
     // Maps message 'ids' to handles
     hashtable_t * handleMap;
+#ifdef ENABLE_COMM_API_FLOW_CONTROL
+    u32 credits;                                // Credits each peer starts with
+    u32 locationCount;
+    u32 * sendCredits;                          // Per destination, requests that may be sent
+    u32 * owedCredits;                          // Per source, requests started and not credited back
+    struct _simpleCommPending_t ** pendingHead; // Per destination, messages waiting for credits
+    struct _simpleCommPending_t ** pendingTail;
+    u32 pendingCount;
+    // Statistics, reported at tear-down
+    u64 stallCount;      // Number of messages that waited for credits
+    u64 creditMsgCount;  // Number of PD_MSG_MGT_FLOW_CREDIT messages sent
+#endif
 } ocrCommApiSimple_t;
 
+typedef struct {
+    paramListCommApiFact_t base;
+#ifdef ENABLE_COMM_API_FLOW_CONTROL
+    u32 credits;
+#endif
+} paramListCommApiFactSimple_t;
+
 typedef struct {
     paramListCommApiInst_t base;
 } paramListCommApiSimple_t;
@@ -33,6 +33,9 @@ const char * commplatform_types[] = {
 #endif
 #ifdef ENABLE_COMM_PLATFORM_GASNET
     "GASNet",
+#endif
+#ifdef ENABLE_COMM_PLATFORM_SHM
+    "Shm",
 #endif
     NULL
 };
@@ -72,6 +75,10 @@ ocrCommPlatformFactory_t *newCommPlatformFactory(commPlatformType_t type, ocrPar
 #ifdef ENABLE_COMM_PLATFORM_GASNET
     case commPlatformGasnet_id:
         return newCommPlatformFactoryGasnet(typeArg);
+#endif
+#ifdef ENABLE_COMM_PLATFORM_SHM
+    case commPlatformShm_id:
+        return newCommPlatformFactoryShm(typeArg);
 #endif
     default:
         ocrAssert(0);
@@ -41,7 +41,13 @@ void gasnetAMMessageLong(gasnet_token_t token, void *buf, size_t nbytes,
                          gasnet_handlerarg_t arg, gasnet_handlerarg_t addr_hi, gasnet_handlerarg_t addr_lo,
                          u32 segment_size);
 
+void gasnetAMMessagePut(gasnet_token_t token, gasnet_handlerarg_t buf_hi, gasnet_handlerarg_t buf_lo,
+                        gasnet_handlerarg_t nbytes, gasnet_handlerarg_t arg,
+                        gasnet_handlerarg_t addr_hi, gasnet_handlerarg_t addr_lo,
+                        u32 segment_size);
+
 AMHANDLER_REGISTER(gasnetAMMessageLong);
+AMHANDLER_REGISTER(gasnetAMMessagePut);
 
 // --------------------------------------------------------------------------------------
 // function implementation
@@ -55,6 +61,7 @@ void registerMessage(FctMessageIncoming incomingMessage) {
 void registerGasnetHandler() {
 #define AMHANDLER_ENTRY(handler)  AMH_REGISTER_FCN(handler)();
     AMHANDLER_ENTRY(gasnetAMMessageLong);
+    AMHANDLER_ENTRY(gasnetAMMessagePut);
 #undef AMHANDLER_ENTRY
     gasnetSplitInit();
 }
@@ -72,6 +79,42 @@ void gasnetAMMessageLong(gasnet_token_t token, void *buf, size_t nbytes, gasnet_
     fctIncomingMessage(platform, (ocrPolicyMsg_t *)buf, nbytes, addr_hi, addr_lo, segment_size);
 }
 
+/**
+ * @brief Function to be invoked once a message has been put in our segment
+ *
+ * The payload is already in place when the handler runs since the sender
+ * only notifies us after its blocking put completed.
+ */
+void gasnetAMMessagePut(gasnet_token_t token, gasnet_handlerarg_t buf_hi, gasnet_handlerarg_t buf_lo,
+                        gasnet_handlerarg_t nbytes, gasnet_handlerarg_t arg,
+                        gasnet_handlerarg_t addr_hi, gasnet_handlerarg_t addr_lo,
+                        u32 segment_size) {
+    ocrCommPlatformGasnet_t *platform = getCommPlatform();
+    void *buf = (void*) getBits64(buf_hi, buf_lo);
+    fctIncomingMessage(platform, (ocrPolicyMsg_t *)buf, (u32) nbytes, addr_hi, addr_lo, segment_size);
+}
+
+/*
+ * @brief one-sided transfer of a message into a remote segment block
+ *
+ * Unlike a long AM, a put is not bounded by gasnet_AMMaxLongRequest(),
+ * only by the size of the block the target node registered for us.
+ * The put is blocking so the short AM notifying the target is only
+ * issued once the whole payload landed in its segment.
+ */
+static void gasnetPutMessage(int targetRank, ocrPolicyMsg_t * message,
+                             u64 bufferSize, u64 gasnetId, gasnetCommBlock_t *block,
+                             gasnet_handlerarg_t addr_hi, gasnet_handlerarg_t addr_lo,
+                             u32 segment_size) {
+    ocrAssert(block->size >= bufferSize);
+    gasnet_put_bulk(targetRank, block->addr, message, bufferSize);
+    gasnet_handlerarg_t buf_hi = (gasnet_handlerarg_t) BITS64_HIGH(block->addr);
+    gasnet_handlerarg_t buf_lo = (gasnet_handlerarg_t) BITS64_LOW(block->addr);
+    GASNET_Safe(gasnet_AMRequestShort7(targetRank, AMHANDLER(gasnetAMMessagePut), buf_hi, buf_lo,
+                                       (gasnet_handlerarg_t) bufferSize, gasnetId,
+                                       addr_hi, addr_lo, segment_size));
+}
+
 /*
  * @brief sending long message
  *
@@ -106,11 +149,29 @@ void gasnetSendLongMessage(int targetRank, ocrPolicyMsg_t * message,
     }
 }
 
+/*
+ * @brief sending a message too big for a long AM
+ *
+ * we have 3 cases:
+ *  (1) the target buffer is big enough, put the message directly in it
+ *  (2) the target buffer is too small, we need to split the message
+ *  (3) no target buffer, use am medium to send message
+ */
 void gasnetSendHugeMessage(int targetRank, ocrPolicyMsg_t * message,
                            u64 bufferSize, u64 gasnetId, gasnetCommBlock_t *block,
                            gasnet_handlerarg_t addr_hi, gasnet_handlerarg_t addr_lo,
                            u32 segment_size) {
-    gasnetSplitToLong(targetRank, message, bufferSize, gasnetId, block, addr_hi, addr_lo, segment_size);
+    if (block != NULL) {
+        if (block->size >= bufferSize) {
+            gasnetPutMessage(targetRank, message, bufferSize, gasnetId, block,
+                             addr_hi, addr_lo, segment_size);
+        } else {
+            gasnetSplitToLong(targetRank, message, bufferSize, gasnetId, block,
+                              addr_hi, addr_lo, segment_size);
+        }
+    } else {
+        gasnetSplitToMedium(targetRank, message, bufferSize, gasnetId, block, addr_hi, addr_lo, segment_size);
+    }
 }
 
 #endif /* COMM_PLATFORM_GASNET_AMLONG */
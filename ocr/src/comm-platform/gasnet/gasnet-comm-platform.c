@@ -83,14 +83,6 @@ static void gasnetMessageIncoming(ocrCommPlatformGasnet_t *platform , ocrPolicyM
 
     // Warning ! Do NOT touch msgCopy from now on
 
-    // the message is to acquire a datablock. If we do receive a datablock (a response)
-    // then we need to free the reserved share segment block
-    if (IS_MSG_TYPE(msg, PD_MSG_DB_ACQUIRE)) {
-        if (IS_MSG_TYPE(msg, PD_MSG_RESPONSE)) {
-            // free this segment block for other usages
-            gasnetReleaseSegmentBlock((void*)msg);
-        }
-    }
     void *addr = (void*) getBits64(seg_addr_hi, seg_addr_lo);
 
     // if the remote process provides an address to its share segment, we need to
@@ -104,6 +96,12 @@ static void gasnetMessageIncoming(ocrCommPlatformGasnet_t *platform , ocrPolicyM
         gasnetSegmentBlockPush(pd, src, block);
         DPRINTF(DEBUG_LVL_VVERB, "[GASNET] pushing %p from 0x%"PRIx32" ( 0x%"PRIx32" | 0x%"PRIx32") \n", addr, src, (u32)seg_addr_hi, (u32)seg_addr_lo);
     }
+
+    // If the message was written in one of our share segment blocks (long AM or
+    // one-sided put), free this segment block for other usages. This covers both
+    // the datablock of an acquire response and the write-back of a release.
+    // Messages received through a medium AM are not in a block and are ignored.
+    gasnetReleaseSegmentBlock((void*)msg);
 }
 
 // ---------------------------------
@@ -165,7 +163,7 @@ void platformInitGasnetComm(int * argc, char *** argv) {
     count = amhandler_count();
 
     maxLocalSegSize = gasnet_getMaxLocalSegmentSize();
-    int segSize = GASNET_PAGESIZE * 64;
+    int segSize = GASNET_PAGESIZE * GASNET_SEGMENT_PAGES;
     segSize = (maxLocalSegSize<segSize ? maxLocalSegSize : segSize);
     int minheap = MINHEAPOFFSET;
 
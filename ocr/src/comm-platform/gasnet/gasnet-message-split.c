@@ -105,6 +105,8 @@ static void gasnetAMMessageLongHelper(gasnet_token_t token, void *buf, size_t nb
                            (gasnet_handlerarg_t) addr_hi, (gasnet_handlerarg_t) addr_lo,
                            (gasnet_handlerarg_t) segment_size);
         gasnet_message_pop( platform->base.pd, messageID );
+        // the message has been reassembled out of our segment block
+        gasnetReleaseSegmentBlock(buf);
     }
     // notify to sender that we are ready to receive another package
     gasnet_AMReplyShort2(token, AMHANDLER(gasnetAMMessageLongReply), reply_hi, reply_lo);
@@ -199,14 +201,18 @@ void gasnetSplitToLong(int targetRank, ocrPolicyMsg_t * message,
     gasnet_handlerarg_t reply_hi = (gasnet_handlerarg_t) BITS64_HIGH(&partner_reply);
     gasnet_handlerarg_t reply_lo = (gasnet_handlerarg_t) BITS64_LOW (&partner_reply);
 
+    // the block may be larger than what a single long AM can carry
+    const u64 max_long_size = gasnet_AMMaxLongRequest();
+    const u64 stage_size = (block->size < max_long_size ? block->size : max_long_size);
+
     int i, position=0, size, tot_size_so_far=0;
-    const unsigned int num_stages = (bufferSize / block->size) + ( bufferSize % block->size == 0? 0: 1);
+    const unsigned int num_stages = (bufferSize / stage_size) + ( bufferSize % stage_size == 0? 0: 1);
     ocrAssert(num_stages > 1);
 
     for (i=0; i<num_stages; i++) {
         partner_reply = MESSAGE_WAIT;
 
-        size = ( i+1 < num_stages? block->size: bufferSize - tot_size_so_far);
+        size = ( i+1 < num_stages? stage_size: bufferSize - tot_size_so_far);
 
         // sending to the target rank the i-th portion of the message, and wait the reply
         // from the target node.
@@ -219,7 +225,7 @@ void gasnetSplitToLong(int targetRank, ocrPolicyMsg_t * message,
                               (gasnet_handlerarg_t) reply_hi, (gasnet_handlerarg_t) reply_lo);
         GASNET_BLOCKUNTIL(partner_reply != '0');
         // prepating for the next package
-        position += block->size;
+        position += stage_size;
         tot_size_so_far += size;
     }
 }
@@ -77,11 +77,15 @@ gasnetCommBlockSender_t* gasnetReserveSegmentBlock() {
 
 /*
  * @brief release a segment block
+ *
+ * The address may be anywhere within the block, which lets the receiver
+ * of a long AM or a one-sided put release the block holding the message.
  */
 void gasnetReleaseSegmentBlock(void *addr) {
     int i;
     for (i=0; i<GASNET_MAX_SEGMENT_BLOCK; i++) {
-        if (segmentBlock[i].block.addr == addr) {
+        if (((char*)addr >= (char*)segmentBlock[i].block.addr) &&
+            ((char*)addr < ((char*)segmentBlock[i].block.addr + segmentBlock[i].block.size))) {
             segmentBlock[i].reserved = 0;
             DPRINTF(DEBUG_LVL_VVERB,"[GASNET] gasnetReleaseSegmentBlock %p  size: %"PRId32" bytes\n",
                                     addr, segmentBlock[i].block.size);
@@ -93,18 +97,29 @@ void gasnetReleaseSegmentBlock(void *addr) {
 
 // ------------------------------------------------------------------
 // Splay tree declaration for storing segment block
+//
+// The registry is keyed by (provider, address) so that a node can hold
+// several blocks advertised by the same remote node, for instance when
+// multiple datablock acquires are in flight towards the same owner.
 // ------------------------------------------------------------------
 
 typedef struct SegmentBlock_s
 {
   SPLAY_ENTRY(SegmentBlock_s) link;
   gasnetCommBlock_t *block;   // the block of the segment
+  void *addr;       // remote address of the block, second part of the key
   u32  provider;    // the original node of the shared segment
 } SegmentBlock_t;
 
 
 static int block_compare(SegmentBlock_t *b1, SegmentBlock_t *b2) {
-  return b1->provider - b2->provider;
+  if (b1->provider != b2->provider) {
+    return (b1->provider < b2->provider) ? -1 : 1;
+  }
+  if (b1->addr != b2->addr) {
+    return ((char*)b1->addr < (char*)b2->addr) ? -1 : 1;
+  }
+  return 0;
 }
 
 /*
@@ -130,18 +145,35 @@ void gasnetSegmentBlockPush(ocrPolicyDomain_t * pd, u32 node, gasnetCommBlock_t
     SegmentBlock_t *item = (SegmentBlock_t *) pd->fcts.pdMalloc(pd, sizeof(SegmentBlock_t));
     ocrAssert(item != NULL);
     item->provider = node;
+    item->addr = block->addr;
     item->block = block;
-    SPLAY_INSERT(SegmentBlockHead_s, &rootBlock, item);
+    // A block is only advertised again once the remote node released it,
+    // which happens after we consumed our entry for it
+    SegmentBlock_t *existing = SPLAY_INSERT(SegmentBlockHead_s, &rootBlock, item);
+    ocrAssert(existing == NULL);
 }
 
 /*
- * @brief release a segment block
+ * @brief retrieve and remove a segment block of a remote node
+ *
+ * Looks up the smallest key (node, addr) of the registry. Since NULL is
+ * never a block address, the lookup misses and the splay leaves either the
+ * predecessor or the successor of the key at the root of the tree.
  *
  * The caller is responsible to free the returned variable
  */
 gasnetCommBlock_t* gasnetSegmentBlockGet(ocrPolicyDomain_t * pd, u32 node) {
-    SegmentBlock_t tmp = {.block = NULL, .provider = node};
+    SegmentBlock_t tmp = {.block = NULL, .addr = NULL, .provider = node};
     SegmentBlock_t *item = SPLAY_FIND(SegmentBlockHead_s, &rootBlock, &tmp);
+    if (item == NULL) {
+        item = SPLAY_ROOT(&rootBlock);
+        if ((item != NULL) && (block_compare(&tmp, item) > 0)) {
+            item = SPLAY_NEXT(SegmentBlockHead_s, &rootBlock, item);
+        }
+        if ((item != NULL) && (item->provider != node)) {
+            item = NULL;
+        }
+    }
     gasnetCommBlock_t *block = NULL;
     if (item != NULL) {
         block = item->block;
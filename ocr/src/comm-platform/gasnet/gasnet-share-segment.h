@@ -13,6 +13,13 @@
 // sender is required to send multiple split messages
 #define GASNET_MAX_SEGMENT_BLOCK 4
 
+// number of pages of the share segment attached by each node.
+// Blocks are carved out of it so this bounds the size of a datablock
+// payload that can be written to a remote node in a single transfer
+#ifndef GASNET_SEGMENT_PAGES
+#define GASNET_SEGMENT_PAGES 1024
+#endif
+
 /*
  * blocks of segment structure
  * containing the address of the segment and its maximum size
@@ -45,7 +52,7 @@ void gasnetBlockInit();
 gasnetCommBlockSender_t* gasnetReserveSegmentBlock();
 
 /*
- * @brief release a segment block
+ * @brief release the segment block containing addr
  */
 void gasnetReleaseSegmentBlock(void *addr);
 
@@ -55,7 +62,8 @@ void gasnetReleaseSegmentBlock(void *addr);
 void gasnetSegmentBlockPush(ocrPolicyDomain_t * pd, u32 node, gasnetCommBlock_t *block);
 
 /*
- * @brief retrieve a segment block of a remote node ID
+ * @brief retrieve and remove a segment block of a remote node ID
+ * A node may have advertised several blocks, any of them is returned.
  * If there's no block for this node, it returns null
  */
 gasnetCommBlock_t *gasnetSegmentBlockGet(ocrPolicyDomain_t * pd, u32 provider);
@@ -43,6 +43,22 @@
 #include "ocr-sal.h"
 #endif
 
+#ifdef ENABLE_MPI_COMPRESSION
+#include "ocr-sal.h"
+#include "utils/compress.h"
+#endif
+
+#ifdef ENABLE_MPI_AGGREGATION
+#include "ocr-sal.h"
+#include <stddef.h>
+#endif
+
+#ifdef ENABLE_MPI_SHARDS
+// For getenv and strcasecmp
+#include <stdlib.h>
+#include <strings.h>
+#endif
+
 //
 // MPI library Init/Finalize
 //
@@ -50,14 +66,54 @@
 /**
  * @brief Initialize the MPI library.
  */
+#ifdef ENABLE_MPI_SHARDS
+// Thread support provided by the MPI library
+static int mpiThreadLevel = MPI_THREAD_SINGLE;
+
+/**
+ * @brief Thread support to request from the MPI library
+ *
+ * The configuration is not parsed yet when MPI is initialized. A single
+ * comm-worker only calls MPI while the runtime's other threads don't, which
+ * SERIALIZED covers. Configurations running several comm-workers (shards)
+ * must set OCR_MPI_THREAD_LEVEL=multiple, their bring-up aborts otherwise.
+ */
+static int mpiRequestedThreadLevel() {
+    char * value = getenv("OCR_MPI_THREAD_LEVEL");
+    if (value == NULL) {
+        return MPI_THREAD_SERIALIZED;
+    }
+    if (strcasecmp(value, "single") == 0) {
+        return MPI_THREAD_SINGLE;
+    } else if (strcasecmp(value, "funneled") == 0) {
+        return MPI_THREAD_FUNNELED;
+    } else if (strcasecmp(value, "serialized") == 0) {
+        return MPI_THREAD_SERIALIZED;
+    } else if (strcasecmp(value, "multiple") == 0) {
+        return MPI_THREAD_MULTIPLE;
+    }
+    DPRINTF(DEBUG_LVL_WARN, "Unknown OCR_MPI_THREAD_LEVEL '%s', requesting serialized\n", value);
+    return MPI_THREAD_SERIALIZED;
+}
+#endif
+
 void platformInitMPIComm(int * argc, char *** argv) {
+#ifdef ENABLE_MPI_SHARDS
+    RESULT_ASSERT(MPI_Init_thread(argc, argv, mpiRequestedThreadLevel(), &mpiThreadLevel), ==, MPI_SUCCESS);
+#else
     RESULT_ASSERT(MPI_Init(argc, argv), ==, MPI_SUCCESS);
+#endif
 }
 /**
  * @brief Finalize the MPI library (no more remote calls after that).
+ * Does nothing if the library has already been finalized.
  */
 void platformFinalizeMPIComm() {
-    RESULT_ASSERT(MPI_Finalize(), ==, MPI_SUCCESS);
+    int finalized = 0;
+    RESULT_ASSERT(MPI_Finalized(&finalized), ==, MPI_SUCCESS);
+    if (!finalized) {
+        RESULT_ASSERT(MPI_Finalize(), ==, MPI_SUCCESS);
+    }
 }
 
 //
@@ -72,6 +128,19 @@ void platformFinalizeMPIComm() {
 #define RECV_ANY_FIXSZ_ID 1
 #define SEND_ANY_FIXSZ_ID 1
 
+// Communicator carrying the policy messages of a comm-platform. The first
+// shard owns the PD's neighbors, the last one synchronizes with other PDs
+// once all shards are up and finalizes MPI.
+#ifdef ENABLE_MPI_SHARDS
+#define MPI_MSG_COMM(mpiComm) ((mpiComm)->comm)
+#define MPI_FIRST_SHARD(mpiComm) ((mpiComm)->shardId == 0)
+#define MPI_LAST_SHARD(mpiComm) (((mpiComm)->shardId + 1) == (mpiComm)->shardCount)
+#else
+#define MPI_MSG_COMM(mpiComm) MPI_COMM_WORLD
+#define MPI_FIRST_SHARD(mpiComm) true
+#define MPI_LAST_SHARD(mpiComm) true
+#endif
+
 // Expected maximum fixed size is the PD msg size
 // Note the size doesn't account for extra payload attached at the end of the message.
 // In that case, it is illegal to use the fixed message size infrastructure.
@@ -99,6 +168,12 @@ typedef struct _mpiCommHandle_t{
     mpiCommHandleBase_t base;
     u32 properties;
     u8 deleteSendMsg;
+#if defined(ENABLE_MPI_COMPRESSION) || defined(ENABLE_MPI_COMPACT_MSG)
+    ocrPolicyMsg_t * wireMsg; /**< Compressed or compact copy of 'msg' actually sent, if any */
+#endif
+#ifdef ENABLE_MPI_LANES
+    bool bulk; /**< Sent in the bulk lane */
+#endif
 } mpiCommHandle_t;
 #endif
 
@@ -269,13 +344,27 @@ static bool isFixedMsgSize(u32 type) {
 }
 
 static bool isFixedMsgSizeResponse(u32 type) {
-    //By default, will not try to receive through the fixed size message channel
+    //By default, will not try to receive through the fixed size message channel.
+    //Responses to metadata communications must not, they arrive in the bulk lane (see responseComm).
     return false;
 }
 
+/**
+ * @brief Internal use - Returns the communicator the response to 'request' arrives on
+ */
+static MPI_Comm responseComm(ocrCommPlatformMPI_t * mpiComm, ocrPolicyMsg_t * request) {
+#ifdef ENABLE_MPI_LANES
+    // Responses to metadata communications travel in the bulk lane
+    if ((mpiComm->bulkMaxInFlight != 0) && ((request->type & PD_MSG_TYPE_ONLY) == PD_MSG_METADATA_COMM)) {
+        return mpiComm->bulkComm;
+    }
+#endif
+    return MPI_MSG_COMM(mpiComm);
+}
+
 static void postRecvFixedSzMsg(ocrCommPlatformMPI_t * mpiComm, mpiCommHandle_t * hdl) {
     ocrAssert(hdl->base.msg != NULL);
-    RESULT_ASSERT(MPI_Irecv(hdl->base.msg, RECV_ANY_FIXSZ, MPI_BYTE, hdl->base.src, hdl->base.msgId, MPI_COMM_WORLD, hdl->base.status), ==, MPI_SUCCESS);
+    RESULT_ASSERT(MPI_Irecv(hdl->base.msg, RECV_ANY_FIXSZ, MPI_BYTE, hdl->base.src, hdl->base.msgId, MPI_MSG_COMM(mpiComm), hdl->base.status), ==, MPI_SUCCESS);
 }
 
 static mpiCommHandle_t * initMpiHandle(ocrCommPlatform_t * self, mpiCommHandle_t * hdl, u64 id, u32 properties, ocrPolicyMsg_t * msg, u8 deleteSendMsg) {
@@ -286,6 +375,12 @@ static mpiCommHandle_t * initMpiHandle(ocrCommPlatform_t * self, mpiCommHandle_t
 #else
     hdl->properties = properties;
     hdl->deleteSendMsg = deleteSendMsg;
+#if defined(ENABLE_MPI_COMPRESSION) || defined(ENABLE_MPI_COMPACT_MSG)
+    hdl->wireMsg = NULL;
+#endif
+#ifdef ENABLE_MPI_LANES
+    hdl->bulk = false;
+#endif
 #endif
     return hdl;
 }
@@ -347,7 +442,413 @@ static int testAnyFromPool(int count, MPI_Request * requestArray, mpiCommHandle_
 // Communication API
 //
 
-static u8 probeIncoming(ocrCommPlatform_t *self, int src, int tag, ocrPolicyMsg_t ** msg, int bufferSize) {
+#if defined(ENABLE_MPI_COMPRESSION) || defined(ENABLE_DB_ZERO_COPY)
+// Offset of the metadata payload in a PD_MSG_METADATA_COMM message.
+// Everything before is sent as is, everything after is compressed
+// or partly gathered from a DB.
+static u64 mdCommPayloadOffset(ocrPolicyMsg_t * msg) {
+#define PD_MSG (msg)
+#define PD_TYPE PD_MSG_METADATA_COMM
+    return (u64) (((u8 *) &PD_MSG_FIELD_I(payload)) - ((u8 *) msg));
+#undef PD_MSG
+#undef PD_TYPE
+}
+#endif
+
+#ifdef ENABLE_DB_ZERO_COPY
+// Whether the message is a metadata communication whose payload ends in
+// memory it only references (a DB's), see 'extPayload'
+static bool hasExtPayload(ocrPolicyMsg_t * msg) {
+    if (((msg->type & PD_MSG_TYPE_ONLY) != PD_MSG_METADATA_COMM) || !(msg->type & PD_MSG_REQUEST)) {
+        return false;
+    }
+#define PD_MSG (msg)
+#define PD_TYPE PD_MSG_METADATA_COMM
+    return (PD_MSG_FIELD_I(extPayload) != NULL);
+#undef PD_MSG
+#undef PD_TYPE
+}
+
+/**
+ * @brief Internal use - Sends a message whose payload ends in the memory of
+ * a DB without copying it: one send gathers the message and that memory so
+ * that the recipient receives a regular message, ready to back its DB copy.
+ */
+static int isendGather(ocrPolicyMsg_t * msg, u64 fullMsgSize, int targetRank, int tag, MPI_Comm comm, MPI_Request * request) {
+#define PD_MSG (msg)
+#define PD_TYPE PD_MSG_METADATA_COMM
+    void * extPayload = PD_MSG_FIELD_I(extPayload);
+    u64 extSize = PD_MSG_FIELD_I(extSize);
+    u64 inlineSize = mdCommPayloadOffset(msg) + PD_MSG_FIELD_I(sizePayload) - extSize;
+    PD_MSG_FIELD_I(extPayload) = NULL;
+#undef PD_MSG
+#undef PD_TYPE
+    // The trailing alignment padding is whatever the first bytes of the message are
+    int lengths[3] = {(int) inlineSize, (int) extSize, (int) (fullMsgSize - inlineSize - extSize)};
+    MPI_Aint displs[3];
+    RESULT_ASSERT(MPI_Get_address(msg, &displs[0]), ==, MPI_SUCCESS);
+    RESULT_ASSERT(MPI_Get_address(extPayload, &displs[1]), ==, MPI_SUCCESS);
+    displs[2] = displs[0];
+    MPI_Datatype gatherType;
+    RESULT_ASSERT(MPI_Type_create_hindexed((lengths[2] != 0) ? 3 : 2, lengths, displs, MPI_BYTE, &gatherType), ==, MPI_SUCCESS);
+    RESULT_ASSERT(MPI_Type_commit(&gatherType), ==, MPI_SUCCESS);
+    int ret = MPI_Isend(MPI_BOTTOM, 1, gatherType, targetRank, tag, comm, request);
+    // The pending send keeps using the type
+    RESULT_ASSERT(MPI_Type_free(&gatherType), ==, MPI_SUCCESS);
+    return ret;
+}
+#endif
+
+#ifdef ENABLE_MPI_COMPRESSION
+
+/**
+ * @brief Internal use - Returns a compressed copy of a marshalled message
+ * or NULL if the message is not worth compressing.
+ *
+ * Only requests carrying a DB payload (fetch, write-back and clone) are
+ * considered, they are always received in a newly allocated buffer. The
+ * copy keeps the header of 'msg' so that its 'usefulSize' (the size of the
+ * uncompressed message) tells the recipient to decompress.
+ */
+static ocrPolicyMsg_t * compressMessage(ocrCommPlatformMPI_t * mpiComm, ocrPolicyMsg_t * msg, u64 * wireSize) {
+    u64 fullMsgSize = msg->usefulSize;
+    if ((mpiComm->compressThreshold == 0) || (fullMsgSize < mpiComm->compressThreshold) ||
+        ((msg->type & PD_MSG_TYPE_ONLY) != PD_MSG_METADATA_COMM) || !(msg->type & PD_MSG_REQUEST)) {
+        return NULL;
+    }
+#ifdef ENABLE_DB_ZERO_COPY
+    // Compressing would take the copy the message avoids
+    if (hasExtPayload(msg)) {
+        return NULL;
+    }
+#endif
+    u64 offset = mdCommPayloadOffset(msg);
+    if (fullMsgSize <= offset) {
+        return NULL;
+    }
+    ocrPolicyDomain_t * pd = mpiComm->base.pd;
+    u64 startTime = salGetTime();
+    u64 payloadSize = fullMsgSize - offset;
+    ocrPolicyMsg_t * wireMsg = pd->fcts.pdMalloc(pd, fullMsgSize);
+    hal_memCopy(wireMsg, msg, offset, false);
+    // Only keep the encoded payload if it is smaller than the original
+    u64 encodedSize = xorDeltaEncode(((u8 *) wireMsg) + offset, payloadSize - 1, ((u8 *) msg) + offset, payloadSize);
+    mpiComm->compressTime += salGetTime() - startTime;
+    if (encodedSize == 0) {
+        pd->fcts.pdFree(pd, wireMsg);
+        return NULL;
+    }
+    mpiComm->compressCount++;
+    mpiComm->compressBytesSaved += (payloadSize - encodedSize);
+    *wireSize = offset + encodedSize;
+    return wireMsg;
+}
+
+/**
+ * @brief Internal use - Returns the decompressed version of a received message
+ * The received message is deallocated.
+ */
+static ocrPolicyMsg_t * decompressMessage(ocrCommPlatformMPI_t * mpiComm, ocrPolicyMsg_t * wireMsg, u64 wireSize) {
+    ocrPolicyDomain_t * pd = mpiComm->base.pd;
+    u64 startTime = salGetTime();
+    u64 fullMsgSize = wireMsg->usefulSize;
+    u64 offset = mdCommPayloadOffset(wireMsg);
+    ocrPolicyMsg_t * msg = allocateNewMessage((ocrCommPlatform_t *) mpiComm, fullMsgSize);
+    hal_memCopy(msg, wireMsg, offset, false);
+    RESULT_ASSERT(xorDeltaDecode(((u8 *) msg) + offset, fullMsgSize - offset, ((u8 *) wireMsg) + offset, wireSize - offset), ==, (wireSize - offset));
+    pd->fcts.pdFree(pd, wireMsg);
+    mpiComm->compressTime += salGetTime() - startTime;
+    return msg;
+}
+#endif
+
+/**
+ * @brief Internal use - Fixes up a message that has just been received
+ * in a buffer of 'count' bytes and unmarshalls it.
+ */
+static void finalizeIncoming(ocrCommPlatform_t *self, ocrPolicyMsg_t * msg, int count) {
+    // After recv, the message size must be updated since it has just been overwritten.
+    msg->usefulSize = count;
+    msg->bufferSize = count;
+
+    // This check usually fails in the 'ocrPolicyMsgGetMsgSize' when there
+    // has been an issue in MPI. It manifest as a received buffer being complete
+    // garbage whereas the sender doesn't detect any corruption of the message when
+    // it is recycled. Tinkering with multiple MPI implementation it sounds the issue
+    // is with the MPI library not being able to register a hook for malloc calls.
+    ocrAssert(((msg->type & (PD_MSG_REQUEST | PD_MSG_RESPONSE)) != (PD_MSG_REQUEST | PD_MSG_RESPONSE)) &&
+       ((msg->type & PD_MSG_REQUEST) || (msg->type & PD_MSG_RESPONSE)) &&
+       "error: Try to link the MPI library first when compiling your OCR program");
+
+#ifdef OCR_MONITOR_NETWORK
+    msg->rcvTime = salGetTime();
+#endif
+#ifdef ENABLE_RESILIENCY
+    ocrPolicyDomain_t * pd = self->pd;
+    ocrPolicyDomainHc_t *hcPolicy = (ocrPolicyDomainHc_t*)pd;
+    ocrAssert((hcPolicy->commStopped == 0) || ((msg->type & PD_MSG_TYPE_ONLY) == PD_MSG_RESILIENCY_CHECKPOINT));
+#endif
+
+    // Unmarshall the message. We check to make sure the size is OK
+    // This should be true since MPI seems to make sure to send the whole message
+    u64 baseSize = 0, marshalledSize = 0;
+    ocrPolicyMsgGetMsgSize(msg, &baseSize, &marshalledSize, MARSHALL_DBPTR | MARSHALL_NSADDR);
+    ocrAssert((baseSize+marshalledSize) == count);
+    // The unmarshalling is just fixing up fields to point to the correct
+    // payload address trailing after the base message.
+    //BUG #604 Communication API extensions
+    //1)     I'm thinking we can further customize un/marshalling for MPI. Because we use
+    //       mpi tags, we actually don't need to send the header part of response message.
+    //       We can directly recv the message at msg + header, update the msg header
+    //       to be a response + flip src/dst.
+    //2)     See if we can improve unmarshalling by keeping around pointers for the various
+    //       payload to be unmarshalled
+    //3)     We also need to deguidify all the fatGuids that are 'local' and decide
+    //       where it is appropriate to do it.
+    //       - REC: I think the right place would be in the user code (ie: not the comm layer)
+    ocrPolicyMsgUnMarshallMsg((u8*)msg, NULL, msg,
+                              MARSHALL_APPEND | MARSHALL_NSADDR | MARSHALL_DBPTR);
+}
+
+/**
+ * @brief Internal use - Returns the identifier of a new communication
+ */
+static u64 nextMsgId(ocrCommPlatformMPI_t * mpiComm) {
+    u64 mpiId = mpiComm->msgId++;
+#ifdef ENABLE_MPI_SHARDS
+    mpiId = COMM_SHARD_MSGID(mpiId, mpiComm->shardId, mpiComm->shardCount);
+#endif
+#ifdef ENABLE_MPI_COMPACT_MSG
+    // A marshalled message starts with the low byte of its msgId,
+    // which must not be mistaken for a compact message mark
+    if ((mpiId & 0xFF) == POLICY_MSG_COMPACT_MARK) {
+        return nextMsgId(mpiComm);
+    }
+#endif
+    return mpiId;
+}
+
+#ifdef ENABLE_MPI_COMPACT_MSG
+/**
+ * @brief Internal use - Returns a compact copy of a marshalled message
+ * or NULL if the compact form is not smaller.
+ *
+ * Only messages the recipient receives in a newly allocated buffer are
+ * considered: a compact message is decoded straight into the final message.
+ * Responses awaited in their request's buffer and messages that may be
+ * received in a fixed-size buffer go as is.
+ */
+static ocrPolicyMsg_t * compactMessage(ocrCommPlatformMPI_t * mpiComm, ocrPolicyMsg_t * msg, u64 * wireSize) {
+    u64 fullMsgSize = msg->usefulSize;
+    if ((fullMsgSize > MPI_COMPACT_MSG_MAX_SZ) || isFixedMsgSize(msg->type) || isFixedMsgSizeResponse(msg->type) ||
+        ((msg->type & PD_MSG_RESPONSE) && (msg->msgId != SEND_ANY_ID))) {
+        return NULL;
+    }
+    ocrPolicyDomain_t * pd = mpiComm->base.pd;
+    ocrPolicyMsg_t * wireMsg = pd->fcts.pdMalloc(pd, fullMsgSize);
+    u64 encodedSize = ocrPolicyMsgCompactEncode(msg, (u8 *) wireMsg, fullMsgSize - 1);
+    if (encodedSize == 0) {
+        pd->fcts.pdFree(pd, wireMsg);
+        return NULL;
+    }
+    mpiComm->compactCount++;
+    mpiComm->compactBytesSaved += (fullMsgSize - encodedSize);
+    *wireSize = encodedSize;
+    return wireMsg;
+}
+
+/**
+ * @brief Internal use - Returns the decoded version of a compact message
+ * received in a buffer of 'count' bytes. The received message is deallocated.
+ */
+static ocrPolicyMsg_t * expandMessage(ocrCommPlatformMPI_t * mpiComm, ocrPolicyMsg_t * wireMsg, int count) {
+    ocrPolicyDomain_t * pd = mpiComm->base.pd;
+    u64 fullMsgSize = ocrPolicyMsgCompactGetSize((u8 *) wireMsg, (u64) count);
+    ocrAssert(fullMsgSize != 0);
+    ocrPolicyMsg_t * msg = allocateNewMessage((ocrCommPlatform_t *) mpiComm, fullMsgSize);
+    RESULT_ASSERT(ocrPolicyMsgCompactDecode((u8 *) wireMsg, (u64) count, msg, fullMsgSize), ==, (u64) count);
+    pd->fcts.pdFree(pd, wireMsg);
+    return msg;
+}
+#endif
+
+#ifdef ENABLE_MPI_AGGREGATION
+// Small one-way messages bound to the same rank are packed in a batch:
+//     mpiAggBatch_t | msg0 | msg1 | ...
+// Each message is marshalled, or compact when that is smaller, and starts
+// 8-byte aligned. The batch header
+// mirrors the first fields of ocrPolicyMsg_t so that batches go through
+// the regular send completion path. Batches use the same tag as unexpected
+// requests and a rank's batch is always flushed before anything else is
+// sent to that rank: messages are still received in the order they were sent.
+
+// Neither a request nor a response, cannot be mistaken for a policy message
+#define MPI_AGG_BATCH_TYPE ((u32) PD_MSG_TYPE_ONLY)
+
+#define MPI_AGG_ALIGN(sz) ((((u64) (sz)) + 7ULL) & ~7ULL)
+
+typedef struct {
+    u64 msgId;
+    u64 bufferSize;
+    u64 usefulSize;
+    ocrLocation_t srcLocation;
+    ocrLocation_t destLocation;
+    u32 type;
+    u32 count; // Number of messages packed
+} mpiAggBatch_t;
+
+ocrStaticAssert(offsetof(mpiAggBatch_t, type) == offsetof(ocrPolicyMsg_t, type));
+
+#define MPI_AGG_HEADER_SZ MPI_AGG_ALIGN(sizeof(mpiAggBatch_t))
+
+typedef struct _mpiAggBuffer_t {
+    mpiAggBatch_t * batch; // NULL when nothing is pending for the rank
+    u64 firstTime;         // When the oldest pending message has been packed
+} mpiAggBuffer_t;
+
+/**
+ * @brief Internal use - Returns the next message of the batch being unpacked
+ */
+static u8 aggUnpackNext(ocrCommPlatformMPI_t * mpiComm, ocrPolicyMsg_t ** msg) {
+    mpiAggBatch_t * batch = (mpiAggBatch_t *) mpiComm->aggRecvBatch;
+    if (batch == NULL) {
+        return POLL_NO_MESSAGE;
+    }
+    ocrCommPlatform_t * self = (ocrCommPlatform_t *) mpiComm;
+    ocrPolicyMsg_t * packed = (ocrPolicyMsg_t *) (((u8 *) batch) + mpiComm->aggRecvOffset);
+    u64 size;
+    // Upper layers own and free each message individually
+#ifdef ENABLE_MPI_COMPACT_MSG
+    if (((u8 *) packed)[0] == POLICY_MSG_COMPACT_MARK) {
+        u64 avail = batch->usefulSize - mpiComm->aggRecvOffset;
+        size = ocrPolicyMsgCompactGetSize((u8 *) packed, avail);
+        ocrAssert(size != 0);
+        *msg = allocateNewMessage(self, size);
+        u64 consumed = ocrPolicyMsgCompactDecode((u8 *) packed, avail, *msg, size);
+        ocrAssert(consumed != 0);
+        mpiComm->aggRecvOffset += MPI_AGG_ALIGN(consumed);
+    } else
+#endif
+    {
+        size = packed->usefulSize;
+        *msg = allocateNewMessage(self, size);
+        hal_memCopy(*msg, packed, size, false);
+        mpiComm->aggRecvOffset += MPI_AGG_ALIGN(size);
+    }
+    ocrAssert(mpiComm->aggRecvOffset <= batch->usefulSize);
+    if (mpiComm->aggRecvOffset == batch->usefulSize) {
+        self->pd->fcts.pdFree(self->pd, batch);
+        mpiComm->aggRecvBatch = NULL;
+    }
+    finalizeIncoming(self, *msg, (int) size);
+    return POLL_MORE_MESSAGE;
+}
+
+/**
+ * @brief Internal use - Sends the batch pending for 'rank', if any
+ */
+static void aggFlush(ocrCommPlatformMPI_t * mpiComm, int rank) {
+    mpiAggBuffer_t * aggBuf = &mpiComm->aggBuffers[rank];
+    mpiAggBatch_t * batch = aggBuf->batch;
+    if (batch == NULL) {
+        return;
+    }
+    aggBuf->batch = NULL;
+    mpiComm->aggPending--;
+    ocrCommPlatform_t * self = (ocrCommPlatform_t *) mpiComm;
+    u64 mpiId = nextMsgId(mpiComm);
+    batch->msgId = mpiId;
+    // One-way: the batch is freed when the send completes
+    mpiCommHandle_t * hdl = createMpiSendHandle(self, mpiId, PERSIST_MSG_PROP, (ocrPolicyMsg_t *) batch, false);
+    mpiComm->aggBatchCount++;
+    DPRINTF(DEBUG_LVL_NEWMPI,"[MPI %"PRId32"] posting isend for batch msgId=%"PRIu64" of %"PRIu32" messages size=%"PRIu64" to MPI rank %"PRId32"\n",
+            locationToMpiRank(self->pd->myLocation), mpiId, batch->count, batch->usefulSize, rank);
+    RESULT_ASSERT(MPI_Isend(batch, (int) batch->usefulSize, MPI_BYTE, rank, SEND_ANY_ID, MPI_MSG_COMM(mpiComm), hdl->base.status), ==, MPI_SUCCESS);
+}
+
+/**
+ * @brief Internal use - Sends pending batches that have been
+ * waiting for more than MPI_AGG_MAX_DELAY
+ */
+static void aggFlushExpired(ocrCommPlatformMPI_t * mpiComm) {
+    if (mpiComm->aggPending == 0) {
+        return;
+    }
+    u64 now = salGetTime();
+    u32 i;
+    for (i = 0; (i < mpiComm->aggRankCount) && (mpiComm->aggPending != 0); i++) {
+        mpiAggBuffer_t * aggBuf = &mpiComm->aggBuffers[i];
+        if ((aggBuf->batch != NULL) && ((now - aggBuf->firstTime) >= MPI_AGG_MAX_DELAY)) {
+            aggFlush(mpiComm, (int) i);
+        }
+    }
+}
+
+/**
+ * @brief Internal use - Packs a marshalled copy of 'message' in the batch
+ * for 'rank'. Returns false if the message cannot be aggregated.
+ *
+ * Only small one-way messages sent on the unexpected messages tag
+ * qualify: requests that are not waiting on a response and
+ * asynchronous responses.
+ */
+static bool aggPack(ocrCommPlatformMPI_t * mpiComm, int rank, ocrPolicyMsg_t * message,
+                    u64 baseSize, u64 fullMsgSize, u32 properties) {
+    bool oneWay = !(properties & TWOWAY_MSG_PROP) || (properties & ASYNC_MSG_PROP);
+    bool anyTag = (message->type & PD_MSG_REQUEST) ? !isFixedMsgSize(message->type) : !!(properties & ASYNC_MSG_PROP);
+    if (!oneWay || !anyTag || !(properties & PERSIST_MSG_PROP) ||
+        (GET_PROP_U8_MARSHALL(properties) != 0) || (fullMsgSize > MPI_AGG_MSG_MAX_SZ) ||
+        ((MPI_AGG_HEADER_SZ + MPI_AGG_ALIGN(fullMsgSize)) > mpiComm->aggBufferSize)) {
+        return false;
+    }
+    ocrCommPlatform_t * self = (ocrCommPlatform_t *) mpiComm;
+    mpiAggBuffer_t * aggBuf = &mpiComm->aggBuffers[rank];
+    if ((aggBuf->batch != NULL) && ((aggBuf->batch->usefulSize + MPI_AGG_ALIGN(fullMsgSize)) > mpiComm->aggBufferSize)) {
+        aggFlush(mpiComm, rank);
+    }
+    if (aggBuf->batch == NULL) {
+        mpiAggBatch_t * batch = (mpiAggBatch_t *) self->pd->fcts.pdMalloc(self->pd, mpiComm->aggBufferSize);
+        batch->msgId = 0;
+        batch->bufferSize = mpiComm->aggBufferSize;
+        batch->usefulSize = MPI_AGG_HEADER_SZ;
+        batch->srcLocation = self->pd->myLocation;
+        batch->destLocation = mpiRankToLocation(rank);
+        batch->type = MPI_AGG_BATCH_TYPE;
+        batch->count = 0;
+        aggBuf->batch = batch;
+        aggBuf->firstTime = salGetTime();
+        mpiComm->aggPending++;
+    }
+    mpiAggBatch_t * batch = aggBuf->batch;
+    ocrPolicyMsg_t * packed = (ocrPolicyMsg_t *) (((u8 *) batch) + batch->usefulSize);
+    packed->bufferSize = fullMsgSize;
+    packed->usefulSize = 0;
+#ifdef OCR_MONITOR_NETWORK
+    message->sendTime = salGetTime();
+#endif
+    ocrPolicyMsgMarshallMsg(message, baseSize, (u8 *) packed,
+                            MARSHALL_FULL_COPY | MARSHALL_DBPTR | MARSHALL_NSADDR);
+    ocrAssert(packed->usefulSize == fullMsgSize);
+    u64 packedSize = fullMsgSize;
+#ifdef ENABLE_MPI_COMPACT_MSG
+    u8 compact[MPI_AGG_MSG_MAX_SZ];
+    u64 encodedSize = ocrPolicyMsgCompactEncode(packed, compact, fullMsgSize - 1);
+    if (encodedSize != 0) {
+        hal_memCopy(packed, compact, encodedSize, false);
+        mpiComm->compactCount++;
+        mpiComm->compactBytesSaved += (fullMsgSize - encodedSize);
+        packedSize = encodedSize;
+    }
+#endif
+    batch->usefulSize += MPI_AGG_ALIGN(packedSize);
+    batch->count++;
+    mpiComm->aggMsgCount++;
+    return true;
+}
+#endif
+
+static u8 probeIncoming(ocrCommPlatform_t *self, MPI_Comm comm, int src, int tag, ocrPolicyMsg_t ** msg, int bufferSize) {
+    ocrCommPlatformMPI_t * mpiComm __attribute__((unused)) = (ocrCommPlatformMPI_t *) self;
     //PERF: Would it be better to always probe and allocate messages for responses on the fly
     //rather than having all this book-keeping for receiving and reusing requests space ?
     //Sound we should get a pool of small messages (let say sizeof(ocrPolicyMsg_t) and allocate
@@ -360,9 +861,9 @@ static u8 probeIncoming(ocrCommPlatform_t *self, int src, int tag, ocrPolicyMsg_
 
     int available = 0;
 #ifdef MPI_MSG
-    RESULT_ASSERT(MPI_Improbe(src, tag, MPI_COMM_WORLD, &available, &mpiMsg, &status), ==, MPI_SUCCESS);
+    RESULT_ASSERT(MPI_Improbe(src, tag, comm, &available, &mpiMsg, &status), ==, MPI_SUCCESS);
 #else
-    RESULT_ASSERT(MPI_Iprobe(src, tag, MPI_COMM_WORLD, &available, &status), ==, MPI_SUCCESS);
+    RESULT_ASSERT(MPI_Iprobe(src, tag, comm, &available, &status), ==, MPI_SUCCESS);
 #endif
     if (available) {
         ocrAssert(msg != NULL);
@@ -378,53 +879,40 @@ static u8 probeIncoming(ocrCommPlatform_t *self, int src, int tag, ocrPolicyMsg_
             *msg = allocateNewMessage(self, count);
         }
         ocrAssert(*msg != NULL);
-        MPI_Comm comm = MPI_COMM_WORLD;
 #ifdef MPI_MSG
         RESULT_ASSERT(MPI_Mrecv(*msg, count, datatype, &mpiMsg, MPI_STATUS_IGNORE), ==, MPI_SUCCESS);
 #else
         RESULT_ASSERT(MPI_Recv(*msg, count, datatype, src, tag, comm, MPI_STATUS_IGNORE), ==, MPI_SUCCESS);
 #endif
-        // After recv, the message size must be updated since it has just been overwritten.
-        (*msg)->usefulSize = count;
-        (*msg)->bufferSize = count;
-
-        // This check usually fails in the 'ocrPolicyMsgGetMsgSize' when there
-        // has been an issue in MPI. It manifest as a received buffer being complete
-        // garbage whereas the sender doesn't detect any corruption of the message when
-        // it is recycled. Tinkering with multiple MPI implementation it sounds the issue
-        // is with the MPI library not being able to register a hook for malloc calls.
-        ocrAssert((((*msg)->type & (PD_MSG_REQUEST | PD_MSG_RESPONSE)) != (PD_MSG_REQUEST | PD_MSG_RESPONSE)) &&
-           (((*msg)->type & PD_MSG_REQUEST) || ((*msg)->type & PD_MSG_RESPONSE)) &&
-           "error: Try to link the MPI library first when compiling your OCR program");
-
-#ifdef OCR_MONITOR_NETWORK
-        (*msg)->rcvTime = salGetTime();
+#ifdef ENABLE_MPI_COMPACT_MSG
+        // Compact messages are never sent to a request's buffer
+        if (((u8 *) *msg)[0] == POLICY_MSG_COMPACT_MARK) {
+            ocrAssert(bufferSize == 0);
+            *msg = expandMessage((ocrCommPlatformMPI_t *) self, *msg, count);
+            count = (int) (*msg)->usefulSize;
+        }
 #endif
-#ifdef ENABLE_RESILIENCY
-        ocrPolicyDomain_t * pd = self->pd;
-        ocrPolicyDomainHc_t *hcPolicy = (ocrPolicyDomainHc_t*)pd;
-        ocrAssert((hcPolicy->commStopped == 0) || (((*msg)->type & PD_MSG_TYPE_ONLY) == PD_MSG_RESILIENCY_CHECKPOINT));
+#ifdef ENABLE_MPI_COMPRESSION
+        // A compressed message advertises its uncompressed size
+        if ((*msg)->usefulSize > (u64) count) {
+            ocrAssert((bufferSize == 0) && (((*msg)->type & PD_MSG_TYPE_ONLY) == PD_MSG_METADATA_COMM));
+            *msg = decompressMessage((ocrCommPlatformMPI_t *) self, *msg, count);
+            count = (int) (*msg)->usefulSize;
+        }
 #endif
-
-        // Unmarshall the message. We check to make sure the size is OK
-        // This should be true since MPI seems to make sure to send the whole message
-        u64 baseSize = 0, marshalledSize = 0;
-        ocrPolicyMsgGetMsgSize(*msg, &baseSize, &marshalledSize, MARSHALL_DBPTR | MARSHALL_NSADDR);
-        ocrAssert((baseSize+marshalledSize) == count);
-        // The unmarshalling is just fixing up fields to point to the correct
-        // payload address trailing after the base message.
-        //BUG #604 Communication API extensions
-        //1)     I'm thinking we can further customize un/marshalling for MPI. Because we use
-        //       mpi tags, we actually don't need to send the header part of response message.
-        //       We can directly recv the message at msg + header, update the msg header
-        //       to be a response + flip src/dst.
-        //2)     See if we can improve unmarshalling by keeping around pointers for the various
-        //       payload to be unmarshalled
-        //3)     We also need to deguidify all the fatGuids that are 'local' and decide
-        //       where it is appropriate to do it.
-        //       - REC: I think the right place would be in the user code (ie: not the comm layer)
-        ocrPolicyMsgUnMarshallMsg((u8*)*msg, NULL, *msg,
-                                  MARSHALL_APPEND | MARSHALL_NSADDR | MARSHALL_DBPTR);
+#ifdef ENABLE_MPI_AGGREGATION
+        if ((*msg)->type == MPI_AGG_BATCH_TYPE) {
+            ocrCommPlatformMPI_t * mpiComm = (ocrCommPlatformMPI_t *) self;
+            ocrAssert((bufferSize == 0) && (mpiComm->aggRecvBatch == NULL));
+            ocrAssert((*msg)->usefulSize == (u64) count);
+            // Hand out the batch's messages one at a time
+            mpiComm->aggRecvBatch = *msg;
+            mpiComm->aggRecvOffset = MPI_AGG_HEADER_SZ;
+            *msg = NULL;
+            return aggUnpackNext(mpiComm, msg);
+        }
+#endif
+        finalizeIncoming(self, *msg, count);
         DPRINTF(DEBUG_LVL_VVERB, "Returning a message in %p\n", msg);
         return POLL_MORE_MESSAGE;
     }
@@ -516,6 +1004,177 @@ static u8 testRecvFixedSzMsg(ocrCommPlatformMPI_t * mpiComm, ocrPolicyMsg_t ** m
 //      - Either awaited responses from src/tag or outstanding request
 // - 3) Check for fixed sized receive completion
 //      - Either awaited responses from src/tag or outstanding request
+/**
+ * @brief Internal use - Posts the send of a marshalled message
+ *
+ * 'messageBuffer' is what the comm-platform keeps around until the send
+ * completes. Depending on its size and type, a compressed or compact
+ * version of it actually goes on the wire.
+ */
+static int postSend(ocrCommPlatform_t * self, ocrPolicyMsg_t * messageBuffer, u64 mpiId,
+                    u32 properties, u8 deleteSendMsg, bool bulk) {
+    ocrCommPlatformMPI_t * mpiComm = ((ocrCommPlatformMPI_t *) self);
+    u64 fullMsgSize = messageBuffer->usefulSize;
+    // What actually goes on the wire
+    ocrPolicyMsg_t * wireBuffer = messageBuffer;
+    u64 wireSize = fullMsgSize;
+#ifdef ENABLE_MPI_COMPRESSION
+    ocrPolicyMsg_t * compressedBuffer = compressMessage(mpiComm, messageBuffer, &wireSize);
+    if (compressedBuffer != NULL) {
+        wireBuffer = compressedBuffer;
+    }
+#endif
+    // Prepare MPI call arguments
+    MPI_Datatype datatype = MPI_BYTE;
+    int targetRank = locationToMpiRank(messageBuffer->destLocation);
+    ocrAssert(targetRank > -1);
+    MPI_Comm comm = MPI_MSG_COMM(mpiComm);
+#ifdef ENABLE_MPI_LANES
+    if (bulk) {
+        comm = mpiComm->bulkComm;
+    }
+#endif
+
+#ifdef ENABLE_MPI_COMPACT_MSG
+    if (wireBuffer == messageBuffer) {
+        ocrPolicyMsg_t * compactBuffer = compactMessage(mpiComm, messageBuffer, &wireSize);
+        if (compactBuffer != NULL) {
+            wireBuffer = compactBuffer;
+        }
+    }
+#endif
+
+    // Setup request's MPI send
+    mpiCommHandle_t * hdl = createMpiSendHandle(self, mpiId, properties, messageBuffer, deleteSendMsg);
+#if defined(ENABLE_MPI_COMPRESSION) || defined(ENABLE_MPI_COMPACT_MSG)
+    hdl->wireMsg = (wireBuffer != messageBuffer) ? wireBuffer : NULL;
+#endif
+#ifdef ENABLE_MPI_LANES
+    hdl->bulk = bulk;
+#endif
+
+    // Setup request's response
+    if ((messageBuffer->type & PD_MSG_REQ_RESPONSE) && !(properties & ASYNC_MSG_PROP)) {
+        // In probe mode just record the recipient id to be checked later
+        hdl->base.src = targetRank;
+    }
+
+    // If this send is for a response, use message's msgId as tag to
+    // match the source recv operation that had been posted on the request send.
+    // Note that msgId is set to SEND_ANY_ID a little earlier in the case of asynchronous
+    // message like DB_ACQUIRE. It allows to handle the response as a one-way message that
+    // is not tied to any particular request at destination
+    int tag = (messageBuffer->type & PD_MSG_RESPONSE) ? messageBuffer->msgId : (isFixedMsgSize(messageBuffer->type) ? SEND_ANY_FIXSZ_ID : SEND_ANY_ID);
+    MPI_Request * status = hdl->base.status;
+    // Fixed size message just never have been copied to accomodate the need for more space
+    ocrAssert(isFixedMsgSize(messageBuffer->type) ? (deleteSendMsg == false) : true);
+
+    DPRINTF(DEBUG_LVL_NEWMPI,"[MPI %"PRId32"] posting isend for msgId=%"PRIu64" tag= %"PRId32" msg=%p type=%"PRIx32" "
+            "fullMsgSize=%"PRIu64" to MPI rank %"PRId32"\n",
+            locationToMpiRank(self->pd->myLocation), messageBuffer->msgId, tag,
+            messageBuffer, messageBuffer->type, fullMsgSize, targetRank);
+
+    //If this assert bombs, we need to implement message chunking
+    //or use a larger MPI datatype to send the message.
+    ocrAssert((fullMsgSize < INT_MAX) && "Outgoing message is too large");
+    ocrAssert((messageBuffer->srcLocation == self->pd->myLocation) &&
+        (messageBuffer->destLocation != self->pd->myLocation) &&
+        (targetRank == messageBuffer->destLocation));
+
+#ifdef OCR_MONITOR_NETWORK
+    messageBuffer->sendTime = salGetTime();
+#endif
+#ifdef ENABLE_DB_ZERO_COPY
+    if ((wireBuffer == messageBuffer) && hasExtPayload(messageBuffer)) {
+        return isendGather(messageBuffer, fullMsgSize, targetRank, tag, comm, status);
+    }
+#endif
+    return MPI_Isend(wireBuffer, (int) wireSize, datatype, targetRank, tag, comm, status);
+}
+
+#ifdef ENABLE_MPI_LANES
+// DB metadata communications carry the DB payloads. They are sent in their
+// own lane so that a control message (satisfy, scheduler, EDT creation or
+// shutdown message) never waits behind them. All of them go through that
+// lane, one-way or two-way, as well as the responses to metadata
+// communications, so that the DB protocol's messages are received in the
+// order they were sent. A control message may overtake a DB message sent
+// earlier. The DB protocol does not depend on that order since a remote
+// user stays registered at the DB's home until its release is received.
+
+typedef struct _mpiBulkPending_t {
+    ocrPolicyMsg_t * msg;   // Marshalled message, owned by the comm-platform
+    u64 msgId;
+    u32 properties;
+    u8 deleteSendMsg;
+    struct _mpiBulkPending_t * next;
+} mpiBulkPending_t;
+
+static bool isBulk(ocrCommPlatformMPI_t * mpiComm, ocrPolicyMsg_t * msg, u32 properties) {
+    if ((mpiComm->bulkMaxInFlight == 0) || ((msg->type & PD_MSG_TYPE_ONLY) != PD_MSG_METADATA_COMM)) {
+        return false;
+    }
+    // The response's output overlays the GUID. Only datablocks answer a
+    // metadata communication (write-back acknowledgement), and the
+    // requester waits for any such response in the bulk lane.
+    if (msg->type & PD_MSG_RESPONSE) {
+        return true;
+    }
+    ocrGuidKind kind;
+    ocrGuidProvider_t * guidProvider = mpiComm->base.pd->guidProviders[0];
+#define PD_MSG (msg)
+#define PD_TYPE PD_MSG_METADATA_COMM
+    RESULT_ASSERT(guidProvider->fcts.getKind(guidProvider, PD_MSG_FIELD_I(guid), &kind), ==, 0);
+#undef PD_MSG
+#undef PD_TYPE
+    return (kind == OCR_GUID_DB);
+}
+
+/**
+ * @brief Internal use - Sends a bulk message or queues it
+ * until one of the bulk sends in flight completes.
+ */
+static void bulkSend(ocrCommPlatformMPI_t * mpiComm, ocrPolicyMsg_t * msg, u64 mpiId, u32 properties, u8 deleteSendMsg) {
+    if ((mpiComm->bulkHead == NULL) && (mpiComm->bulkInFlight < mpiComm->bulkMaxInFlight)) {
+        RESULT_ASSERT(postSend((ocrCommPlatform_t *) mpiComm, msg, mpiId, properties, deleteSendMsg, true), ==, MPI_SUCCESS);
+        mpiComm->bulkInFlight++;
+    } else {
+        ocrPolicyDomain_t * pd = mpiComm->base.pd;
+        mpiBulkPending_t * pending = pd->fcts.pdMalloc(pd, sizeof(mpiBulkPending_t));
+        pending->msg = msg;
+        pending->msgId = mpiId;
+        pending->properties = properties;
+        pending->deleteSendMsg = deleteSendMsg;
+        pending->next = NULL;
+        if (mpiComm->bulkTail == NULL) {
+            mpiComm->bulkHead = pending;
+        } else {
+            mpiComm->bulkTail->next = pending;
+        }
+        mpiComm->bulkTail = pending;
+        mpiComm->bulkDeferred++;
+    }
+    mpiComm->bulkCount++;
+}
+
+/**
+ * @brief Internal use - Posts the queued bulk messages that fit in flight
+ */
+static void bulkSendPending(ocrCommPlatformMPI_t * mpiComm) {
+    ocrPolicyDomain_t * pd = mpiComm->base.pd;
+    while ((mpiComm->bulkHead != NULL) && (mpiComm->bulkInFlight < mpiComm->bulkMaxInFlight)) {
+        mpiBulkPending_t * pending = mpiComm->bulkHead;
+        mpiComm->bulkHead = pending->next;
+        if (mpiComm->bulkHead == NULL) {
+            mpiComm->bulkTail = NULL;
+        }
+        RESULT_ASSERT(postSend((ocrCommPlatform_t *) mpiComm, pending->msg, pending->msgId, pending->properties, pending->deleteSendMsg, true), ==, MPI_SUCCESS);
+        mpiComm->bulkInFlight++;
+        pd->fcts.pdFree(pd, pending);
+    }
+}
+#endif
+
 static u8 MPICommPollMessageInternal(ocrCommPlatform_t *self, ocrPolicyMsg_t **msg,
                               u32 properties, u32 *mask) {
     START_PROFILE(commplt_MPICommPollMessageInternal);
@@ -540,6 +1199,15 @@ static u8 MPICommPollMessageInternal(ocrCommPlatform_t *self, ocrPolicyMsg_t **m
                     locationToMpiRank(hdl->base.msg->srcLocation), locationToMpiRank(hdl->base.msg->destLocation),
                     hdl->base.msg->msgId, hdl->base.msg->type, hdl->base.msg->usefulSize);
             u32 msgProperties = hdl->properties;
+#ifdef ENABLE_MPI_LANES
+            bool bulk = hdl->bulk;
+#endif
+#if defined(ENABLE_MPI_COMPRESSION) || defined(ENABLE_MPI_COMPACT_MSG)
+            if (hdl->wireMsg != NULL) {
+                pd->fcts.pdFree(pd, hdl->wireMsg);
+                hdl->wireMsg = NULL;
+            }
+#endif
             // By construction, either messages are persistent in API's upper levels
             // or they've been made persistent on the send through a copy.
             ocrAssert(msgProperties & PERSIST_MSG_PROP);
@@ -562,10 +1230,25 @@ static u8 MPICommPollMessageInternal(ocrCommPlatform_t *self, ocrPolicyMsg_t **m
                 }
             }
             compactSendPool(mpiComm, idx);
+#ifdef ENABLE_MPI_LANES
+            if (bulk) {
+                ocrAssert(mpiComm->bulkInFlight > 0);
+                mpiComm->bulkInFlight--;
+                bulkSendPending(mpiComm);
+            }
+#endif
         }
         EXIT_PROFILE;
     }
 
+#ifdef ENABLE_MPI_AGGREGATION
+    aggFlushExpired(mpiComm);
+    // Finish handing out a received batch before looking at anything else
+    if (aggUnpackNext(mpiComm, msg) == POLL_MORE_MESSAGE) {
+        RETURN_PROFILE(POLL_MORE_MESSAGE);
+    }
+#endif
+
     // Checking unknown size recv completions
     u8 res = POLL_NO_MESSAGE;
     {
@@ -578,7 +1261,7 @@ static u8 MPICommPollMessageInternal(ocrCommPlatform_t *self, ocrPolicyMsg_t **m
         // if it fits. Otherwise, a new message is allocated. Upper-layers are responsible
         // for deallocating the request/response buffers.
         ocrPolicyMsg_t * reqMsg = hdl->base.msg;
-        res = probeIncoming(self, hdl->base.src, (int) hdl->base.msgId, &hdl->base.msg, hdl->base.msg->bufferSize);
+        res = probeIncoming(self, responseComm(mpiComm, reqMsg), hdl->base.src, (int) hdl->base.msgId, &hdl->base.msg, hdl->base.msg->bufferSize);
         // The message is properly unmarshalled at this point
         if (res == POLL_MORE_MESSAGE) {
             DPRINTF(DEBUG_LVL_NEWMPI,"[MPI %"PRId32"] Received an awaited message of type %"PRIx32" with msgId=%"PRIu64" recvHdlPool idx=%"PRIu32"\n",
@@ -639,13 +1322,41 @@ static u8 MPICommPollMessageInternal(ocrCommPlatform_t *self, ocrPolicyMsg_t **m
     START_PROFILE(commplt_MPICommPollMessageInternal_progress_probe_awaited);
     // Check for outstanding incoming. If any, a message is allocated
     // and returned through 'msg'.
-    retCode = probeIncoming(self, MPI_ANY_SOURCE, RECV_ANY_ID, msg, 0);
+#ifdef ENABLE_MPI_LANES
+    // The bulk lane is looked at once there is no control message left,
+    // and first every MPI_BULK_POLL_PERIOD control messages not to starve.
+    if (mpiComm->bulkMaxInFlight != 0) {
+        bool bulkFirst = (mpiComm->bulkPollCredit == 0);
+        if (bulkFirst) {
+            retCode = probeIncoming(self, mpiComm->bulkComm, MPI_ANY_SOURCE, RECV_ANY_ID, msg, 0);
+            mpiComm->bulkPollCredit = MPI_BULK_POLL_PERIOD;
+        }
+        if (retCode == POLL_NO_MESSAGE) {
+            retCode = probeIncoming(self, MPI_MSG_COMM(mpiComm), MPI_ANY_SOURCE, RECV_ANY_ID, msg, 0);
+            if (retCode != POLL_NO_MESSAGE) {
+                mpiComm->bulkPollCredit--;
+            } else if (!bulkFirst) {
+                retCode = probeIncoming(self, mpiComm->bulkComm, MPI_ANY_SOURCE, RECV_ANY_ID, msg, 0);
+                mpiComm->bulkPollCredit = MPI_BULK_POLL_PERIOD;
+            }
+        }
+    } else {
+        retCode = probeIncoming(self, MPI_MSG_COMM(mpiComm), MPI_ANY_SOURCE, RECV_ANY_ID, msg, 0);
+    }
+#else
+    retCode = probeIncoming(self, MPI_MSG_COMM(mpiComm), MPI_ANY_SOURCE, RECV_ANY_ID, msg, 0);
+#endif
     // Message is properly un-marshalled at this point
     EXIT_PROFILE;
     }
 
     if (retCode == POLL_NO_MESSAGE) {
+#ifdef ENABLE_MPI_AGGREGATION
+        // Pending batches are outgoing messages too: they go out once expired
+        retCode |= ((mpiComm->sendPoolSz == 0) && (mpiComm->aggPending == 0)) ? POLL_NO_OUTGOING_MESSAGE : 0;
+#else
         retCode |= (mpiComm->sendPoolSz == 0) ? POLL_NO_OUTGOING_MESSAGE : 0;
+#endif
         // Always one unexpected recv posted for fixed size but there should be no awaited recv
         retCode |= ((mpiComm->recvFxdPoolSz == 1) && (mpiComm->recvPoolSz == 0)) ? POLL_NO_INCOMING_MESSAGE : 0;
     } else {
@@ -672,11 +1383,10 @@ static u8 MPICommSendMessage(ocrCommPlatform_t * self,
     ocrPolicyMsgGetMsgSize(message, &baseSize, &marshalledSize, MARSHALL_DBPTR | MARSHALL_NSADDR);
     u64 fullMsgSize = baseSize + marshalledSize;
 
-    //BUG #602 multi-comm-worker: msgId incr only works if a single comm-worker per rank,
-    //do we want OCR to provide PD, system level counters ?
+    // Identifiers are unique across the rank's shards (see nextMsgId)
     // Always generate an identifier for a new communication to give back to upper-layer
 
-    u64 mpiId = mpiComm->msgId++;
+    u64 mpiId = nextMsgId(mpiComm);
 
     // If we're sending a request, set the message's msgId to this communication id
     if (message->type & PD_MSG_REQUEST) {
@@ -692,12 +1402,42 @@ static u8 MPICommSendMessage(ocrCommPlatform_t * self,
         // message's msgId the calling PD is waiting on.
     }
 
+#ifdef ENABLE_MPI_LANES
+    bool bulk = isBulk(mpiComm, message, properties);
+#else
+    bool bulk = false;
+#endif
+#ifdef ENABLE_MPI_AGGREGATION
+    // Batches go through the control lane
+    if ((mpiComm->aggBufferSize != 0) && !bulk) {
+        int aggRank = locationToMpiRank(target);
+        if (aggPack(mpiComm, aggRank, message, baseSize, fullMsgSize, properties)) {
+            // By design, one-way messages are heap-allocated copies owned by the comm-platform
+            self->pd->fcts.pdFree(self->pd, message);
+            *id = mpiId;
+            RETURN_PROFILE(MPI_SUCCESS);
+        }
+        // Whatever is sent to a rank goes after what has been packed for it
+        aggFlush(mpiComm, aggRank);
+    }
+#endif
+
     ocrPolicyMsg_t * messageBuffer = message;
+#ifdef ENABLE_DB_ZERO_COPY
+    // The payload referenced by the message is gathered when sent
+    bool extPayload = hasExtPayload(message);
+    ocrAssert(extPayload ? (properties & PERSIST_MSG_PROP) : true);
+#else
+    bool extPayload = false;
+#endif
     // Check if we need to allocate a new message buffer:
     //  - Does the serialized message fit in the current message ?
     //  - Is the message persistent (then need a copy anyway) ?
     bool deleteSendMsg = false;
-    if ((fullMsgSize > bufferSize) || !(properties & PERSIST_MSG_PROP)) {
+    if (extPayload) {
+        // Nothing else to marshall in a metadata communication
+        messageBuffer->usefulSize = fullMsgSize;
+    } else if ((fullMsgSize > bufferSize) || !(properties & PERSIST_MSG_PROP)) {
         // Allocate message and marshall a copy
         messageBuffer = allocateNewMessage(self, fullMsgSize);
         ocrPolicyMsgMarshallMsg(message, baseSize, (u8*)messageBuffer,
@@ -745,47 +1485,14 @@ static u8 MPICommSendMessage(ocrCommPlatform_t * self,
 
     // Warning: From now on, exclusively use 'messageBuffer' instead of 'message'
     ocrAssert(fullMsgSize == messageBuffer->usefulSize);
-    // Prepare MPI call arguments
-    MPI_Datatype datatype = MPI_BYTE;
-    int targetRank = locationToMpiRank(target);
-    ocrAssert(targetRank > -1);
-    MPI_Comm comm = MPI_COMM_WORLD;
-
-    // Setup request's MPI send
-    mpiCommHandle_t * hdl = createMpiSendHandle(self, mpiId, properties, messageBuffer, deleteSendMsg);
-
-    // Setup request's response
-    if ((messageBuffer->type & PD_MSG_REQ_RESPONSE) && !(properties & ASYNC_MSG_PROP)) {
-        // In probe mode just record the recipient id to be checked later
-        hdl->base.src = targetRank;
+#ifdef ENABLE_MPI_LANES
+    if (bulk) {
+        bulkSend(mpiComm, messageBuffer, mpiId, properties, deleteSendMsg);
+        *id = mpiId;
+        RETURN_PROFILE(MPI_SUCCESS);
     }
-
-    // If this send is for a response, use message's msgId as tag to
-    // match the source recv operation that had been posted on the request send.
-    // Note that msgId is set to SEND_ANY_ID a little earlier in the case of asynchronous
-    // message like DB_ACQUIRE. It allows to handle the response as a one-way message that
-    // is not tied to any particular request at destination
-    int tag = (messageBuffer->type & PD_MSG_RESPONSE) ? messageBuffer->msgId : (isFixedMsgSize(messageBuffer->type) ? SEND_ANY_FIXSZ_ID : SEND_ANY_ID);
-    MPI_Request * status = hdl->base.status;
-    // Fixed size message just never have been copied to accomodate the need for more space
-    ocrAssert(isFixedMsgSize(messageBuffer->type) ? (deleteSendMsg == false) : true);
-
-    DPRINTF(DEBUG_LVL_NEWMPI,"[MPI %"PRId32"] posting isend for msgId=%"PRIu64" tag= %"PRId32" msg=%p type=%"PRIx32" "
-            "fullMsgSize=%"PRIu64" marshalledSize=%"PRIu64" to MPI rank %"PRId32"\n",
-            locationToMpiRank(self->pd->myLocation), messageBuffer->msgId, tag,
-            messageBuffer, messageBuffer->type, fullMsgSize, marshalledSize, targetRank);
-
-    //If this assert bombs, we need to implement message chunking
-    //or use a larger MPI datatype to send the message.
-    ocrAssert((fullMsgSize < INT_MAX) && "Outgoing message is too large");
-    ocrAssert((messageBuffer->srcLocation == self->pd->myLocation) &&
-        (messageBuffer->destLocation != self->pd->myLocation) &&
-        (targetRank == messageBuffer->destLocation));
-
-#ifdef OCR_MONITOR_NETWORK
-    messageBuffer->sendTime = salGetTime();
 #endif
-    int res = MPI_Isend(messageBuffer, (int) fullMsgSize, datatype, targetRank, tag, comm, status);
+    int res = postSend(self, messageBuffer, mpiId, properties, deleteSendMsg, bulk);
 
     if (res == MPI_SUCCESS) {
         *id = mpiId;
@@ -1037,7 +1744,7 @@ static u8 verifyIncomingResponsesMT(ocrCommPlatformMPI_t *mpiComm, bool doUntilE
             hdl->myStrand->curEvent, addrOfMsg, reqMsg);
         ocrAssert(hdl->base.msg == msgEvent->msg);
         // Here we try to reuse the request message to receive the response
-        u8 res = probeIncoming((ocrCommPlatform_t*)mpiComm, hdl->base.src, (int) hdl->base.msgId,
+        u8 res = probeIncoming((ocrCommPlatform_t*)mpiComm, MPI_MSG_COMM(mpiComm), hdl->base.src, (int) hdl->base.msgId,
                                addrOfMsg, reqMsg->bufferSize);
 
         // The message is properly unmarshalled at this point
@@ -1108,7 +1815,7 @@ static u8 MPICommPollMessageInternalMT(ocrCommPlatform_t *self, pdEvent_t **outE
         RESULT_ASSERT(verifyIncomingResponsesMT(mpiComm, true), ==, POLL_NO_MESSAGE);
         // Check for messages that we are not  expecting and are
         // not fixed size messages
-        retCode = probeIncoming(self, MPI_ANY_SOURCE, RECV_ANY_ID, &outMsg, 0);
+        retCode = probeIncoming(self, MPI_MSG_COMM(mpiComm), MPI_ANY_SOURCE, RECV_ANY_ID, &outMsg, 0);
     }
 
     // If we actually got an unexpected message, we create an event for it and mark
@@ -1171,10 +1878,9 @@ static u8 MPICommSendMessageMT(ocrCommPlatform_t * self,
     ocrPolicyMsgGetMsgSize(message, &baseSize, &marshalledSize, MARSHALL_DBPTR | MARSHALL_NSADDR);
     u64 fullMsgSize = baseSize + marshalledSize;
 
-    //BUG #602 multi-comm-worker: msgId incr only works if a single comm-worker per rank,
-    //do we want OCR to provide PD, system level counters ?
+    // Identifiers are unique across the rank's shards (see nextMsgId)
     // Always generate an identifier for a new communication to give back to upper-layer
-    u64 mpiId = mpiComm->msgId++;
+    u64 mpiId = nextMsgId(mpiComm);
 
     if(!(message->type & PD_MSG_RESPONSE)) {
         // If we're sending an actual two way message, set the msgId
@@ -1239,7 +1945,7 @@ static u8 MPICommSendMessageMT(ocrCommPlatform_t * self,
     MPI_Datatype datatype = MPI_BYTE;
     int targetRank = locationToMpiRank(message->destLocation);
     ocrAssert(targetRank > -1);
-    MPI_Comm comm = MPI_COMM_WORLD;
+    MPI_Comm comm = MPI_MSG_COMM(mpiComm);
 
     // Setup request's MPI send
     mpiCommHandle_t * hdl = createMpiSendHandle(self, mpiId, msgEvent->properties, message, false/*TODO-MT-COMM to rm*/);
@@ -1386,6 +2092,40 @@ static u8 MPICommSwitchRunlevel(ocrCommPlatform_t *self, ocrPolicyDomain_t *PD,
             MPI_Comm_rank(MPI_COMM_WORLD, &rank);
             DPRINTF(DEBUG_LVL_VERB,"[MPI %"PRId32"] comm-platform starts\n", rank);
             PD->myLocation = locationToMpiRank(rank);
+#ifdef ENABLE_MPI_SHARDS
+            // Shards are the PD's MPI comm-platforms, in comm-api order
+            u32 i;
+            mpiComm->shardId = 0;
+            mpiComm->shardCount = 0;
+            for (i = 0; i < PD->commApiCount; i++) {
+                ocrCommPlatform_t * commPlatform = PD->commApis[i]->commPlatform;
+                if (commPlatform->fcts.sendMessage == self->fcts.sendMessage) {
+                    if (commPlatform == self) {
+                        mpiComm->shardId = mpiComm->shardCount;
+                    }
+                    mpiComm->shardCount++;
+                }
+            }
+            if (mpiComm->shardCount > 1) {
+                if (mpiThreadLevel != MPI_THREAD_MULTIPLE) {
+                    // Not an assert: without it, the shards would call MPI
+                    // concurrently at a level the library does not support.
+                    PRINTF("ERROR: several MPI comm-platforms require MPI_THREAD_MULTIPLE, "
+                           "set OCR_MPI_THREAD_LEVEL=multiple (library provides level %"PRId32")\n", mpiThreadLevel);
+                    MPI_Abort(MPI_COMM_WORLD, 1);
+                }
+                // Each shard gets its own tag space. MPI_Comm_dup is collective:
+                // all ranks must bring up their shards in the same order.
+                RESULT_ASSERT(MPI_Comm_dup(MPI_COMM_WORLD, &mpiComm->comm), ==, MPI_SUCCESS);
+            }
+            DPRINTF(DEBUG_LVL_VERB,"[MPI %"PRId32"] comm-platform is shard %"PRIu32" of %"PRIu32"\n",
+                    rank, mpiComm->shardId, mpiComm->shardCount);
+#endif
+#ifdef ENABLE_MPI_LANES
+            if (mpiComm->bulkMaxInFlight != 0) {
+                RESULT_ASSERT(MPI_Comm_dup(MPI_COMM_WORLD, &mpiComm->bulkComm), ==, MPI_SUCCESS);
+            }
+#endif
         }
         break;
     case RL_MEMORY_OK:
@@ -1394,8 +2134,7 @@ static u8 MPICommSwitchRunlevel(ocrCommPlatform_t *self, ocrPolicyDomain_t *PD,
     case RL_GUID_OK:
         ocrAssert(self->pd == PD);
         if((properties & RL_BRING_UP) && RL_IS_LAST_PHASE_UP(self->pd, RL_GUID_OK, phase)) {
-            //BUG #602 multi-comm-worker: multi-initialization if multiple comm-worker
-            //Initialize mpi comm internal queues
+            //Initialize mpi comm internal queues, one set per shard
             mpiComm->sendPool = (MPI_Request *) self->pd->fcts.pdMalloc(self->pd, MPI_COMM_REQUEST_POOL_SZ * sizeof(MPI_Request));
             mpiComm->recvPool = (MPI_Request *) self->pd->fcts.pdMalloc(self->pd, MPI_COMM_REQUEST_POOL_SZ * sizeof(MPI_Request));
             mpiComm->recvFxdPool = (MPI_Request *) self->pd->fcts.pdMalloc(self->pd, MPI_COMM_REQUEST_POOL_SZ * sizeof(MPI_Request));
@@ -1421,40 +2160,54 @@ static u8 MPICommSwitchRunlevel(ocrCommPlatform_t *self, ocrPolicyDomain_t *PD,
             //BUG #606 Neighbor registration: neighbor information should come from discovery or topology description
             int nbRanks;
             MPI_Comm_size(MPI_COMM_WORLD, &nbRanks);
-            PD->neighborCount = nbRanks - 1;
-            PD->neighbors = PD->fcts.pdMalloc(PD, sizeof(ocrLocation_t) * PD->neighborCount);
             int myRank = (int) locationToMpiRank(PD->myLocation);
             int k = 0;
-            while(k < (nbRanks-1)) {
-                PD->neighbors[k] = mpiRankToLocation((myRank+k+1)%nbRanks);
-                DPRINTF(DEBUG_LVL_VERB,"[MPI %"PRId32"] Neighbors[%"PRId32"] is %"PRIu64"\n", myRank, k, PD->neighbors[k]);
-                k++;
+            if (MPI_FIRST_SHARD(mpiComm)) {
+                PD->neighborCount = nbRanks - 1;
+                PD->neighbors = PD->fcts.pdMalloc(PD, sizeof(ocrLocation_t) * PD->neighborCount);
+                while(k < (nbRanks-1)) {
+                    PD->neighbors[k] = mpiRankToLocation((myRank+k+1)%nbRanks);
+                    DPRINTF(DEBUG_LVL_VERB,"[MPI %"PRId32"] Neighbors[%"PRId32"] is %"PRIu64"\n", myRank, k, PD->neighbors[k]);
+                    k++;
+                }
+            }
+#ifdef ENABLE_MPI_AGGREGATION
+            if (mpiComm->aggBufferSize != 0) {
+                mpiComm->aggRankCount = (u32) nbRanks;
+                mpiComm->aggBuffers = (mpiAggBuffer_t *) PD->fcts.pdMalloc(PD, sizeof(mpiAggBuffer_t) * nbRanks);
+                for (k = 0; k < nbRanks; k++) {
+                    mpiComm->aggBuffers[k].batch = NULL;
+                    mpiComm->aggBuffers[k].firstTime = 0;
+                }
             }
+#endif
 #ifdef DEBUG_MPI_HOSTNAMES
             char hostname[256];
             gethostname(hostname,255);
             ocrPrintf("MPI rank %"PRId32" on host %s\n", myRank, hostname);
 #endif
             // Runlevel barrier across policy-domains
+            if (MPI_LAST_SHARD(mpiComm)) {
 #ifdef ENABLE_RESILIENCY
-            u64 time = PD->commApis[0]->syncCalTime;
-            if (myRank == 0) {
-                if (time == 0)
-                    time = salGetCalTime();
-            } else {
-                ocrAssert(time == 0);
-            }
-            MPI_Bcast((void*)(&time), 1, MPI_UINT64_T, 0, MPI_COMM_WORLD);
-            ocrAssert(time != 0);
-            int i;
-            if (PD->commApis[0]->syncCalTime == 0) {
-                for (i = 0; i < PD->commApiCount; i++) {
-                    PD->commApis[i]->syncCalTime = time;
+                u64 time = PD->commApis[0]->syncCalTime;
+                if (myRank == 0) {
+                    if (time == 0)
+                        time = salGetCalTime();
+                } else {
+                    ocrAssert(time == 0);
+                }
+                MPI_Bcast((void*)(&time), 1, MPI_UINT64_T, 0, MPI_COMM_WORLD);
+                ocrAssert(time != 0);
+                int i;
+                if (PD->commApis[0]->syncCalTime == 0) {
+                    for (i = 0; i < PD->commApiCount; i++) {
+                        PD->commApis[i]->syncCalTime = time;
+                    }
                 }
-            }
 #else
-            MPI_Barrier(MPI_COMM_WORLD);
+                MPI_Barrier(MPI_COMM_WORLD);
 #endif
+            }
         }
         if ((properties & RL_TEAR_DOWN) && RL_IS_FIRST_PHASE_DOWN(self->pd, RL_GUID_OK, phase)) {
             // There might still be one-way messages in flight that are
@@ -1467,11 +2220,52 @@ static u8 MPICommSwitchRunlevel(ocrCommPlatform_t *self, ocrPolicyDomain_t *PD,
                 ocrPolicyMsg_t * msg = dh->base.msg;
 #ifdef OCR_ASSERT
                 DPRINTF(DEBUG_LVL_WARN, "Shutdown: message of type %"PRIx32" has not been drained\n", (u32) (msg->type & PD_MSG_TYPE_ONLY));
+#endif
+#if defined(ENABLE_MPI_COMPRESSION) || defined(ENABLE_MPI_COMPACT_MSG)
+                if (dh->wireMsg != NULL) {
+                    self->pd->fcts.pdFree(self->pd, dh->wireMsg);
+                }
 #endif
                 self->pd->fcts.pdFree(self->pd, msg);
                 i++;
             }
             mpiComm->sendPoolSz = 0;
+#ifdef ENABLE_MPI_AGGREGATION
+            if (mpiComm->aggBuffers != NULL) {
+                for (i = 0; i < mpiComm->aggRankCount; i++) {
+                    mpiAggBatch_t * batch = mpiComm->aggBuffers[i].batch;
+                    if (batch != NULL) {
+#ifdef OCR_ASSERT
+                        DPRINTF(DEBUG_LVL_WARN, "Shutdown: batch of %"PRIu32" messages has not been sent\n", batch->count);
+#endif
+                        self->pd->fcts.pdFree(self->pd, batch);
+                    }
+                }
+                self->pd->fcts.pdFree(self->pd, mpiComm->aggBuffers);
+                mpiComm->aggBuffers = NULL;
+                mpiComm->aggPending = 0;
+            }
+            if (mpiComm->aggRecvBatch != NULL) {
+                self->pd->fcts.pdFree(self->pd, mpiComm->aggRecvBatch);
+                mpiComm->aggRecvBatch = NULL;
+            }
+            DPRINTF(DEBUG_LVL_INFO, "[MPI %"PRId32"] aggregated %"PRIu64" messages in %"PRIu64" batches\n",
+                    locationToMpiRank(self->pd->myLocation), mpiComm->aggMsgCount, mpiComm->aggBatchCount);
+#endif
+#ifdef ENABLE_MPI_COMPRESSION
+            DPRINTF(DEBUG_LVL_INFO, "[MPI %"PRId32"] compressed %"PRIu64" messages, saved %"PRIu64" bytes in %"PRIu64" ns\n",
+                    locationToMpiRank(self->pd->myLocation), mpiComm->compressCount,
+                    mpiComm->compressBytesSaved, mpiComm->compressTime);
+#endif
+#ifdef ENABLE_MPI_LANES
+            ocrAssert((mpiComm->bulkHead == NULL) && (mpiComm->bulkInFlight == 0));
+            DPRINTF(DEBUG_LVL_INFO, "[MPI %"PRId32"] sent %"PRIu64" messages in the bulk lane, %"PRIu64" waited for a slot\n",
+                    locationToMpiRank(self->pd->myLocation), mpiComm->bulkCount, mpiComm->bulkDeferred);
+#endif
+#ifdef ENABLE_MPI_COMPACT_MSG
+            DPRINTF(DEBUG_LVL_INFO, "[MPI %"PRId32"] sent %"PRIu64" messages in compact form, saved %"PRIu64" bytes\n",
+                    locationToMpiRank(self->pd->myLocation), mpiComm->compactCount, mpiComm->compactBytesSaved);
+#endif
 
             // Cancel pre-post fxd pool irecvs
             i = 0;
@@ -1496,8 +2290,10 @@ static u8 MPICommSwitchRunlevel(ocrCommPlatform_t *self, ocrPolicyDomain_t *PD,
             self->pd->fcts.pdFree(self->pd, mpiComm->sendHdlPool);
             self->pd->fcts.pdFree(self->pd, mpiComm->recvHdlPool);
             self->pd->fcts.pdFree(self->pd, mpiComm->recvFxdHdlPool);
-            PD->fcts.pdFree(PD, PD->neighbors);
-            PD->neighbors = NULL;
+            if (MPI_FIRST_SHARD(mpiComm)) {
+                PD->fcts.pdFree(PD, PD->neighbors);
+                PD->neighbors = NULL;
+            }
         }
         break;
     case RL_COMPUTE_OK:
@@ -1522,8 +2318,23 @@ static u8 MPICommSwitchRunlevel(ocrCommPlatform_t *self, ocrPolicyDomain_t *PD,
 //
 
 static void MPICommDestruct (ocrCommPlatform_t * self) {
+    ocrCommPlatformMPI_t * mpiComm __attribute__((unused)) = (ocrCommPlatformMPI_t *) self;
+#ifdef ENABLE_MPI_SHARDS
+    if (mpiComm->comm != MPI_COMM_WORLD) {
+        RESULT_ASSERT(MPI_Comm_free(&mpiComm->comm), ==, MPI_SUCCESS);
+    }
+#endif
+#ifdef ENABLE_MPI_LANES
+    if (mpiComm->bulkComm != MPI_COMM_NULL) {
+        RESULT_ASSERT(MPI_Comm_free(&mpiComm->bulkComm), ==, MPI_SUCCESS);
+    }
+#endif
     //This should be called only once per rank and by the same thread that did MPI_Init.
-    platformFinalizeMPIComm();
+    //Shards are destroyed in order, the last one finalizes. MPI_Comm_free is
+    //collective: all ranks must destroy their shards in the same order.
+    if (MPI_LAST_SHARD(mpiComm)) {
+        platformFinalizeMPIComm();
+    }
     runtimeChunkFree((u64)self, PERSISTENT_CHUNK);
 }
 
@@ -1553,6 +2364,11 @@ static void initializeCommPlatformMPI(ocrCommPlatformFactory_t * factory, ocrCom
     mpiComm->msgId = 2; // all recv ANY use id '0'
     mpiComm->maxMsgSize = 0;
     mpiComm->curState = 0;
+#ifdef ENABLE_MPI_SHARDS
+    mpiComm->comm = MPI_COMM_WORLD;
+    mpiComm->shardId = 0;
+    mpiComm->shardCount = 1;
+#endif
     mpiComm->sendPool = NULL;
     mpiComm->sendPoolSz = 0;
     mpiComm->sendPoolMax = 0;
@@ -1565,6 +2381,36 @@ static void initializeCommPlatformMPI(ocrCommPlatformFactory_t * factory, ocrCom
     mpiComm->sendHdlPool = NULL;
     mpiComm->recvHdlPool = NULL;
     mpiComm->recvFxdHdlPool = NULL;
+#ifdef ENABLE_MPI_COMPRESSION
+    mpiComm->compressThreshold = ((ocrCommPlatformFactoryMPI_t *) factory)->compressThreshold;
+    mpiComm->compressCount = 0;
+    mpiComm->compressBytesSaved = 0;
+    mpiComm->compressTime = 0;
+#endif
+#ifdef ENABLE_MPI_LANES
+    mpiComm->bulkComm = MPI_COMM_NULL;
+    mpiComm->bulkMaxInFlight = ((ocrCommPlatformFactoryMPI_t *) factory)->bulkMaxInFlight;
+    mpiComm->bulkInFlight = 0;
+    mpiComm->bulkPollCredit = MPI_BULK_POLL_PERIOD;
+    mpiComm->bulkHead = NULL;
+    mpiComm->bulkTail = NULL;
+    mpiComm->bulkCount = 0;
+    mpiComm->bulkDeferred = 0;
+#endif
+#ifdef ENABLE_MPI_COMPACT_MSG
+    mpiComm->compactCount = 0;
+    mpiComm->compactBytesSaved = 0;
+#endif
+#ifdef ENABLE_MPI_AGGREGATION
+    mpiComm->aggBufferSize = ((ocrCommPlatformFactoryMPI_t *) factory)->aggBufferSize;
+    mpiComm->aggBuffers = NULL;
+    mpiComm->aggRankCount = 0;
+    mpiComm->aggPending = 0;
+    mpiComm->aggRecvBatch = NULL;
+    mpiComm->aggRecvOffset = 0;
+    mpiComm->aggMsgCount = 0;
+    mpiComm->aggBatchCount = 0;
+#endif
 }
 
 ocrCommPlatformFactory_t *newCommPlatformFactoryMPI(ocrParamList_t *perType) {
@@ -1573,6 +2419,18 @@ ocrCommPlatformFactory_t *newCommPlatformFactoryMPI(ocrParamList_t *perType) {
     base->instantiate = &newCommPlatformMPI;
     base->initialize = &initializeCommPlatformMPI;
     base->destruct = FUNC_ADDR(void (*)(ocrCommPlatformFactory_t*), destructCommPlatformFactoryMPI);
+#ifdef ENABLE_MPI_COMPRESSION
+    ((ocrCommPlatformFactoryMPI_t *) base)->compressThreshold = (perType != NULL) ?
+        ((paramListCommPlatformFactMPI_t *) perType)->compressThreshold : MPI_COMPRESS_THRESHOLD;
+#endif
+#ifdef ENABLE_MPI_AGGREGATION
+    ((ocrCommPlatformFactoryMPI_t *) base)->aggBufferSize = (perType != NULL) ?
+        ((paramListCommPlatformFactMPI_t *) perType)->aggBufferSize : MPI_AGG_BUFFER_SZ;
+#endif
+#ifdef ENABLE_MPI_LANES
+    ((ocrCommPlatformFactoryMPI_t *) base)->bulkMaxInFlight = (perType != NULL) ?
+        ((paramListCommPlatformFactMPI_t *) perType)->bulkMaxInFlight : MPI_BULK_MAX_INFLIGHT;
+#endif
 
     base->platformFcts.destruct = FUNC_ADDR(void (*)(ocrCommPlatform_t*), MPICommDestruct);
     base->platformFcts.switchRunlevel = FUNC_ADDR(u8 (*)(ocrCommPlatform_t*, ocrPolicyDomain_t*, ocrRunlevel_t,
@@ -19,12 +19,82 @@
 
 #include <mpi.h>
 
+// Aggregation, compact messages, shards and lanes are only
+// implemented for the communication path without micro-tasks
+#ifdef UTASK_COMM2
+#undef ENABLE_MPI_AGGREGATION
+#undef ENABLE_MPI_COMPACT_MSG
+#undef ENABLE_MPI_SHARDS
+#undef ENABLE_MPI_LANES
+#endif
+
 typedef struct {
     ocrCommPlatformFactory_t base;
+#ifdef ENABLE_MPI_COMPRESSION
+    u64 compressThreshold;
+#endif
+#ifdef ENABLE_MPI_AGGREGATION
+    u64 aggBufferSize;
+#endif
+#ifdef ENABLE_MPI_LANES
+    u64 bulkMaxInFlight;
+#endif
 } ocrCommPlatformFactoryMPI_t;
 
 #define MPI_COMM_RL_MAX 3
 
+#ifdef ENABLE_MPI_COMPRESSION
+// Metadata communications (DB fetch, write-back and clone) at least that
+// large have their payload compressed. Set through the 'compressthreshold'
+// key of the comm-platform type section, 0 disables compression.
+#ifndef MPI_COMPRESS_THRESHOLD
+#define MPI_COMPRESS_THRESHOLD 4096
+#endif
+#endif
+
+#ifdef ENABLE_MPI_AGGREGATION
+// Small one-way messages are packed per destination rank in buffers of that
+// size. A buffer is sent when full, when its oldest message has waited for
+// MPI_AGG_MAX_DELAY ns or before any other message is sent to the same rank.
+// Set through the 'aggregatesize' key of the comm-platform type section,
+// 0 disables aggregation.
+#ifndef MPI_AGG_BUFFER_SZ
+#define MPI_AGG_BUFFER_SZ 16384
+#endif
+// Largest message considered for aggregation
+#ifndef MPI_AGG_MSG_MAX_SZ
+#define MPI_AGG_MSG_MAX_SZ 1024
+#endif
+#ifndef MPI_AGG_MAX_DELAY
+#define MPI_AGG_MAX_DELAY 50000
+#endif
+#endif
+
+#ifdef ENABLE_MPI_LANES
+// DB metadata communications (fetch, write-back, clone, destruction) and
+// the responses to metadata communications (write-back acknowledgements) go
+// through the bulk lane: a communicator of their own that is looked at when
+// no control message is pending, or every MPI_BULK_POLL_PERIOD control
+// messages. At most MPI_BULK_MAX_INFLIGHT of them are being sent at a time,
+// the others wait in order in the comm-platform. Set through the
+// 'bulkinflight' key of the comm-platform type section, 0 disables the lane.
+#ifndef MPI_BULK_MAX_INFLIGHT
+#define MPI_BULK_MAX_INFLIGHT 4
+#endif
+#ifndef MPI_BULK_POLL_PERIOD
+#define MPI_BULK_POLL_PERIOD 16
+#endif
+#endif
+
+#ifdef ENABLE_MPI_COMPACT_MSG
+// Messages up to that size are sent in their compact encoding
+// (see ocrPolicyMsgCompactEncode) whenever it is smaller. Responses
+// received in their request's buffer are always sent as is.
+#ifndef MPI_COMPACT_MSG_MAX_SZ
+#define MPI_COMPACT_MSG_MAX_SZ 4096
+#endif
+#endif
+
 // Initial value for request pool
 // Implementation resizes as needed
 #ifndef MPI_COMM_REQUEST_POOL_SZ
@@ -32,6 +102,12 @@ typedef struct {
 #endif
 
 struct _mpiCommHandle_t;
+#ifdef ENABLE_MPI_AGGREGATION
+struct _mpiAggBuffer_t;
+#endif
+#ifdef ENABLE_MPI_LANES
+struct _mpiBulkPending_t;
+#endif
 
 typedef struct {
     ocrCommPlatform_t base;
@@ -57,8 +133,63 @@ typedef struct {
     // The state encodes the RL (top 4 bits) and the phase (bottom 4 bits)
     // This is mainly for debugging purpose
     volatile u8 curState;
+#ifdef ENABLE_MPI_SHARDS
+    // Shards are created and destroyed in comm-api order, which must be the
+    // same on every rank since duplicating and freeing a communicator are
+    // collective. Several shards need OCR_MPI_THREAD_LEVEL=multiple.
+    MPI_Comm comm;      // Communicator of the shard, duplicated when there are several
+    u32 shardId;        // Index of this instance among the PD's MPI comm-platforms
+    u32 shardCount;
+#endif
+#ifdef ENABLE_MPI_COMPRESSION
+    u64 compressThreshold;
+    // Statistics, reported at tear-down
+    u64 compressCount;      // Number of messages sent compressed
+    u64 compressBytesSaved; // Bytes not sent thanks to compression
+    u64 compressTime;       // Time spent (de)compressing in ns
+#endif
+#ifdef ENABLE_MPI_AGGREGATION
+    u64 aggBufferSize;
+    struct _mpiAggBuffer_t * aggBuffers; // Outgoing batches, one per rank
+    u32 aggRankCount;
+    u32 aggPending;                      // Number of ranks with a pending batch
+    ocrPolicyMsg_t * aggRecvBatch;       // Received batch being handed out
+    u64 aggRecvOffset;                   // Offset of the next message in aggRecvBatch
+    // Statistics, reported at tear-down
+    u64 aggMsgCount;   // Number of messages sent in batches
+    u64 aggBatchCount; // Number of batches sent
+#endif
+#ifdef ENABLE_MPI_LANES
+    MPI_Comm bulkComm;                    // Communicator of the bulk lane
+    u64 bulkMaxInFlight;
+    u32 bulkInFlight;                     // Number of bulk sends posted and not completed
+    u32 bulkPollCredit;                   // Control messages received before looking at the bulk lane
+    struct _mpiBulkPending_t * bulkHead;  // Bulk messages waiting to be posted, in order
+    struct _mpiBulkPending_t * bulkTail;
+    // Statistics, reported at tear-down
+    u64 bulkCount;     // Number of messages sent in the bulk lane
+    u64 bulkDeferred;  // Number of them that had to wait for a slot
+#endif
+#ifdef ENABLE_MPI_COMPACT_MSG
+    // Statistics, reported at tear-down
+    u64 compactCount;      // Number of messages sent in compact form
+    u64 compactBytesSaved; // Bytes not sent thanks to the compact form
+#endif
 } ocrCommPlatformMPI_t;
 
+typedef struct {
+    paramListCommPlatformFact_t base;
+#ifdef ENABLE_MPI_COMPRESSION
+    u64 compressThreshold;
+#endif
+#ifdef ENABLE_MPI_AGGREGATION
+    u64 aggBufferSize;
+#endif
+#ifdef ENABLE_MPI_LANES
+    u64 bulkMaxInFlight;
+#endif
+} paramListCommPlatformFactMPI_t;
+
 typedef struct {
     paramListCommPlatformInst_t base;
 } paramListCommPlatformMPI_t;
@@ -0,0 +1,887 @@
+/*
+ * This file is subject to the license agreement located in the file LICENSE
+ * and cannot be distributed without it. This notice cannot be
+ * removed or modified.
+ */
+
+#include "ocr-config.h"
+#ifdef ENABLE_COMM_PLATFORM_SHM
+
+#include "debug.h"
+#include "ocr-sysboot.h"
+#include "ocr-policy-domain.h"
+#include "ocr-worker.h"
+#include "utils/ocr-utils.h"
+#include "shm-comm-platform.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <linux/futex.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+
+#define DEBUG_TYPE COMM_PLATFORM
+
+// For upper-level platforms
+#define SEND_ANY_ID 0
+
+//
+// Segment layout
+//
+// The segment is created by rank 0, the other ranks attach to it once rank 0
+// has marked it ready. It has the same size for all ranks and its pages are
+// zero-filled on creation:
+//     shmSegmentHeader_t | shmDoorbell_t[nbRanks] | ring[nbRanks][nbRanks]
+// Each item starts on its own cache line. ring[src][dst] is a shmRing_t
+// followed by 'ringSize' bytes of data. Only 'src' writes the ring's tail
+// and only 'dst' writes its head, both grow monotonically.
+//
+// A message is written in the ring as one or more chunks:
+//     shmChunkHeader_t | data (padded to 8 bytes)
+// Chunks of a message are contiguous in the ring: a message is written
+// entirely before the next one to the same destination is started.
+//
+
+#define SHM_CACHE_LINE 64
+
+#define SHM_ALIGN(sz) ((((u64) (sz)) + 7ULL) & ~7ULL)
+
+// Set by rank 0 in the header once the segment can be attached to
+#define SHM_SEGMENT_READY 0x4f435253
+
+typedef struct {
+    volatile u32 barrierCount;
+    volatile u32 barrierPhase; // Futex word, bumped when all ranks reached the barrier
+    volatile u32 ready;        // SHM_SEGMENT_READY once rank 0 created the segment
+    volatile s32 creator;      // Process id of rank 0
+} shmSegmentHeader_t;
+
+typedef struct {
+    volatile u32 doorbell;     // Futex word, bumped when a chunk is written for this rank
+    volatile u32 sleeping;     // Set while the rank waits on its doorbell
+} shmDoorbell_t;
+
+typedef struct {
+    volatile u64 head;         // Bytes consumed
+    u8 pad0[SHM_CACHE_LINE - sizeof(u64)];
+    volatile u64 tail;         // Bytes produced
+    u8 pad1[SHM_CACHE_LINE - sizeof(u64)];
+} shmRing_t;
+
+typedef struct {
+    u64 msgSize;               // Size of the whole message
+    u64 chunkSize;             // Size of the data following this header
+} shmChunkHeader_t;
+
+// Outgoing message that did not fit in its ring yet
+typedef struct _shmPending_t {
+    ocrPolicyMsg_t * msg;
+    u64 size;
+    u64 sent;
+    u64 deliverAt;             // Time the emulated link lets the message through, 0 if none
+    bool freeMsg;              // Message is owned by the comm-platform
+    struct _shmPending_t * next;
+} shmPending_t;
+
+// Incoming message being reassembled
+typedef struct _shmIncoming_t {
+    ocrPolicyMsg_t * msg;
+    u64 size;
+    u64 received;
+} shmIncoming_t;
+
+static inline shmSegmentHeader_t * segmentHeader(ocrCommPlatformShm_t * shmComm) {
+    return (shmSegmentHeader_t *) shmComm->segment;
+}
+
+static inline shmDoorbell_t * doorbellOf(ocrCommPlatformShm_t * shmComm, u32 rank) {
+    return (shmDoorbell_t *) (shmComm->segment + (SHM_CACHE_LINE * (1 + rank)));
+}
+
+static inline shmRing_t * ringOf(ocrCommPlatformShm_t * shmComm, u32 src, u32 dst) {
+    u64 offset = (SHM_CACHE_LINE * (1 + shmComm->nbRanks)) +
+                 ((src * shmComm->nbRanks) + dst) * (sizeof(shmRing_t) + shmComm->ringSize);
+    return (shmRing_t *) (shmComm->segment + offset);
+}
+
+static inline u8 * ringData(shmRing_t * ring) {
+    return ((u8 *) ring) + sizeof(shmRing_t);
+}
+
+/**
+ * @brief Internal use - Returns a new message
+ */
+static ocrPolicyMsg_t * allocateNewMessage(ocrCommPlatform_t * self, u64 size) {
+    ocrPolicyDomain_t * pd = self->pd;
+    ocrPolicyMsg_t * message = pd->fcts.pdMalloc(pd, size);
+    initializePolicyMessage(message, size);
+    return message;
+}
+
+//
+// Process bootstrap
+//
+
+/**
+ * @brief Read an integer from the first of 'names' set in the environment
+ */
+static s64 getEnvValue(const char * names[]) {
+    u32 i = 0;
+    while (names[i] != NULL) {
+        char * value = getenv(names[i]);
+        if (value != NULL) {
+            return (s64) strtol(value, NULL, 10);
+        }
+        i++;
+    }
+    return -1;
+}
+
+/**
+ * @brief Find out the rank of this process and the number of ranks
+ *
+ * An explicit setting has priority over the values exported by common
+ * launchers, a process launched on its own is rank 0 of 1.
+ */
+static void shmDiscoverRank(ocrCommPlatformShm_t * shmComm) {
+    const char * rankVars[] = {"OCR_SHM_RANK", "OMPI_COMM_WORLD_RANK", "PMI_RANK", NULL};
+    const char * sizeVars[] = {"OCR_SHM_SIZE", "OMPI_COMM_WORLD_SIZE", "PMI_SIZE", NULL};
+    s64 rank = getEnvValue(rankVars);
+    s64 size = getEnvValue(sizeVars);
+    if ((rank < 0) || (size < 1)) {
+        rank = 0;
+        size = 1;
+    }
+    ocrAssert(rank < size);
+    shmComm->rank = (u32) rank;
+    shmComm->nbRanks = (u32) size;
+    // All the ranks of a job must agree on the segment name. By default
+    // it derives from the launcher, which is the parent of all ranks.
+    char * name = getenv("OCR_SHM_NAME");
+    if (name != NULL) {
+        snprintf(shmComm->segName, SHM_NAME_MAX, "%s", name);
+    } else {
+        snprintf(shmComm->segName, SHM_NAME_MAX, "/ocr-shm-%"PRId32, (s32) getppid());
+    }
+}
+
+static void shmFutexWait(volatile u32 * addr, u32 value, u64 timeoutNs) {
+    struct timespec ts;
+    ts.tv_sec = timeoutNs / 1000000000ULL;
+    ts.tv_nsec = timeoutNs % 1000000000ULL;
+    // Not a private futex: the word lives in memory shared across processes
+    syscall(SYS_futex, addr, FUTEX_WAIT, value, (timeoutNs == 0) ? NULL : &ts, NULL, 0);
+}
+
+static void shmFutexWake(volatile u32 * addr) {
+    syscall(SYS_futex, addr, FUTEX_WAKE, INT_MAX, NULL, NULL, 0);
+}
+
+/**
+ * @brief Sense-reversing barrier across all the ranks attached to the segment
+ */
+static void shmBarrier(ocrCommPlatformShm_t * shmComm) {
+    shmSegmentHeader_t * header = segmentHeader(shmComm);
+    u32 phase = header->barrierPhase;
+    hal_fence();
+    if (hal_xadd32(&header->barrierCount, 1) == (shmComm->nbRanks - 1)) {
+        header->barrierCount = 0;
+        hal_fence();
+        header->barrierPhase = phase + 1;
+        shmFutexWake(&header->barrierPhase);
+    } else {
+        while (header->barrierPhase == phase) {
+            shmFutexWait(&header->barrierPhase, phase, 0);
+        }
+    }
+}
+
+/**
+ * @brief Creates the segment (rank 0)
+ *
+ * A segment left behind under the same name by a job that did not tear
+ * down properly is removed first, so that the job starts from a zero-filled
+ * segment.
+ */
+static int shmCreateSegment(ocrCommPlatformShm_t * shmComm) {
+    int fd = shm_open(shmComm->segName, O_CREAT | O_EXCL | O_RDWR, S_IRUSR | S_IWUSR);
+    if ((fd == -1) && (errno == EEXIST)) {
+        DPRINTF(DEBUG_LVL_WARN, "[SHM %"PRIu32"] Removing stale shared memory segment %s\n",
+                shmComm->rank, shmComm->segName);
+        shm_unlink(shmComm->segName);
+        fd = shm_open(shmComm->segName, O_CREAT | O_EXCL | O_RDWR, S_IRUSR | S_IWUSR);
+    }
+    if (fd == -1) {
+        DPRINTF(DEBUG_LVL_WARN, "[SHM %"PRIu32"] Unable to create shared memory segment %s\n",
+                shmComm->rank, shmComm->segName);
+        ocrAssert(false);
+    }
+    RESULT_ASSERT(ftruncate(fd, (off_t) shmComm->segmentSize), ==, 0);
+    return fd;
+}
+
+/**
+ * @brief Returns whether the segment mapped by a rank other than 0 is the
+ * one rank 0 created for this job. Returns false if it is not ready yet.
+ */
+static bool shmSegmentIsCurrent(ocrCommPlatformShm_t * shmComm, int fd) {
+    shmSegmentHeader_t * header = segmentHeader(shmComm);
+    if (header->ready != SHM_SEGMENT_READY) {
+        return false;
+    }
+    hal_fence();
+    // A stale segment's creator is gone, and rank 0 replaces the segment
+    // under the same name: check that the name still refers to ours.
+    if ((kill((pid_t) header->creator, 0) == -1) && (errno == ESRCH)) {
+        return false;
+    }
+    int current = shm_open(shmComm->segName, O_RDWR, 0);
+    if (current == -1) {
+        return false;
+    }
+    struct stat mine, named;
+    bool same = (fstat(fd, &mine) == 0) && (fstat(current, &named) == 0) &&
+                (mine.st_dev == named.st_dev) && (mine.st_ino == named.st_ino);
+    close(current);
+    return same;
+}
+
+static void shmMapSegment(ocrCommPlatformShm_t * shmComm) {
+    u32 nbRanks = shmComm->nbRanks;
+    shmComm->segmentSize = (SHM_CACHE_LINE * (1 + nbRanks)) +
+                           (nbRanks * nbRanks) * (sizeof(shmRing_t) + shmComm->ringSize);
+    if (shmComm->rank == 0) {
+        int fd = shmCreateSegment(shmComm);
+        void * addr = mmap(NULL, shmComm->segmentSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        ocrAssert(addr != MAP_FAILED);
+        close(fd);
+        shmComm->segment = (u8 *) addr;
+        segmentHeader(shmComm)->creator = (s32) getpid();
+        hal_fence();
+        segmentHeader(shmComm)->ready = SHM_SEGMENT_READY;
+    } else {
+        // Wait for rank 0 to create the segment
+        while (shmComm->segment == NULL) {
+            int fd = shm_open(shmComm->segName, O_RDWR, 0);
+            struct stat st;
+            if ((fd != -1) && (fstat(fd, &st) == 0) && (((u64) st.st_size) >= shmComm->segmentSize)) {
+                void * addr = mmap(NULL, shmComm->segmentSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+                ocrAssert(addr != MAP_FAILED);
+                shmComm->segment = (u8 *) addr;
+                if (!shmSegmentIsCurrent(shmComm, fd)) {
+                    RESULT_ASSERT(munmap(addr, shmComm->segmentSize), ==, 0);
+                    shmComm->segment = NULL;
+                }
+            }
+            if (fd != -1) {
+                close(fd);
+            }
+            if (shmComm->segment == NULL) {
+                usleep(1000);
+            }
+        }
+    }
+    DPRINTF(DEBUG_LVL_VERB, "[SHM %"PRIu32"] mapped %s, %"PRIu64" bytes for %"PRIu32" ranks\n",
+            shmComm->rank, shmComm->segName, shmComm->segmentSize, nbRanks);
+}
+
+//
+// Link emulation
+//
+
+static u64 shmNow() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (((u64) ts.tv_sec) * 1000000000ULL) + ((u64) ts.tv_nsec);
+}
+
+/**
+ * @brief Returns the next jitter value, uniform in [0, jitter]
+ */
+static u64 shmNextJitter(ocrCommPlatformShm_t * shmComm) {
+    // xorshift64*
+    u64 x = shmComm->jitterState;
+    x ^= x >> 12;
+    x ^= x << 25;
+    x ^= x >> 27;
+    shmComm->jitterState = x;
+    return ((x * 2685821657736338717ULL) >> 11) % (shmComm->link.jitter + 1);
+}
+
+/**
+ * @brief Returns when a message of 'size' bytes sent at 'now' reaches 'dst'
+ *
+ * A link transfers one message at a time at its bandwidth, the message then
+ * travels for the latency plus some jitter. Jitter does not reorder the
+ * messages of a link.
+ */
+static u64 shmLinkDeliveryTime(ocrCommPlatformShm_t * shmComm, u32 dst, u64 size, u64 now) {
+    shmLinkModel_t * link = &shmComm->link;
+    u64 start = (shmComm->linkBusyUntil[dst] > now) ? shmComm->linkBusyUntil[dst] : now;
+    u64 transfer = (link->bandwidth == 0) ? 0 : ((size * 1000ULL) / link->bandwidth);
+    shmComm->linkBusyUntil[dst] = start + transfer;
+    u64 deliverAt = start + transfer + link->latency;
+    if (link->jitter != 0) {
+        deliverAt += shmNextJitter(shmComm);
+    }
+    shmPending_t * last = shmComm->pendingTail[dst];
+    if ((last != NULL) && (last->deliverAt > deliverAt)) {
+        deliverAt = last->deliverAt;
+    }
+    shmComm->delayTotal += deliverAt - now;
+    return deliverAt;
+}
+
+/**
+ * @brief Returns the earliest time a pending message can go, 0 if none waits on its link
+ */
+static u64 shmNextDelivery(ocrCommPlatformShm_t * shmComm) {
+    u64 next = 0;
+    u32 dst;
+    for (dst = 0; dst < shmComm->nbRanks; dst++) {
+        shmPending_t * pending = shmComm->pendingHead[dst];
+        if ((pending != NULL) && (pending->sent == 0) &&
+            ((next == 0) || (pending->deliverAt < next))) {
+            next = pending->deliverAt;
+        }
+    }
+    return next;
+}
+
+//
+// Rings
+//
+
+static void ringCopyIn(ocrCommPlatformShm_t * shmComm, shmRing_t * ring, u64 pos, u8 * src, u64 size) {
+    u64 offset = pos & (shmComm->ringSize - 1);
+    u64 first = ((shmComm->ringSize - offset) < size) ? (shmComm->ringSize - offset) : size;
+    hal_memCopy(ringData(ring) + offset, src, first, false);
+    if (first < size) {
+        hal_memCopy(ringData(ring), src + first, size - first, false);
+    }
+}
+
+static void ringCopyOut(ocrCommPlatformShm_t * shmComm, shmRing_t * ring, u64 pos, u8 * dst, u64 size) {
+    u64 offset = pos & (shmComm->ringSize - 1);
+    u64 first = ((shmComm->ringSize - offset) < size) ? (shmComm->ringSize - offset) : size;
+    hal_memCopy(dst, ringData(ring) + offset, first, false);
+    if (first < size) {
+        hal_memCopy(dst + first, ringData(ring), size - first, false);
+    }
+}
+
+static void ringDoorbell(ocrCommPlatformShm_t * shmComm, u32 dst) {
+    shmDoorbell_t * bell = doorbellOf(shmComm, dst);
+    hal_xadd32(&bell->doorbell, 1);
+    hal_fence();
+    if (bell->sleeping) {
+        shmFutexWake(&bell->doorbell);
+    }
+}
+
+/**
+ * @brief Write as much as possible of 'msg' in the ring to 'dst'
+ *
+ * Never blocks. '*sent' is updated with the number of bytes written so far.
+ * @return true if the message has been fully written
+ */
+static bool shmWrite(ocrCommPlatformShm_t * shmComm, u32 dst, ocrPolicyMsg_t * msg, u64 size, u64 * sent) {
+    shmRing_t * ring = ringOf(shmComm, shmComm->rank, dst);
+    bool written = false;
+    while (*sent < size) {
+        u64 tail = ring->tail;
+        u64 avail = shmComm->ringSize - (tail - ring->head);
+        if (avail < (sizeof(shmChunkHeader_t) + sizeof(u64))) {
+            break;
+        }
+        u64 chunkSize = (avail - sizeof(shmChunkHeader_t)) & ~7ULL;
+        if (chunkSize > (size - *sent)) {
+            chunkSize = size - *sent;
+        }
+        shmChunkHeader_t chunk;
+        chunk.msgSize = size;
+        chunk.chunkSize = chunkSize;
+        ringCopyIn(shmComm, ring, tail, (u8 *) &chunk, sizeof(shmChunkHeader_t));
+        ringCopyIn(shmComm, ring, tail + sizeof(shmChunkHeader_t), ((u8 *) msg) + *sent, chunkSize);
+        // Publish the chunk once its content is visible
+        hal_fence();
+        ring->tail = tail + sizeof(shmChunkHeader_t) + SHM_ALIGN(chunkSize);
+        *sent += chunkSize;
+        written = true;
+    }
+    if (written) {
+        ringDoorbell(shmComm, dst);
+    }
+    return (*sent == size);
+}
+
+/**
+ * @brief Write pending messages, in order, for each destination
+ */
+static void shmProgressSends(ocrCommPlatformShm_t * shmComm) {
+    ocrPolicyDomain_t * pd = shmComm->base.pd;
+    u64 now = ((shmComm->linkEmulation) && (shmComm->pendingCount != 0)) ? shmNow() : 0;
+    u32 dst;
+    for (dst = 0; (dst < shmComm->nbRanks) && (shmComm->pendingCount != 0); dst++) {
+        shmPending_t * pending = shmComm->pendingHead[dst];
+        while (pending != NULL) {
+            if (pending->deliverAt > now) {
+                // Still travelling on the emulated link
+                break;
+            }
+            if (!shmWrite(shmComm, dst, pending->msg, pending->size, &pending->sent)) {
+                break;
+            }
+            shmComm->pendingHead[dst] = pending->next;
+            if (pending->freeMsg) {
+                pd->fcts.pdFree(pd, pending->msg);
+            }
+            pd->fcts.pdFree(pd, pending);
+            shmComm->pendingCount--;
+            pending = shmComm->pendingHead[dst];
+        }
+        if (pending == NULL) {
+            shmComm->pendingTail[dst] = NULL;
+        }
+    }
+}
+
+static void finalizeIncoming(ocrCommPlatform_t *self, ocrPolicyMsg_t * msg, u64 count) {
+    // The message header has just been overwritten
+    msg->usefulSize = count;
+    msg->bufferSize = count;
+    ocrAssert(((msg->type & (PD_MSG_REQUEST | PD_MSG_RESPONSE)) != (PD_MSG_REQUEST | PD_MSG_RESPONSE)) &&
+              ((msg->type & PD_MSG_REQUEST) || (msg->type & PD_MSG_RESPONSE)));
+    u64 baseSize = 0, marshalledSize = 0;
+    ocrPolicyMsgGetMsgSize(msg, &baseSize, &marshalledSize, MARSHALL_DBPTR | MARSHALL_NSADDR);
+    ocrAssert((baseSize+marshalledSize) == count);
+    ocrPolicyMsgUnMarshallMsg((u8*)msg, NULL, msg,
+                              MARSHALL_APPEND | MARSHALL_NSADDR | MARSHALL_DBPTR);
+}
+
+/**
+ * @brief Consume the chunks available in the ring from 'src'
+ * @return POLL_MORE_MESSAGE if a message has been completed
+ */
+static u8 shmRead(ocrCommPlatformShm_t * shmComm, u32 src, ocrPolicyMsg_t ** msg) {
+    shmRing_t * ring = ringOf(shmComm, src, shmComm->rank);
+    shmIncoming_t * incoming = &shmComm->incoming[src];
+    while (true) {
+        u64 head = ring->head;
+        if (ring->tail == head) {
+            return POLL_NO_MESSAGE;
+        }
+        // Do not read the chunk before having seen it published
+        hal_fence();
+        shmChunkHeader_t chunk;
+        ringCopyOut(shmComm, ring, head, (u8 *) &chunk, sizeof(shmChunkHeader_t));
+        if (incoming->msg == NULL) {
+            incoming->msg = allocateNewMessage((ocrCommPlatform_t *) shmComm, chunk.msgSize);
+            incoming->size = chunk.msgSize;
+            incoming->received = 0;
+        }
+        ocrAssert((chunk.msgSize == incoming->size) && ((incoming->received + chunk.chunkSize) <= incoming->size));
+        ringCopyOut(shmComm, ring, head + sizeof(shmChunkHeader_t),
+                    ((u8 *) incoming->msg) + incoming->received, chunk.chunkSize);
+        incoming->received += chunk.chunkSize;
+        // Give the space back once the chunk has been copied out
+        hal_fence();
+        ring->head = head + sizeof(shmChunkHeader_t) + SHM_ALIGN(chunk.chunkSize);
+        if (incoming->received == incoming->size) {
+            *msg = incoming->msg;
+            incoming->msg = NULL;
+            finalizeIncoming((ocrCommPlatform_t *) shmComm, *msg, incoming->size);
+            return POLL_MORE_MESSAGE;
+        }
+    }
+}
+
+//
+// Comm life-cycle functions
+//
+
+static u8 ShmCommSendMessage(ocrCommPlatform_t * self,
+                             ocrLocation_t target, ocrPolicyMsg_t * message,
+                             u64 *id, u32 properties, u32 mask) {
+    ocrCommPlatformShm_t * shmComm = ((ocrCommPlatformShm_t *) self);
+    ocrPolicyDomain_t * pd = self->pd;
+    u64 bufferSize = message->bufferSize;
+
+    u64 baseSize = 0, marshalledSize = 0;
+    ocrPolicyMsgGetMsgSize(message, &baseSize, &marshalledSize, MARSHALL_DBPTR | MARSHALL_NSADDR);
+    u64 fullMsgSize = baseSize + marshalledSize;
+
+    //BUG #602 multi-comm-worker: msgId incr only works if a single comm-worker per rank
+    u64 shmId = shmComm->msgId++;
+
+    // If we're sending a request, set the message's msgId to this communication id
+    if (message->type & PD_MSG_REQUEST) {
+        message->msgId = shmId;
+    } else {
+        // For response in ASYNC set the message ID as any.
+        ocrAssert(message->type & PD_MSG_RESPONSE);
+        if (properties & ASYNC_MSG_PROP) {
+            message->msgId = SEND_ANY_ID;
+        }
+        // else, for regular responses, just keep the original
+        // message's msgId the calling PD is waiting on.
+    }
+
+    // One-way messages are heap-allocated copies owned by the comm-platform.
+    // The request of a two-way belongs to the caller, the response is always
+    // received in a new message.
+    bool freeMsg = (!(properties & TWOWAY_MSG_PROP) || (properties & ASYNC_MSG_PROP));
+    ocrPolicyMsg_t * messageBuffer = message;
+    if ((fullMsgSize > bufferSize) || !(properties & PERSIST_MSG_PROP)) {
+        ocrAssert((properties & PERSIST_MSG_PROP) && "not used in current implementation (hence not tested)");
+        // Allocate message and marshall a copy
+        messageBuffer = allocateNewMessage(self, fullMsgSize);
+        ocrPolicyMsgMarshallMsg(message, baseSize, (u8*)messageBuffer,
+            MARSHALL_FULL_COPY | MARSHALL_DBPTR | MARSHALL_NSADDR);
+        if (freeMsg) {
+            pd->fcts.pdFree(pd, message);
+            message = NULL; // to catch misuses later in this function call
+        }
+        freeMsg = true;
+    } else {
+        ocrMarshallMode_t marshallMode = (ocrMarshallMode_t) GET_PROP_U8_MARSHALL(properties);
+        if (marshallMode == 0) {
+            // Marshall the message. We made sure we had enough space.
+            ocrPolicyMsgMarshallMsg(messageBuffer, baseSize, (u8*)messageBuffer,
+                                    MARSHALL_APPEND | MARSHALL_DBPTR | MARSHALL_NSADDR);
+        } else {
+            ocrAssert(marshallMode == MARSHALL_FULL_COPY);
+        }
+    }
+
+    // Warning: From now on, exclusively use 'messageBuffer' instead of 'message'
+    ocrAssert(fullMsgSize == messageBuffer->usefulSize);
+    u32 dst = (u32) target;
+    ocrAssert((dst < shmComm->nbRanks) && (dst != shmComm->rank));
+    ocrAssert((messageBuffer->srcLocation == pd->myLocation) &&
+              (messageBuffer->destLocation == target));
+    DPRINTF(DEBUG_LVL_VVERB, "[SHM %"PRIu32"] send msgId=%"PRIu64" type=%"PRIx32" size=%"PRIu64" to %"PRIu32"\n",
+            shmComm->rank, messageBuffer->msgId, messageBuffer->type, fullMsgSize, dst);
+    shmComm->sendCount++;
+    shmComm->sendBytes += fullMsgSize;
+
+    // Messages to a destination are written in order, never block on a full ring.
+    // With link emulation, messages always wait for their delivery time.
+    u64 sent = 0;
+    u64 deliverAt = 0;
+    if (shmComm->linkEmulation) {
+        deliverAt = shmLinkDeliveryTime(shmComm, dst, fullMsgSize, shmNow());
+    }
+    if ((deliverAt == 0) && (shmComm->pendingHead[dst] == NULL) &&
+        shmWrite(shmComm, dst, messageBuffer, fullMsgSize, &sent)) {
+        if (freeMsg) {
+            pd->fcts.pdFree(pd, messageBuffer);
+        }
+    } else {
+        if (deliverAt == 0) {
+            shmComm->ringFullCount++;
+        }
+        shmPending_t * pending = (shmPending_t *) pd->fcts.pdMalloc(pd, sizeof(shmPending_t));
+        pending->msg = messageBuffer;
+        pending->size = fullMsgSize;
+        pending->sent = sent;
+        pending->deliverAt = deliverAt;
+        pending->freeMsg = freeMsg;
+        pending->next = NULL;
+        if (shmComm->pendingTail[dst] == NULL) {
+            shmComm->pendingHead[dst] = pending;
+        } else {
+            shmComm->pendingTail[dst]->next = pending;
+        }
+        shmComm->pendingTail[dst] = pending;
+        shmComm->pendingCount++;
+    }
+    *id = shmId;
+    return 0;
+}
+
+static u8 ShmCommPollMessage(ocrCommPlatform_t *self, ocrPolicyMsg_t **msg,
+                             u32 properties, u32 *mask) {
+    ocrCommPlatformShm_t * shmComm = ((ocrCommPlatformShm_t *) self);
+    ocrAssert(msg != NULL);
+    ocrAssert((*msg == NULL) && "SHM comm-layer cannot poll for a specific message");
+
+    shmProgressSends(shmComm);
+
+    // Round-robin on sources so that a busy rank cannot starve the others
+    u32 nbRanks = shmComm->nbRanks;
+    u32 i;
+    bool partial = false;
+    for (i = 0; i < nbRanks; i++) {
+        u32 src = (shmComm->nextSource + i) % nbRanks;
+        if (src == shmComm->rank) {
+            continue;
+        }
+        if (shmRead(shmComm, src, msg) == POLL_MORE_MESSAGE) {
+            shmComm->nextSource = (src + 1) % nbRanks;
+            DPRINTF(DEBUG_LVL_VVERB, "[SHM %"PRIu32"] received msgId=%"PRIu64" type=%"PRIx32" from %"PRIu32"\n",
+                    shmComm->rank, (*msg)->msgId, (*msg)->type, src);
+            return POLL_MORE_MESSAGE;
+        }
+        partial |= (shmComm->incoming[src].msg != NULL);
+    }
+
+    // Nothing came in: let the workers of this PD, or the other PDs when
+    // the node is oversubscribed, make progress
+    hal_pause();
+    u8 retCode = POLL_NO_MESSAGE;
+    retCode |= (shmComm->pendingCount == 0) ? POLL_NO_OUTGOING_MESSAGE : 0;
+    retCode |= partial ? 0 : POLL_NO_INCOMING_MESSAGE;
+    return retCode;
+}
+
+static u8 ShmCommWaitMessage(ocrCommPlatform_t *self, ocrPolicyMsg_t **msg,
+                             u32 properties, u32 *mask) {
+    ocrCommPlatformShm_t * shmComm = ((ocrCommPlatformShm_t *) self);
+    shmDoorbell_t * bell = doorbellOf(shmComm, shmComm->rank);
+    u8 ret = 0;
+    while (true) {
+        u32 value = bell->doorbell;
+        hal_fence();
+        ret = self->fcts.pollMessage(self, msg, properties, mask);
+        if (ret == POLL_MORE_MESSAGE) {
+            break;
+        }
+        // Producers check 'sleeping' after bumping the doorbell. The timeout
+        // bounds the delay of our own pending outgoing messages.
+        u64 timeout = SHM_WAIT_TIMEOUT;
+        if (shmComm->linkEmulation && (shmComm->pendingCount != 0)) {
+            u64 next = shmNextDelivery(shmComm);
+            u64 now = shmNow();
+            if (next != 0) {
+                timeout = (next <= now) ? 1 : (((next - now) < timeout) ? (next - now) : timeout);
+            }
+        }
+        bell->sleeping = 1;
+        hal_fence();
+        if (bell->doorbell == value) {
+            shmFutexWait(&bell->doorbell, value, timeout);
+        }
+        bell->sleeping = 0;
+    }
+    return ret;
+}
+
+static u8 ShmCommSwitchRunlevel(ocrCommPlatform_t *self, ocrPolicyDomain_t *PD, ocrRunlevel_t runlevel,
+                                phase_t phase, u32 properties, void (*callback)(ocrPolicyDomain_t*, u64), u64 val) {
+    ocrCommPlatformShm_t * shmComm = ((ocrCommPlatformShm_t *) self);
+    u8 toReturn = 0;
+    // Verify properties for this call
+    ocrAssert((properties & RL_REQUEST) && !(properties & RL_RESPONSE)
+           && !(properties & RL_RELEASE));
+    ocrAssert(!(properties & RL_FROM_MSG));
+
+    switch(runlevel) {
+    case RL_CONFIG_PARSE:
+    case RL_NETWORK_OK:
+        // Nothing
+        break;
+    case RL_PD_OK:
+        if ((properties & RL_BRING_UP) && RL_IS_FIRST_PHASE_UP(PD, RL_PD_OK, phase)) {
+            //Initialize base
+            self->pd = PD;
+            shmDiscoverRank(shmComm);
+            // Each rank draws its own reproducible jitter sequence
+            shmComm->jitterState = (shmComm->link.seed * 0x9E3779B97F4A7C15ULL) ^ (shmComm->rank + 1);
+            if (shmComm->jitterState == 0) {
+                shmComm->jitterState = 1;
+            }
+            DPRINTF(DEBUG_LVL_VERB,"[SHM %"PRIu32"] comm-platform starts\n", shmComm->rank);
+            PD->myLocation = (ocrLocation_t) shmComm->rank;
+        }
+        break;
+    case RL_MEMORY_OK:
+        // Nothing to do
+        break;
+    case RL_GUID_OK:
+        ocrAssert(self->pd == PD);
+        if((properties & RL_BRING_UP) && RL_IS_LAST_PHASE_UP(self->pd, RL_GUID_OK, phase)) {
+            u32 nbRanks = shmComm->nbRanks;
+            shmComm->pendingHead = (shmPending_t **) PD->fcts.pdMalloc(PD, sizeof(shmPending_t *) * nbRanks);
+            shmComm->pendingTail = (shmPending_t **) PD->fcts.pdMalloc(PD, sizeof(shmPending_t *) * nbRanks);
+            shmComm->incoming = (shmIncoming_t *) PD->fcts.pdMalloc(PD, sizeof(shmIncoming_t) * nbRanks);
+            u32 k;
+            for (k = 0; k < nbRanks; k++) {
+                shmComm->pendingHead[k] = NULL;
+                shmComm->pendingTail[k] = NULL;
+                shmComm->incoming[k].msg = NULL;
+            }
+            if (shmComm->linkEmulation) {
+                shmComm->linkBusyUntil = (u64 *) PD->fcts.pdMalloc(PD, sizeof(u64) * nbRanks);
+                for (k = 0; k < nbRanks; k++) {
+                    shmComm->linkBusyUntil[k] = 0;
+                }
+                DPRINTF(DEBUG_LVL_VERB, "[SHM %"PRIu32"] emulating links: latency %"PRIu64" ns, jitter %"PRIu64" ns, bandwidth %"PRIu64" MB/s\n",
+                        shmComm->rank, shmComm->link.latency, shmComm->link.jitter, shmComm->link.bandwidth);
+            }
+            shmComm->pendingCount = 0;
+            shmMapSegment(shmComm);
+            // Generate the list of known neighbors (All-to-all)
+            //BUG #606 Neighbor registration: neighbor information should come from discovery or topology description
+            PD->neighborCount = nbRanks - 1;
+            PD->neighbors = PD->fcts.pdMalloc(PD, sizeof(ocrLocation_t) * PD->neighborCount);
+            for (k = 0; k < (nbRanks-1); k++) {
+                PD->neighbors[k] = (ocrLocation_t) ((shmComm->rank+k+1)%nbRanks);
+            }
+            // Runlevel barrier across policy-domains. Everybody has mapped
+            // the segment past this point, remove its name from the system.
+            shmBarrier(shmComm);
+            if (shmComm->rank == 0) {
+                shm_unlink(shmComm->segName);
+            }
+        }
+        if ((properties & RL_TEAR_DOWN) && RL_IS_FIRST_PHASE_DOWN(self->pd, RL_GUID_OK, phase)) {
+            // There might still be one-way messages that are 'sticking out'
+            // of the EDT that called shutdown
+            u32 k;
+            for (k = 0; k < shmComm->nbRanks; k++) {
+                shmPending_t * pending = shmComm->pendingHead[k];
+                while (pending != NULL) {
+                    shmPending_t * next = pending->next;
+#ifdef OCR_ASSERT
+                    DPRINTF(DEBUG_LVL_WARN, "Shutdown: message of type %"PRIx32" has not been drained\n",
+                            (u32) (pending->msg->type & PD_MSG_TYPE_ONLY));
+#endif
+                    if (pending->freeMsg) {
+                        PD->fcts.pdFree(PD, pending->msg);
+                    }
+                    PD->fcts.pdFree(PD, pending);
+                    pending = next;
+                }
+                if (shmComm->incoming[k].msg != NULL) {
+                    PD->fcts.pdFree(PD, shmComm->incoming[k].msg);
+                }
+            }
+            shmComm->pendingCount = 0;
+            DPRINTF(DEBUG_LVL_INFO, "[SHM %"PRIu32"] sent %"PRIu64" messages, %"PRIu64" bytes, %"PRIu64" found their ring full\n",
+                    shmComm->rank, shmComm->sendCount, shmComm->sendBytes, shmComm->ringFullCount);
+            if (shmComm->linkEmulation) {
+                DPRINTF(DEBUG_LVL_INFO, "[SHM %"PRIu32"] link emulation delayed messages by %"PRIu64" ns in total\n",
+                        shmComm->rank, shmComm->delayTotal);
+                PD->fcts.pdFree(PD, shmComm->linkBusyUntil);
+                shmComm->linkBusyUntil = NULL;
+            }
+            PD->fcts.pdFree(PD, shmComm->pendingHead);
+            PD->fcts.pdFree(PD, shmComm->pendingTail);
+            PD->fcts.pdFree(PD, shmComm->incoming);
+            shmComm->pendingHead = NULL;
+            shmComm->pendingTail = NULL;
+            shmComm->incoming = NULL;
+            RESULT_ASSERT(munmap(shmComm->segment, shmComm->segmentSize), ==, 0);
+            shmComm->segment = NULL;
+            PD->fcts.pdFree(PD, PD->neighbors);
+            PD->neighbors = NULL;
+        }
+        break;
+    case RL_COMPUTE_OK:
+    case RL_USER_OK:
+        // Messages sent to a PD that has not reached this runlevel yet
+        // wait in the rings until its communication worker starts.
+        break;
+    default:
+        // Unknown runlevel
+        ocrAssert(0);
+    }
+    return toReturn;
+}
+
+//
+// Init and destruct
+//
+
+static void ShmCommDestruct(ocrCommPlatform_t * self) {
+    runtimeChunkFree((u64)self, PERSISTENT_CHUNK);
+}
+
+ocrCommPlatform_t* newCommPlatformShm(ocrCommPlatformFactory_t *factory,
+                                      ocrParamList_t *perInstance) {
+    ocrCommPlatformShm_t * commPlatformShm = (ocrCommPlatformShm_t*)
+        runtimeChunkAlloc(sizeof(ocrCommPlatformShm_t), PERSISTENT_CHUNK);
+    commPlatformShm->base.location = ((paramListCommPlatformInst_t *)perInstance)->location;
+    commPlatformShm->base.fcts = factory->platformFcts;
+    factory->initialize(factory, (ocrCommPlatform_t *) commPlatformShm, perInstance);
+    return (ocrCommPlatform_t*) commPlatformShm;
+}
+
+
+/******************************************************/
+/* SHM COMM-PLATFORM FACTORY                          */
+/******************************************************/
+
+static void destructCommPlatformFactoryShm(ocrCommPlatformFactory_t *factory) {
+    runtimeChunkFree((u64)factory, NONPERSISTENT_CHUNK);
+}
+
+static void initializeCommPlatformShm(ocrCommPlatformFactory_t * factory, ocrCommPlatform_t * base, ocrParamList_t * perInstance) {
+    initializeCommPlatformOcr(factory, base, perInstance);
+    ocrCommPlatformShm_t * shmComm = (ocrCommPlatformShm_t*) base;
+    shmComm->msgId = 1; // all async responses use id '0'
+    shmComm->ringSize = ((ocrCommPlatformFactoryShm_t *) factory)->ringSize;
+    shmComm->rank = 0;
+    shmComm->nbRanks = 1;
+    shmComm->segName[0] = '\0';
+    shmComm->segment = NULL;
+    shmComm->segmentSize = 0;
+    shmComm->pendingHead = NULL;
+    shmComm->pendingTail = NULL;
+    shmComm->pendingCount = 0;
+    shmComm->incoming = NULL;
+    shmComm->nextSource = 0;
+    shmComm->link = ((ocrCommPlatformFactoryShm_t *) factory)->link;
+    shmComm->linkEmulation = ((shmComm->link.latency | shmComm->link.jitter | shmComm->link.bandwidth) != 0);
+    shmComm->linkBusyUntil = NULL;
+    shmComm->jitterState = 1;
+    shmComm->sendCount = 0;
+    shmComm->sendBytes = 0;
+    shmComm->ringFullCount = 0;
+    shmComm->delayTotal = 0;
+}
+
+ocrCommPlatformFactory_t *newCommPlatformFactoryShm(ocrParamList_t *perType) {
+    ocrCommPlatformFactory_t *base = (ocrCommPlatformFactory_t*)
+        runtimeChunkAlloc(sizeof(ocrCommPlatformFactoryShm_t), NONPERSISTENT_CHUNK);
+    base->instantiate = &newCommPlatformShm;
+    base->initialize = &initializeCommPlatformShm;
+    base->destruct = FUNC_ADDR(void (*)(ocrCommPlatformFactory_t*), destructCommPlatformFactoryShm);
+    // Ring positions are masked: round the size up to a power of two
+    u64 ringSize = (perType != NULL) ? ((paramListCommPlatformFactShm_t *) perType)->ringSize : SHM_RING_SZ;
+    u64 pow2 = SHM_CACHE_LINE;
+    while (pow2 < ringSize) {
+        pow2 <<= 1;
+    }
+    ((ocrCommPlatformFactoryShm_t *) base)->ringSize = pow2;
+    shmLinkModel_t * link = &((ocrCommPlatformFactoryShm_t *) base)->link;
+    if (perType != NULL) {
+        *link = ((paramListCommPlatformFactShm_t *) perType)->link;
+    } else {
+        link->latency = 0;
+        link->jitter = 0;
+        link->bandwidth = 0;
+        link->seed = 0;
+    }
+
+    base->platformFcts.destruct = FUNC_ADDR(void (*)(ocrCommPlatform_t*), ShmCommDestruct);
+    base->platformFcts.switchRunlevel = FUNC_ADDR(u8 (*)(ocrCommPlatform_t*, ocrPolicyDomain_t*, ocrRunlevel_t,
+                                                  phase_t, u32, void (*)(ocrPolicyDomain_t*,u64), u64), ShmCommSwitchRunlevel);
+    base->platformFcts.sendMessage = FUNC_ADDR(u8 (*)(ocrCommPlatform_t*,ocrLocation_t,ocrPolicyMsg_t*,u64*,u32,u32), ShmCommSendMessage);
+    base->platformFcts.pollMessage = FUNC_ADDR(u8 (*)(ocrCommPlatform_t*,ocrPolicyMsg_t**,u32,u32*), ShmCommPollMessage);
+    base->platformFcts.waitMessage = FUNC_ADDR(u8 (*)(ocrCommPlatform_t*,ocrPolicyMsg_t**,u32,u32*), ShmCommWaitMessage);
+    base->platformFcts.sendMessageMT = NULL;
+    base->platformFcts.pollMessageMT = NULL;
+    base->platformFcts.waitMessageMT = NULL;
+    return base;
+}
+
+#endif /* ENABLE_COMM_PLATFORM_SHM */
@@ -0,0 +1,101 @@
+/**
+ * @brief Shared-memory communication platform
+ *
+ * Connects policy domains running as separate processes on the same node
+ * through a POSIX shared memory segment. Each ordered pair of ranks owns a
+ * single-producer single-consumer byte ring in the segment.
+ *
+ * The links between ranks can optionally emulate a network: a message is
+ * only written in its ring once the link's latency, bandwidth and jitter
+ * allow it. The jitter is drawn from a generator seeded per rank, so a rank
+ * draws the same sequence of delays on every run. Which message gets which
+ * delay depends on the order the runtime sends them in, so the timing of a
+ * run, and the interleavings it leads to, are not reproducible.
+ **/
+
+/*
+ * This file is subject to the license agreement located in the file LICENSE
+ * and cannot be distributed without it. This notice cannot be
+ * removed or modified.
+ */
+#ifndef __SHM_COMM_PLATFORM_H__
+#define __SHM_COMM_PLATFORM_H__
+
+#include "ocr-config.h"
+#ifdef ENABLE_COMM_PLATFORM_SHM
+
+#include "utils/ocr-utils.h"
+#include "ocr-comm-platform.h"
+
+// Size in bytes of each ring, rounded up to a power of two. Messages larger
+// than a ring are streamed through it in chunks. Set through the 'ringsize'
+// key of the comm-platform type section.
+#ifndef SHM_RING_SZ
+#define SHM_RING_SZ (1<<18)
+#endif
+
+// Maximum time in ns waitMessage sleeps before checking outgoing messages again
+#ifndef SHM_WAIT_TIMEOUT
+#define SHM_WAIT_TIMEOUT 1000000
+#endif
+
+#define SHM_NAME_MAX 64
+
+// Link emulation parameters, set through the 'latency' (ns), 'jitter' (ns),
+// 'bandwidth' (MB/s, 0 for unlimited) and 'seed' keys of the comm-platform
+// type section. All zero disables the emulation.
+typedef struct {
+    u64 latency;        // Fixed delay added to each message
+    u64 jitter;         // Upper bound of a random delay added to each message
+    u64 bandwidth;      // Link bandwidth in MB/s, serializes messages on a link
+    u64 seed;           // Seed of the jitter generator
+} shmLinkModel_t;
+
+struct _shmPending_t;
+struct _shmIncoming_t;
+
+typedef struct {
+    ocrCommPlatformFactory_t base;
+    u64 ringSize;
+    shmLinkModel_t link;
+} ocrCommPlatformFactoryShm_t;
+
+typedef struct {
+    ocrCommPlatform_t base;
+    u64 msgId;
+    u64 ringSize;
+    u32 rank;
+    u32 nbRanks;
+    char segName[SHM_NAME_MAX];
+    u8 * segment;                        // Mapped shared memory segment
+    u64 segmentSize;
+    struct _shmPending_t ** pendingHead; // Per destination, messages not fully written yet
+    struct _shmPending_t ** pendingTail;
+    u32 pendingCount;
+    struct _shmIncoming_t * incoming;    // Per source, message being reassembled
+    u32 nextSource;                      // Round-robin start for incoming rings
+    bool linkEmulation;                  // Whether 'link' delays messages
+    shmLinkModel_t link;
+    u64 * linkBusyUntil;                 // Per destination, end of the last transfer on the link
+    u64 jitterState;                     // Jitter generator state
+    // Statistics, reported at tear-down
+    u64 sendCount;      // Number of messages sent
+    u64 sendBytes;      // Bytes sent
+    u64 ringFullCount;  // Number of times a message could not be fully written
+    u64 delayTotal;     // Sum of the delays injected by the link emulation, in ns
+} ocrCommPlatformShm_t;
+
+typedef struct {
+    paramListCommPlatformFact_t base;
+    u64 ringSize;
+    shmLinkModel_t link;
+} paramListCommPlatformFactShm_t;
+
+typedef struct {
+    paramListCommPlatformInst_t base;
+} paramListCommPlatformShm_t;
+
+extern ocrCommPlatformFactory_t* newCommPlatformFactoryShm(ocrParamList_t *perType);
+
+#endif /* ENABLE_COMM_PLATFORM_SHM */
+#endif /* __SHM_COMM_PLATFORM_H__ */
@@ -13,6 +13,9 @@ const char * dataBlock_types [] = {
 #endif
 #ifdef ENABLE_DATABLOCK_LOCKABLE
     "Lockable",
+#endif
+#ifdef ENABLE_DATABLOCK_SINGLE_ASSIGN
+    "SingleAssign",
 #endif
     NULL
 };
@@ -28,6 +31,11 @@ ocrDataBlockFactory_t* newDataBlockFactory(dataBlockType_t type, ocrParamList_t
     case dataBlockLockable_id:
         return newDataBlockFactoryLockable(typeArg, typeArg->id);
         break;
+#endif
+#ifdef ENABLE_DATABLOCK_SINGLE_ASSIGN
+    case dataBlockSingleAssign_id:
+        return newDataBlockFactorySingleAssign(typeArg, typeArg->id);
+        break;
 #endif
     default:
         ocrAssert(0);
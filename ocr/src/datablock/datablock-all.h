@@ -22,6 +22,9 @@ typedef enum _dataBlockType_t {
 #endif
 #ifdef ENABLE_DATABLOCK_LOCKABLE
     dataBlockLockable_id,
+#endif
+#ifdef ENABLE_DATABLOCK_SINGLE_ASSIGN
+    dataBlockSingleAssign_id,
 #endif
     dataBlockMax_id
 } dataBlockType_t;
@@ -34,6 +37,9 @@ extern const char * dataBlock_types[];
 #ifdef ENABLE_DATABLOCK_LOCKABLE
 #include "datablock/lockable/lockable-datablock.h"
 #endif
+#ifdef ENABLE_DATABLOCK_SINGLE_ASSIGN
+#include "datablock/single-assign/single-assign-datablock.h"
+#endif
 
 ocrDataBlockFactory_t* newDataBlockFactory(dataBlockType_t type, ocrParamList_t *typeArg);
 
@@ -34,6 +34,11 @@
 #include "ocr-statistics-callbacks.h"
 #endif
 
+#ifdef DB_STATS_LOCKABLE
+#include "ocr-sal.h"
+#include <stdio.h>
+#endif
+
 #define DEBUG_TYPE DATABLOCK
 
 #define DEBUG_LVL_BUG DEBUG_LVL_INFO
@@ -49,6 +54,8 @@
 
 // Macros that can be defined:
 // - LOCKABLE_RELEASE_ASYNC: Experimental for asynchronous release
+// - DB_STATS_LOCKABLE: Per DB access statistics, aggregated per creating
+//   EDT template and dumped in 'DbStatsNode<location>' at shutdown
 
 #define DFLT_PEND_MSG_Q_SIZE 4
 
@@ -62,6 +69,12 @@
 #define DB_RW    1    //01
 #define DB_RO    0    //00
 
+#ifdef ENABLE_EXTENSION_DB_PARTITION
+#define IS_PARTITION(rself) ((rself)->parent != NULL)
+#else
+#define IS_PARTITION(rself) false
+#endif
+
 // DB internal state
 // - isPrime: true if the MD is the current authority (R/W modes)
 // - isActive: true if the MD is not prime but has a pointer to live DB ptr (R mode)
@@ -83,8 +96,8 @@
 #define M_DATA            0x8
 #define M_DEL             0x10
 #define M_SATISFY         0x20
-#ifdef ENABLE_LAZY_DB
-// Notify a slave lazy MD copy it is invalidated
+#if defined(ENABLE_LAZY_DB) || defined(ENABLE_DB_REPLICA_CACHE)
+// Notify a slave lazy MD copy or a read-only replica it is invalidated
 #define M_INVALIDATE      0x40
 #endif
 
@@ -140,10 +153,13 @@ typedef struct _md_pull_acquire_t {
 typedef struct _md_push_acquire_t {
     u8 dbMode;
     bool writeBack;
+#ifdef ENABLE_EXTENSION_DB_DIRTY_RANGE
+    u16 dirtyCount; // Release only: number of ranges written back, zero for the whole DB
+#endif
     char * dbPtr; //TODO-MD-PACK
 } md_push_acquire_t;
 
-#ifdef ENABLE_LAZY_DB
+#if defined(ENABLE_LAZY_DB) || defined(ENABLE_DB_REPLICA_CACHE)
 typedef struct _md_push_invalidate_t {
     // If dest is invalid this is just a notification else we must fwd to destination
     ocrLocation_t dest; //TODO-LAZY: Limitation: single destination for now
@@ -160,6 +176,10 @@ typedef struct _md_push_clone_t {
     u64 size;
     u32 flags;
     bool isEager;
+#ifdef DB_STATS_LOCKABLE
+    ocrGuid_t creatorTemplate;
+    u64 creatorFunc;
+#endif
     storage_t storage;
 } md_push_clone_t;
 
@@ -208,6 +228,9 @@ typedef struct _dbWaiter_t {
     u32 slot;
     u32 properties; // properties specified with the acquire request
     bool isInternal;
+#ifdef DB_STATS_LOCKABLE
+    u64 waitStart;
+#endif
     struct _dbWaiter_t * next;
 } dbWaiter_t;
 
@@ -220,6 +243,9 @@ static void enqueueLocalAcquire(ocrPolicyDomain_t * pd, ocrFatGuid_t dstGuid, oc
     waiterEntry->slot = dstSlot;
     waiterEntry->isInternal = isInternal;
     waiterEntry->properties = properties;
+#ifdef DB_STATS_LOCKABLE
+    waiterEntry->waitStart = salGetTime();
+#endif
     waiterEntry->next = *queue;
     *queue = waiterEntry;
 }
@@ -275,6 +301,106 @@ static void lowLevelRelease(ocrDataBlock_t *self, ocrDataBlockLockableAttr_t * a
 static u8 lockableMdSize(ocrObject_t * dest, u64 mode, u64 * size);
 
 
+#ifdef ENABLE_EXTENSION_DB_DIRTY_RANGE
+#define DB_DIRTY_ALL ((u32) -1)
+
+// Record [start, end) in the sorted list of disjoint dirty ranges,
+// merging it with the ranges it overlaps or is adjacent to.
+static void addDirtyRange(ocrDataBlockLockable_t * rself, u64 start, u64 end) {
+    u32 count = rself->dirtyCount;
+    if (count == DB_DIRTY_ALL) {
+        return;
+    }
+    u64 * ranges = rself->dirtyRanges;
+    u32 i = 0;
+    while ((i < count) && (ranges[2*i+1] < start)) {
+        i++;
+    }
+    u32 j = i;
+    while ((j < count) && (ranges[2*j] <= end)) {
+        start = (ranges[2*j] < start) ? ranges[2*j] : start;
+        end = (ranges[2*j+1] > end) ? ranges[2*j+1] : end;
+        j++;
+    }
+    u32 k;
+    if (j == i) {
+        if (count == DB_MAX_DIRTY_RANGES) {
+            rself->dirtyCount = DB_DIRTY_ALL;
+            return;
+        }
+        for (k = count; k > i; k--) {
+            ranges[2*k] = ranges[2*(k-1)];
+            ranges[2*k+1] = ranges[2*(k-1)+1];
+        }
+        count++;
+    } else {
+        u32 shift = j - i - 1;
+        for (k = i + 1; (k + shift) < count; k++) {
+            ranges[2*k] = ranges[2*(k+shift)];
+            ranges[2*k+1] = ranges[2*(k+shift)+1];
+        }
+        count -= shift;
+    }
+    ranges[2*i] = start;
+    ranges[2*i+1] = end;
+    rself->dirtyCount = count;
+}
+
+// Compact the dirty ranges of 'data' at its beginning followed by their
+// descriptors and reset the tracking. Returns the size of the packed data
+// or zero if the whole DB must be written back.
+static u64 packDirtyRanges(ocrDataBlockLockable_t * rself, char * data, u16 * packedCount) {
+    u32 count = rself->dirtyCount;
+    rself->dirtyCount = 0;
+    *packedCount = 0;
+    if ((count == 0) || (count == DB_DIRTY_ALL) || !rself->attributes.writeBack) {
+        return 0;
+    }
+    u64 * ranges = rself->dirtyRanges;
+    u64 dirtySize = 0;
+    u32 i;
+    for (i = 0; i < count; i++) {
+        dirtySize += ranges[2*i+1] - ranges[2*i];
+    }
+    u64 descOffset = (dirtySize + sizeof(u64) - 1) & ~(sizeof(u64) - 1);
+    u64 packedSize = descOffset + (sizeof(u64) * 2 * count);
+    if (packedSize >= rself->base.size) {
+        return 0;
+    }
+    // Ranges are sorted so data only ever moves toward the beginning
+    u64 cur = 0;
+    for (i = 0; i < count; i++) {
+        u64 len = ranges[2*i+1] - ranges[2*i];
+        hal_memMove(data + cur, data + ranges[2*i], len, false);
+        cur += len;
+    }
+    hal_memCopy(data + descOffset, ranges, sizeof(u64) * 2 * count, false);
+    *packedCount = (u16) count;
+    return packedSize;
+}
+
+// Patch the ranges of a delta write back into the current payload
+static void applyDirtyRanges(ocrDataBlock_t * self, md_push_release_t * mdMsg, u64 sizePayload) {
+    char * data = (char *) &(mdMsg->dbPtr);
+    u32 count = mdMsg->dirtyCount;
+    u64 descSize = sizeof(u64) * 2 * count;
+    u64 * ranges = (u64 *) (data + (sizePayload - (sizeof(md_push_release_t) - sizeof(char*)) - descSize));
+    u64 cur = 0;
+    u32 i;
+    for (i = 0; i < count; i++) {
+        u64 len = ranges[2*i+1] - ranges[2*i];
+        ocrAssert(ranges[2*i+1] <= self->size);
+        hal_memCopy(((char *) self->ptr) + ranges[2*i], data + cur, len, false);
+        cur += len;
+    }
+}
+
+#define IS_DELTA_WRITEBACK(mdMsg) ((mdMsg)->dirtyCount != 0)
+#else
+#define IS_DELTA_WRITEBACK(mdMsg) false
+#define applyDirtyRanges(self, mdMsg, sizePayload)
+#endif
+
 // Send a release message to mdPeer
 static void issueReleaseRequest(ocrDataBlock_t * self) {
     ocrDataBlockLockable_t * rself = (ocrDataBlockLockable_t*) self;
@@ -303,9 +429,20 @@ static void issueReleaseRequest(ocrDataBlock_t * self) {
         PD_MSG_FIELD_I(sizePayload) = sizePayload;
         md_push_release_t * payload = (md_push_release_t *) &PD_MSG_FIELD_I(payload);
         ocrAssert(((payload->dbMode & WR_MASK) & !(rself->attributes.flags & DB_PROP_SINGLE_ASSIGNMENT)) ? rself->attributes.writeBack : !rself->attributes.writeBack);
+#ifdef ENABLE_EXTENSION_DB_DIRTY_RANGE
+        u64 packedSize = packDirtyRanges(rself, (char *) &(payload->dbPtr), &(payload->dirtyCount));
+        if (packedSize != 0) {
+            PD_MSG_FIELD_I(sizePayload) = sizeof(md_push_release_t) - sizeof(char*) + packedSize;
+            DPRINTF(DBG_LVL_DB_MD, "db-md: delta write back "GUIDF" of %"PRIu32" ranges in %"PRIu64" bytes\n",
+                    GUIDA(self->guid), (u32) payload->dirtyCount, packedSize);
+        }
+#endif
         DPRINTF (DBG_LVL_DB_MD, "db-md: push release "GUIDF" in dbMode=%d\n", GUIDA(self->guid), payload->dbMode);
     }
     getCurrentEnv(&pd, NULL, NULL, NULL);
+#ifdef DB_STATS_LOCKABLE
+    rself->stats.counters[CNT_BYTES_SENT] += PD_MSG_FIELD_I(sizePayload);
+#endif
 
     // Fill in this call specific arguments
     ocrLocation_t destLocation = rself->mdPeers;
@@ -324,6 +461,7 @@ static void issueReleaseRequest(ocrDataBlock_t * self) {
     PD_MSG_FIELD_I(factoryId) = self->fctId;
     PD_MSG_FIELD_I(response) = NULL;
     PD_MSG_FIELD_I(mdPtr) = NULL;
+    PD_MSG_FIELD_I(extPayload) = NULL;
     // Note: here we do not serialize because we're actually reusing the original message
     // to send the release. 'lockableMdSize' takes into account the fact we're writing back
     // or not to set the appropriate message payload size.
@@ -385,6 +523,9 @@ static void issueForwardRequest(ocrDataBlock_t * self, ocrLocation_t destLocatio
             md_push_release_t * payload = (md_push_release_t *) &PD_MSG_FIELD_I(payload);
             payload->dbMode = destDbMode;
             payload->writeBack = rself->attributes.writeBack;
+#ifdef ENABLE_EXTENSION_DB_DIRTY_RANGE
+            payload->dirtyCount = 0;
+#endif
             DPRINTF(DBG_LVL_LAZY, "db-md: push release "GUIDF" in dbMode=%d\n", GUIDA(self->guid), payload->dbMode);
         } else {
             // When forwarding we must take into account whether this DB had
@@ -408,6 +549,7 @@ static void issueForwardRequest(ocrDataBlock_t * self, ocrLocation_t destLocatio
     PD_MSG_FIELD_I(factoryId) = self->fctId;
     PD_MSG_FIELD_I(response) = NULL;
     PD_MSG_FIELD_I(mdPtr) = NULL;
+    PD_MSG_FIELD_I(extPayload) = NULL;
     // Note: here we do not serialize because we're actually reusing the original message
     // to send the acquire. It will be automatically destroyed.
     // What's the implication for lazy ?
@@ -421,9 +563,13 @@ static void issueForwardRequest(ocrDataBlock_t * self, ocrLocation_t destLocatio
 #undef PD_TYPE
 }
 
+#endif /*ENABLE_LAZY_DB*/
+
+#if defined(ENABLE_LAZY_DB) || defined(ENABLE_DB_REPLICA_CACHE)
+// Sent by the master to a slave MD holding a copy of the DB
 static void issueInvalidateRequest(ocrDataBlock_t * self, ocrLocation_t srcLocation, ocrLocation_t destLocation, u8 dbMode) {
     ocrDataBlockLockable_t * rself = (ocrDataBlockLockable_t*) self;
-    ocrAssert(rself->attributes.isLazy);
+    ocrAssert(!rself->attributes.hasPeers);
     // Create a policy-domain message
     ocrPolicyDomain_t *pd = NULL;
     PD_MSG_STACK(msg);
@@ -442,6 +588,7 @@ static void issueInvalidateRequest(ocrDataBlock_t * self, ocrLocation_t srcLocat
     PD_MSG_FIELD_I(sizePayload) = sizeof(md_push_invalidate_t);
     PD_MSG_FIELD_I(response) = NULL;
     PD_MSG_FIELD_I(mdPtr) = NULL;
+    PD_MSG_FIELD_I(extPayload) = NULL;
     DPRINTF(DBG_LVL_LAZY, "db-md: push invalidate "GUIDF" in mode=%d\n", GUIDA(self->guid), dbMode);
     md_push_invalidate_t * payload = (md_push_invalidate_t *) &PD_MSG_FIELD_I(payload);
     payload->dest = srcLocation; // Who's requesting the invalidate
@@ -455,8 +602,194 @@ static void issueInvalidateRequest(ocrDataBlock_t * self, ocrLocation_t srcLocat
 #undef PD_MSG
 #undef PD_TYPE
 }
+#endif
 
-#endif /*ENABLE_LAZY_DB*/
+#if defined(ENABLE_DB_PREFETCH) && !defined(ENABLE_DB_REPLICA_CACHE)
+#error "ENABLE_DB_PREFETCH requires ENABLE_DB_REPLICA_CACHE"
+#endif
+
+#ifdef ENABLE_DB_REPLICA_CACHE
+static ocrDataBlockFactoryLockable_t * getLockableFactory(ocrDataBlock_t * self) {
+    ocrPolicyDomain_t * pd;
+    getCurrentEnv(&pd, NULL, NULL, NULL);
+    return (ocrDataBlockFactoryLockable_t *) pd->factories[self->fctId];
+}
+
+static bool hasLocalWaiters(ocrDataBlockLockable_t * rself) {
+    u32 i;
+    for (i = 0; i < DB_MODE_COUNT; i++) {
+        if (rself->localWaitQueues[i] != NULL) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static bool hasPendingWriter(ocrDataBlockLockable_t * rself) {
+    return (rself->localWaitQueues[DB_RW] != NULL) || (rself->localWaitQueues[DB_EW] != NULL) ||
+           !queueIsEmpty(rself->remoteWaitQueues[DB_RW]) || !queueIsEmpty(rself->remoteWaitQueues[DB_EW]);
+}
+
+// Replicas kept by a PD are listed from the most to the least recently
+// used. The factory's lock must be held.
+static void unlinkReplica(ocrDataBlockFactoryLockable_t * factory, ocrDataBlockLockable_t * rself) {
+    if (rself->replicaPrev != NULL) {
+        rself->replicaPrev->replicaNext = rself->replicaNext;
+    } else {
+        factory->replicaHead = rself->replicaNext;
+    }
+    if (rself->replicaNext != NULL) {
+        rself->replicaNext->replicaPrev = rself->replicaPrev;
+    } else {
+        factory->replicaTail = rself->replicaPrev;
+    }
+    rself->replicaPrev = NULL;
+    rself->replicaNext = NULL;
+}
+
+static void linkReplica(ocrDataBlockFactoryLockable_t * factory, ocrDataBlockLockable_t * rself) {
+    rself->replicaPrev = NULL;
+    rself->replicaNext = factory->replicaHead;
+    if (factory->replicaHead != NULL) {
+        factory->replicaHead->replicaPrev = rself;
+    } else {
+        factory->replicaTail = rself;
+    }
+    factory->replicaHead = rself;
+}
+
+static bool isLinkedReplica(ocrDataBlockFactoryLockable_t * factory, ocrDataBlockLockable_t * rself) {
+    return (rself->replicaPrev != NULL) || (factory->replicaHead == rself);
+}
+
+static void uncacheReplica(ocrDataBlock_t * self, ocrDataBlockLockableAttr_t * attr) {
+    if (attr->isCached) {
+        ocrDataBlockFactoryLockable_t * factory = getLockableFactory(self);
+        ocrDataBlockLockable_t * rself = (ocrDataBlockLockable_t *) self;
+        hal_lock(&(factory->replicaLock));
+        // Already unlinked when picked for eviction
+        if (isLinkedReplica(factory, rself)) {
+            unlinkReplica(factory, rself);
+        }
+        hal_unlock(&(factory->replicaLock));
+        hal_xadd64((u64 *) &(factory->replicaCacheUsed), -((s64) self->size));
+        attr->isCached = 0;
+    }
+}
+
+// Slave: called when the last local user of a read-only copy is done.
+// Returns true if the copy is kept in the replica cache instead of
+// being released to the master. The copy may put the PD over budget,
+// see evictReplicas.
+static bool cacheReplica(ocrDataBlock_t * self, ocrDataBlockLockableAttr_t * attr) {
+    ocrDataBlockLockable_t * rself = (ocrDataBlockLockable_t *) self;
+    if (attr->isInvalid || attr->freeRequested || hasLocalWaiters(rself)) {
+        attr->isInvalid = 0;
+        uncacheReplica(self, attr);
+        return false;
+    }
+    if (attr->isCached) {
+        // Most recently used now
+        ocrDataBlockFactoryLockable_t * factory = getLockableFactory(self);
+        hal_lock(&(factory->replicaLock));
+        unlinkReplica(factory, rself);
+        linkReplica(factory, rself);
+        hal_unlock(&(factory->replicaLock));
+        return true;
+    }
+    if (attr->writeBack || attr->isEager || attr->isLazy || (rself->backingPtrMsg == NULL)) {
+        return false;
+    }
+    // Copies pushed at creation (M_CLONE | M_DATA) are not backed by an acquire
+#define PD_MSG (rself->backingPtrMsg)
+#define PD_TYPE PD_MSG_METADATA_COMM
+    if (!(PD_MSG_FIELD_I(mode) & M_ACQUIRE)) {
+        return false;
+    }
+#undef PD_MSG
+#undef PD_TYPE
+    ocrDataBlockFactoryLockable_t * factory = getLockableFactory(self);
+    if ((factory->replicaCacheSize == 0) || (self->size > factory->replicaCacheSize)) {
+        return false;
+    }
+    hal_xadd64((u64 *) &(factory->replicaCacheUsed), self->size);
+    hal_lock(&(factory->replicaLock));
+    linkReplica(factory, rself);
+    hal_unlock(&(factory->replicaLock));
+    attr->isCached = 1;
+    DPRINTF(DBG_LVL_DB_MD, "db-md: cache replica "GUIDF" size=%"PRIu64"\n", GUIDA(self->guid), self->size);
+    return true;
+}
+
+// Slave: give a cached replica back to the master. The lock must be held.
+static void releaseReplica(ocrDataBlock_t * self, ocrDataBlockLockableAttr_t * attr) {
+    ocrAssert(attr->isCached && (attr->numUsers == 0));
+    DPRINTF(DBG_LVL_DB_MD, "db-md: release replica "GUIDF"\n", GUIDA(self->guid));
+    uncacheReplica(self, attr);
+    attr->state = STATE_IDLE;
+    issueReleaseRequest(self);
+}
+
+// Slave: the DB is being destroyed, the master waits for the replica
+static void releaseCachedReplica(ocrDataBlock_t * self, ocrDataBlockLockableAttr_t * attr) {
+    if (attr->isCached && (attr->numUsers == 0) && !attr->isReleasing) {
+        releaseReplica(self, attr);
+    }
+}
+
+// Slave: received an invalidation from the master
+// Returns true if the cached copy has been released.
+static bool invalidateReplica(ocrDataBlock_t * self, ocrDataBlockLockableAttr_t * attr) {
+    if (attr->isCached && (attr->numUsers == 0) && !attr->isReleasing) {
+        releaseReplica(self, attr);
+        return true;
+    } else if (attr->isFetching || (attr->state != STATE_IDLE)) {
+        // The copy is in use or on its way, release it once done with it.
+        // Invalidations may cross the grant they apply to.
+        attr->isInvalid = 1;
+    } // else the copy has already been released
+    return false;
+}
+
+// Master: true if a location holds a read-only copy it may keep in its
+// replica cache. Locations are recorded when granted a read copy and
+// forgotten when they release it. The lock must be held.
+static bool hasReplicas(ocrDataBlockLockable_t * rself) {
+    u32 i;
+    for (i = 0; i < DB_MAX_LOC_ARRAY; i++) {
+        if (rself->replicaLocs[i] != 0ULL) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Master: ask the locations that may keep a read-only replica to release
+// it if a writer is waiting for the DB. The lock must be held.
+static void invalidateReplicas(ocrDataBlock_t * self) {
+    ocrDataBlockLockable_t * rself = (ocrDataBlockLockable_t *) self;
+    if (rself->attributes.hasPeers || (rself->attributes.state != STATE_SHARED) || !hasPendingWriter(rself)) {
+        return;
+    }
+    u32 i;
+    for (i = 0; i < DB_MAX_LOC_ARRAY; i++) {
+        u64 cur = rself->replicaLocs[i];
+        u32 nbShift = 0;
+        while (cur != 0) {
+            if (cur & 1ULL) {
+                ocrLocation_t destLoc = (ocrLocation_t) ((i*64)+nbShift);
+                issueInvalidateRequest(self, INVALID_LOCATION, destLoc, DB_RO);
+            }
+            cur >>= 1;
+            nbShift++;
+        }
+    }
+}
+#else
+#define cacheReplica(self, attr) false
+#define releaseCachedReplica(self, attr)
+#define invalidateReplicas(self)
+#endif
 
 // Sends a message to mdPeers requesting acquisition of the DB in the specified mode.
 // - Flips the isFetching flag.
@@ -484,6 +817,7 @@ static void issueFetchRequest(ocrDataBlock_t * self, u8 othMode) {
     PD_MSG_FIELD_I(sizePayload) = sizeof(md_pull_acquire_t);
     PD_MSG_FIELD_I(response) = NULL;
     PD_MSG_FIELD_I(mdPtr) = NULL;
+    PD_MSG_FIELD_I(extPayload) = NULL;
     DPRINTF(DBG_LVL_DB_MD, "db-md: pull acquire "GUIDF" in mode=%d isEager=%d\n", GUIDA(self->guid), othMode, rself->attributes.isEager);    DPRINTF(DBG_LVL_DB_MD, "db-md: pull acquire "GUIDF" in mode=%d isEager=%d\n", GUIDA(self->guid), othMode, rself->attributes.isEager);    DPRINTF(DBG_LVL_DB_MD, "db-md: pull acquire "GUIDF" in mode=%d isEager=%d\n", GUIDA(self->guid), othMode, rself->attributes.isEager);
     DPRINTF(DBG_LVL_LAZY, "db-md: issueFetchRequest pull acquire "GUIDF" in mode=%d isEager=%d\n", GUIDA(self->guid), othMode, rself->attributes.isEager);    DPRINTF(DBG_LVL_DB_MD, "db-md: pull acquire "GUIDF" in mode=%d isEager=%d\n", GUIDA(self->guid), othMode, rself->attributes.isEager);    DPRINTF(DBG_LVL_DB_MD, "db-md: pull acquire "GUIDF" in mode=%d isEager=%d\n", GUIDA(self->guid), othMode, rself->attributes.isEager);
     // Create a M_ACQUIRE PULL payload
@@ -506,10 +840,21 @@ static void answerFetchRequest(ocrDataBlock_t * self, ocrLocation_t destLocation
     u64 mdSize;
     lockableMdSize((ocrObject_t *) self, mdMode, &mdSize);
     u64 msgSize = MSG_MDCOMM_SZ + mdSize;
+#ifdef ENABLE_DB_ZERO_COPY
+    // A large payload is not copied in the message: the comm-platform reads it
+    // from the DB. The DB stays put until then because the requester is a user
+    // of the DB until its release, which can only come after it got the data.
+    bool zeroCopy = (self->size >= DB_ZERO_COPY_THRESHOLD);
+    if (zeroCopy) {
+        msgSize -= self->size;
+    }
+#else
+    bool zeroCopy = false;
+#endif
     ocrPolicyMsg_t * msg;
     PD_MSG_STACK(msgStack);
     u32 msgProp = 0;
-    if (msgSize > sizeof(ocrPolicyMsg_t)) {
+    if (zeroCopy || (msgSize > sizeof(ocrPolicyMsg_t))) {
         //TODO-MD-SLAB
         msg = (ocrPolicyMsg_t *) allocPolicyMsg(pd, &msgSize);
         initializePolicyMessage(msg, msgSize);
@@ -533,6 +878,7 @@ static void answerFetchRequest(ocrDataBlock_t * self, ocrLocation_t destLocation
     PD_MSG_FIELD_I(sizePayload) = mdSize;
     PD_MSG_FIELD_I(response) = NULL;
     PD_MSG_FIELD_I(mdPtr) = NULL;
+    PD_MSG_FIELD_I(extPayload) = NULL;
     // Create a M_ACQUIRE PUSH payload
     md_push_acquire_t * payload = (md_push_acquire_t *) &PD_MSG_FIELD_I(payload);
     payload->dbMode = othMode;
@@ -540,17 +886,34 @@ static void answerFetchRequest(ocrDataBlock_t * self, ocrLocation_t destLocation
     // For now write back when acquiring in one of the write mode and not a single assignment DB.
     // Technically, a SA DB should not be acquired in write mode, just depends on how much slack the runtime allows.
     payload->writeBack = !!(othMode & WR_MASK) && !(((ocrDataBlockLockable_t *)self)->attributes.flags & DB_PROP_SINGLE_ASSIGNMENT);
+#ifdef ENABLE_EXTENSION_DB_DIRTY_RANGE
+    payload->dirtyCount = 0;
+#endif
+#ifdef ENABLE_DB_REPLICA_CACHE
+    ocrDataBlockLockable_t * rself = (ocrDataBlockLockable_t *) self;
+    if (!(othMode & WR_MASK) && !rself->attributes.isLazy && !rself->attributes.isEager &&
+        (getLockableFactory(self)->replicaCacheSize != 0)) {
+        // The destination may keep its copy in its replica cache
+        rself->replicaLocs[destLocation/64] |= (1ULL << (destLocation%64));
+    }
+#endif
     DPRINTF (DBG_LVL_DB_MD, "db-md: push acquire "GUIDF" wb=%d dbMode=%d msgSize=%"PRIu64" dbSize=%"PRIu64"\n", GUIDA(self->guid), payload->writeBack, othMode, msgSize, self->size);
     DPRINTF (DBG_LVL_LAZY, "db-md: push acquire "GUIDF" wb=%d dbMode=%d msgSize=%"PRIu64" dbSize=%"PRIu64"\n", GUIDA(self->guid), payload->writeBack, othMode, msgSize, self->size);
 #ifdef DB_STATS_LOCKABLE
     ((ocrDataBlockLockable_t *)self)->stats.counters[CNT_REMOTE_ACQUIRE]++;
+    ((ocrDataBlockLockable_t *)self)->stats.counters[CNT_BYTES_SENT] += mdSize;
 #endif
     void *dataPtr;
     ocrFatGuid_t fguid = {.guid = NULL_GUID, .metaDataPtr = NULL};
     lowLevelAcquire(self, &dataPtr, fguid, EDT_SLOT_NONE, othMode, false, 0);
 
-    ocrObjectFactory_t * factory = pd->factories[self->fctId];
-    lockableSerialize(factory, self->guid, (ocrObject_t *) self, &mdMode, destLocation, (void **) &payload, &mdSize);
+    if (zeroCopy) {
+        PD_MSG_FIELD_I(extPayload) = self->ptr;
+        PD_MSG_FIELD_I(extSize) = self->size;
+    } else {
+        ocrObjectFactory_t * factory = pd->factories[self->fctId];
+        lockableSerialize(factory, self->guid, (ocrObject_t *) self, &mdMode, destLocation, (void **) &payload, &mdSize);
+    }
 
     // Send the request
     pd->fcts.sendMessage(pd, msg->destLocation, msg, NULL, msgProp);
@@ -595,8 +958,12 @@ static void answerCloneRequest(ocrDataBlock_t * self, ocrLocation_t srcLocation)
     PD_MSG_FIELD_I(sizePayload) = mdSize;
     PD_MSG_FIELD_I(response) = NULL;
     PD_MSG_FIELD_I(mdPtr) = NULL;
+    PD_MSG_FIELD_I(extPayload) = NULL;
     // Create a M_CLONE PUSH payload
     md_push_clone_t * payload = (md_push_clone_t *) &PD_MSG_FIELD_I(payload);
+#ifdef DB_STATS_LOCKABLE
+    ((ocrDataBlockLockable_t *)self)->stats.counters[CNT_BYTES_SENT] += mdSize;
+#endif
     ocrObjectFactory_t * factory = pd->factories[self->fctId];
     lockableSerialize(factory, self->guid, (ocrObject_t *) self, &mdMode, srcLocation, (void **) &payload, &mdSize);
     pd->fcts.sendMessage(pd, srcLocation, msg, NULL, msgProp);
@@ -679,6 +1046,11 @@ static dbWaiter_t * processLocalAcquireCallbacks(ocrDataBlock_t *self, dbWaiter_
         if(((ocrDataBlockLockable_t *)self)->attributes.isLazy) {
             DPRINTF(DBG_LVL_LAZY, "LAZY resume blocked acquire for "GUIDF" in mode=%d\n", GUIDA(dbGuid.guid), dbMode);
         }
+#ifdef DB_STATS_LOCKABLE
+        ((ocrDataBlockLockable_t *)self)->stats.counters[CNT_LOCAL_ACQUIRE]++;
+        ((ocrDataBlockLockable_t *)self)->stats.waitTime[getDbMode(waiter->properties & DB_ACCESS_MODE_MASK)] +=
+            (salGetTime() - waiter->waitStart);
+#endif
 #undef PD_MSG
 #undef PD_TYPE
         dbWaiter_t * next = waiter->next;
@@ -792,6 +1164,7 @@ static bool localAcquire(ocrDataBlock_t * self, ocrDataBlockLockableAttr_t * att
 static void localRelease(ocrDataBlock_t * self, ocrDataBlockLockableAttr_t * attr);
 static bool remoteAcquire(ocrDataBlock_t * self, ocrDataBlockLockableAttr_t * attr, u8 othMode);
 static void remoteRelease(ocrDataBlock_t * self, ocrDataBlockLockableAttr_t * attr);
+static bool localAcquireIdle(ocrDataBlock_t * self, ocrDataBlockLockableAttr_t * attr, u8 othMode);
 
 //
 // Prime rules for local & remote acquire/release.
@@ -812,7 +1185,9 @@ static bool localAcquirePrime(ocrDataBlock_t * self, ocrDataBlockLockableAttr_t
     }
 
     if ((attr->dbMode == DB_RW) && ((othMode == DB_RW) || (othMode == DB_RO))) {
-        return true;
+        // The only writer of a single-assignment DB is its assigner: readers
+        // wait for the assignment to be released to see the data
+        return ((othMode == DB_RW) || !(self->flags & DB_PROP_SINGLE_ASSIGNMENT));
     }
     ocrAssert(!attr->isEager);
 
@@ -875,6 +1250,13 @@ static void remoteReleasePrime(ocrDataBlock_t * self, ocrDataBlockLockableAttr_t
 
 static bool localAcquireShared(ocrDataBlock_t * self, ocrDataBlockLockableAttr_t * attr, u8 othMode) {
     if (othMode & WR_MASK) {
+#ifdef ENABLE_DB_REPLICA_CACHE
+        if (attr->isCached && (attr->numUsers == 0)) {
+            // Give the replica back and fetch the DB in the mode asked
+            releaseReplica(self, attr);
+            return localAcquireIdle(self, attr, othMode);
+        }
+#endif
         // Shared is granted when in prime and transitioning to shared
         return false;
     }
@@ -899,8 +1281,8 @@ static void localReleaseShared(ocrDataBlock_t * self, ocrDataBlockLockableAttr_t
 #endif
             if (releaseCond) {
                 // Couldn't schedule any pending work
-                // Release back to master
-                if (!attr->isLazy) {
+                // Release back to master unless the copy is cached
+                if (!attr->isLazy && !cacheReplica(self, attr)) {
                     attr->state = STATE_IDLE;
                     // Transition to idle state
                     issueReleaseRequest(self);
@@ -919,6 +1301,19 @@ static void localReleaseShared(ocrDataBlock_t * self, ocrDataBlockLockableAttr_t
 
 // This is always received by the master
 static bool remoteAcquireShared(ocrDataBlock_t * self, ocrDataBlockLockableAttr_t * attr, u8 othMode) {
+#ifdef ENABLE_DB_REPLICA_CACHE
+    if ((othMode & WR_MASK) && !(attr->dbMode & WR_MASK) && (getLockableFactory(self)->replicaCacheSize != 0)) {
+        // Read-only replicas may outlive their users. Else later reads could
+        // be served from a copy older than the write:
+        // - The writer waits for the replicas to be invalidated and released
+        // - Readers coming after the writer wait for its release
+        if (hasReplicas((ocrDataBlockLockable_t *) self)) {
+            return false;
+        }
+        attr->dbMode = othMode;
+        return true;
+    }
+#endif
     if (!(attr->dbMode & WR_MASK)) {
         if ((attr->dbMode == DB_RO) && (othMode == DB_CONST)) {
             attr->dbMode = DB_CONST;
@@ -1059,6 +1454,120 @@ static void remoteRelease(ocrDataBlock_t * self, ocrDataBlockLockableAttr_t * at
 
 // Forward declaration
 u8 lockableDestruct(ocrDataBlock_t *self);
+u8 lockableRelease(ocrDataBlock_t *self, ocrFatGuid_t edt, ocrLocation_t srcLoc, bool isInternal);
+
+#ifdef LOCKABLE_FAST_PATH
+//
+// Lock-free path for local read acquire/release.
+//
+// While the MD is the master copy (hasPeers is false) in PRIME, held in RO
+// or CONST and nobody is queued, local read acquires that the locked code
+// would grant without changing the MD state are granted through a CAS on
+// 'fastUsers' instead: RO and CONST acquires when the MD is in CONST, RO
+// acquires when the MD is in RO. The releases that follow decrement the
+// same counter. It is kept out of 'attributes' because the lock holder
+// updates the attribute bitfields with plain stores.
+//
+// The fast path is open when FAST_PATH_CLOSED is not set. Only the lock
+// holder opens it, right before unlocking and if the conditions above
+// hold, and records the mode in FAST_PATH_CONST so that readers check it
+// with the same CAS that checks them in. The MD mode itself is never
+// changed: any other acquire, such as a writer on an MD read in RO, takes
+// the lock and is handled exactly as if all readers had come through it.
+// Whoever takes the lock closes the fast path and folds the fast users
+// back into 'numUsers' so that the locked code always sees an exact
+// count. If there are none left, the MD gets back to RO as the last
+// locked release would have done.
+//
+
+#define FAST_PATH_CLOSED (((u32) 1) << 31)
+#define FAST_PATH_CONST  (((u32) 1) << 30)
+#define FAST_PATH_USERS  (FAST_PATH_CONST - 1)
+
+// Must be called right after taking the lock
+static void fastPathClose(ocrDataBlockLockable_t * rself) {
+    u32 cur = rself->fastUsers;
+    while (!(cur & FAST_PATH_CLOSED)) {
+        u32 old = hal_cmpswap32(&rself->fastUsers, cur, FAST_PATH_CLOSED);
+        if (old == cur) {
+            ocrDataBlockLockableAttr_t * attr = &rself->attributes;
+            attr->numUsers += (cur & FAST_PATH_USERS);
+            if (attr->numUsers == 0) {
+                // Nobody can have been queued while open
+                attr->dbMode = DB_RO;
+            }
+            return;
+        }
+        cur = old;
+    }
+}
+
+// Must be called right before releasing the lock
+static void fastPathOpen(ocrDataBlockLockable_t * rself) {
+    ocrDataBlockLockableAttr_t * attr = &rself->attributes;
+    if ((attr->state != STATE_PRIME) || ((attr->dbMode != DB_CONST) && (attr->dbMode != DB_RO)) ||
+        attr->hasPeers || attr->isFetching || attr->isReleasing ||
+        attr->isEager || attr->isLazy || attr->freeRequested) {
+        return;
+    }
+    u8 i;
+    for (i = 0; i < DB_MODE_COUNT; i++) {
+        if ((rself->localWaitQueues[i] != NULL) || !queueIsEmpty(rself->remoteWaitQueues[i])) {
+            return;
+        }
+    }
+    // Nobody can CAS while closed and the unlock publishes the store
+    rself->fastUsers = ((attr->dbMode == DB_CONST) ? FAST_PATH_CONST : 0);
+}
+
+static bool fastPathAcquire(ocrDataBlockLockable_t * rself, u8 othMode) {
+    if (othMode & WR_MASK) {
+        return false;
+    }
+    u32 cur = rself->fastUsers;
+    // A CONST acquire on an MD in RO changes its mode
+    while (!(cur & FAST_PATH_CLOSED) && ((othMode == DB_RO) || (cur & FAST_PATH_CONST))) {
+        u32 old = hal_cmpswap32(&rself->fastUsers, cur, cur + 1);
+        if (old == cur) {
+            return true;
+        }
+        cur = old;
+    }
+    return false;
+}
+
+// A user checked-in through the fast path may have been folded into
+// 'numUsers' by a lock holder since. That's fine as long as the total
+// is decremented. Once the counter is zero, remaining users are all
+// accounted for in 'numUsers' and must go through the lock.
+static bool fastPathRelease(ocrDataBlockLockable_t * rself) {
+    u32 cur = rself->fastUsers;
+    while (!(cur & FAST_PATH_CLOSED) && ((cur & FAST_PATH_USERS) != 0)) {
+        u32 old = hal_cmpswap32(&rself->fastUsers, cur, cur - 1);
+        if (old == cur) {
+            return true;
+        }
+        cur = old;
+    }
+    return false;
+}
+#else
+#define fastPathClose(rself)
+#define fastPathOpen(rself)
+#endif
+
+#ifdef ENABLE_EXTENSION_DB_PARTITION
+// A partition holds its parent from its creation until it is destroyed.
+// Must not be called with the partition's lock held
+static void partitionReleaseParent(ocrDataBlock_t * parent) {
+    if (parent != NULL) {
+        ocrPolicyDomain_t * pd;
+        getCurrentEnv(&pd, NULL, NULL, NULL);
+        ocrFatGuid_t noEdt = {.guid = NULL_GUID, .metaDataPtr = NULL};
+        lockableRelease(parent, noEdt, pd->myLocation, true);
+    }
+}
+#endif
 
 // This is needed because we may be in helper mode ?
 static bool lockButSelf(ocrDataBlockLockable_t *rself) {
@@ -1076,9 +1585,51 @@ static bool lockButSelf(ocrDataBlockLockable_t *rself) {
         hal_lock(&rself->lock);
         rself->worker = worker;
     }
+    if (unlock) {
+        fastPathClose(rself);
+    }
     return unlock;
 }
 
+#ifdef ENABLE_EXTENSION_DB_COPY_ON_WRITE
+// Master: a writer gets its own copy while local readers hold the DB in
+// CONST. Returns true if the copy was made, the writer still has to be
+// checked-in. The lock must be held.
+static bool acquireCopyOnWrite(ocrDataBlock_t * self, u8 othMode, u32 properties) {
+    ocrDataBlockLockable_t * rself = (ocrDataBlockLockable_t *) self;
+    ocrDataBlockLockableAttr_t * attr = &rself->attributes;
+    if (!(self->flags & DB_PROP_COPY_ON_WRITE) || !(othMode & WR_MASK) ||
+        (properties & DB_PROP_ASYNC_ACQ) || (rself->cowPtr != NULL) || attr->hasPeers ||
+        (attr->state != STATE_PRIME) || (attr->dbMode != DB_CONST) || (attr->numUsers == 0) ||
+        attr->isEager || attr->isLazy || attr->freeRequested) {
+        return false;
+    }
+    ocrPolicyDomain_t * pd;
+    getCurrentEnv(&pd, NULL, NULL, NULL);
+    rself->cowPtr = pd->fcts.pdMalloc(pd, self->size);
+    if (rself->cowPtr == NULL) {
+        // Wait for the readers instead
+        return false;
+    }
+    hal_memCopy(rself->cowPtr, self->ptr, self->size, false);
+    attr->dbMode = othMode;
+    DPRINTF(DEBUG_LVL_VERB, "DB (GUID "GUIDF") copy-on-write for %"PRIu32" readers\n",
+            GUIDA(self->guid), (u32) attr->numUsers);
+    return true;
+}
+
+// Master: the last user of either version is done, the writer's
+// version becomes the DB's content. The lock must be held.
+static void releaseCopyOnWrite(ocrDataBlock_t * self) {
+    ocrDataBlockLockable_t * rself = (ocrDataBlockLockable_t *) self;
+    ocrPolicyDomain_t * pd;
+    getCurrentEnv(&pd, NULL, NULL, NULL);
+    hal_memCopy(self->ptr, rself->cowPtr, self->size, false);
+    pd->fcts.pdFree(pd, rself->cowPtr);
+    rself->cowPtr = NULL;
+}
+#endif
+
 // Can only be called locally to the current PD. However, the MD may or may not be able to
 // accomodate the call immediately.
 // Remote acquire are going through the MD cloning infrastructure and the 'process' call
@@ -1086,13 +1637,28 @@ u8 lockableAcquire(ocrDataBlock_t *self, void** ptr, ocrFatGuid_t edt, ocrLocati
                   ocrDbAccessMode_t accessMode, bool isInternal, u32 properties) {
     u8 res = 0;
     ocrDataBlockLockable_t *rself = (ocrDataBlockLockable_t*)self;
-    bool unlock = lockButSelf(rself);
     u8 othMode = getDbMode(accessMode);
+#ifdef LOCKABLE_FAST_PATH
+    if (!(properties & DB_PROP_ASYNC_ACQ) && fastPathAcquire(rself, othMode)) {
+        DPRINTF(DEBUG_LVL_VERB, "Acquiring DB @ 0x%"PRIx64" (GUID: "GUIDF") from EDT (GUID: "GUIDF") (mode: %"PRId32") lock-free\n",
+                (u64)self->ptr, GUIDA(rself->base.guid), GUIDA(edt.guid), (int) othMode);
+        *ptr = self->ptr;
+        return 0;
+    }
+#endif
+    bool unlock = lockButSelf(rself);
     // When we're a clone MD it's easy to use isFetching to shortcut whether or not to grant.
     // It doesn't cover all of them but it's cheap enough to do it here.
     bool isReleasing = rself->attributes.isReleasing;
+#ifdef ENABLE_EXTENSION_DB_COPY_ON_WRITE
+    // Other acquires wait for both versions to be released
+    bool isCopy = acquireCopyOnWrite(self, othMode, properties);
+    bool granted = isCopy || ((rself->cowPtr == NULL) && (!rself->attributes.isFetching) && (!isReleasing) &&
+                    localAcquire(self, &rself->attributes, othMode));
+#else
     bool granted = (!rself->attributes.isFetching) && (!isReleasing) &&
                     localAcquire(self, &rself->attributes, othMode);
+#endif
     if (granted) { // Enqueue acquire request
         // Do not touch the state here. For local MD the state doesn't change and in
         // remote the state is set before executing callbacks
@@ -1122,6 +1688,11 @@ u8 lockableAcquire(ocrDataBlock_t *self, void** ptr, ocrFatGuid_t edt, ocrLocati
             }
         }
         lowLevelAcquire(self, ptr, edt, edtSlot, othMode, isInternal, properties);
+#ifdef ENABLE_EXTENSION_DB_COPY_ON_WRITE
+        if (isCopy) {
+            *ptr = rself->cowPtr;
+        }
+#endif
         //TODO-MD-DBRTACQ
         //Came from a gated acquire waiting on MD, generate a response.
         if (properties & DB_PROP_ASYNC_ACQ) {
@@ -1133,6 +1704,9 @@ u8 lockableAcquire(ocrDataBlock_t *self, void** ptr, ocrFatGuid_t edt, ocrLocati
             dbWaiter->slot = edtSlot;
             dbWaiter->properties = properties;
             dbWaiter->isInternal = isInternal;
+#ifdef DB_STATS_LOCKABLE
+            dbWaiter->waitStart = salGetTime();
+#endif
             dbWaiter->next = NULL;
             processLocalAcquireCallbacks(self, dbWaiter, false);
         }
@@ -1142,8 +1716,10 @@ u8 lockableAcquire(ocrDataBlock_t *self, void** ptr, ocrFatGuid_t edt, ocrLocati
 #ifdef OCR_ASSERT
             ocrPolicyDomain_t *pd = NULL;
             getCurrentEnv(&pd, NULL, NULL, NULL);
-            u64 val;
-            pd->guidProviders[0]->fcts.getVal(pd->guidProviders[0], edt.guid, &val, NULL, MD_LOCAL, NULL);
+            u64 val = (u64) edt.metaDataPtr;
+            if (val == 0) {
+                pd->guidProviders[0]->fcts.getVal(pd->guidProviders[0], edt.guid, &val, NULL, MD_LOCAL, NULL);
+            }
             void * fctPtr = NULL;
             if (val != 0) {
                 ocrTask_t * edtPtr = (ocrTask_t *) val;
@@ -1162,8 +1738,10 @@ u8 lockableAcquire(ocrDataBlock_t *self, void** ptr, ocrFatGuid_t edt, ocrLocati
             ocrPolicyDomain_t *pd = NULL;
             getCurrentEnv(&pd, NULL, NULL, NULL);
 #ifdef OCR_ASSERT
-            u64 val;
-            pd->guidProviders[0]->fcts.getVal(pd->guidProviders[0], edt.guid, &val, NULL, MD_LOCAL, NULL);
+            u64 val = (u64) edt.metaDataPtr;
+            if (val == 0) {
+                pd->guidProviders[0]->fcts.getVal(pd->guidProviders[0], edt.guid, &val, NULL, MD_LOCAL, NULL);
+            }
             void * fctPtr = NULL;
             if (val != 0) {
                 ocrTask_t * edtPtr = (ocrTask_t *) val;
@@ -1184,8 +1762,10 @@ u8 lockableAcquire(ocrDataBlock_t *self, void** ptr, ocrFatGuid_t edt, ocrLocati
         ocrPolicyDomain_t *pd = NULL;
         getCurrentEnv(&pd, NULL, NULL, NULL);
 #ifdef OCR_ASSERT
-        u64 val;
-        pd->guidProviders[0]->fcts.getVal(pd->guidProviders[0], edt.guid, &val, NULL, MD_LOCAL, NULL);
+        u64 val = (u64) edt.metaDataPtr;
+        if (val == 0) {
+            pd->guidProviders[0]->fcts.getVal(pd->guidProviders[0], edt.guid, &val, NULL, MD_LOCAL, NULL);
+        }
         void * fctPtr = NULL;
         if (val != 0) {
             ocrTask_t * edtPtr = (ocrTask_t *) val;
@@ -1196,11 +1776,16 @@ u8 lockableAcquire(ocrDataBlock_t *self, void** ptr, ocrFatGuid_t edt, ocrLocati
         DPRINTF(DBG_LVL_LAZY, "DB LAZY - Enqueue for DB "GUIDF" with mode=%d \n", GUIDA(self->guid), othMode);
 #endif
         enqueueLocalAcquire(pd, edt, dstLoc, edtSlot, isInternal, properties, &(rself->localWaitQueues[othMode]));
+#ifdef DB_STATS_LOCKABLE
+        rself->stats.counters[CNT_CONTENDED]++;
+#endif
+        invalidateReplicas(self);
         res = OCR_EBUSY;
 #ifdef ENABLE_LAZY_DB
 #endif
     }
     if (unlock) {
+        fastPathOpen(rself);
         rself->worker = NULL;
         hal_unlock(&rself->lock);
     }
@@ -1250,6 +1835,54 @@ static void schedulePending(ocrDataBlock_t *self) {
     } // else stay idle
 }
 
+#ifdef ENABLE_DB_REPLICA_CACHE
+// Slave: give the least recently used replicas back to their master until
+// the ones kept fit in the budget. Replicas in use, or whose lock is taken,
+// are skipped and the budget stays exceeded until they are released. The
+// caller must not hold a DB lock since releasing waits for the master.
+static void evictReplicas(ocrDataBlock_t * self) {
+    ocrDataBlockFactoryLockable_t * factory = getLockableFactory(self);
+    ocrWorker_t * worker;
+    getCurrentEnv(NULL, &worker, NULL, NULL);
+    while (factory->replicaCacheUsed > factory->replicaCacheSize) {
+        // DB locks are taken before the factory's one elsewhere, only try them here
+        hal_lock(&(factory->replicaLock));
+        ocrDataBlockLockable_t * victim = factory->replicaTail;
+        while (victim != NULL) {
+            if (hal_trylock(&(victim->lock)) == 0) {
+                ocrDataBlockLockableAttr_t * attr = &(victim->attributes);
+                if ((attr->state == STATE_SHARED) && (attr->numUsers == 0) && !attr->isReleasing &&
+                    !attr->isFetching && !attr->freeRequested && !hasLocalWaiters(victim)) {
+                    unlinkReplica(factory, victim);
+                    break;
+                }
+                hal_unlock(&(victim->lock));
+            }
+            victim = victim->replicaPrev;
+        }
+        hal_unlock(&(factory->replicaLock));
+        if (victim == NULL) {
+            return;
+        }
+        ocrDataBlock_t * vbase = (ocrDataBlock_t *) victim;
+        DPRINTF(DBG_LVL_DB_MD, "db-md: evict replica "GUIDF" used=%"PRIu64"\n", GUIDA(vbase->guid), factory->replicaCacheUsed);
+        victim->worker = worker;
+        releaseReplica(vbase, &(victim->attributes));
+        // Local acquires may have been queued or the DB destroyed while releasing
+        schedulePending(vbase);
+        victim->worker = NULL;
+        if (victim->attributes.freeRequested && (victim->attributes.numUsers == 0)) {
+            hal_unlock(&(victim->lock));
+            lockableDestruct(vbase);
+        } else {
+            hal_unlock(&(victim->lock));
+        }
+    }
+}
+#else
+#define evictReplicas(self)
+#endif
+
 
 // Always called by release local to the current PD
 // 'edt' may be NULL_GUID here if we are doing a PD-level release
@@ -1257,10 +1890,16 @@ u8 lockableRelease(ocrDataBlock_t *self, ocrFatGuid_t edt, ocrLocation_t srcLoc,
     ocrDataBlockLockable_t *rself = (ocrDataBlockLockable_t*)self;
     DPRINTF(DEBUG_LVL_VERB, "Releasing DB @ 0x%"PRIx64" (GUID "GUIDF") from EDT "GUIDF" (runtime release: %"PRId32")\n",
             (u64)self->ptr, GUIDA(rself->base.guid), GUIDA(edt.guid), (u32)isInternal);
+#ifdef LOCKABLE_FAST_PATH
+    if (fastPathRelease(rself)) {
+        return 0;
+    }
+#endif
     ocrWorker_t * worker;
     getCurrentEnv(NULL, &worker, NULL, NULL);
     // Start critical section
     hal_lock(&(rself->lock));
+    fastPathClose(rself);
     rself->worker = worker;
 #ifdef DB_STATS_LOCKABLE
     rself->stats.counters[CNT_LOCAL_RELEASE]++;
@@ -1285,6 +1924,11 @@ u8 lockableRelease(ocrDataBlock_t *self, ocrFatGuid_t edt, ocrLocation_t srcLoc,
         hal_memCopy(self->bkPtr, self->ptr, self->size, 0);
         DPRINTF(DEBUG_LVL_VERB, "DB (GUID "GUIDF") backed up from EDT "GUIDF"\n", GUIDA(rself->base.guid), GUIDA(edt.guid));
     }
+#endif
+#ifdef ENABLE_EXTENSION_DB_COPY_ON_WRITE
+    if ((rself->cowPtr != NULL) && (rself->attributes.numUsers == 1)) {
+        releaseCopyOnWrite(self);
+    }
 #endif
     localRelease(self, &rself->attributes);
     DPRINTF(DEBUG_LVL_VVERB, "DB (GUID: "GUIDF") attributes: numUsers %"PRId32" freeRequested %"PRId32"\n",
@@ -1314,8 +1958,10 @@ u8 lockableRelease(ocrDataBlock_t *self, ocrFatGuid_t edt, ocrLocation_t srcLoc,
         }
 
     }
+    fastPathOpen(rself);
     rself->worker = NULL;
     hal_unlock(&(rself->lock));
+    evictReplicas(self);
     return 0;
 }
 
@@ -1351,6 +1997,7 @@ static void issueDelMessage(ocrDataBlockLockable_t * rself, ocrLocation_t srcToA
         PD_MSG_FIELD_I(sizePayload) = 0;
         PD_MSG_FIELD_I(response) = NULL;
         PD_MSG_FIELD_I(mdPtr) = NULL;
+        PD_MSG_FIELD_I(extPayload) = NULL;
 #undef PD_MSG
 #undef PD_TYPE
         pd->fcts.sendMessage(pd, msg.destLocation, &msg, NULL, 0);
@@ -1380,6 +2027,7 @@ static void issueDelMessage(ocrDataBlockLockable_t * rself, ocrLocation_t srcToA
             PD_MSG_FIELD_I(sizePayload) = 0;
             PD_MSG_FIELD_I(response) = NULL;
             PD_MSG_FIELD_I(mdPtr) = NULL;
+            PD_MSG_FIELD_I(extPayload) = NULL;
 #undef PD_MSG
 #undef PD_TYPE
             u32 i=0;
@@ -1406,6 +2054,121 @@ static void issueDelMessage(ocrDataBlockLockable_t * rself, ocrLocation_t srcToA
     }
 }
 
+#ifdef DB_STATS_LOCKABLE
+// Fold the statistics of a DB being destroyed into its PD's table
+static void recordDbStats(ocrDataBlock_t * self) {
+    ocrDataBlockLockable_t * rself = (ocrDataBlockLockable_t *) self;
+    dbLockableStats_t * stats = &rself->stats;
+    ocrPolicyDomain_t * pd = NULL;
+    getCurrentEnv(&pd, NULL, NULL, NULL);
+    dbLockableStatsTable_t * table = ((ocrDataBlockFactoryLockable_t *) pd->factories[self->fctId])->statsTable;
+    u32 i;
+    hal_lock(&table->lock);
+    table->pd = pd;
+    for (i = 0; i < table->templateCount; i++) {
+        if (ocrGuidIsEq(table->templates[i].creatorTemplate, stats->creatorTemplate)) {
+            break;
+        }
+    }
+    if (i == table->templateCount) {
+        if (table->templateCount == table->templateMax) {
+            u32 newMax = (table->templateMax == 0) ? 8 : (table->templateMax * 2);
+            dbLockableTemplateStats_t * newTemplates = (dbLockableTemplateStats_t *)
+                pd->fcts.pdMalloc(pd, sizeof(dbLockableTemplateStats_t) * newMax);
+            if (table->templates != NULL) {
+                hal_memCopy(newTemplates, table->templates, sizeof(dbLockableTemplateStats_t) * table->templateCount, false);
+                pd->fcts.pdFree(pd, table->templates);
+            }
+            table->templates = newTemplates;
+            table->templateMax = newMax;
+        }
+        dbLockableTemplateStats_t * newEntry = &table->templates[i];
+        newEntry->creatorTemplate = stats->creatorTemplate;
+        newEntry->creatorFunc = stats->creatorFunc;
+        newEntry->dbCount = 0;
+        u32 j;
+        for (j = 0; j < CNT_MAX; j++) {
+            newEntry->counters[j] = 0;
+        }
+        for (j = 0; j < DB_MODE_COUNT; j++) {
+            newEntry->waitTime[j] = 0;
+        }
+        table->templateCount++;
+    }
+    dbLockableTemplateStats_t * entry = &table->templates[i];
+    entry->dbCount++;
+    u64 waitTime = 0;
+    for (i = 0; i < CNT_MAX; i++) {
+        entry->counters[i] += stats->counters[i];
+    }
+    for (i = 0; i < DB_MODE_COUNT; i++) {
+        entry->waitTime[i] += stats->waitTime[i];
+        waitTime += stats->waitTime[i];
+    }
+    // Keep the hottest DBs, replacing the one with the fewest acquires
+    u64 acquires = stats->counters[CNT_LOCAL_ACQUIRE] + stats->counters[CNT_REMOTE_ACQUIRE];
+    u32 slot = table->hotCount;
+    if (slot == DB_STATS_TOP_N) {
+        slot = 0;
+        for (i = 1; i < DB_STATS_TOP_N; i++) {
+            if (table->hottest[i].acquires < table->hottest[slot].acquires) {
+                slot = i;
+            }
+        }
+        if (table->hottest[slot].acquires >= acquires) {
+            slot = DB_STATS_TOP_N;
+        }
+    } else {
+        table->hotCount++;
+    }
+    if (slot < DB_STATS_TOP_N) {
+        dbLockableHotStats_t * hot = &table->hottest[slot];
+        hot->guid = self->guid;
+        hot->creatorTemplate = stats->creatorTemplate;
+        hot->acquires = acquires;
+        hot->contended = stats->counters[CNT_CONTENDED];
+        hot->bytesSent = stats->counters[CNT_BYTES_SENT];
+        hot->waitTime = waitTime;
+    }
+    hal_unlock(&table->lock);
+}
+
+// Write the statistics table of the PD as tab-separated values
+static void dumpDbStats(dbLockableStatsTable_t * table) {
+    if (table->pd == NULL) {
+        return; // No DB was ever destroyed
+    }
+    char filename[32];
+    SNPRINTF(filename, sizeof(filename), "DbStatsNode%"PRIu64, (u64) table->pd->myLocation);
+    FILE * fp = fopen(filename, "w");
+    if (fp == NULL) {
+        DPRINTF(DEBUG_LVL_WARN, "Cannot open %s to dump DB statistics\n", filename);
+        return;
+    }
+    u32 i, j;
+    fprintf(fp, "TEMPLATE\tFUNC\tDBS\tLOCAL_RELEASE\tREMOTE_RELEASE\tLOCAL_ACQUIRE\tREMOTE_ACQUIRE\t"
+                "EAGER_CLONE\tEAGER_PULL\tCONTENDED\tBYTES_SENT\tWAIT_RO_NS\tWAIT_RW_NS\tWAIT_CONST_NS\tWAIT_EW_NS\n");
+    for (i = 0; i < table->templateCount; i++) {
+        dbLockableTemplateStats_t * entry = &table->templates[i];
+        fprintf(fp, GUIDF"\t0x%"PRIx64"\t%"PRIu64, GUIDA(entry->creatorTemplate), entry->creatorFunc, entry->dbCount);
+        for (j = 0; j < CNT_MAX; j++) {
+            fprintf(fp, "\t%"PRIu64, entry->counters[j]);
+        }
+        for (j = 0; j < DB_MODE_COUNT; j++) {
+            fprintf(fp, "\t%"PRIu64, entry->waitTime[j]);
+        }
+        fprintf(fp, "\n");
+    }
+    fprintf(fp, "\nDB\tTEMPLATE\tACQUIRES\tCONTENDED\tBYTES_SENT\tWAIT_NS\n");
+    for (i = 0; i < table->hotCount; i++) {
+        dbLockableHotStats_t * hot = &table->hottest[i];
+        fprintf(fp, GUIDF"\t"GUIDF"\t%"PRIu64"\t%"PRIu64"\t%"PRIu64"\t%"PRIu64"\n", GUIDA(hot->guid),
+                GUIDA(hot->creatorTemplate), hot->acquires, hot->contended, hot->bytesSent, hot->waitTime);
+    }
+    fclose(fp);
+}
+#endif
+
 u8 lockableDestruct(ocrDataBlock_t *self) {
     DPRINTF(DEBUG_LVL_VERB, "Freeing DB (GUID: "GUIDF")\n", GUIDA(self->guid));
     ocrPolicyDomain_t *pd = NULL;
@@ -1413,6 +2176,9 @@ u8 lockableDestruct(ocrDataBlock_t *self) {
     getCurrentEnv(&pd, NULL, NULL, &msg);
 
     ocrDataBlockLockable_t *rself = (ocrDataBlockLockable_t*)self;
+#ifdef ENABLE_EXTENSION_DB_PARTITION
+    ocrDataBlock_t * parent = rself->parent;
+#endif
     // Any of these wrong would indicate a race between free and DB's consumers
     ocrAssert(rself->attributes.numUsers == 0);
     ocrAssert(rself->attributes.isFetching == 0);
@@ -1450,6 +2216,9 @@ u8 lockableDestruct(ocrDataBlock_t *self) {
     DPRINTF(DEBUG_LVL_WARN, "["GUIDF"] Local Release  = %"PRIu64"\n", GUIDA(self->guid), rself->stats.counters[CNT_LOCAL_RELEASE]);
     DPRINTF(DEBUG_LVL_WARN, "["GUIDF"] Eager Clone    = %"PRIu64"\n", GUIDA(self->guid), rself->stats.counters[CNT_EAGER_CLONE]);
     DPRINTF(DEBUG_LVL_WARN, "["GUIDF"] Eager Push     = %"PRIu64"\n", GUIDA(self->guid), rself->stats.counters[CNT_EAGER_PULL]);
+    DPRINTF(DEBUG_LVL_WARN, "["GUIDF"] Contended      = %"PRIu64"\n", GUIDA(self->guid), rself->stats.counters[CNT_CONTENDED]);
+    DPRINTF(DEBUG_LVL_WARN, "["GUIDF"] Bytes Sent     = %"PRIu64"\n", GUIDA(self->guid), rself->stats.counters[CNT_BYTES_SENT]);
+    recordDbStats(self);
 #endif
     ocrAssert(rself->lock == 0);
 
@@ -1467,10 +2236,11 @@ u8 lockableDestruct(ocrDataBlock_t *self) {
     // 2) This is the master, it can msg/data being either
     //    !null/!null, data points to msg's payload
     //    null/!null, has never been cloned
+    // A partition's master ptr points into its parent and is not freed here
     if (rself->backingPtrMsg != NULL) {
         pd->fcts.pdFree(pd, rself->backingPtrMsg);
     } else {
-        if (self->ptr != NULL) {
+        if ((self->ptr != NULL) && !IS_PARTITION(rself)) {
             msg.type = PD_MSG_MEM_UNALLOC | PD_MSG_REQUEST;
             PD_MSG_FIELD_I(allocatingPD.guid) = self->allocatingPD;
             PD_MSG_FIELD_I(allocatingPD.metaDataPtr) = NULL;
@@ -1502,6 +2272,10 @@ u8 lockableDestruct(ocrDataBlock_t *self) {
     RESULT_PROPAGATE(pd->fcts.processMessage(pd, &msg, false));
 #undef PD_MSG
 #undef PD_TYPE
+#ifdef ENABLE_EXTENSION_DB_PARTITION
+    // Last use of the parent's storage
+    partitionReleaseParent(parent);
+#endif
     return 0;
 }
 
@@ -1520,6 +2294,7 @@ u8 lockableFree(ocrDataBlock_t *self, ocrFatGuid_t edt, ocrLocation_t srcLoc, u3
 #endif
 
     hal_lock(&(rself->lock));
+    fastPathClose(rself);
     if(rself->attributes.freeRequested) {
         ocrAssert(false && "Internal DB free invoked multiple times");
         hal_unlock(&(rself->lock));
@@ -1529,6 +2304,7 @@ u8 lockableFree(ocrDataBlock_t *self, ocrFatGuid_t edt, ocrLocation_t srcLoc, u3
     rself->attributes.freeRequested = 1;
     ocrAssert((rself->attributes.isFetching == 0) && "error: DB Destroy seems to be concurrent with other DB operations");
     issueDelMessage(rself, INVALID_LOCATION);
+    releaseCachedReplica(self, &rself->attributes);
     // This is to work out the issue where an EDT is post-releasing the DB
     // and there's synchronization happening with the DB master MD. However,
     // a child EDT is trying to destroy the DB.
@@ -1633,8 +2409,16 @@ static u8 newDataBlockLockableInternal(ocrDataBlockFactory_t *factory, ocrFatGui
     result->base.fctId = factory->factoryId;
     // Only keep flags that represent the nature of
     // the DB as opposed to one-time usage creation flags
+#ifdef ENABLE_EXTENSION_DB_COPY_ON_WRITE
+    result->base.flags = (flags & (DB_PROP_SINGLE_ASSIGNMENT | DB_PROP_COPY_ON_WRITE));
+    result->cowPtr = NULL;
+#else
     result->base.flags = (flags & DB_PROP_SINGLE_ASSIGNMENT);
+#endif
     result->lock = INIT_LOCK;
+#ifdef LOCKABLE_FAST_PATH
+    result->fastUsers = FAST_PATH_CLOSED;
+#endif
     result->attributes.flags = result->base.flags;
     result->attributes.numUsers = 0;
     result->attributes.freeRequested = 0;
@@ -1665,6 +2449,10 @@ static u8 newDataBlockLockableInternal(ocrDataBlockFactory_t *factory, ocrFatGui
         result->remoteWaitQueues[i] = NULL;
     }
     result->worker = NULL;
+#ifdef ENABLE_DB_REPLICA_CACHE
+    result->replicaPrev = NULL;
+    result->replicaNext = NULL;
+#endif
     result->attributes.dbMode = DB_RO;
 
     result->mdPeers = loc;
@@ -1706,11 +2494,32 @@ static u8 newDataBlockLockableInternal(ocrDataBlockFactory_t *factory, ocrFatGui
     for(i = 0; i < CNT_MAX; ++i) {
         result->stats.counters[i] = 0;
     }
+    for(i = 0; i < DB_MODE_COUNT; ++i) {
+        result->stats.waitTime[i] = 0;
+    }
+    // Clones get the creator of the master on deserialization
+    ocrTask_t * curTask = NULL;
+    getCurrentEnv(NULL, NULL, &curTask, NULL);
+    result->stats.creatorTemplate = (curTask != NULL) ? curTask->templateGuid : NULL_GUID;
+    result->stats.creatorFunc = (curTask != NULL) ? ((u64) curTask->funcPtr) : 0;
+#endif
+    for(i = 0; i < DB_MAX_LOC_ARRAY; ++i) {
+        result->nonCoherentLocs[i] = 0ULL;
+    }
+#ifdef ENABLE_DB_REPLICA_CACHE
+    for(i = 0; i < DB_MAX_LOC_ARRAY; ++i) {
+        result->replicaLocs[i] = 0ULL;
+    }
 #endif
-    result->nonCoherentLoc = INVALID_LOCATION;
 #ifdef ENABLE_LAZY_DB
     result->lazyLoc = INVALID_LOCATION;
 #endif
+#ifdef ENABLE_EXTENSION_DB_PARTITION
+    result->parent = NULL;
+#endif
+#ifdef ENABLE_EXTENSION_DB_DIRTY_RANGE
+    result->dirtyCount = 0;
+#endif
 
 #ifdef OCR_ENABLE_STATISTICS
     ocrTask_t *task = NULL;
@@ -1875,6 +2684,122 @@ u8 newDataBlockLockable(ocrDataBlockFactory_t *factory, ocrFatGuid_t *guid, ocrF
     //it's obvious we need to register the metadata. I think that would allow to eliminate the firstCreate parameter
 }
 
+#ifdef ENABLE_EXTENSION_DB_PARTITION
+// Partitions are only created from the master MD and must stay local to it
+// since their payload points into the parent's. Each partition accounts for
+// one user of the parent, as if acquired by the runtime in RW, or in CONST if
+// the parent is being read in CONST, until the partition is destroyed.
+u8 lockablePartition(ocrDataBlock_t *self, u32 partc, u64 *offsets, u64 *sizes, ocrGuid_t *partGuids) {
+    ocrDataBlockLockable_t *rself = (ocrDataBlockLockable_t*)self;
+    u32 i;
+    for (i = 0; i < partc; i++) {
+        if ((sizes[i] == 0) || (offsets[i] > self->size) || (sizes[i] > (self->size - offsets[i]))) {
+            return OCR_EINVAL;
+        }
+    }
+    ocrDataBlockLockableAttr_t * attr = &rself->attributes;
+    if (attr->hasPeers || attr->isEager || attr->isLazy || (self->flags & DB_PROP_SINGLE_ASSIGNMENT)) {
+        return OCR_ENOTSUP;
+    }
+    bool unlock = lockButSelf(rself);
+    // Same rule as a local RW acquire except it is never deferred. A parent
+    // currently read in CONST is held in CONST instead.
+    bool granted = (attr->state == STATE_PRIME) && !attr->isFetching && !attr->isReleasing &&
+                   !attr->freeRequested && (attr->dbMode != DB_EW) &&
+                   (partc < ((1U << 15) - attr->numUsers));
+    if (granted) {
+        if (attr->dbMode == DB_RO) {
+            attr->dbMode = DB_RW;
+        }
+        attr->numUsers += partc;
+    }
+    if (unlock) {
+        fastPathOpen(rself);
+        rself->worker = NULL;
+        hal_unlock(&rself->lock);
+    }
+    if (!granted) {
+        DPRINTF(DEBUG_LVL_WARN, "Cannot partition DB "GUIDF" in dbMode=%"PRIu32"\n", GUIDA(self->guid), (u32) attr->dbMode);
+        return OCR_EACCES;
+    }
+    ocrPolicyDomain_t *pd = NULL;
+    getCurrentEnv(&pd, NULL, NULL, NULL);
+    ocrDataBlockFactory_t * factory = (ocrDataBlockFactory_t *) pd->factories[self->fctId];
+    ocrFatGuid_t allocator = {.guid = self->allocator, .metaDataPtr = NULL};
+    ocrFatGuid_t allocPD = {.guid = self->allocatingPD, .metaDataPtr = NULL};
+    for (i = 0; i < partc; i++) {
+        ocrFatGuid_t partGuid = {.guid = NULL_GUID, .metaDataPtr = NULL};
+        void * partPtr = ((u8 *) self->ptr) + offsets[i];
+        // Record the GUID only once the parent is set
+        RESULT_ASSERT(newDataBlockLockableInternal(factory, &partGuid, allocator, allocPD, sizes[i], &partPtr,
+                      NULL_HINT, DB_PROP_NO_HINT, NULL, /*isEager*/false, /*isClone=*/false, /*firstCreate=*/true,
+                      INVALID_LOCATION), ==, 0);
+        ocrDataBlockLockable_t * part = (ocrDataBlockLockable_t *) partGuid.metaDataPtr;
+        part->parent = self;
+        hal_fence();
+        RESULT_ASSERT(pd->guidProviders[0]->fcts.registerGuid(pd->guidProviders[0], partGuid.guid, (u64) part), ==, 0);
+        DPRINTF(DEBUG_LVL_VERB, "Partition DB "GUIDF" of "GUIDF" @ offset %"PRIu64" size %"PRIu64"\n",
+                GUIDA(partGuid.guid), GUIDA(self->guid), offsets[i], sizes[i]);
+        partGuids[i] = partGuid.guid;
+    }
+    return 0;
+}
+#endif
+
+#ifdef ENABLE_EXTENSION_DB_DIRTY_RANGE
+// Only remote copies that write back track dirty ranges,
+// the master already holds the data in place.
+u8 lockableMarkDirty(ocrDataBlock_t *self, u64 offset, u64 size) {
+    ocrDataBlockLockable_t *rself = (ocrDataBlockLockable_t*)self;
+    if ((offset > self->size) || (size > (self->size - offset))) {
+        return OCR_EINVAL;
+    }
+    if (size == 0) {
+        return 0;
+    }
+    bool unlock = lockButSelf(rself);
+    if (rself->attributes.hasPeers && rself->attributes.writeBack && (rself->attributes.numUsers != 0)) {
+        addDirtyRange(rself, offset, offset + size);
+    }
+    if (unlock) {
+        fastPathOpen(rself);
+        rself->worker = NULL;
+        hal_unlock(&rself->lock);
+    }
+    return 0;
+}
+#endif
+
+#ifdef ENABLE_DB_PREFETCH
+// A slave without a copy fetches one in the read mode asked. Nobody
+// is waiting for it, so the copy lands in the replica cache until
+// the acquires come. Skipped when the copy would not fit.
+u8 lockablePrefetch(ocrDataBlock_t *self, ocrDbAccessMode_t accessMode) {
+    ocrDataBlockLockable_t *rself = (ocrDataBlockLockable_t*)self;
+    u8 othMode = getDbMode(accessMode);
+    if (!rself->attributes.hasPeers || (othMode & WR_MASK)) {
+        return 0;
+    }
+    ocrDataBlockFactoryLockable_t * factory = getLockableFactory(self);
+    if ((factory->replicaCacheUsed + self->size) > factory->replicaCacheSize) {
+        return 0;
+    }
+    bool unlock = lockButSelf(rself);
+    ocrDataBlockLockableAttr_t * attr = &rself->attributes;
+    if ((attr->state == STATE_IDLE) && !attr->isFetching && !attr->isReleasing &&
+        !attr->freeRequested && !attr->isLazy && !attr->isEager) {
+        DPRINTF(DBG_LVL_DB_MD, "db-md: prefetch "GUIDF" in mode=%d\n", GUIDA(self->guid), othMode);
+        issueFetchRequest(self, othMode);
+    }
+    if (unlock) {
+        fastPathOpen(rself);
+        rself->worker = NULL;
+        hal_unlock(&rself->lock);
+    }
+    return 0;
+}
+#endif
+
 u8 lockableSetHint(ocrDataBlock_t* self, ocrHint_t *hint) {
     ocrDataBlockLockable_t *derived = (ocrDataBlockLockable_t*)self;
     ocrRuntimeHint_t *rHint = &(derived->hint);
@@ -2244,6 +3169,9 @@ static u8 lockableProcess(ocrObjectFactory_t * factory, ocrGuid_t guid, ocrObjec
     u8 direction = PD_MSG_FIELD_I(direction);
     void * payload = &PD_MSG_FIELD_I(payload);
     u64 mdMode = PD_MSG_FIELD_I(mode);
+#ifdef ENABLE_EXTENSION_DB_DIRTY_RANGE
+    u64 sizePayload = PD_MSG_FIELD_I(sizePayload);
+#endif
     // Incoming Request to pull MD
     DPRINTF(DBG_LVL_DB_MD, "DB (GUID: "GUIDF") enter process\n", GUIDA(guid));
     if (direction == MD_DIR_PULL) {
@@ -2260,6 +3188,7 @@ static u8 lockableProcess(ocrObjectFactory_t * factory, ocrGuid_t guid, ocrObjec
             u8 othMode = mdMsg->dbMode;
             ocrAssert(!rself->attributes.hasPeers); // master
             hal_lock(&rself->lock);
+            fastPathClose(rself);
 #ifdef ENABLE_LAZY_DB
             bool isLazy = (rself->attributes.isLazy);
             if (isLazy) {
@@ -2312,14 +3241,20 @@ static u8 lockableProcess(ocrObjectFactory_t * factory, ocrGuid_t guid, ocrObjec
                 ocrPolicyDomain_t * pd;
                 getCurrentEnv(&pd, NULL, NULL, NULL);
                 enqueueRemoteAcquire(pd, msg, &(rself->remoteWaitQueues[othMode]));
+#ifdef DB_STATS_LOCKABLE
+                rself->stats.counters[CNT_CONTENDED]++;
+#endif
                 retCode = OCR_EPEND;
             }
 #ifdef ENABLE_LAZY_DB
             }
 #endif /*!ENABLE_LAZY_DB*/
+            // Readers granted while a writer waits must not keep their copy either
+            invalidateReplicas(self);
             hal_unlock(&rself->lock);
         } else if (mdMode & M_CLONE) {
             hal_lock(&rself->lock);
+            fastPathClose(rself);
             // Preparing response
             // No synchronization needed here we're just reading RO data
             // Record the location requesting the PD
@@ -2385,6 +3320,7 @@ static u8 lockableProcess(ocrObjectFactory_t * factory, ocrGuid_t guid, ocrObjec
             u8 othMode = mdMsg->dbMode;
             // In this implementation a push should always be awaited for and successful
             hal_lock(&rself->lock);
+            fastPathClose(rself);
             ocrDataBlockLockableAttr_t attr = rself->attributes;
             ocrAssert(attr.isFetching);
             ocrAssert(attr.dbMode == DB_RO); // most liberal
@@ -2410,6 +3346,10 @@ static u8 lockableProcess(ocrObjectFactory_t * factory, ocrGuid_t guid, ocrObjec
             ocrAssert(((othMode & WR_MASK) & !(rself->attributes.flags & DB_PROP_SINGLE_ASSIGNMENT)) ? mdMsg->writeBack : !mdMsg->writeBack);
             rself->attributes.isFetching = false;
             rself->backingPtrMsg = msg;
+#ifdef ENABLE_EXTENSION_DB_DIRTY_RANGE
+            // A forwarded copy carries modifications the master has not seen yet
+            rself->dirtyCount = (rself->mdPeers != msg->srcLocation) ? DB_DIRTY_ALL : 0;
+#endif
 
             // Resume locally blocked acquire before releasing the lock.
             // This is just to make sure we give a chance to the blocked acquire
@@ -2422,17 +3362,35 @@ static u8 lockableProcess(ocrObjectFactory_t * factory, ocrGuid_t guid, ocrObjec
 
             DPRINTF(DBG_LVL_DB_MD, "M_ACQUIRE,PUSH PROCESS: "GUIDF" wb=%d dbMode=%d msg_usefulSize=%"PRId64" msg_bufferSize=%"PRId64" dbSize=%"PRId64"\n",
                     GUIDA(self->guid), (int) mdMsg->writeBack, (int) mdMsg->dbMode, msg->usefulSize, msg->bufferSize, self->size);
-#ifndef ENABLE_LAZY_DB
+#if !defined(ENABLE_LAZY_DB) && !defined(ENABLE_DB_PREFETCH)
             schedulePendingAcquire(self, &(rself->attributes));
 #else
             bool res = schedulePendingAcquire(self, &(rself->attributes));
+#ifdef ENABLE_LAZY_DB
 #ifdef OCR_ASSERT
             if (rself->attributes.isLazy) {
                 DPRINTF(DBG_LVL_LAZY, "DB LAZY - Received PUSH ACQUIRE on DB "GUIDF" from %"PRIu64" and dequed=%d\n", GUIDA(rself->base.guid), msg->srcLocation, res);
             }
 #endif
+#endif
+#ifdef ENABLE_DB_PREFETCH
+            if (!res && (rself->attributes.state == STATE_SHARED) &&
+                (rself->attributes.numUsers == 0) && !rself->attributes.isLazy) {
+                // A prefetched copy, or one whose waiters cannot use it.
+                // Handled as if the last user had just released it.
+                rself->attributes.dbMode = DB_RO;
+                if (!cacheReplica(self, &(rself->attributes))) {
+                    rself->attributes.state = STATE_IDLE;
+                    issueReleaseRequest(self);
+                    schedulePending(self);
+                }
+            }
+#endif
 #endif
             hal_unlock(&rself->lock);
+#ifdef ENABLE_DB_PREFETCH
+            evictReplicas(self);
+#endif
             //TODO-MD-MSGBACK: return OCR_EPEND so that caller doesn't deallocate the message being processed
             retCode = OCR_EPEND;
 #ifdef OCR_ASSERT
@@ -2445,12 +3403,23 @@ static u8 lockableProcess(ocrObjectFactory_t * factory, ocrGuid_t guid, ocrObjec
             ocrDataBlock_t * self = (ocrDataBlock_t *) mdPtr;
             ocrDataBlockLockable_t * rself = (ocrDataBlockLockable_t *) mdPtr;
             hal_lock(&rself->lock);
+            fastPathClose(rself);
             md_push_release_t * mdMsg = (md_push_release_t *) payload;
             ocrAssert(!rself->attributes.hasPeers); // Only master recv push release
             // If WB flag we need to deserialize
             DPRINTF(DBG_LVL_DB_MD, "M_RELEASE: "GUIDF" wb=%d dbMode=%d msg_usefulSize=%"PRId64" msg_bufferSize=%"PRId64" state=%d\n",
                     GUIDA(self->guid), (int) mdMsg->writeBack, (int) mdMsg->dbMode, msg->usefulSize, msg->bufferSize, rself->attributes.state);
-            if (mdMsg->writeBack) {
+#ifdef ENABLE_DB_REPLICA_CACHE
+            // Whatever copy the source had, it is gone
+            rself->replicaLocs[msg->srcLocation/64] &= ~(1ULL << (msg->srcLocation%64));
+#endif
+            if (mdMsg->writeBack && IS_DELTA_WRITEBACK(mdMsg)) {
+                // Only the dirty ranges are written back, patch them in place
+                applyDirtyRanges(self, mdMsg, sizePayload);
+            } else if (mdMsg->writeBack && IS_PARTITION(rself)) {
+                // The payload is a slice of the parent's, copy it back in place
+                hal_memCopy(self->ptr, (void *) &(mdMsg->dbPtr), self->size, false);
+            } else if (mdMsg->writeBack) {
                 ocrPolicyDomain_t * pd;
                 getCurrentEnv(&pd, NULL, NULL, NULL);
                 if (rself->backingPtrMsg) {
@@ -2536,10 +3505,12 @@ static u8 lockableProcess(ocrObjectFactory_t * factory, ocrGuid_t guid, ocrObjec
             ocrDataBlock_t * self = (ocrDataBlock_t *) mdPtr;
             ocrDataBlockLockable_t * rself = (ocrDataBlockLockable_t *) mdPtr;
             hal_lock(&rself->lock);
+            fastPathClose(rself);
             DPRINTF(DEBUG_LVL_BUG, "DB["GUIDF"] setting freeRequest from M_DEL\n", GUIDA(self->guid));
             rself->attributes.freeRequested = 1;
             if (rself->attributes.hasPeers) { // Slave
                 // Notification from the master the current MD is to be deleted
+                releaseCachedReplica(self, &rself->attributes);
             } else { // Master
                 // Notification from a slave it has executed ocrDbDestroy.
                 // Remove slave from known peers
@@ -2556,6 +3527,24 @@ static u8 lockableProcess(ocrObjectFactory_t * factory, ocrGuid_t guid, ocrObjec
             checkMdMode &= ~M_DEL;
 #endif
         }
+#ifdef ENABLE_DB_REPLICA_CACHE
+        if ((mdMode & M_INVALIDATE) && !((ocrDataBlockLockable_t *) mdPtr)->attributes.isLazy) {
+            ocrDataBlock_t * self = (ocrDataBlock_t *) mdPtr;
+            ocrDataBlockLockable_t * rself = (ocrDataBlockLockable_t *) mdPtr;
+            ocrAssert(rself->attributes.hasPeers);
+            hal_lock(&rself->lock);
+            fastPathClose(rself);
+            if (invalidateReplica(self, &rself->attributes)) {
+                // Local acquires may have been queued while releasing
+                schedulePending(self);
+            }
+            hal_unlock(&(rself->lock));
+            mdMode &= ~M_INVALIDATE; // Not meant for the lazy DB handling
+#ifdef OCR_ASSERT
+            checkMdMode &= ~M_INVALIDATE;
+#endif
+        }
+#endif
 #ifdef ENABLE_LAZY_DB
         if (mdMode & M_INVALIDATE) {
             ocrDataBlock_t * self = (ocrDataBlock_t *) mdPtr;
@@ -2563,6 +3552,7 @@ static u8 lockableProcess(ocrObjectFactory_t * factory, ocrGuid_t guid, ocrObjec
             // DPRINTF(DBG_LVL_LAZY, "DB["GUIDF"] received invalidate\n", GUIDA(self->guid));
             ocrAssert(rself->mdPeers != INVALID_LOCATION); // Must be a slave to execute this code
             hal_lock(&rself->lock);
+            fastPathClose(rself);
             // We need to deal with auto-release introducing a race as it executes after the EDT user code
             // if the datablock is currently being used, record the invalidation
             if (rself->attributes.numUsers != 0) {
@@ -2628,17 +3618,22 @@ static u8 lockableProcess(ocrObjectFactory_t * factory, ocrGuid_t guid, ocrObjec
     return retCode;
 }
 
-//If yes, then we just want to send the M_DATA part
-static bool isKnownNonCoherentLocation(ocrDataBlockLockable_t * dself, ocrLocation_t destLocation) {
-    //TODO-MD-EAGER: Limitation: don't support multiple locations so far
-    return (dself->nonCoherentLoc != INVALID_LOCATION);
-}
-
-//Record the location is non-coherent
-static void registerKnownNonCoherentLocation(ocrDataBlockLockable_t * dself, ocrLocation_t destLocation) {
-    //TODO-MD-EAGER: Limitation: don't support multiple locations so far
-    ocrAssert(dself->nonCoherentLoc == INVALID_LOCATION);
-    dself->nonCoherentLoc = destLocation;
+// Record the location holds a non-coherent copy of the DB.
+// Returns false if it already did, then we just want to send the M_DATA part.
+static bool registerKnownNonCoherentLocation(ocrDataBlockLockable_t * dself, ocrLocation_t destLocation) {
+    u64 id = (u64) destLocation;
+    u64 bit = (1ULL << (id % 64));
+    u64 * word = &(dself->nonCoherentLocs[id/64]);
+    u64 cur = *word;
+    // Concurrent pushes to different locations may race on the same word
+    while (!(cur & bit)) {
+        u64 old = hal_cmpswap64(word, cur, (cur | bit));
+        if (old == cur) {
+            return true;
+        }
+        cur = old;
+    }
+    return false;
 }
 
 extern void mdLocalDeguidify(ocrPolicyDomain_t *self, ocrFatGuid_t *guid);
@@ -2661,8 +3656,7 @@ static u8 lockableCloneInternal(ocrObjectFactory_t * pfactory, ocrGuid_t guid, o
         // Going to push data and it requires satifying an event at destination
         u64 mdMode = M_DATA | M_SATISFY;
         ocrAssert(waitersCount != 0); // Probably too tight of a restriction. Leave it for debugging purpose.
-        if (!isKnownNonCoherentLocation(dself, destLocation)) {
-            registerKnownNonCoherentLocation(dself, destLocation);
+        if (registerKnownNonCoherentLocation(dself, destLocation)) {
             DPRINTF(DEBUG_LVL_VVERB, "db-md: registerKnownNonCoherentLocation M_CLONE "GUIDF"\n", GUIDA(guid));
             // First time an EAGER DB is pushed, set the clone flag to install it at destinatiokn
             mdMode |= M_CLONE;
@@ -2710,6 +3704,7 @@ static u8 lockableCloneInternal(ocrObjectFactory_t * pfactory, ocrGuid_t guid, o
         PD_MSG_FIELD_I(factoryId) = self->fctId;
         PD_MSG_FIELD_I(response) = NULL;
         PD_MSG_FIELD_I(mdPtr) = NULL;
+        PD_MSG_FIELD_I(extPayload) = NULL;
         DPRINTF(DEBUG_LVL_VVERB, "db-md: push "GUIDF" in mode=%"PRIx64" isEager(%"PRIu64")\n", GUIDA(guid), mdMode, (mdMode & M_CLONE));
         PD_MSG_FIELD_I(sizePayload) = mdSize;
         char * ptr = &(PD_MSG_FIELD_I(payload));
@@ -2720,7 +3715,6 @@ static u8 lockableCloneInternal(ocrObjectFactory_t * pfactory, ocrGuid_t guid, o
         }
         ptr += baseMdSize;
         md_push_satisfy_t * satPtr = (md_push_satisfy_t *) ptr;
-        ocrAssert(waitersCount == 1);
         satPtr->waitersCount = waitersCount;
         // serializing the data into the destBuffer
         hal_memCopy(&(satPtr->regNodesPtr), waitersPtr, (sizeof(regNode_t) * waitersCount), false);
@@ -2745,6 +3739,7 @@ static u8 lockableCloneInternal(ocrObjectFactory_t * pfactory, ocrGuid_t guid, o
         PD_MSG_FIELD_I(factoryId) = ((ocrDataBlockFactory_t *)pfactory)->factoryId;
         PD_MSG_FIELD_I(response) = NULL;
         PD_MSG_FIELD_I(mdPtr) = NULL;
+        PD_MSG_FIELD_I(extPayload) = NULL;
         DPRINTF (DBG_LVL_DB_MD, "db-md: pull "GUIDF" in mode=M_CLONE\n", GUIDA(guid));
         PD_MSG_FIELD_I(sizePayload) = 0;
         // Don't add any specific payload since the src is encoded in the message
@@ -2796,6 +3791,10 @@ static u8 lockableSerialize(ocrObjectFactory_t * factory, ocrGuid_t guid,
         //and context-dependent information. Hence, serialize can only put default values while the
         //calling context patches it up.
         mdBuffer->isEager = false;
+#ifdef DB_STATS_LOCKABLE
+        mdBuffer->creatorTemplate = dself->stats.creatorTemplate;
+        mdBuffer->creatorFunc = dself->stats.creatorFunc;
+#endif
         writePtr = writePtr + sizeof(md_push_clone_t);
         u64 hintSize = OCR_RUNTIME_HINT_GET_SIZE(dself->hint.hintMask);
         if (hintSize > 0) {
@@ -2925,6 +3924,10 @@ static u8 lockableDeserialize(ocrObjectFactory_t * pfactory, ocrGuid_t dbGuid, o
                                                    NULL, isEager, /*isClone=*/isClone, false, srcLoc), ==, 0);
         ocrAssert(fguid.metaDataPtr != NULL);
         *dest = fguid.metaDataPtr;
+#ifdef DB_STATS_LOCKABLE
+        ((ocrDataBlockLockable_t *) *dest)->stats.creatorTemplate = mdMsg->creatorTemplate;
+        ((ocrDataBlockLockable_t *) *dest)->stats.creatorFunc = mdMsg->creatorFunc;
+#endif
         curPtr = (curPtr + (sizeof(md_push_clone_t) + (hasHint ? sizeof(u64)*(hintSize+1) : 0)));
     }
 
@@ -2995,7 +3998,7 @@ static u8 lockableDeserialize(ocrObjectFactory_t * pfactory, ocrGuid_t dbGuid, o
         u32 i = 0;
         PD_MSG_STACK(msg);
         DPRINTF(DEBUG_LVL_VERB, "Processing M_SATISFY waitersCount=%"PRIu32"\n", waitersCount);
-        ocrAssert(waitersCount == 1);
+        ocrAssert(waitersCount != 0);
         while (i < waitersCount) {
 #define PD_MSG (&msg)
 #define PD_TYPE PD_MSG_DEP_SATISFY
@@ -3038,6 +4041,14 @@ static u8 lockableDeserialize(ocrObjectFactory_t * pfactory, ocrGuid_t dbGuid, o
 /******************************************************/
 
 void destructLockableFactory(ocrObjectFactory_t *factory) {
+#ifdef DB_STATS_LOCKABLE
+    dbLockableStatsTable_t * table = ((ocrDataBlockFactoryLockable_t *) factory)->statsTable;
+    dumpDbStats(table);
+    if (table->templates != NULL) {
+        table->pd->fcts.pdFree(table->pd, table->templates);
+    }
+    runtimeChunkFree((u64) table, PERSISTENT_CHUNK);
+#endif
     runtimeChunkFree((u64)((ocrDataBlockFactory_t*)factory)->hintPropMap, PERSISTENT_CHUNK);
     runtimeChunkFree((u64)factory, PERSISTENT_CHUNK);
 }
@@ -3070,14 +4081,43 @@ ocrDataBlockFactory_t *newDataBlockFactoryLockable(ocrParamList_t *perType, u32
     base->fcts.setHint = FUNC_ADDR(u8 (*)(ocrDataBlock_t*, ocrHint_t*), lockableSetHint);
     base->fcts.getHint = FUNC_ADDR(u8 (*)(ocrDataBlock_t*, ocrHint_t*), lockableGetHint);
     base->fcts.getRuntimeHint = FUNC_ADDR(ocrRuntimeHint_t* (*)(ocrDataBlock_t*), getRuntimeHintDbLockable);
+#ifdef ENABLE_EXTENSION_DB_PARTITION
+    base->fcts.partition = FUNC_ADDR(u8 (*)(ocrDataBlock_t*, u32, u64*, u64*, ocrGuid_t*), lockablePartition);
+#endif
+#ifdef ENABLE_EXTENSION_DB_DIRTY_RANGE
+    base->fcts.markDirty = FUNC_ADDR(u8 (*)(ocrDataBlock_t*, u64, u64), lockableMarkDirty);
+#endif
+#ifdef ENABLE_DB_PREFETCH
+    base->fcts.prefetch = FUNC_ADDR(u8 (*)(ocrDataBlock_t*, ocrDbAccessMode_t), lockablePrefetch);
+#endif
 #ifdef ENABLE_RESILIENCY
     base->fcts.getSerializationSize = FUNC_ADDR(u8 (*)(ocrDataBlock_t*, u64*), getSerializationSizeDataBlockLockable);
     base->fcts.serialize = FUNC_ADDR(u8 (*)(ocrDataBlock_t*, u8*), serializeDataBlockLockable);
     base->fcts.deserialize = FUNC_ADDR(u8 (*)(u8*, ocrDataBlock_t**), deserializeDataBlockLockable);
     base->fcts.fixup = FUNC_ADDR(u8 (*)(ocrDataBlock_t*), fixupDataBlockLockable);
     base->fcts.reset = FUNC_ADDR(u8 (*)(ocrDataBlock_t*), resetDataBlockLockable);
+#endif
+#ifdef ENABLE_DB_REPLICA_CACHE
+    ocrDataBlockFactoryLockable_t * rbase = (ocrDataBlockFactoryLockable_t *) base;
+    rbase->replicaCacheSize = (perType != NULL) ? ((paramListDataBlockFactLockable_t *) perType)->replicaCacheSize : DB_REPLICA_CACHE_SIZE;
+    rbase->replicaCacheUsed = 0;
+    rbase->replicaLock = INIT_LOCK;
+    rbase->replicaHead = NULL;
+    rbase->replicaTail = NULL;
+#endif
+#ifdef DB_STATS_LOCKABLE
+    dbLockableStatsTable_t * statsTable = (dbLockableStatsTable_t *)
+        runtimeChunkAlloc(sizeof(dbLockableStatsTable_t), PERSISTENT_CHUNK);
+    statsTable->lock = INIT_LOCK;
+    statsTable->pd = NULL;
+    statsTable->templates = NULL;
+    statsTable->templateCount = 0;
+    statsTable->templateMax = 0;
+    statsTable->hotCount = 0;
+    ((ocrDataBlockFactoryLockable_t *) base)->statsTable = statsTable;
 #endif
     base->factoryId = factoryId;
+    base->dbProps = 0;
     //Setup hint framework
     base->hintPropMap = (u64*)runtimeChunkAlloc(sizeof(u64)*(OCR_HINT_DB_PROP_END - OCR_HINT_DB_PROP_START - 1), PERSISTENT_CHUNK);
     OCR_HINT_SETUP(base->hintPropMap, ocrHintPropDbLockable, OCR_HINT_COUNT_DB_LOCKABLE, OCR_HINT_DB_PROP_START, OCR_HINT_DB_PROP_END);
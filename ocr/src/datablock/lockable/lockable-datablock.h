@@ -29,10 +29,31 @@
 #define OCR_HINT_COUNT_DB_LOCKABLE   0
 #endif
 
+#ifdef DB_STATS_LOCKABLE
+struct _dbLockableStatsTable_t;
+#endif
+
 typedef struct {
     ocrDataBlockFactory_t base;
+#ifdef ENABLE_DB_REPLICA_CACHE
+    u64 replicaCacheSize; /**< Budget in bytes of read-only replicas kept by this PD */
+    volatile u64 replicaCacheUsed; /**< Bytes of read-only replicas currently kept */
+    lock_t replicaLock; /**< Protects the list of replicas kept */
+    struct _ocrDataBlockLockable_t * replicaHead; /**< Most recently used replica kept */
+    struct _ocrDataBlockLockable_t * replicaTail; /**< Least recently used replica kept, evicted first */
+#endif
+#ifdef DB_STATS_LOCKABLE
+    struct _dbLockableStatsTable_t * statsTable; /**< Statistics of the DBs destroyed in this PD */
+#endif
 } ocrDataBlockFactoryLockable_t;
 
+#ifdef ENABLE_DB_REPLICA_CACHE
+typedef struct {
+    paramListDataBlockFact_t base;
+    u64 replicaCacheSize; /**< 'replicacache' key of the factory's section, in bytes */
+} paramListDataBlockFactLockable_t;
+#endif
+
 typedef union {
     struct {
         u64 state      : 2;   // Current state of the DB
@@ -47,7 +68,9 @@ typedef union {
         u64 numUsers   : 15;  // Number of consumers checked-in
         u64 freeRequested: 1; // dbDestroy has been called
         u64 singleAssign : 1; // Single assignment done
-        u64 _padding   : 21;
+        u64 isCached   : 1;   // Read-only copy kept in the replica cache
+        u64 isInvalid  : 1;   // Invalidated while in use, must not be cached
+        u64 _padding   : 19;
     };
     u64 data;
 } ocrDataBlockLockableAttr_t;
@@ -63,6 +86,34 @@ struct _ocrPolicyMsg_t;
 #define DB_MAX_LOC (1<<GUID_PROVIDER_LOCID_SIZE)
 #define DB_MAX_LOC_ARRAY ((DB_MAX_LOC/64)+1)
 
+// Lock-free local read acquire/release. Disabled when acquire and release
+// have side effects that must be serialized with the DB state.
+#if defined(ENABLE_LOCKABLE_DB_FASTPATH) && !defined(ENABLE_RESILIENCY) && \
+    !defined(DB_STATS_LOCKABLE) && !defined(OCR_ENABLE_STATISTICS)
+#define LOCKABLE_FAST_PATH
+#endif
+
+// Dirty ranges a remote RW copy tracks before falling back to a full write back
+#ifdef ENABLE_EXTENSION_DB_DIRTY_RANGE
+#ifndef DB_MAX_DIRTY_RANGES
+#define DB_MAX_DIRTY_RANGES 16
+#endif
+#endif
+
+// Default budget of the read-only replica cache when not set in the configuration
+#ifdef ENABLE_DB_REPLICA_CACHE
+#ifndef DB_REPLICA_CACHE_SIZE
+#define DB_REPLICA_CACHE_SIZE (64*1024*1024)
+#endif
+#endif
+
+// Smallest payload sent to another PD from the DB's memory rather than from a copy
+#ifdef ENABLE_DB_ZERO_COPY
+#ifndef DB_ZERO_COPY_THRESHOLD
+#define DB_ZERO_COPY_THRESHOLD (16*1024)
+#endif
+#endif
+
 // DB Stats
 #ifdef DB_STATS_LOCKABLE
 #define CNT_LOCAL_RELEASE   0
@@ -71,11 +122,56 @@ struct _ocrPolicyMsg_t;
 #define CNT_REMOTE_ACQUIRE  3
 #define CNT_EAGER_CLONE     4
 #define CNT_EAGER_PULL      5
-#define CNT_MAX             6
+#define CNT_CONTENDED       6 // Acquires, local or remote, that had to be queued
+#define CNT_BYTES_SENT      7 // Payload bytes sent to other PDs (fetch, write back, clone)
+#define CNT_MAX             8
+
+// Number of hottest DBs (by number of acquires) reported per PD
+#ifndef DB_STATS_TOP_N
+#define DB_STATS_TOP_N 16
+#endif
 
 typedef struct {
     u64 counters[CNT_MAX];
+    u64 waitTime[DB_MODE_COUNT]; /**< Time in ns queued local acquires waited, per requested mode */
+    ocrGuid_t creatorTemplate; /**< Template of the EDT that created the DB */
+    u64 creatorFunc; /**< Function of the EDT that created the DB */
 } dbLockableStats_t;
+
+// Statistics of the DBs created by EDTs of the same template
+typedef struct {
+    ocrGuid_t creatorTemplate;
+    u64 creatorFunc;
+    u64 dbCount;
+    u64 counters[CNT_MAX];
+    u64 waitTime[DB_MODE_COUNT];
+} dbLockableTemplateStats_t;
+
+typedef struct {
+    ocrGuid_t guid;
+    ocrGuid_t creatorTemplate;
+    u64 acquires;
+    u64 contended;
+    u64 bytesSent;
+    u64 waitTime;
+} dbLockableHotStats_t;
+
+/**
+ * @brief Statistics of a PD's lockable DBs
+ *
+ * Each DB instance folds its statistics in the table of its PD when it
+ * is destroyed. The table is dumped in 'DbStatsNode<location>' when the
+ * factory is destroyed. DBs that are never destroyed are not accounted for.
+ */
+typedef struct _dbLockableStatsTable_t {
+    lock_t lock;
+    struct _ocrPolicyDomain_t * pd; /**< PD of the DBs, set once one is destroyed */
+    dbLockableTemplateStats_t * templates;
+    u32 templateCount;
+    u32 templateMax;
+    dbLockableHotStats_t hottest[DB_STATS_TOP_N];
+    u32 hotCount;
+} dbLockableStatsTable_t;
 #endif
 
 /**
@@ -115,18 +211,69 @@ typedef struct {
  *   the incoming payload.
  * - It is better to keep reusing a datablock instance rather than keep creating/destroying new
  *   ones to avoid extra overheads.
+ * - To broadcast a DB, satisfy a persistent event that has all the consumers registered. Remote
+ *   waiters are grouped per PD and the DB is pushed once to each PD, bundled with the satisfaction
+ *   of all the waiters there. Local consumers at a destination share the same eager copy.
  *
  * Limitations (reason):
- * - The EAGER hint is only honored when satisfying a channel event
- *   (avoids checking the hint for all events)
- * - The channel-event being satisfied with an eager DB must have a single dependence
- *   (just did not impl for multiple recipient, check nonCoherentLoc and waitersCount)
+ * - The EAGER hint is only honored when satisfying a channel event or when a persistent event
+ *   is satisfied with waiters already registered (avoids checking the hint for all events)
+ * - The DB metadata must be local to the PD satisfying the event
+ *
+ *
+ * Delta write back:
+ *
+ * Users may declare the byte ranges they modify in a DB acquired in a write mode. When a remote
+ * copy has dirty ranges, its release only writes these ranges back and the master patches them
+ * into its own copy. The ranges are compacted at the beginning of the acquire message that holds
+ * the copy, followed by their descriptors, so no extra buffer is needed. Too many ranges, or
+ * ranges covering most of the DB, fall back to a full write back.
+ *
+ *
+ * Replica cache:
+ *
+ * A PD that acquires a remote DB in a read mode may keep its copy once the last local
+ * user is done instead of releasing it back to the master. Later local read acquires are
+ * granted from the copy without fetching it again. The master still counts the copy as
+ * a user and remembers which locations hold one until they release it. A writer, local or
+ * remote, that finds such copies makes the master send M_INVALIDATE to these locations and
+ * is granted once they have released their copies, which they do as soon as they are not
+ * in use. A remote writer granted while the master is shared without replicas puts it in
+ * its write mode so that later readers wait for its write-back. Copies are also released
+ * on M_DEL when the DB is destroyed. The copies kept by a PD are ordered by their last
+ * release. When keeping one puts the PD over the 'replicacache' budget of the factory, the
+ * least recently used copies that are not in use are released back to their master until
+ * the kept bytes fit again. Copies larger than the budget are never kept. A budget of 0
+ * disables replicas and the master then grants writers as without the cache.
+ *
+ *
+ * Partitions:
+ *
+ * A partition is a DB whose payload is a slice of its parent's payload. The master MD
+ * of a partition never owns memory: remote write-backs are copied in place instead of
+ * adopting the incoming message's buffer. Clones of a partition are regular clones of
+ * the slice. Each partition holds a runtime RW (or CONST) acquire on its parent that is
+ * released when the partition is destroyed. This keeps the parent's storage and orders
+ * the parent's conflicting acquires until then.
+ *
+ *
+ * Copy-on-write:
+ *
+ * For DBs created with DB_PROP_COPY_ON_WRITE, a local writer acquiring the master MD while
+ * local CONST users hold it is granted a private copy of the current content. The users
+ * keep reading the previous version in place. All other acquires, local or remote, are
+ * queued until both the writer and the readers have released the DB; the writer's copy
+ * is then copied back and the queued acquires are processed. This lets one writer overlap
+ * with the readers of the previous version, it does not keep more than two versions.
  *
  */
 typedef struct _ocrDataBlockLockable_t {
     ocrDataBlock_t base;
     lock_t lock; /**< Lock for this data-block */
     ocrDataBlockLockableAttr_t attributes; /**< Attributes for this data-block */
+#ifdef LOCKABLE_FAST_PATH
+    volatile u32 fastUsers; /**< Users checked-in without taking the lock */
+#endif
     struct _dbWaiter_t * localWaitQueues[DB_MODE_COUNT]; /** Per mode local waiters queued to acquire the db */
     Queue_t * remoteWaitQueues[DB_MODE_COUNT]; /** Per mode remote PD waiters queued to acquire the db */
     struct _ocrPolicyMsg_t * backingPtrMsg; /** Pointer to a policy message that stores the DB's data */
@@ -143,10 +290,25 @@ typedef struct _ocrDataBlockLockable_t {
 #ifdef DB_STATS_LOCKABLE
     dbLockableStats_t stats; /**< Datablock statistics */
 #endif
-    ocrLocation_t nonCoherentLoc; /**< Whether or not coherence must be kept */
+    u64 nonCoherentLocs[DB_MAX_LOC_ARRAY]; /**< Locations holding an eager (non-coherent) copy */
 #ifdef ENABLE_LAZY_DB
     //TODO-LAZY: Limitation: currently track a single location
     ocrLocation_t lazyLoc; /**< Location that's currently owning the DB in lazy mode */
+#endif
+#ifdef ENABLE_EXTENSION_DB_PARTITION
+    ocrDataBlock_t * parent; /**< Master MD this DB is a partition of, if any */
+#endif
+#ifdef ENABLE_DB_REPLICA_CACHE
+    u64 replicaLocs[DB_MAX_LOC_ARRAY]; /**< Locations that may keep a read-only replica */
+    struct _ocrDataBlockLockable_t * replicaPrev; /**< More recently used replica kept by this PD */
+    struct _ocrDataBlockLockable_t * replicaNext; /**< Less recently used replica kept by this PD */
+#endif
+#ifdef ENABLE_EXTENSION_DB_COPY_ON_WRITE
+    void * cowPtr; /**< Writer's copy while readers hold the previous version */
+#endif
+#ifdef ENABLE_EXTENSION_DB_DIRTY_RANGE
+    u32 dirtyCount; /**< Number of dirty ranges recorded on a remote RW copy */
+    u64 dirtyRanges[DB_MAX_DIRTY_RANGES*2]; /**< Sorted and disjoint [start, end) byte ranges */
 #endif
     ocrRuntimeHint_t hint; // Warning must be the last
 } ocrDataBlockLockable_t;
@@ -391,7 +391,17 @@ ocrDataBlockFactory_t *newDataBlockFactoryRegular(ocrParamList_t *perType, u32 f
     base->fcts.setHint = FUNC_ADDR(u8 (*)(ocrDataBlock_t*, ocrHint_t*), regularSetHint);
     base->fcts.getHint = FUNC_ADDR(u8 (*)(ocrDataBlock_t*, ocrHint_t*), regularGetHint);
     base->fcts.getRuntimeHint = FUNC_ADDR(ocrRuntimeHint_t* (*)(ocrDataBlock_t*), getRuntimeHintDbRegular);
+#ifdef ENABLE_EXTENSION_DB_PARTITION
+    base->fcts.partition = NULL;
+#endif
+#ifdef ENABLE_EXTENSION_DB_DIRTY_RANGE
+    base->fcts.markDirty = NULL;
+#endif
+#ifdef ENABLE_DB_PREFETCH
+    base->fcts.prefetch = NULL;
+#endif
     base->factoryId = factoryId;
+    base->dbProps = 0;
     //Setup hint framework
     base->hintPropMap = (u64*)runtimeChunkAlloc(sizeof(u64)*(OCR_HINT_DB_PROP_END - OCR_HINT_DB_PROP_START - 1), PERSISTENT_CHUNK);
     OCR_HINT_SETUP(base->hintPropMap, ocrHintPropDbRegular, OCR_HINT_COUNT_DB_REGULAR, OCR_HINT_DB_PROP_START, OCR_HINT_DB_PROP_END);
@@ -0,0 +1,955 @@
+/**
+ * @brief Single-assignment data-block implementation
+ **/
+
+/*
+ * This file is subject to the license agreement located in the file LICENSE
+ * and cannot be distributed without it. This notice cannot be
+ * removed or modified.
+ */
+
+#include "ocr-config.h"
+#ifdef ENABLE_DATABLOCK_SINGLE_ASSIGN
+
+#include "ocr-hal.h"
+#include "datablock/single-assign/single-assign-datablock.h"
+#include "debug.h"
+#include "ocr-comp-platform.h"
+#include "ocr-datablock.h"
+#include "ocr-errors.h"
+#include "ocr-policy-domain.h"
+#include "ocr-sysboot.h"
+#include "utils/ocr-utils.h"
+#include "extensions/ocr-hints.h"
+
+#ifdef OCR_ENABLE_STATISTICS
+#include "ocr-statistics.h"
+#include "ocr-statistics-callbacks.h"
+#endif
+
+#define DEBUG_TYPE DATABLOCK
+
+// Datablock written once, by the EDT creating it, through the acquire
+// that comes with the creation. Releasing that acquire publishes the DB.
+// From there on acquires can only read and are a reference count update:
+// there is no lock and no mode queue to go through. Reads issued before
+// the publication wait for it.
+//
+// In distributed, the DB lives in the PD that created it. Other PDs pull a
+// copy once and keep it as a read-only replica for the DB's lifetime: the
+// data never changes so there is no coherence traffic past the clone.
+// Destroying the DB from any PD destroys the original and all its replicas.
+
+#define DFLT_PEND_MSG_Q_SIZE 4
+
+// Actions carried out on the DB metadata. Clones are pulled by the PD's
+// default datablock factory, hence the encoding shared with lockable DBs.
+#define M_CLONE           0x1
+#define M_DATA            0x8
+#define M_DEL             0x10
+
+// 'IN' size of PD_MSG_METADATA_COMM
+#define MSG_MDCOMM_SZ       (_PD_MSG_SIZE_IN(PD_MSG_METADATA_COMM))
+
+// To tweak the debug level for DB metadata
+#ifndef DBG_LVL_DB_MD
+#define DBG_LVL_DB_MD DEBUG_LVL_VERB
+#endif
+
+/***********************************************************/
+/* OCR-SingleAssign Datablock Hint Properties              */
+/* (Add implementation specific supported properties here) */
+/***********************************************************/
+
+u64 ocrHintPropDbSingleAssign[] = {
+#ifdef ENABLE_HINTS
+    OCR_HINT_DB_AFFINITY
+#endif
+};
+
+//Make sure OCR_HINT_COUNT_DB_SINGLE_ASSIGN in single-assign-datablock.h is equal to the length of array ocrHintPropDbSingleAssign
+ocrStaticAssert((sizeof(ocrHintPropDbSingleAssign)/sizeof(u64)) == OCR_HINT_COUNT_DB_SINGLE_ASSIGN);
+ocrStaticAssert(OCR_HINT_COUNT_DB_SINGLE_ASSIGN < OCR_RUNTIME_HINT_PROP_BITS);
+
+// Payload of a replica sent to another PD
+typedef struct _md_push_sa_clone_t {
+    u64 size;
+    u32 flags;
+    char * dbPtr; // Start of the DB's data
+} md_push_sa_clone_t;
+
+#define SA_CLONE_HEADER_SZ ((u64) &(((md_push_sa_clone_t*)0)->dbPtr))
+
+// Read acquire waiting for the DB to be published
+typedef struct _saWaiter_t {
+    ocrFatGuid_t fguid;
+    ocrLocation_t dstLoc;
+    u32 slot;
+    u32 properties; // properties specified with the acquire request
+    bool isInternal;
+    struct _saWaiter_t * next;
+} saWaiter_t;
+
+/******************************************************/
+/* OCR-SingleAssign Datablock                         */
+/******************************************************/
+
+// Forward declaraction
+u8 singleAssignDestruct(ocrDataBlock_t *self);
+static u8 singleAssignSerialize(ocrObjectFactory_t * factory, ocrGuid_t guid,
+                                ocrObject_t * src, u64 * mode, ocrLocation_t destLocation,
+                                void ** destBuffer, u64 * destSize);
+
+static void setTrackID(u64 * tracker, ocrLocation_t locId) {
+    u64 id = (u64) locId;
+    tracker[id/64] |=  (1ULL << (id % 64));
+}
+
+static void clearTrackID(u64 * tracker, ocrLocation_t locId) {
+    u64 id = ((u64) locId);
+    tracker[id/64] &= ~(1ULL << (id % 64));
+}
+
+static saWaiter_t * newWaiter(ocrPolicyDomain_t * pd, ocrFatGuid_t edt, ocrLocation_t dstLoc,
+                              u32 edtSlot, bool isInternal, u32 properties) {
+    saWaiter_t * waiter = (saWaiter_t *) pd->fcts.pdMalloc(pd, sizeof(saWaiter_t));
+    waiter->fguid = edt;
+    waiter->dstLoc = dstLoc;
+    waiter->slot = edtSlot;
+    waiter->isInternal = isInternal;
+    waiter->properties = properties;
+    waiter->next = NULL;
+    return waiter;
+}
+
+// Lock-free check-in of a reader. Fails if the DB is not published yet.
+static bool tryAcquirePublished(ocrDataBlockSingleAssign_t * rself) {
+    ocrDataBlockSingleAssignAttr_t cur, next;
+    cur.data = rself->attributes.data;
+    while (cur.published && !cur.freeRequested) {
+        next.data = cur.data;
+        next.numUsers += 1;
+        u64 old = hal_cmpswap64((u64 *) &(rself->attributes.data), cur.data, next.data);
+        if (old == cur.data) {
+            return true;
+        }
+        cur.data = old;
+    }
+    return false;
+}
+
+// Sets freeRequested, returns false if it already was
+static bool requestFree(ocrDataBlockSingleAssign_t * rself, ocrDataBlockSingleAssignAttr_t * attr) {
+    ocrDataBlockSingleAssignAttr_t cur, next;
+    cur.data = rself->attributes.data;
+    while (!cur.freeRequested) {
+        next.data = cur.data;
+        next.freeRequested = 1;
+        u64 old = hal_cmpswap64((u64 *) &(rself->attributes.data), cur.data, next.data);
+        if (old == cur.data) {
+            attr->data = next.data;
+            return true;
+        }
+        cur.data = old;
+    }
+    return false;
+}
+
+// Hand out the DB to an acquire that could not be answered synchronously.
+// The waiter must already be accounted for in numUsers.
+static void processAcquireCallback(ocrDataBlock_t * self, saWaiter_t * waiter) {
+    ocrPolicyDomain_t * pd = NULL;
+    PD_MSG_STACK(msg);
+    getCurrentEnv(&pd, NULL, NULL, &msg);
+    ocrAssert(waiter->slot != EDT_SLOT_NONE);
+    ocrAssert(waiter->dstLoc == pd->myLocation);
+#define PD_MSG (&msg)
+#define PD_TYPE PD_MSG_DB_ACQUIRE
+    msg.type = PD_MSG_DB_ACQUIRE | PD_MSG_RESPONSE;
+    PD_MSG_FIELD_IO(guid.guid) = self->guid;
+    PD_MSG_FIELD_IO(guid.metaDataPtr) = self;
+    PD_MSG_FIELD_IO(edt) = waiter->fguid;
+    PD_MSG_FIELD_IO(destLoc) = waiter->dstLoc;
+    PD_MSG_FIELD_IO(edtSlot) = waiter->slot;
+    PD_MSG_FIELD_IO(properties) = waiter->properties;
+    // A response msg is being built, must set all the OUT fields
+    PD_MSG_FIELD_O(ptr) = self->ptr;
+    PD_MSG_FIELD_O(size) = self->size;
+    PD_MSG_FIELD_O(returnDetail) = 0;
+#undef PD_MSG
+#undef PD_TYPE
+    pd->fcts.pdFree(pd, waiter);
+    RESULT_ASSERT(pd->fcts.processMessage(pd, &msg, true), ==, 0);
+}
+
+// Sends a copy of the DB, metadata and data, to a PD that requested a clone
+static void answerCloneRequest(ocrDataBlock_t * self, ocrLocation_t destLocation) {
+    ocrPolicyDomain_t *pd = NULL;
+    getCurrentEnv(&pd, NULL, NULL, NULL);
+    u64 mdMode = M_CLONE | M_DATA;
+    u64 mdSize = SA_CLONE_HEADER_SZ + self->size;
+    u64 msgSize = MSG_MDCOMM_SZ + mdSize;
+    ocrPolicyMsg_t * msg;
+    PD_MSG_STACK(msgStack);
+    u32 msgProp = 0;
+    if (msgSize > sizeof(ocrPolicyMsg_t)) {
+        msg = (ocrPolicyMsg_t *) allocPolicyMsg(pd, &msgSize);
+        initializePolicyMessage(msg, msgSize);
+        getCurrentEnv(NULL, NULL, NULL, msg);
+        msgProp = PERSIST_MSG_PROP;
+    } else {
+        msg = &msgStack;
+        getCurrentEnv(NULL, NULL, NULL, &msgStack);
+    }
+    DPRINTF(DBG_LVL_DB_MD, "answerCloneRequest "GUIDF" to PD=%"PRIu64"\n", GUIDA(self->guid), (u64) destLocation);
+#define PD_MSG (msg)
+#define PD_TYPE PD_MSG_METADATA_COMM
+    msg->type = PD_MSG_METADATA_COMM | PD_MSG_REQUEST;
+    msg->destLocation = destLocation;
+    PD_MSG_FIELD_I(guid) = self->guid;
+    PD_MSG_FIELD_I(direction) = MD_DIR_PUSH;
+    PD_MSG_FIELD_I(op) = 0; /*ocrObjectOperation_t*/
+    PD_MSG_FIELD_I(mode) = mdMode;
+    PD_MSG_FIELD_I(factoryId) = self->fctId;
+    PD_MSG_FIELD_I(sizePayload) = mdSize;
+    PD_MSG_FIELD_I(response) = NULL;
+    PD_MSG_FIELD_I(mdPtr) = NULL;
+    PD_MSG_FIELD_I(extPayload) = NULL;
+    void * payload = (void *) &PD_MSG_FIELD_I(payload);
+#undef PD_MSG
+#undef PD_TYPE
+    singleAssignSerialize(pd->factories[self->fctId], self->guid, (ocrObject_t *) self, &mdMode, destLocation, &payload, &mdSize);
+    pd->fcts.sendMessage(pd, destLocation, msg, NULL, msgProp);
+}
+
+static void sendDelMessage(ocrDataBlock_t * self, ocrLocation_t destLocation) {
+    ocrPolicyDomain_t * pd;
+    PD_MSG_STACK(msg);
+    getCurrentEnv(&pd, NULL, NULL, &msg);
+    msg.destLocation = destLocation;
+#define PD_MSG (&msg)
+#define PD_TYPE PD_MSG_METADATA_COMM
+    msg.type = PD_MSG_METADATA_COMM | PD_MSG_REQUEST;
+    PD_MSG_FIELD_I(guid) = self->guid;
+    PD_MSG_FIELD_I(direction) = MD_DIR_PUSH;
+    PD_MSG_FIELD_I(op) = 0; /*ocrObjectOperation_t*/
+    PD_MSG_FIELD_I(mode) = M_DEL;
+    PD_MSG_FIELD_I(factoryId) = self->fctId;
+    PD_MSG_FIELD_I(sizePayload) = 0;
+    PD_MSG_FIELD_I(response) = NULL;
+    PD_MSG_FIELD_I(mdPtr) = NULL;
+    PD_MSG_FIELD_I(extPayload) = NULL;
+#undef PD_MSG
+#undef PD_TYPE
+    pd->fcts.sendMessage(pd, destLocation, &msg, NULL, 0);
+}
+
+// Distributed destruction: a replica notifies the original which
+// notifies all the other replicas.
+static void issueDelMessages(ocrDataBlockSingleAssign_t * rself, ocrLocation_t srcToAvoid) {
+    ocrDataBlock_t * self = (ocrDataBlock_t *) rself;
+    if (rself->attributes.isReplica) {
+        if (srcToAvoid == INVALID_LOCATION) {
+            ocrPolicyDomain_t * pd;
+            getCurrentEnv(&pd, NULL, NULL, NULL);
+            ocrLocation_t ownerLocation;
+            pd->guidProviders[0]->fcts.getLocation(pd->guidProviders[0], self->guid, &ownerLocation);
+            sendDelMessage(self, ownerLocation);
+        } // else the notification comes from the original
+        return;
+    }
+    u64 replicaLocs[DB_SA_MAX_LOC_ARRAY];
+    u32 i;
+    hal_lock(&(rself->lock));
+    if (srcToAvoid != INVALID_LOCATION) {
+        clearTrackID(rself->replicaLocs, srcToAvoid);
+    }
+    for (i = 0; i < DB_SA_MAX_LOC_ARRAY; i++) {
+        replicaLocs[i] = rself->replicaLocs[i];
+    }
+    hal_unlock(&(rself->lock));
+    for (i = 0; i < DB_SA_MAX_LOC_ARRAY; i++) {
+        u64 cur = replicaLocs[i];
+        u8 nbShift = 0;
+        while (cur != 0) {
+            if (cur & 1ULL) {
+                ocrLocation_t destLoc = (ocrLocation_t) ((i*64)+nbShift);
+                DPRINTF(DBG_LVL_DB_MD, "(GUID: "GUIDF") Notify location %"PRIu64" for M_DEL\n", GUIDA(self->guid), (u64) destLoc);
+                sendDelMessage(self, destLoc);
+            }
+            cur >>= 1;
+            nbShift++;
+        }
+    }
+}
+
+// Releasing the single assignment makes the DB visible to readers
+static u8 publish(ocrDataBlock_t * self) {
+    ocrDataBlockSingleAssign_t * rself = (ocrDataBlockSingleAssign_t *) self;
+    ocrPolicyDomain_t * pd = NULL;
+    getCurrentEnv(&pd, NULL, NULL, NULL);
+    // The assigned data must be visible before the DB is
+    hal_fence();
+    hal_lock(&(rself->lock));
+    saWaiter_t * waiters = rself->localWaiters;
+    rself->localWaiters = NULL;
+    Queue_t * cloneRequests = rself->cloneRequests;
+    rself->cloneRequests = NULL;
+    u32 waitersCount = 0;
+    saWaiter_t * waiter = waiters;
+    while (waiter != NULL) {
+        waitersCount++;
+        waiter = waiter->next;
+    }
+    // Track replicas before they are sent so that a destruction reaches them
+    if (cloneRequests != NULL) {
+        u32 i, sz = queueGetSize(cloneRequests);
+        for (i = 0; i < sz; i++) {
+            setTrackID(rself->replicaLocs, ((ocrPolicyMsg_t *) queueGet(cloneRequests, i))->srcLocation);
+        }
+    }
+    // Pending readers are checked-in along with the publication
+    ocrDataBlockSingleAssignAttr_t cur, next;
+    cur.data = rself->attributes.data;
+    while (true) {
+        ocrAssert(cur.numUsers == 1);
+        next.data = cur.data;
+        next.numUsers = waitersCount;
+        next.published = 1;
+        u64 old = hal_cmpswap64((u64 *) &(rself->attributes.data), cur.data, next.data);
+        if (old == cur.data) {
+            break;
+        }
+        cur.data = old;
+    }
+    hal_unlock(&(rself->lock));
+    DPRINTF(DEBUG_LVL_VERB, "DB (GUID: "GUIDF") published, granting %"PRIu32" pending readers\n",
+            GUIDA(self->guid), waitersCount);
+    while (waiters != NULL) {
+        saWaiter_t * nextWaiter = waiters->next;
+        processAcquireCallback(self, waiters);
+        waiters = nextWaiter;
+    }
+    if (cloneRequests != NULL) {
+        while (!queueIsEmpty(cloneRequests)) {
+            ocrPolicyMsg_t * msg = (ocrPolicyMsg_t *) queueRemoveLast(cloneRequests);
+            answerCloneRequest(self, msg->srcLocation);
+            pd->fcts.pdFree(pd, msg);
+        }
+        queueDestroy(cloneRequests);
+    }
+    if ((next.numUsers == 0) && next.freeRequested) {
+        return singleAssignDestruct(self);
+    }
+    return 0;
+}
+
+u8 singleAssignAcquire(ocrDataBlock_t *self, void** ptr, ocrFatGuid_t edt, ocrLocation_t dstLoc, u32 edtSlot,
+                       ocrDbAccessMode_t mode, bool isInternal, u32 properties) {
+    ocrDataBlockSingleAssign_t *rself = (ocrDataBlockSingleAssign_t*)self;
+    ocrPolicyDomain_t * pd = NULL;
+    getCurrentEnv(&pd, NULL, NULL, NULL);
+    *ptr = NULL;
+
+    if ((mode == DB_MODE_RW) || (mode == DB_MODE_EW)) {
+        // Only the acquire done at creation can write
+        ocrDataBlockSingleAssignAttr_t cur, next;
+        cur.data = rself->attributes.data;
+        while (true) {
+            if (cur.published || cur.isReplica || cur.freeRequested || (cur.numUsers != 0)) {
+                DPRINTF(DEBUG_LVL_WARN, "Cannot re-acquire SA DB (GUID "GUIDF") for EDT "GUIDF" in writable mode %"PRIu32"\n",
+                        GUIDA(self->guid), GUIDA(edt.guid), (u32) mode);
+                return OCR_EACCES;
+            }
+            next.data = cur.data;
+            next.numUsers = 1;
+            u64 old = hal_cmpswap64((u64 *) &(rself->attributes.data), cur.data, next.data);
+            if (old == cur.data) {
+                break;
+            }
+            cur.data = old;
+        }
+#ifdef ENABLE_RESILIENCY
+        self->singleAssigner = edt.guid;
+#endif
+    } else if (!tryAcquirePublished(rself)) {
+        hal_lock(&(rself->lock));
+        // The DB may have been published in between
+        if (!tryAcquirePublished(rself)) {
+            if (rself->attributes.freeRequested) {
+                hal_unlock(&(rself->lock));
+                return OCR_EACCES;
+            }
+            ocrAssert(!rself->attributes.published);
+            saWaiter_t * waiter = newWaiter(pd, edt, dstLoc, edtSlot, isInternal, properties);
+            waiter->next = rself->localWaiters;
+            rself->localWaiters = waiter;
+            hal_unlock(&(rself->lock));
+            DPRINTF(DEBUG_LVL_VERB, "DB (GUID: "GUIDF") not published yet, deferring acquire from EDT (GUID: "GUIDF")\n",
+                    GUIDA(self->guid), GUIDA(edt.guid));
+            return OCR_EBUSY;
+        }
+        hal_unlock(&(rself->lock));
+    }
+
+    DPRINTFMSK(DEBUG_LVL_VERB, DEBUG_MSK_EDTSTATS, "Acquiring DB @ 0x%"PRIx64" (GUID: "GUIDF") size %"PRId64" from EDT (GUID: "GUIDF") (runtime acquire: %"PRId32") (mode: %"PRId32") (numUsers: %"PRId32") (dbMode: %"PRId32")\n",
+            (u64)self->ptr, GUIDA(self->guid), self->size, GUIDA(edt.guid), (u32)isInternal, (int)mode, (u32) rself->attributes.numUsers, 0);
+#ifdef OCR_ENABLE_STATISTICS
+    {
+        statsDB_ACQ(pd, edt.guid, (ocrTask_t*)edt.metaDataPtr, self->guid, self);
+    }
+#endif /* OCR_ENABLE_STATISTICS */
+    *ptr = self->ptr;
+    // Came from an acquire gated on the MD being brought in, generate a response
+    if (properties & DB_PROP_ASYNC_ACQ) {
+        processAcquireCallback(self, newWaiter(pd, edt, dstLoc, edtSlot, isInternal, properties));
+    }
+    return 0;
+}
+
+u8 singleAssignRelease(ocrDataBlock_t *self, ocrFatGuid_t edt,
+                       ocrLocation_t srcLoc, bool isInternal) {
+    ocrDataBlockSingleAssign_t *rself = (ocrDataBlockSingleAssign_t*)self;
+
+    DPRINTF(DEBUG_LVL_VERB, "Releasing DB @ 0x%"PRIx64" (GUID "GUIDF") from EDT "GUIDF" (runtime release: %"PRId32")\n",
+            (u64)self->ptr, GUIDA(self->guid), GUIDA(edt.guid), (u32)isInternal);
+#ifdef OCR_ENABLE_STATISTICS
+    {
+        statsDB_REL(getCurrentPD(), edt.guid, (ocrTask_t*)edt.metaDataPtr, self->guid, self);
+    }
+#endif /* OCR_ENABLE_STATISTICS */
+
+    ocrDataBlockSingleAssignAttr_t cur, next;
+    cur.data = rself->attributes.data;
+    // Until published, the only user is the one assigning the DB
+    if (!cur.published) {
+        return publish(self);
+    }
+    while (true) {
+        ocrAssert(cur.numUsers != 0);
+        next.data = cur.data;
+        next.numUsers -= 1;
+        u64 old = hal_cmpswap64((u64 *) &(rself->attributes.data), cur.data, next.data);
+        if (old == cur.data) {
+            break;
+        }
+        cur.data = old;
+    }
+    DPRINTF(DEBUG_LVL_VVERB, "DB (GUID: "GUIDF") attributes: numUsers %"PRId32"; freeRequested %"PRId32"\n",
+            GUIDA(self->guid), (u32) next.numUsers, (u32) next.freeRequested);
+    if ((next.numUsers == 0) && next.freeRequested) {
+        return singleAssignDestruct(self);
+    }
+    return 0;
+}
+
+u8 singleAssignDestruct(ocrDataBlock_t *self) {
+    ocrDataBlockSingleAssign_t *rself = (ocrDataBlockSingleAssign_t*)self;
+    // Any of these wrong would indicate a race between free and DB's consumers
+    ocrAssert(rself->attributes.numUsers == 0);
+    ocrAssert(rself->attributes.freeRequested == 1);
+    ocrAssert(rself->localWaiters == NULL);
+
+    DPRINTF(DEBUG_LVL_VERB, "Really freeing DB (GUID: "GUIDF")\n", GUIDA(self->guid));
+    ocrPolicyDomain_t *pd = NULL;
+    ocrTask_t *task = NULL;
+    PD_MSG_STACK(msg);
+    getCurrentEnv(&pd, NULL, &task, &msg);
+
+    if (rself->cloneRequests != NULL) {
+        ocrAssert(queueIsEmpty(rself->cloneRequests));
+        queueDestroy(rself->cloneRequests);
+        rself->cloneRequests = NULL;
+    }
+
+#define PD_MSG (&msg)
+#define PD_TYPE PD_MSG_MEM_UNALLOC
+    if (self->ptr != NULL) {
+        msg.type = PD_MSG_MEM_UNALLOC | PD_MSG_REQUEST;
+        PD_MSG_FIELD_I(allocatingPD.guid) = self->allocatingPD;
+        PD_MSG_FIELD_I(allocatingPD.metaDataPtr) = NULL;
+        PD_MSG_FIELD_I(allocator.guid) = self->allocator;
+        PD_MSG_FIELD_I(allocator.metaDataPtr) = NULL;
+        PD_MSG_FIELD_I(ptr) = self->ptr;
+        PD_MSG_FIELD_I(type) = DB_MEMTYPE;
+        PD_MSG_FIELD_I(properties) = 0;
+        RESULT_PROPAGATE(pd->fcts.processMessage(pd, &msg, false));
+    }
+
+#ifdef OCR_ENABLE_STATISTICS
+    // This needs to be done before GUID is freed.
+    {
+        statsDB_DESTROY(pd, task->guid, task, self->allocator, NULL, self->guid, self);
+    }
+#endif /* OCR_ENABLE_STATISTICS */
+
+#undef PD_TYPE
+#define PD_TYPE PD_MSG_GUID_DESTROY
+    getCurrentEnv(NULL, NULL, NULL, &msg);
+    msg.type = PD_MSG_GUID_DESTROY | PD_MSG_REQUEST;
+    // These next two statements may be not required. Just to be safe
+    PD_MSG_FIELD_I(guid.guid) = self->guid;
+    PD_MSG_FIELD_I(guid.metaDataPtr) = self;
+    PD_MSG_FIELD_I(properties) = 1; // Free metadata
+    RESULT_PROPAGATE(pd->fcts.processMessage(pd, &msg, false));
+#undef PD_MSG
+#undef PD_TYPE
+    return 0;
+}
+
+// This is the runtime implementation for ocrDbDestroy and is invoked once per DB instance.
+u8 singleAssignFree(ocrDataBlock_t *self, ocrFatGuid_t edt, ocrLocation_t srcLoc, u32 properties) {
+    bool isInternal = ((properties & DB_PROP_RT_ACQUIRE) != 0);
+    bool reqRelease = ((properties & DB_PROP_NO_RELEASE) == 0);
+    ocrDataBlockSingleAssign_t *rself = (ocrDataBlockSingleAssign_t*)self;
+
+#ifdef ENABLE_EXTENSION_PERF
+    ocrTask_t * curEdt = (ocrTask_t *)edt.metaDataPtr;
+    if(curEdt) curEdt->swPerfCtrs[PERF_DB_DESTROYS - PERF_HW_MAX] += self->size;
+#endif
+
+    DPRINTF(DEBUG_LVL_VERB, "Requesting a free for DB @ 0x%"PRIx64" (GUID: "GUIDF")\n",
+            (u64)self->ptr, GUIDA(self->guid));
+    ocrDataBlockSingleAssignAttr_t attr;
+    if (!requestFree(rself, &attr)) {
+        return OCR_EPERM;
+    }
+    issueDelMessages(rself, INVALID_LOCATION);
+    if (attr.numUsers == 0) {
+        return singleAssignDestruct(self);
+    }
+    // The datablock may not have been acquired by the current EDT hence
+    // we do not need to account for a release.
+    if (reqRelease) {
+        return singleAssignRelease(self, edt, srcLoc, isInternal);
+    }
+    return 0;
+}
+
+u8 singleAssignRegisterWaiter(ocrDataBlock_t *self, ocrFatGuid_t waiter, u32 slot,
+                              bool isDepAdd) {
+    ocrAssert(0);
+    return OCR_ENOSYS;
+}
+
+u8 singleAssignUnregisterWaiter(ocrDataBlock_t *self, ocrFatGuid_t waiter, u32 slot,
+                                bool isDepRem) {
+    ocrAssert(0);
+    return OCR_ENOSYS;
+}
+
+u8 newDataBlockSingleAssign(ocrDataBlockFactory_t *factory, ocrFatGuid_t *guid, ocrFatGuid_t allocator,
+                            ocrFatGuid_t allocPD, u64 size, void** ptr, ocrHint_t *hint, u32 flags,
+                            ocrParamList_t *perInstance) {
+    ocrPolicyDomain_t *pd = NULL;
+    ocrTask_t *task = NULL;
+    ocrGuid_t resultGuid = NULL_GUID;
+    u8 returnValue = 0;
+    PD_MSG_STACK(msg);
+    getCurrentEnv(&pd, NULL, &task, &msg);
+
+    ocrLocation_t targetLoc = pd->myLocation;
+    if (hint != NULL_HINT) {
+        u64 hintValue = 0ULL;
+        if ((ocrGetHintValue(hint, OCR_HINT_DB_AFFINITY, &hintValue) == 0) && (hintValue != 0)) {
+            ocrGuid_t affGuid;
+#if GUID_BIT_COUNT == 64
+            affGuid.guid = hintValue;
+#elif GUID_BIT_COUNT == 128
+            affGuid.upper = 0ULL;
+            affGuid.lower = hintValue;
+#endif
+            ocrAssert(!ocrGuidIsNull(affGuid));
+            affinityToLocation(&targetLoc, affGuid);
+        }
+    }
+
+    // Labeled DBs and DBs created on behalf of another PD rely on
+    // the creation protocol of the PD's general-purpose factory.
+    ocrDataBlockFactory_t * dfltFactory = (ocrDataBlockFactory_t *) pd->factories[pd->datablockFactoryIdx];
+    ocrAssert((dfltFactory != factory) && "SingleAssign cannot be the first DataBlockType of the configuration");
+    if ((flags & GUID_PROP_IS_LABELED) || (targetLoc != pd->myLocation)) {
+        return dfltFactory->instantiate(dfltFactory, guid, allocator, allocPD, size, ptr, hint, flags, perInstance);
+    }
+
+    u32 hintc = (flags & DB_PROP_NO_HINT) ? 0 : OCR_HINT_COUNT_DB_SINGLE_ASSIGN;
+#define PD_MSG (&msg)
+#define PD_TYPE PD_MSG_GUID_CREATE
+    msg.type = PD_MSG_GUID_CREATE | PD_MSG_REQUEST | PD_MSG_REQ_RESPONSE;
+    PD_MSG_FIELD_IO(guid) = *guid;
+    PD_MSG_FIELD_I(size) = sizeof(ocrDataBlockSingleAssign_t) + hintc*sizeof(u64);
+    PD_MSG_FIELD_I(kind) = OCR_GUID_DB;
+    PD_MSG_FIELD_I(targetLoc) = targetLoc;
+    PD_MSG_FIELD_I(properties) = ((flags & (GUID_RT_PROP_ALL|GUID_PROP_ALL)) | GUID_PROP_TORECORD);
+    RESULT_PROPAGATE(pd->fcts.processMessage(pd, &msg, true));
+
+    ocrDataBlockSingleAssign_t *result = (ocrDataBlockSingleAssign_t*)PD_MSG_FIELD_IO(guid.metaDataPtr);
+    resultGuid = PD_MSG_FIELD_IO(guid.guid);
+    returnValue = PD_MSG_FIELD_O(returnDetail);
+#undef PD_MSG
+#undef PD_TYPE
+
+    if(returnValue != 0) {
+        return returnValue;
+    }
+
+    // If the caller wants a pointer back
+    if ((ptr != NULL) && (*ptr != NULL)) {
+        // Use that pointer provided
+        result->base.ptr = *ptr;
+    } else {
+        // All other cases, allocate some memory
+        PD_MSG_STACK(msg);
+        getCurrentEnv(NULL, NULL, NULL, &msg);
+#define PD_MSG (&msg)
+#define PD_TYPE PD_MSG_MEM_ALLOC
+        msg.type = PD_MSG_MEM_ALLOC | PD_MSG_REQUEST | PD_MSG_REQ_RESPONSE;
+        PD_MSG_FIELD_I(size) = size;
+        PD_MSG_FIELD_I(properties) = 0;
+        PD_MSG_FIELD_I(type) = DB_MEMTYPE;
+        RESULT_PROPAGATE(pd->fcts.processMessage(pd, &msg, true));
+        void * allocPtr = (void *)PD_MSG_FIELD_O(ptr);
+#undef PD_MSG
+#undef PD_TYPE
+        result->base.ptr = allocPtr;
+        if (ptr != NULL) {
+            *ptr = allocPtr;
+        }
+    }
+
+    ocrAssert(result);
+#ifdef ENABLE_RESILIENCY
+    result->base.base.kind = OCR_GUID_DB;
+    result->base.base.size = sizeof(ocrDataBlockSingleAssign_t) + hintc*sizeof(u64);
+    result->base.bkPtr = NULL;
+    result->base.singleAssigner = NULL_GUID;
+#endif
+    result->base.base.fctId = factory->factoryId;
+    result->base.fctId = factory->factoryId;
+    result->base.allocator = allocator.guid;
+    result->base.allocatingPD = allocPD.guid;
+    result->base.size = size;
+    // Only keep flags that represent the nature of
+    // the DB as opposed to one-time usage creation flags
+    result->base.flags = (flags & DB_PROP_SINGLE_ASSIGNMENT);
+    result->lock = INIT_LOCK;
+    result->attributes.data = 0;
+    result->localWaiters = NULL;
+    result->cloneRequests = NULL;
+    u32 i;
+    for (i = 0; i < DB_SA_MAX_LOC_ARRAY; i++) {
+        result->replicaLocs[i] = 0ULL;
+    }
+
+    if (hintc == 0) {
+        result->hint.hintMask = 0;
+        result->hint.hintVal = NULL;
+    } else {
+        OCR_RUNTIME_HINT_MASK_INIT(result->hint.hintMask, OCR_HINT_DB_T, factory->factoryId);
+        result->hint.hintVal = (u64*)((u64)result + sizeof(ocrDataBlockSingleAssign_t));
+        if (hint != NULL_HINT) {
+            factory->fcts.setHint((ocrDataBlock_t *) result, hint);
+        }
+    }
+#ifdef OCR_ENABLE_STATISTICS
+    statsDB_CREATE(pd, task->guid, task, allocator.guid,
+                   (ocrAllocator_t*)allocator.metaDataPtr, result->base.guid,
+                   &(result->base));
+#endif /* OCR_ENABLE_STATISTICS */
+    DPRINTF(DEBUG_LVL_VERB, "Creating a single-assignment datablock of size %"PRIu64", @ 0x%"PRIx64" (GUID: "GUIDF")\n",
+            size, (u64)result->base.ptr, GUIDA(resultGuid));
+
+    // Do this at the very end; it indicates that the object
+    // is actually valid
+    hal_fence();
+    result->base.guid = resultGuid;
+
+    guid->guid = resultGuid;
+    guid->metaDataPtr = result;
+    return 0;
+}
+
+u8 singleAssignSetHint(ocrDataBlock_t* self, ocrHint_t *hint) {
+    ocrDataBlockSingleAssign_t *derived = (ocrDataBlockSingleAssign_t*)self;
+    ocrRuntimeHint_t *rHint = &(derived->hint);
+    OCR_RUNTIME_HINT_SET(hint, rHint, OCR_HINT_COUNT_DB_SINGLE_ASSIGN, ocrHintPropDbSingleAssign, OCR_HINT_DB_PROP_START);
+    return 0;
+}
+
+u8 singleAssignGetHint(ocrDataBlock_t* self, ocrHint_t *hint) {
+    ocrDataBlockSingleAssign_t *derived = (ocrDataBlockSingleAssign_t*)self;
+    ocrRuntimeHint_t *rHint = &(derived->hint);
+    OCR_RUNTIME_HINT_GET(hint, rHint, OCR_HINT_COUNT_DB_SINGLE_ASSIGN, ocrHintPropDbSingleAssign, OCR_HINT_DB_PROP_START);
+    return 0;
+}
+
+ocrRuntimeHint_t* getRuntimeHintDbSingleAssign(ocrDataBlock_t* self) {
+    ocrDataBlockSingleAssign_t *derived = (ocrDataBlockSingleAssign_t*)self;
+    return &(derived->hint);
+}
+
+/******************************************************/
+/* OCR-SingleAssign Datablock Metadata                */
+/******************************************************/
+
+// Pre-declare with unused attribute otherwise TG assumes it is not used although the name is referenced when setting up function pointers
+static u8 singleAssignMdSize(ocrObject_t * dest, u64 mode, u64 * size) __attribute__((unused));
+static u8 singleAssignMdSize(ocrObject_t * dest, u64 mode, u64 * size) {
+    ocrDataBlock_t * self = (ocrDataBlock_t *) dest;
+    *size = 0;
+    if (mode & M_CLONE) {
+        *size += SA_CLONE_HEADER_SZ;
+    }
+    if (mode & M_DATA) {
+        *size += self->size;
+    }
+    return 0;
+}
+
+static u8 singleAssignSerialize(ocrObjectFactory_t * factory, ocrGuid_t guid,
+                                ocrObject_t * src, u64 * mode, ocrLocation_t destLocation,
+                                void ** destBuffer, u64 * destSize) {
+    ocrAssert((destBuffer != NULL) && (*destBuffer != NULL));
+    // Replicas are only ever sent whole
+    ocrAssert(*mode == (M_CLONE | M_DATA));
+    ocrDataBlock_t * self = (ocrDataBlock_t *) src;
+    md_push_sa_clone_t * mdBuffer = (md_push_sa_clone_t *) *destBuffer;
+    mdBuffer->size = self->size;
+    mdBuffer->flags = self->flags;
+    hal_memCopy(&(mdBuffer->dbPtr), self->ptr, self->size, false);
+    if (destSize != NULL) {
+        *destSize = SA_CLONE_HEADER_SZ + self->size;
+    }
+    return 0;
+}
+
+// Pre-declare with unused attribute otherwise TG assumes it is not used although the name is referenced when setting up function pointers
+static u8 singleAssignDeserialize(ocrObjectFactory_t * pfactory, ocrGuid_t dbGuid, ocrObject_t ** dest, u64 mode, void * srcBuffer, u64 srcSize) __attribute__((unused));
+static u8 singleAssignDeserialize(ocrObjectFactory_t * pfactory, ocrGuid_t dbGuid, ocrObject_t ** dest, u64 mode, void * srcBuffer, u64 srcSize) {
+    ocrAssert(mode == (M_CLONE | M_DATA));
+    md_push_sa_clone_t * mdMsg = (md_push_sa_clone_t *) srcBuffer;
+    ocrAssert(srcSize == (SA_CLONE_HEADER_SZ + mdMsg->size));
+    ocrDataBlockFactory_t * factory = (ocrDataBlockFactory_t *) pfactory;
+    ocrPolicyDomain_t *pd = NULL;
+    PD_MSG_STACK(msg);
+    getCurrentEnv(&pd, NULL, NULL, &msg);
+    // Create the replica's metadata for the existing GUID. It is
+    // recorded once fully initialized so that pending acquires
+    // waiting on the clone are not resumed too early.
+#define PD_MSG (&msg)
+#define PD_TYPE PD_MSG_GUID_CREATE
+    msg.type = PD_MSG_GUID_CREATE | PD_MSG_REQUEST | PD_MSG_REQ_RESPONSE;
+    PD_MSG_FIELD_IO(guid.guid) = dbGuid;
+    PD_MSG_FIELD_IO(guid.metaDataPtr) = NULL;
+    PD_MSG_FIELD_I(size) = sizeof(ocrDataBlockSingleAssign_t);
+    PD_MSG_FIELD_I(kind) = OCR_GUID_DB;
+    PD_MSG_FIELD_I(targetLoc) = pd->myLocation;
+    PD_MSG_FIELD_I(properties) = GUID_PROP_ISVALID;
+    RESULT_PROPAGATE(pd->fcts.processMessage(pd, &msg, true));
+    ocrDataBlockSingleAssign_t * result = (ocrDataBlockSingleAssign_t *) PD_MSG_FIELD_IO(guid.metaDataPtr);
+    u8 returnValue = PD_MSG_FIELD_O(returnDetail);
+#undef PD_MSG
+#undef PD_TYPE
+    if (returnValue != 0) {
+        return returnValue;
+    }
+    ocrAssert(result);
+    getCurrentEnv(NULL, NULL, NULL, &msg);
+#define PD_MSG (&msg)
+#define PD_TYPE PD_MSG_MEM_ALLOC
+    msg.type = PD_MSG_MEM_ALLOC | PD_MSG_REQUEST | PD_MSG_REQ_RESPONSE;
+    PD_MSG_FIELD_I(size) = mdMsg->size;
+    PD_MSG_FIELD_I(properties) = 0;
+    PD_MSG_FIELD_I(type) = DB_MEMTYPE;
+    RESULT_PROPAGATE(pd->fcts.processMessage(pd, &msg, true));
+    result->base.ptr = (void *) PD_MSG_FIELD_O(ptr);
+#undef PD_MSG
+#undef PD_TYPE
+    hal_memCopy(result->base.ptr, &(mdMsg->dbPtr), mdMsg->size, false);
+
+#ifdef ENABLE_RESILIENCY
+    result->base.base.kind = OCR_GUID_DB;
+    result->base.base.size = sizeof(ocrDataBlockSingleAssign_t);
+    result->base.bkPtr = NULL;
+    result->base.singleAssigner = NULL_GUID;
+#endif
+    result->base.base.fctId = factory->factoryId;
+    result->base.fctId = factory->factoryId;
+    result->base.allocator = pd->allocators[0]->fguid.guid;
+    result->base.allocatingPD = pd->fguid.guid;
+    result->base.size = mdMsg->size;
+    result->base.flags = mdMsg->flags;
+    result->lock = INIT_LOCK;
+    result->attributes.data = 0;
+    result->attributes.published = 1;
+    result->attributes.isReplica = 1;
+    result->localWaiters = NULL;
+    result->cloneRequests = NULL;
+    u32 i;
+    for (i = 0; i < DB_SA_MAX_LOC_ARRAY; i++) {
+        result->replicaLocs[i] = 0ULL;
+    }
+    // Hints are not replicated
+    result->hint.hintMask = 0;
+    result->hint.hintVal = NULL;
+    DPRINTF(DBG_LVL_DB_MD, "Created replica of single-assignment DB (GUID: "GUIDF") size %"PRIu64"\n",
+            GUIDA(dbGuid), result->base.size);
+    hal_fence();
+    result->base.guid = dbGuid;
+    RESULT_ASSERT(pd->guidProviders[0]->fcts.registerGuid(pd->guidProviders[0], dbGuid, (u64) result), ==, 0);
+    *dest = (ocrObject_t *) result;
+    return 0;
+}
+
+// Pre-declare with unused attribute otherwise TG assumes it is not used although the name is referenced when setting up function pointers
+static u8 singleAssignClone(ocrObjectFactory_t * pfactory, ocrGuid_t guid, ocrObject_t ** mdPtr, ocrLocation_t destLocation, u32 type) __attribute__((unused));
+static u8 singleAssignClone(ocrObjectFactory_t * pfactory, ocrGuid_t guid, ocrObject_t ** mdPtr, ocrLocation_t destLocation, u32 type) {
+    ocrPolicyDomain_t *pd = NULL;
+    PD_MSG_STACK(msg);
+    getCurrentEnv(&pd, NULL, NULL, &msg);
+    // Replicas are only pulled by the PD needing one
+    ocrAssert(HAS_MD_CLONE(type) && (destLocation == pd->myLocation));
+    ocrLocation_t ownerLocation;
+    RESULT_ASSERT(pd->guidProviders[0]->fcts.getLocation(pd->guidProviders[0], guid, &ownerLocation), ==, 0);
+    msg.destLocation = ownerLocation;
+#define PD_MSG (&msg)
+#define PD_TYPE PD_MSG_METADATA_COMM
+    msg.type = PD_MSG_METADATA_COMM | PD_MSG_REQUEST;
+    PD_MSG_FIELD_I(guid) = guid;
+    PD_MSG_FIELD_I(direction) = MD_DIR_PULL;
+    PD_MSG_FIELD_I(op) = 0; /*ocrObjectOperation_t*/
+    PD_MSG_FIELD_I(mode) = M_CLONE;
+    PD_MSG_FIELD_I(factoryId) = ((ocrDataBlockFactory_t *)pfactory)->factoryId;
+    PD_MSG_FIELD_I(response) = NULL;
+    PD_MSG_FIELD_I(mdPtr) = NULL;
+    PD_MSG_FIELD_I(extPayload) = NULL;
+    PD_MSG_FIELD_I(sizePayload) = 0;
+    pd->fcts.processMessage(pd, &msg, true);
+#undef PD_MSG
+#undef PD_TYPE
+    if (NULL != mdPtr) {
+        *mdPtr = NULL;
+    }
+    return OCR_EPEND; // This is a remote operation that's pending
+}
+
+// Pre-declare with unused attribute otherwise TG assumes it is not used although the name is referenced when setting up function pointers
+static u8 singleAssignProcess(ocrObjectFactory_t * factory, ocrGuid_t guid, ocrObject_t * mdPtr, ocrPolicyMsg_t * msg) __attribute__((unused));
+static u8 singleAssignProcess(ocrObjectFactory_t * factory, ocrGuid_t guid, ocrObject_t * mdPtr, ocrPolicyMsg_t * msg) {
+    ocrAssert((msg->type & PD_MSG_TYPE_ONLY) == PD_MSG_METADATA_COMM);
+    ocrPolicyDomain_t * pd = NULL;
+    getCurrentEnv(&pd, NULL, NULL, NULL);
+#define PD_MSG (msg)
+#define PD_TYPE PD_MSG_METADATA_COMM
+    u8 direction = PD_MSG_FIELD_I(direction);
+    u64 mdMode = PD_MSG_FIELD_I(mode);
+    void * payload = &PD_MSG_FIELD_I(payload);
+    u64 sizePayload = PD_MSG_FIELD_I(sizePayload);
+#undef PD_MSG
+#undef PD_TYPE
+    if (direction == MD_DIR_PULL) {
+        // Another PD wants a replica
+        ocrAssert((mdMode == M_CLONE) && (mdPtr != NULL));
+        ocrDataBlock_t * self = (ocrDataBlock_t *) mdPtr;
+        ocrDataBlockSingleAssign_t * rself = (ocrDataBlockSingleAssign_t *) mdPtr;
+        ocrAssert(!rself->attributes.isReplica);
+        hal_lock(&(rself->lock));
+        if (!rself->attributes.published) {
+            // Answered on publication
+            Queue_t * queue = rself->cloneRequests;
+            if (queue == NULL) {
+                queue = newBoundedQueue(pd, DFLT_PEND_MSG_Q_SIZE);
+            } else if (queueIsFull(queue)) {
+                queue = queueDoubleResize(queue, /*freeOld=*/true);
+            }
+            queueAddLast(queue, msg);
+            rself->cloneRequests = queue;
+            hal_unlock(&(rself->lock));
+            return OCR_EPEND;
+        }
+        setTrackID(rself->replicaLocs, msg->srcLocation);
+        hal_unlock(&(rself->lock));
+        answerCloneRequest(self, msg->srcLocation);
+    } else {
+        ocrAssert(direction == MD_DIR_PUSH);
+        if (mdMode & M_CLONE) {
+            // NOTE: The GUID provider ensures a single clone is requested per GUID
+            ocrObject_t * dest = NULL;
+            RESULT_PROPAGATE(factory->deserialize(factory, guid, &dest, mdMode, payload, sizePayload));
+        } else {
+            ocrAssert(mdMode == M_DEL);
+            if (mdPtr == NULL) {
+                // The local replica is already gone
+                DPRINTF(DBG_LVL_DB_MD, "DB (GUID: "GUIDF") ignoring M_DEL, no local instance\n", GUIDA(guid));
+                return 0;
+            }
+            ocrDataBlock_t * self = (ocrDataBlock_t *) mdPtr;
+            ocrDataBlockSingleAssign_t * rself = (ocrDataBlockSingleAssign_t *) mdPtr;
+            ocrDataBlockSingleAssignAttr_t attr;
+            // Both the original and the replica may have been destroyed concurrently
+            if (requestFree(rself, &attr)) {
+                issueDelMessages(rself, msg->srcLocation);
+                if (attr.numUsers == 0) {
+                    return singleAssignDestruct(self);
+                } // else destruction will happen on the last release
+            }
+        }
+    }
+    return 0;
+}
+
+/******************************************************/
+/* OCR DATABLOCK SINGLE-ASSIGN FACTORY                */
+/******************************************************/
+
+void destructSingleAssignFactory(ocrObjectFactory_t *factory) {
+    runtimeChunkFree((u64)((ocrDataBlockFactory_t*)factory)->hintPropMap, PERSISTENT_CHUNK);
+    runtimeChunkFree((u64)factory, PERSISTENT_CHUNK);
+}
+
+ocrDataBlockFactory_t *newDataBlockFactorySingleAssign(ocrParamList_t *perType, u32 factoryId) {
+    ocrObjectFactory_t * bbase = (ocrObjectFactory_t *)
+                                  runtimeChunkAlloc(sizeof(ocrDataBlockFactorySingleAssign_t), PERSISTENT_CHUNK);
+    // Initialize base's base
+    bbase->fcts.processEvent = NULL;
+    bbase->clone = FUNC_ADDR(u8 (*)(ocrObjectFactory_t * factory, ocrGuid_t guid, ocrObject_t**, ocrLocation_t, u32), singleAssignClone);
+    bbase->mdSize = FUNC_ADDR(u8 (*)(ocrObject_t * dest, u64, u64*), singleAssignMdSize);
+    bbase->process = FUNC_ADDR(u8 (*)(ocrObjectFactory_t * factory, ocrGuid_t guid, ocrObject_t*, /*MD-COMM*/ocrPolicyMsg_t * msg), singleAssignProcess);
+    bbase->serialize = FUNC_ADDR(u8 (*)(ocrObjectFactory_t * factory, ocrGuid_t guid, ocrObject_t*, u64*, ocrLocation_t, void**, u64*), singleAssignSerialize);
+    bbase->deserialize = FUNC_ADDR(u8 (*)(ocrObjectFactory_t * factory, ocrGuid_t guid, ocrObject_t**, u64, void*, u64), singleAssignDeserialize);
+    ocrDataBlockFactory_t* base = (ocrDataBlockFactory_t*) bbase;
+    base->instantiate = FUNC_ADDR(u8 (*) (ocrDataBlockFactory_t*, ocrFatGuid_t *, ocrFatGuid_t, ocrFatGuid_t,
+                                   u64, void**, ocrHint_t*, u32, ocrParamList_t*), newDataBlockSingleAssign);
+    bbase->destruct = FUNC_ADDR(void (*)(ocrObjectFactory_t*), destructSingleAssignFactory);
+    // Instance functions
+    base->fcts.cloneAndSatisfy = NULL;
+    base->fcts.destruct = FUNC_ADDR(u8 (*)(ocrDataBlock_t*), singleAssignDestruct);
+    base->fcts.acquire = FUNC_ADDR(u8 (*)(ocrDataBlock_t*, void**, ocrFatGuid_t, ocrLocation_t, u32, ocrDbAccessMode_t, bool, u32), singleAssignAcquire);
+    base->fcts.release = FUNC_ADDR(u8 (*)(ocrDataBlock_t*, ocrFatGuid_t, ocrLocation_t, bool), singleAssignRelease);
+    base->fcts.free = FUNC_ADDR(u8 (*)(ocrDataBlock_t*, ocrFatGuid_t, ocrLocation_t, u32), singleAssignFree);
+    base->fcts.registerWaiter = FUNC_ADDR(u8 (*)(ocrDataBlock_t*, ocrFatGuid_t,
+                                                 u32, bool), singleAssignRegisterWaiter);
+    base->fcts.unregisterWaiter = FUNC_ADDR(u8 (*)(ocrDataBlock_t*, ocrFatGuid_t,
+                                                   u32, bool), singleAssignUnregisterWaiter);
+    base->fcts.setHint = FUNC_ADDR(u8 (*)(ocrDataBlock_t*, ocrHint_t*), singleAssignSetHint);
+    base->fcts.getHint = FUNC_ADDR(u8 (*)(ocrDataBlock_t*, ocrHint_t*), singleAssignGetHint);
+    base->fcts.getRuntimeHint = FUNC_ADDR(ocrRuntimeHint_t* (*)(ocrDataBlock_t*), getRuntimeHintDbSingleAssign);
+#ifdef ENABLE_EXTENSION_DB_PARTITION
+    base->fcts.partition = NULL;
+#endif
+#ifdef ENABLE_EXTENSION_DB_DIRTY_RANGE
+    base->fcts.markDirty = NULL;
+#endif
+#ifdef ENABLE_DB_PREFETCH
+    base->fcts.prefetch = NULL;
+#endif
+    base->factoryId = factoryId;
+    // DBs created with these properties are routed to this factory
+    base->dbProps = DB_PROP_SINGLE_ASSIGNMENT;
+    //Setup hint framework
+    base->hintPropMap = (u64*)runtimeChunkAlloc(sizeof(u64)*(OCR_HINT_DB_PROP_END - OCR_HINT_DB_PROP_START - 1), PERSISTENT_CHUNK);
+    OCR_HINT_SETUP(base->hintPropMap, ocrHintPropDbSingleAssign, OCR_HINT_COUNT_DB_SINGLE_ASSIGN, OCR_HINT_DB_PROP_START, OCR_HINT_DB_PROP_END);
+
+    return base;
+}
+#endif /* ENABLE_DATABLOCK_SINGLE_ASSIGN */
@@ -0,0 +1,68 @@
+/**
+ * @brief Single-assignment data-block implementation.
+ **/
+
+/*
+ * This file is subject to the license agreement located in the file LICENSE
+ * and cannot be distributed without it. This notice cannot be
+ * removed or modified.
+ */
+
+#ifndef __DATABLOCK_SINGLE_ASSIGN_H__
+#define __DATABLOCK_SINGLE_ASSIGN_H__
+
+#include "ocr-config.h"
+#ifdef ENABLE_DATABLOCK_SINGLE_ASSIGN
+
+#include "ocr-allocator.h"
+#include "ocr-datablock.h"
+#include "ocr-hal.h"
+#include "ocr-types.h"
+#include "utils/ocr-utils.h"
+#include "utils/queue.h"
+
+#ifdef ENABLE_HINTS
+/**< The number of hint properties supported by this implementation */
+#define OCR_HINT_COUNT_DB_SINGLE_ASSIGN   1
+#else
+#define OCR_HINT_COUNT_DB_SINGLE_ASSIGN   0
+#endif
+
+typedef struct {
+    ocrDataBlockFactory_t base;
+} ocrDataBlockFactorySingleAssign_t;
+
+// Only ever updated with compare-and-swap so that published
+// DBs can be acquired and released without taking the lock
+typedef union {
+    struct {
+        u64 numUsers : 32;     // Number of consumers checked-in
+        u64 published : 1;     // The single assignment has been released
+        u64 freeRequested : 1; // dbDestroy has been called
+        u64 isReplica : 1;     // Read-only copy of a DB owned by another PD
+        u64 _padding : 29;
+    };
+    u64 data;
+} ocrDataBlockSingleAssignAttr_t;
+
+// Declared in .c
+struct _saWaiter_t;
+
+// Tracker for the PDs holding a replica
+#define DB_SA_MAX_LOC (1<<GUID_PROVIDER_LOCID_SIZE)
+#define DB_SA_MAX_LOC_ARRAY ((DB_SA_MAX_LOC/64)+1)
+
+typedef struct _ocrDataBlockSingleAssign_t {
+    ocrDataBlock_t base;
+    lock_t lock; /**< Protects the waiters, the pending clones and the replica tracker */
+    volatile ocrDataBlockSingleAssignAttr_t attributes;
+    struct _saWaiter_t * localWaiters; /**< Read acquires waiting for the DB to be published */
+    Queue_t * cloneRequests; /**< Remote clone requests waiting for the DB to be published */
+    u64 replicaLocs[DB_SA_MAX_LOC_ARRAY]; /**< PDs a replica has been sent to (owner only) */
+    ocrRuntimeHint_t hint;
+} ocrDataBlockSingleAssign_t;
+
+extern ocrDataBlockFactory_t* newDataBlockFactorySingleAssign(ocrParamList_t *perType, u32 factoryId);
+
+#endif /* ENABLE_DATABLOCK_SINGLE_ASSIGN */
+#endif /* __DATABLOCK_SINGLE_ASSIGN_H__ */
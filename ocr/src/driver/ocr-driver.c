@@ -471,6 +471,13 @@ void platformSpecificInit(ocrConfig_t * ocrConfig) {
  * Warning ! the call may eventually call 'exit'.
  */
 void platformSpecificFinalizer(u8 returnCode) {
+#ifdef ENABLE_COMM_PLATFORM_MPI
+    // MPI is initialized whenever the MPI comm-platform is built in, even
+    // if the configuration uses another comm-platform
+    extern void platformFinalizeMPIComm();
+    platformFinalizeMPIComm();
+#endif
+
 #ifdef ENABLE_COMM_PLATFORM_GASNET
     // Spec says client should include a barrier before gasnet_exit()
     gasnet_barrier_notify(0,GASNET_BARRIERFLAG_ANONYMOUS);
@@ -135,6 +135,10 @@ static void mdPushHcDist(ocrGuid_t evtGuid, ocrLocation_t loc, ocrGuid_t dbGuid,
 
 #ifdef ENABLE_EXTENSION_COLLECTIVE_EVT
 
+#ifndef ENABLE_EXTENSION_DISTRIBUTED_LABELED
+    #error ENABLE_EXTENSION_DISTRIBUTED_LABELED must be enabled when ENABLE_EXTENSION_COLLECTIVE_EVT is
+#endif
+
 // 'IN' size of PD_MSG_METADATA_COMM
 #define MSG_MDCOMM_SZ       (_PD_MSG_SIZE_IN(PD_MSG_METADATA_COMM))
 
@@ -157,188 +161,220 @@ static void mdPushHcDist(ocrGuid_t evtGuid, ocrLocation_t loc, ocrGuid_t dbGuid,
 #define REDOP_GET(NAME, VAR)       (RSHIFT(NAME, (VAR)))
 #define REDOP_EQ(CHECK, VAR) (CHECK == VAR)
 
+// Width in bytes of the blocks the reduction operators process at once.
+// The operators are written with generic vectors so that the compiler
+// emits SIMD code for the ISA(s) picked by HAL_SIMD_DISPATCH.
+#define REDUCE_VEC_SZB 64
+
+// Vector of TYPE only requiring the alignment of TYPE, so that the kernels
+// remain correct on buffers that are not REDUCE_VEC_SZB aligned
+#define REDUCE_VEC_TYPEDEF(TYPE) \
+    typedef TYPE redVec_t __attribute__((vector_size(REDUCE_VEC_SZB), aligned(sizeof(TYPE)), may_alias));
+
+#define REDUCE_VEC_LEN(TYPE) (REDUCE_VEC_SZB/sizeof(TYPE))
+
 // Apply a reduction operator
 #define REDUCE_FCT_OP(DST, SRC, NB_DATUM, TYPE, OP) { \
-    u32 i; \
+    REDUCE_VEC_TYPEDEF(TYPE) \
+    u32 i = 0; \
     TYPE * tdst = (TYPE *) DST; \
     TYPE * tsrc = (TYPE *) SRC; \
-    for(i=0;i<NB_DATUM;i++) { \
-        *tdst++ OP##= *tsrc++;\
+    for(; (i+REDUCE_VEC_LEN(TYPE)) <= NB_DATUM; i+=REDUCE_VEC_LEN(TYPE)) { \
+        *((redVec_t *) &tdst[i]) OP##= *((redVec_t *) &tsrc[i]); \
+    } \
+    for(; i<NB_DATUM; i++) { \
+        tdst[i] OP##= tsrc[i]; \
     } \
 }
 
-// Apply a min/max operator
+// Apply a min/max operator: dst is replaced by src wherever 'dst OP src' holds.
+// The vector comparison yields an all-ones/all-zeros integer mask per element.
 #define REDUCE_FCT_MINMAX(DST, SRC, NB_DATUM, TYPE, OP) { \
-    u32 i; \
+    REDUCE_VEC_TYPEDEF(TYPE) \
+    typedef __typeof__(((redVec_t){0}) OP ((redVec_t){0})) redMask_t; \
+    u32 i = 0; \
     TYPE * tdst = (TYPE *) DST; \
     TYPE * tsrc = (TYPE *) SRC; \
-    for(i=0;i<NB_DATUM;i++) { \
-        if(*tdst++ OP *tsrc++) *(tdst-1) = *(tsrc-1); \
+    for(; (i+REDUCE_VEC_LEN(TYPE)) <= NB_DATUM; i+=REDUCE_VEC_LEN(TYPE)) { \
+        redVec_t vdst = *((redVec_t *) &tdst[i]); \
+        redVec_t vsrc = *((redVec_t *) &tsrc[i]); \
+        redMask_t take = (vdst OP vsrc); \
+        *((redVec_t *) &tdst[i]) = (redVec_t) ((take & ((redMask_t) vsrc)) | (~take & ((redMask_t) vdst))); \
+    } \
+    for(; i<NB_DATUM; i++) { \
+        if(tdst[i] OP tsrc[i]) tdst[i] = tsrc[i]; \
     } \
 }
 
 // Reduction functions
-static void reduceDoubleAdd(void * dst, void * src, u32 nbDatum) {
+HAL_SIMD_DISPATCH static void reduceDoubleAdd(void * dst, void * src, u32 nbDatum) {
     REDUCE_FCT_OP(dst, src, nbDatum, double, +)
 }
 
-static void reduceDoubleMult(void * dst, void * src, u32 nbDatum) {
+HAL_SIMD_DISPATCH static void reduceDoubleMult(void * dst, void * src, u32 nbDatum) {
     REDUCE_FCT_OP(dst, src, nbDatum, double, *)
 }
 
-static void reduceDoubleMin(void * dst, void * src, u32 nbDatum) {
+HAL_SIMD_DISPATCH static void reduceDoubleMin(void * dst, void * src, u32 nbDatum) {
     REDUCE_FCT_MINMAX(dst, src, nbDatum, double, <)
 }
 
-static void reduceDoubleMax(void * dst, void * src, u32 nbDatum) {
+HAL_SIMD_DISPATCH static void reduceDoubleMax(void * dst, void * src, u32 nbDatum) {
     REDUCE_FCT_MINMAX(dst, src, nbDatum, double, >)
 }
 
-static void reduceU64Add(void * dst, void * src, u32 nbDatum) {
+HAL_SIMD_DISPATCH static void reduceU64Add(void * dst, void * src, u32 nbDatum) {
     REDUCE_FCT_OP(dst, src, nbDatum, u64, +)
 }
 
-static void reduceU64Mult(void * dst, void * src, u32 nbDatum) {
+HAL_SIMD_DISPATCH static void reduceU64Mult(void * dst, void * src, u32 nbDatum) {
     REDUCE_FCT_OP(dst, src, nbDatum, u64, *)
 }
 
-static void reduceU64Min(void * dst, void * src, u32 nbDatum) {
+HAL_SIMD_DISPATCH static void reduceU64Min(void * dst, void * src, u32 nbDatum) {
     REDUCE_FCT_MINMAX(dst, src, nbDatum, u64, <)
 }
 
-static void reduceU64Max(void * dst, void * src, u32 nbDatum) {
+HAL_SIMD_DISPATCH static void reduceU64Max(void * dst, void * src, u32 nbDatum) {
     REDUCE_FCT_MINMAX(dst, src, nbDatum, u64, >)
 }
 
-static void reduceU64BitAnd(void * dst, void * src, u32 nbDatum) {
+HAL_SIMD_DISPATCH static void reduceU64BitAnd(void * dst, void * src, u32 nbDatum) {
     REDUCE_FCT_OP(dst, src, nbDatum, u64, &)
 }
 
-static void reduceU64BitOr(void * dst, void * src, u32 nbDatum) {
+HAL_SIMD_DISPATCH static void reduceU64BitOr(void * dst, void * src, u32 nbDatum) {
     REDUCE_FCT_OP(dst, src, nbDatum, u64, |)
 }
 
-static void reduceU64BitXor(void * dst, void * src, u32 nbDatum) {
+HAL_SIMD_DISPATCH static void reduceU64BitXor(void * dst, void * src, u32 nbDatum) {
     REDUCE_FCT_OP(dst, src, nbDatum, u64, ^)
 }
 
-static void reduceS64Min(void * dst, void * src, u32 nbDatum) {
+HAL_SIMD_DISPATCH static void reduceS64Min(void * dst, void * src, u32 nbDatum) {
     REDUCE_FCT_MINMAX(dst, src, nbDatum, s64, <)
 }
 
-static void reduceS64Max(void * dst, void * src, u32 nbDatum) {
+HAL_SIMD_DISPATCH static void reduceS64Max(void * dst, void * src, u32 nbDatum) {
     REDUCE_FCT_MINMAX(dst, src, nbDatum, s64, >)
 }
 
-static void reduceFloatAdd(void * dst, void * src, u32 nbDatum) {
+HAL_SIMD_DISPATCH static void reduceFloatAdd(void * dst, void * src, u32 nbDatum) {
     REDUCE_FCT_OP(dst, src, nbDatum, float, +)
 }
 
-static void reduceFloatMult(void * dst, void * src, u32 nbDatum) {
+HAL_SIMD_DISPATCH static void reduceFloatMult(void * dst, void * src, u32 nbDatum) {
     REDUCE_FCT_OP(dst, src, nbDatum, float, *)
 }
 
-static void reduceFloatMin(void * dst, void * src, u32 nbDatum) {
+HAL_SIMD_DISPATCH static void reduceFloatMin(void * dst, void * src, u32 nbDatum) {
     REDUCE_FCT_MINMAX(dst, src, nbDatum, float, <)
 }
 
-static void reduceFloatMax(void * dst, void * src, u32 nbDatum) {
+HAL_SIMD_DISPATCH static void reduceFloatMax(void * dst, void * src, u32 nbDatum) {
     REDUCE_FCT_MINMAX(dst, src, nbDatum, float, >)
 }
 
-static void reduceU32Add(void * dst, void * src, u32 nbDatum) {
+HAL_SIMD_DISPATCH static void reduceU32Add(void * dst, void * src, u32 nbDatum) {
     REDUCE_FCT_OP(dst, src, nbDatum, u32, +)
 }
 
-static void reduceU32Mult(void * dst, void * src, u32 nbDatum) {
+HAL_SIMD_DISPATCH static void reduceU32Mult(void * dst, void * src, u32 nbDatum) {
     REDUCE_FCT_OP(dst, src, nbDatum, u32, *)
 }
 
-static void reduceU32Min(void * dst, void * src, u32 nbDatum) {
+HAL_SIMD_DISPATCH static void reduceU32Min(void * dst, void * src, u32 nbDatum) {
     REDUCE_FCT_MINMAX(dst, src, nbDatum, u32, <)
 }
 
-static void reduceU32Max(void * dst, void * src, u32 nbDatum) {
+HAL_SIMD_DISPATCH static void reduceU32Max(void * dst, void * src, u32 nbDatum) {
     REDUCE_FCT_MINMAX(dst, src, nbDatum, u32, >)
 }
 
-static void reduceS32Min(void * dst, void * src, u32 nbDatum) {
+HAL_SIMD_DISPATCH static void reduceS32Min(void * dst, void * src, u32 nbDatum) {
     REDUCE_FCT_MINMAX(dst, src, nbDatum, s32, <)
 }
 
-static void reduceS32Max(void * dst, void * src, u32 nbDatum) {
+HAL_SIMD_DISPATCH static void reduceS32Max(void * dst, void * src, u32 nbDatum) {
     REDUCE_FCT_MINMAX(dst, src, nbDatum, s32, >)
 }
 
-static void reduceU32BitAnd(void * dst, void * src, u32 nbDatum) {
+HAL_SIMD_DISPATCH static void reduceU32BitAnd(void * dst, void * src, u32 nbDatum) {
     REDUCE_FCT_OP(dst, src, nbDatum, u32, &)
 }
 
-static void reduceU32BitOr(void * dst, void * src, u32 nbDatum) {
+HAL_SIMD_DISPATCH static void reduceU32BitOr(void * dst, void * src, u32 nbDatum) {
     REDUCE_FCT_OP(dst, src, nbDatum, u32, |)
 }
 
-static void reduceU32BitXor(void * dst, void * src, u32 nbDatum) {
+HAL_SIMD_DISPATCH static void reduceU32BitXor(void * dst, void * src, u32 nbDatum) {
     REDUCE_FCT_OP(dst, src, nbDatum, u32, ^)
 }
 
-void setReductionFctPtr(ocrEventHcCollective_t * dself, redOp_t redOp) {
+// Resolving in a separate function avoids GCC 12 mistaking the ifunc
+// resolved operators for locals (-Wdangling-pointer) when stored in dself
+static ocrReduceFct_t getReductionFct(redOp_t redOp) {
     // Mask associativity and commutativity flags
     redOp &= ~((REDOP_ASSOCIATIVE)|(REDOP_COMMUTATIVE));
     if (REDOP_EQ((REDOP_BS8 | REDOP_SIGNED | REDOP_REAL | REDOP_ADD), redOp)) {
-        dself->reduce = reduceDoubleAdd; return;
+        return reduceDoubleAdd;
     } else if (REDOP_EQ((REDOP_BS8 | REDOP_SIGNED | REDOP_REAL | REDOP_MULT), redOp)) {
-        dself->reduce = reduceDoubleMult; return;
+        return reduceDoubleMult;
     } else if (REDOP_EQ((REDOP_BS8 | REDOP_SIGNED | REDOP_REAL | REDOP_MIN), redOp)) {
-        dself->reduce = reduceDoubleMin; return;
+        return reduceDoubleMin;
     } else if (REDOP_EQ((REDOP_BS8 | REDOP_SIGNED | REDOP_REAL | REDOP_MAX), redOp)) {
-        dself->reduce = reduceDoubleMax; return;
+        return reduceDoubleMax;
     } else if (REDOP_EQ((REDOP_BS8 | REDOP_UNSIGNED | REDOP_INTEGER | REDOP_ADD), redOp)) {
-        dself->reduce = reduceU64Add; return;
+        return reduceU64Add;
     } else if (REDOP_EQ((REDOP_BS8 | REDOP_UNSIGNED | REDOP_INTEGER | REDOP_MULT), redOp)) {
-        dself->reduce = reduceU64Mult; return;
+        return reduceU64Mult;
     } else if (REDOP_EQ((REDOP_BS8 | REDOP_UNSIGNED | REDOP_INTEGER | REDOP_MIN), redOp)) {
-        dself->reduce = reduceU64Min; return;
+        return reduceU64Min;
     } else if (REDOP_EQ((REDOP_BS8 | REDOP_UNSIGNED | REDOP_INTEGER | REDOP_MAX), redOp)) {
-        dself->reduce = reduceU64Max; return;
+        return reduceU64Max;
     } else if (REDOP_EQ((REDOP_BS8 | REDOP_UNSIGNED | REDOP_INTEGER | REDOP_BITAND), redOp)) {
-        dself->reduce = reduceU64BitAnd; return;
+        return reduceU64BitAnd;
     } else if (REDOP_EQ((REDOP_BS8 | REDOP_UNSIGNED | REDOP_INTEGER | REDOP_BITOR), redOp)) {
-        dself->reduce = reduceU64BitOr; return;
+        return reduceU64BitOr;
     } else if (REDOP_EQ((REDOP_BS8 | REDOP_UNSIGNED | REDOP_INTEGER | REDOP_BITXOR), redOp)) {
-        dself->reduce = reduceU64BitXor; return;
+        return reduceU64BitXor;
     } else if (REDOP_EQ((REDOP_BS8 | REDOP_SIGNED | REDOP_INTEGER | REDOP_MIN), redOp)) {
-        dself->reduce = reduceS64Min; return;
+        return reduceS64Min;
     } else if (REDOP_EQ((REDOP_BS8 | REDOP_SIGNED | REDOP_INTEGER | REDOP_MAX), redOp)) {
-        dself->reduce = reduceS64Max; return;
+        return reduceS64Max;
     } else if (REDOP_EQ((REDOP_BS4 | REDOP_SIGNED | REDOP_REAL | REDOP_ADD), redOp)) {
-        dself->reduce = reduceFloatAdd; return;
+        return reduceFloatAdd;
     } else if (REDOP_EQ((REDOP_BS4 | REDOP_SIGNED | REDOP_REAL | REDOP_MULT), redOp)) {
-        dself->reduce = reduceFloatMult; return;
+        return reduceFloatMult;
     } else if (REDOP_EQ((REDOP_BS4 | REDOP_SIGNED | REDOP_REAL | REDOP_MIN), redOp)) {
-        dself->reduce = reduceFloatMin; return;
+        return reduceFloatMin;
     } else if (REDOP_EQ((REDOP_BS4 | REDOP_SIGNED | REDOP_REAL | REDOP_MAX), redOp)) {
-        dself->reduce = reduceFloatMax; return;
+        return reduceFloatMax;
     } else if (REDOP_EQ((REDOP_BS4 | REDOP_UNSIGNED | REDOP_INTEGER | REDOP_ADD), redOp)) {
-        dself->reduce = reduceU32Add; return;
+        return reduceU32Add;
     } else if (REDOP_EQ((REDOP_BS4 | REDOP_UNSIGNED | REDOP_INTEGER | REDOP_MULT), redOp)) {
-        dself->reduce = reduceU32Mult; return;
+        return reduceU32Mult;
     } else if (REDOP_EQ((REDOP_BS4 | REDOP_UNSIGNED | REDOP_INTEGER | REDOP_MIN), redOp)) {
-        dself->reduce = reduceU32Min; return;
+        return reduceU32Min;
     } else if (REDOP_EQ((REDOP_BS4 | REDOP_UNSIGNED | REDOP_INTEGER | REDOP_MAX), redOp)) {
-        dself->reduce = reduceU32Max; return;
+        return reduceU32Max;
     } else if (REDOP_EQ((REDOP_BS4 | REDOP_SIGNED | REDOP_INTEGER | REDOP_MIN), redOp)) {
-        dself->reduce = reduceS32Min; return;
+        return reduceS32Min;
     } else if (REDOP_EQ((REDOP_BS4 | REDOP_SIGNED | REDOP_INTEGER | REDOP_MAX), redOp)) {
-        dself->reduce = reduceS32Max; return;
+        return reduceS32Max;
     } else if (REDOP_EQ((REDOP_BS4 | REDOP_UNSIGNED | REDOP_INTEGER | REDOP_BITAND), redOp)) {
-        dself->reduce = reduceU32BitAnd; return;
+        return reduceU32BitAnd;
     } else if (REDOP_EQ((REDOP_BS4 | REDOP_UNSIGNED | REDOP_INTEGER | REDOP_BITOR), redOp)) {
-        dself->reduce = reduceU32BitOr; return;
+        return reduceU32BitOr;
     } else if (REDOP_EQ((REDOP_BS4 | REDOP_UNSIGNED | REDOP_INTEGER | REDOP_BITXOR), redOp)) {
-        dself->reduce = reduceU32BitXor; return;
+        return reduceU32BitXor;
     }
     ocrAssert(false && "Unresolved reduction function pointer");
+    return NULL;
+}
+
+void setReductionFctPtr(ocrEventHcCollective_t * dself, redOp_t redOp) {
+    dself->reduce = getReductionFct(redOp);
 }
 
 typedef u16 rph_t;
@@ -587,61 +623,231 @@ static u8 commonSatisfyRegNode(ocrPolicyDomain_t * pd, ocrPolicyMsg_t * msg,
 }
 
 #ifdef ALLOW_EAGER_DB
+// Returns true if 'db' has local metadata and carries the EAGER hint
+static bool isLocalEagerDb(ocrPolicyDomain_t * pd, ocrFatGuid_t db) {
+    if (ocrGuidIsNull(db.guid)) {
+        return false;
+    }
+    u64 val = 0;
+    RESULT_ASSERT(pd->guidProviders[0]->fcts.getVal(pd->guidProviders[0], db.guid, &val, NULL, MD_LOCAL, NULL), ==, 0);
+    if (val == 0) { // Only check if local
+        return false;
+    }
+    ocrDataBlock_t * dbSelf = (ocrDataBlock_t *) val;
+    ocrHint_t hint;
+    RESULT_ASSERT(ocrHintInit(&hint, OCR_HINT_DB_T), ==, 0);
+    RESULT_ASSERT(((ocrDataBlockFactory_t *)pd->factories[dbSelf->fctId])->fcts.getHint(dbSelf, &hint), ==, 0);
+    u64 hintValue = 0ULL;
+    return ((ocrGetHintValue(&hint, OCR_HINT_DB_EAGER, &hintValue) == 0) && (hintValue != 0));
+}
+
+// Push an eager DB to a remote PD along with the satisfaction of
+// all of the 'nodes' that live there. The payload is sent once.
+static u8 pushEagerDb(ocrPolicyDomain_t * pd, ocrFatGuid_t db, ocrLocation_t dstLocation,
+                      u32 nodesCount, regNode_t * nodes) {
+    DPRINTF(DEBUG_LVL_VVERB, "Eager: push "GUIDF" to %"PRIu64" for %"PRIu32" waiters\n",
+            GUIDA(db.guid), (u64) dstLocation, nodesCount);
+    ocrAssert(dstLocation != pd->myLocation);
+    ocrPolicyMsg_t * msgClone;
+    PD_MSG_STACK(msgStack);
+    u64 msgSize = (_PD_MSG_SIZE_IN(PD_MSG_GUID_METADATA_CLONE)) + sizeof(u32) + (sizeof(regNode_t) * nodesCount) - sizeof(char*);
+    if (msgSize > sizeof(ocrPolicyMsg_t)) {
+        //TODO-MD-SLAB
+        msgClone = (ocrPolicyMsg_t *) pd->fcts.pdMalloc(pd, msgSize);
+        initializePolicyMessage(msgClone, msgSize);
+    } else {
+        msgClone = &msgStack;
+    }
+    getCurrentEnv(NULL, NULL, NULL, msgClone);
+#define PD_MSG (msgClone)
+#define PD_TYPE PD_MSG_GUID_METADATA_CLONE
+    msgClone->type = PD_MSG_GUID_METADATA_CLONE | PD_MSG_REQUEST;
+    PD_MSG_FIELD_IO(guid) = db;
+    PD_MSG_FIELD_I(type) = MD_CLONE | MD_NON_COHERENT;
+    PD_MSG_FIELD_I(dstLocation) = dstLocation;
+    char *  writePtr = (char *) &PD_MSG_FIELD_I(addPayload);
+    ((u32*)writePtr)[0] = nodesCount;
+    writePtr+=sizeof(u32);
+    hal_memCopy(writePtr, nodes, sizeof(regNode_t) * nodesCount, false);
+    u8 res = pd->fcts.processMessage(pd, msgClone, false);
+#undef PD_MSG
+#undef PD_TYPE
+    // The clone operation serializes its own message
+    if (msgClone != &msgStack) {
+        pd->fcts.pdFree(pd, msgClone);
+    }
+    return res;
+}
+
 static u8 commonSatisfyRegNodeEager(ocrPolicyDomain_t * pd, ocrPolicyMsg_t * msg,
                          ocrGuid_t evtGuid,
                          ocrFatGuid_t db, ocrFatGuid_t currentEdt,
                          regNode_t * node) {
     if (!ocrGuidIsNull(db.guid)) {
-        u64 val = 0;
-        RESULT_ASSERT(pd->guidProviders[0]->fcts.getVal(pd->guidProviders[0], db.guid, &val, NULL, MD_LOCAL, NULL), ==, 0);
-        if (val != 0) { // Only check if local
-            ocrLocation_t dstLocation;
-            pd->guidProviders[0]->fcts.getLocation(pd->guidProviders[0], node->guid, &dstLocation);
-            if (dstLocation != pd->myLocation) {
-                // Check if the db is eager
-                ocrDataBlock_t * dbSelf = (ocrDataBlock_t *) val;
-                ocrHint_t hint;
-                RESULT_ASSERT(ocrHintInit(&hint, OCR_HINT_DB_T), ==, 0);
-                RESULT_ASSERT(((ocrDataBlockFactory_t *)pd->factories[dbSelf->fctId])->fcts.getHint(dbSelf, &hint), ==, 0);
-                u64 hintValue = 0ULL;
-                if ((ocrGetHintValue(&hint, OCR_HINT_DB_EAGER, &hintValue) == 0) && (hintValue != 0)) {
-                    DPRINTF(DEBUG_LVL_VVERB, "Eager: DETECTED Eager hint "GUIDF"\n", GUIDA(db.guid));
-                    //TODO-DB-EAGER: this is just handling a single node
-                    ocrPolicyMsg_t * msgClone;
-                    PD_MSG_STACK(msgStack);
-                    u64 msgSize = (_PD_MSG_SIZE_IN(PD_MSG_GUID_METADATA_CLONE)) + sizeof(u32) + sizeof(regNode_t) - sizeof(char*);
-                    ocrAssert(dstLocation != pd->myLocation); // Per the getVal above
-                    if (msgSize > sizeof(ocrPolicyMsg_t)) {
-                        //TODO-MD-SLAB
-                        msgClone = (ocrPolicyMsg_t *) pd->fcts.pdMalloc(pd, msgSize);
-                        initializePolicyMessage(msgClone, msgSize);
-                    } else {
-                        msgClone = &msgStack;
-                    }
-                    getCurrentEnv(NULL, NULL, NULL, msgClone);
-    #define PD_MSG (msgClone)
-    #define PD_TYPE PD_MSG_GUID_METADATA_CLONE
-                    msgClone->type = PD_MSG_GUID_METADATA_CLONE | PD_MSG_REQUEST;
-                    PD_MSG_FIELD_IO(guid) = db;
-                    PD_MSG_FIELD_I(type) = MD_CLONE | MD_NON_COHERENT;
-                    PD_MSG_FIELD_I(dstLocation) = dstLocation;
-                    //TODO-EAGER Need to support multiple dependences to be satisfied
-                    char *  writePtr = (char *) &PD_MSG_FIELD_I(addPayload);
-                    ((u32*)writePtr)[0] = ((u32)1);
-                    writePtr+=sizeof(u32);
-                    ((regNode_t *)writePtr)[0] = *node;
-                    RESULT_PROPAGATE(pd->fcts.processMessage(pd, msgClone, false));
-    #undef PD_MSG
-    #undef PD_TYPE
-                    return 0;
-                }
-            }
+        ocrLocation_t dstLocation;
+        pd->guidProviders[0]->fcts.getLocation(pd->guidProviders[0], node->guid, &dstLocation);
+        if ((dstLocation != pd->myLocation) && isLocalEagerDb(pd, db)) {
+            DPRINTF(DEBUG_LVL_VVERB, "Eager: DETECTED Eager hint "GUIDF"\n", GUIDA(db.guid));
+            return pushEagerDb(pd, db, dstLocation, 1, node);
         }
     }
     return commonSatisfyRegNode(pd, msg, evtGuid, db, currentEdt, node);
 }
 #endif
 
+#if defined(ALLOW_EAGER_DB) || defined(ENABLE_EVENT_SATISFY_BATCH)
+/**
+ * Remote waiters of an event, held back until all of the event's waiters are
+ * known so that each destination PD gets a single message for the waiters it
+ * holds. With an eager DB, the DB is pushed once per PD and shared by all the
+ * waiters there. Otherwise the waiters are satisfied in batches.
+ */
+typedef struct {
+    regNode_t * nodes;
+    ocrLocation_t * locations;
+    u32 count;
+    u32 capacity;   // Number of waiters of the event, the arrays are allocated on first use
+    bool eagerDb;   // Whether the payload is an eager DB to push along
+} remoteWaiters_t;
+
+#ifdef ENABLE_EVENT_SATISFY_BATCH
+// Returns true if the satisfaction of 'guid' can be carried by a
+// PD_MSG_DEP_SATISFY_MULTI. Channel and collective events are
+// satisfied through their own protocol.
+static bool isBatchableWaiter(ocrPolicyDomain_t * pd, ocrGuid_t guid) {
+    ocrGuidKind kind;
+    RESULT_ASSERT(pd->guidProviders[0]->fcts.getKind(pd->guidProviders[0], guid, &kind), ==, 0);
+#ifdef ENABLE_EXTENSION_CHANNEL_EVT
+    if (kind == OCR_GUID_EVENT_CHANNEL) {
+        return false;
+    }
+#endif
+#ifdef ENABLE_EXTENSION_COLLECTIVE_EVT
+    if (kind == OCR_GUID_EVENT_COLLECTIVE) {
+        return false;
+    }
+#endif
+    return (kind == OCR_GUID_EDT) || (kind & OCR_GUID_EVENT);
+}
+
+// Satisfy all of the 'nodes' that live at 'dstLocation' with one
+// message per HCEVT_SATISFY_BATCH_MAX waiters.
+static u8 satisfyRemoteWaiters(ocrPolicyDomain_t * pd, ocrPolicyMsg_t * msg,
+                               ocrGuid_t evtGuid, ocrFatGuid_t db, ocrFatGuid_t currentEdt,
+                               ocrLocation_t dstLocation, u32 nodesCount, regNode_t * nodes) {
+    if (nodesCount == 1) {
+        return commonSatisfyRegNode(pd, msg, evtGuid, db, currentEdt, nodes);
+    }
+    DPRINTF(DEBUG_LVL_INFO, "SatisfyFromEvent: src: "GUIDF" dst: %"PRIu64" waiters:%"PRIu32"\n",
+            GUIDA(evtGuid), (u64) dstLocation, nodesCount);
+    while (nodesCount != 0) {
+        u32 batchCount = (nodesCount < HCEVT_SATISFY_BATCH_MAX) ? nodesCount : HCEVT_SATISFY_BATCH_MAX;
+#ifdef OCR_ENABLE_STATISTICS
+        u32 i;
+        for (i = 0; i < batchCount; ++i) {
+            statsDEP_SATISFYFromEvt(pd, evtGuid, NULL, nodes[i].guid,
+                                    db.guid, nodes[i].slot);
+        }
+#endif
+#define PD_MSG (msg)
+#define PD_TYPE PD_MSG_DEP_SATISFY_MULTI
+        getCurrentEnv(NULL, NULL, NULL, msg);
+        msg->type = PD_MSG_DEP_SATISFY_MULTI | PD_MSG_REQUEST;
+        msg->destLocation = dstLocation;
+        PD_MSG_FIELD_I(satisfierGuid.guid) = evtGuid;
+        PD_MSG_FIELD_I(satisfierGuid.metaDataPtr) = NULL;
+        PD_MSG_FIELD_I(payload) = db;
+        PD_MSG_FIELD_I(currentEdt) = currentEdt;
+        PD_MSG_FIELD_I(waiters) = nodes;
+        PD_MSG_FIELD_I(waitersCount) = batchCount;
+        PD_MSG_FIELD_I(properties) = 0;
+        // One-way: the waiters are copied in the message before it returns
+        RESULT_PROPAGATE(pd->fcts.processMessage(pd, msg, false));
+#undef PD_MSG
+#undef PD_TYPE
+        nodes += batchCount;
+        nodesCount -= batchCount;
+    }
+    return 0;
+}
+#endif
+
+static u8 commonSatisfyRegNodeDefer(ocrPolicyDomain_t * pd, ocrPolicyMsg_t * msg,
+                         ocrGuid_t evtGuid,
+                         ocrFatGuid_t db, ocrFatGuid_t currentEdt,
+                         regNode_t * node, remoteWaiters_t * remote) {
+#ifndef ENABLE_EVENT_SATISFY_BATCH
+    if (!remote->eagerDb) {
+        return commonSatisfyRegNode(pd, msg, evtGuid, db, currentEdt, node);
+    }
+#endif
+    ocrLocation_t dstLocation;
+    pd->guidProviders[0]->fcts.getLocation(pd->guidProviders[0], node->guid, &dstLocation);
+    bool defer = (dstLocation != pd->myLocation);
+#ifdef ENABLE_EVENT_SATISFY_BATCH
+    defer = defer && (remote->eagerDb || isBatchableWaiter(pd, node->guid));
+#endif
+    if (!defer) {
+        return commonSatisfyRegNode(pd, msg, evtGuid, db, currentEdt, node);
+    }
+    if (remote->nodes == NULL) {
+        remote->nodes = (regNode_t *) pd->fcts.pdMalloc(pd, sizeof(regNode_t) * remote->capacity);
+        remote->locations = (ocrLocation_t *) pd->fcts.pdMalloc(pd, sizeof(ocrLocation_t) * remote->capacity);
+    }
+    ocrAssert(remote->count < remote->capacity);
+    remote->nodes[remote->count] = *node;
+    remote->locations[remote->count] = dstLocation;
+    remote->count++;
+    return 0;
+}
+
+static void freeRemoteWaiters(ocrPolicyDomain_t * pd, remoteWaiters_t * remote) {
+    if (remote->nodes != NULL) {
+        pd->fcts.pdFree(pd, remote->nodes);
+        pd->fcts.pdFree(pd, remote->locations);
+        remote->nodes = NULL;
+        remote->locations = NULL;
+    }
+}
+
+static u8 flushRemoteWaiters(ocrPolicyDomain_t * pd, ocrPolicyMsg_t * msg,
+                             ocrGuid_t evtGuid, ocrFatGuid_t db, ocrFatGuid_t currentEdt,
+                             remoteWaiters_t * remote) {
+    u8 returnCode = 0;
+    u32 head = 0;
+    while ((head < remote->count) && (returnCode == 0)) {
+        // Gather all the waiters located at the same PD as 'head'
+        ocrLocation_t dstLocation = remote->locations[head];
+        u32 end = head + 1;
+        u32 i;
+        for (i = head + 1; i < remote->count; ++i) {
+            if (remote->locations[i] == dstLocation) {
+                regNode_t tmpNode = remote->nodes[end];
+                remote->nodes[end] = remote->nodes[i];
+                remote->nodes[i] = tmpNode;
+                remote->locations[i] = remote->locations[end];
+                remote->locations[end] = dstLocation;
+                end++;
+            }
+        }
+#ifdef ALLOW_EAGER_DB
+        if (remote->eagerDb) {
+            returnCode = pushEagerDb(pd, db, dstLocation, end - head, &(remote->nodes[head]));
+        }
+#endif
+#ifdef ENABLE_EVENT_SATISFY_BATCH
+        if (!remote->eagerDb) {
+            returnCode = satisfyRemoteWaiters(pd, msg, evtGuid, db, currentEdt,
+                                              dstLocation, end - head, &(remote->nodes[head]));
+        }
+#endif
+        head = end;
+    }
+    freeRemoteWaiters(pd, remote);
+    return returnCode;
+}
+#endif
+
 static u8 commonSatisfyWaiters(ocrPolicyDomain_t *pd, ocrEvent_t *base, ocrFatGuid_t db, u32 waitersCount,
                                 ocrFatGuid_t currentEdt, ocrPolicyMsg_t * msg,
                                 bool isPersistentEvent) {
@@ -651,11 +857,32 @@ static u8 commonSatisfyWaiters(ocrPolicyDomain_t *pd, ocrEvent_t *base, ocrFatGu
     // event->waitersCount set to STATE_CHECKED_IN.
     ocrFatGuid_t dbWaiters = event->waitersDb;
     u32 i;
+#if defined(ALLOW_EAGER_DB) || defined(ENABLE_EVENT_SATISFY_BATCH)
+    // Remote waiters are satisfied last, with one message per PD
+    remoteWaiters_t remote = {.nodes = NULL, .locations = NULL, .count = 0,
+                              .capacity = waitersCount, .eagerDb = false};
+#ifdef ALLOW_EAGER_DB
+    remote.eagerDb = isPersistentEvent && isLocalEagerDb(pd, db);
+#endif
+#define SATISFY_WAITER(node) commonSatisfyRegNodeDefer(pd, msg, base->guid, db, currentEdt, (node), &remote)
+    // Do not leak the deferred waiters on early returns
+#define SATISFY_PROPAGATE(expression)               \
+    do {                                            \
+        u8 __result = (expression);                 \
+        if(__result) {                              \
+            freeRemoteWaiters(pd, &remote);         \
+            return __result;                        \
+        }                                           \
+    } while(0)
+#else
+#define SATISFY_WAITER(node) commonSatisfyRegNode(pd, msg, base->guid, db, currentEdt, (node))
+#define SATISFY_PROPAGATE(expression) RESULT_PROPAGATE(expression)
+#endif
 #if HCEVT_WAITER_STATIC_COUNT
     u32 ub = ((waitersCount < HCEVT_WAITER_STATIC_COUNT) ? waitersCount : HCEVT_WAITER_STATIC_COUNT);
     // Do static waiters first
     for(i = 0; i < ub; ++i) {
-        RESULT_PROPAGATE(commonSatisfyRegNode(pd, msg, base->guid, db, currentEdt, &event->waiters[i]));
+        SATISFY_PROPAGATE(SATISFY_WAITER(&event->waiters[i]));
     }
     waitersCount -= ub;
 #endif
@@ -688,7 +915,7 @@ static u8 commonSatisfyWaiters(ocrPolicyDomain_t *pd, ocrEvent_t *base, ocrFatGu
 
         // Second, call satisfy on all the waiters
         for(i = 0; i < waitersCount; ++i) {
-            RESULT_PROPAGATE(commonSatisfyRegNode(pd, msg, base->guid, db, currentEdt, &waiters[i]));
+            SATISFY_PROPAGATE(SATISFY_WAITER(&waiters[i]));
         }
 
         // Release the DB
@@ -701,11 +928,16 @@ static u8 commonSatisfyWaiters(ocrPolicyDomain_t *pd, ocrEvent_t *base, ocrFatGu
         PD_MSG_FIELD_I(ptr) = NULL;
         PD_MSG_FIELD_I(size) = 0;
         PD_MSG_FIELD_I(properties) = DB_PROP_RT_ACQUIRE;
-        RESULT_PROPAGATE(pd->fcts.processMessage(pd, msg, true));
+        SATISFY_PROPAGATE(pd->fcts.processMessage(pd, msg, true));
 #undef PD_MSG
 #undef PD_TYPE
     }
+#undef SATISFY_WAITER
+#undef SATISFY_PROPAGATE
 
+#if defined(ALLOW_EAGER_DB) || defined(ENABLE_EVENT_SATISFY_BATCH)
+    RESULT_PROPAGATE(flushRemoteWaiters(pd, msg, base->guid, db, currentEdt, &remote));
+#endif
     return 0;
 }
 
@@ -915,6 +1147,7 @@ u8 satisfyEventHcPersistSticky(ocrEvent_t *base, ocrFatGuid_t db, u32 slot) {
     return 0;
 }
 
+
 // This is for latch events
 u8 satisfyEventHcLatch(ocrEvent_t *base, ocrFatGuid_t db, u32 slot) {
     ocrEventHcLatch_t *event = (ocrEventHcLatch_t*)base;
@@ -1591,6 +1824,7 @@ static void mdPushHcDist(ocrGuid_t evtGuid, ocrLocation_t loc, ocrGuid_t dbGuid,
     PD_MSG_FIELD_I(factoryId) = factoryId;
     PD_MSG_FIELD_I(response) = NULL;
     PD_MSG_FIELD_I(mdPtr) = NULL;
+    PD_MSG_FIELD_I(extPayload) = NULL;
     DPRINTF (DBG_HCEVT_LOG, "event-md: push "GUIDF" in mode=%d\n", GUIDA(evtGuid), mode);
     PD_MSG_FIELD_I(sizePayload) = 0; // This MUST be set to zero otherwise base size returns random crap
     ocrAssert((ocrPolicyMsgGetMsgBaseSize(&msg, true) + sizeof(ocrLocation_t) + sizeof(ocrGuid_t)) < sizeof(ocrPolicyMsg_t));
@@ -1641,6 +1875,7 @@ static void mdPullHcDist(ocrGuid_t guid, u32 mode, u32 factoryId) {
     PD_MSG_FIELD_I(factoryId) = factoryId;
     PD_MSG_FIELD_I(response) = NULL;
     PD_MSG_FIELD_I(mdPtr) = NULL;
+    PD_MSG_FIELD_I(extPayload) = NULL;
     DPRINTF (DBG_HCEVT_LOG, "event-md: pull "GUIDF" in mode=%d\n", GUIDA(guid), mode);
     PD_MSG_FIELD_I(sizePayload) = 0; // This MUST be set to zero otherwise base size returns random crap
     ocrAssert((ocrPolicyMsgGetMsgBaseSize(&msg, true) + sizeof(ocrLocation_t)) < sizeof(ocrPolicyMsg_t));
@@ -1665,10 +1900,34 @@ static void mdPullHcDist(ocrGuid_t guid, u32 mode, u32 factoryId) {
 //Fwd declaration needed for event initialization
 static contributor_t * getContributor(ocrEventHcCollective_t * dself, u32 lslot);
 
+// Contributions are laid out so that every buffer handed to the reduction
+// operators starts on a COLEVT_CONTRIB_ALIGN boundary.
+#define COLEVT_ALIGN_UP(val) ((((u64)(val)) + (COLEVT_CONTRIB_ALIGN-1)) & ~((u64)(COLEVT_CONTRIB_ALIGN-1)))
+
+// Distance between the contributions of two consecutive phases
+static u64 colEvtPhaseStride(u32 contribSize) {
+    return COLEVT_ALIGN_UP(contribSize);
+}
+
+// Size of a contributor's header, padded so that its contributions are aligned
+static u64 colEvtContributorHeaderSize(u16 maxGen) {
+    return COLEVT_ALIGN_UP(sizeof(contributor_t) + (sizeof(regNode_t) * maxGen));
+}
+
+// Distance between two consecutive contributors
+static u64 colEvtContributorStride(u32 contribSize, u16 maxGen) {
+    return colEvtContributorHeaderSize(maxGen) + (colEvtPhaseStride(contribSize) * maxGen);
+}
+
 #ifdef COLEVT_TREE_CONTRIB
 typedef struct _remoteContrib_t {
     ocrPolicyMsg_t * msg;
 } remoteContrib_t;
+
+// Remote contributions are CAS'ed in place. They follow an array of u16 and
+// must be realigned, a misaligned entry may straddle a cache line and turn the
+// CAS into a split lock the kernel can trap or throttle.
+#define COLEVT_ALIGN_RCONTRIB(val) ((((u64)(val)) + (sizeof(remoteContrib_t)-1)) & ~((u64)(sizeof(remoteContrib_t)-1)))
 #endif
 
 typedef struct _collectiveDbRecord_t {
@@ -1931,6 +2190,8 @@ static u8 initNewEventHc(ocrEventHc_t * event, ocrEventTypes_t eventType, ocrGui
         curPtr += (sizeof(ocrLocation_t) * devt->nbOfDescendants);
         devt->phaseLocalContribCounters = (u32*) curPtr;
         curPtr += (sizeof(u32) * params->EVENT_COLLECTIVE.maxGen);
+        devt->phaseCombineCounters = (u32*) curPtr;
+        curPtr += (sizeof(u32) * params->EVENT_COLLECTIVE.maxGen * params->EVENT_COLLECTIVE.nbContribsPd);
         devt->phaseDbResult = (collectiveDbRecord_t*) curPtr;
         curPtr += (sizeof(collectiveDbRecord_t) * params->EVENT_COLLECTIVE.maxGen);
 #ifdef COLEVT_TREE_CONTRIB
@@ -1939,10 +2200,11 @@ static u8 initNewEventHc(ocrEventHc_t * event, ocrEventTypes_t eventType, ocrGui
         devt->inOrderIdxToArrayIdx = (u16 *) curPtr;
         // for that array, we only need the number of leaves
         curPtr += (sizeof(u16) * ((devt->nbOfDescendants) ? ((remoteContribCount/2)+1) : 0));
-        devt->remoteContribs = (remoteContrib_t *) curPtr;
+        devt->remoteContribs = (remoteContrib_t *) COLEVT_ALIGN_RCONTRIB(curPtr);
+        curPtr = (char *) devt->remoteContribs;
         curPtr += (sizeof(remoteContrib_t) * remoteContribCount * params->EVENT_COLLECTIVE.maxGen);
 #endif
-        devt->contributors = (contributor_t *) curPtr;
+        devt->contributors = (contributor_t *) COLEVT_ALIGN_UP(curPtr);
         u32 maxGen = params->EVENT_COLLECTIVE.maxGen;
         ocrAssert(devt->reduce != NULL);
         u32 c, ub;
@@ -1950,6 +2212,10 @@ static u8 initNewEventHc(ocrEventHc_t * event, ocrEventTypes_t eventType, ocrGui
         while(c < ub) {
             devt->phaseLocalContribCounters[c++] = 0;
         }
+        c=0; ub = params->EVENT_COLLECTIVE.maxGen * params->EVENT_COLLECTIVE.nbContribsPd;
+        while(c < ub) {
+            devt->phaseCombineCounters[c++] = 0;
+        }
         c=0; ub = params->EVENT_COLLECTIVE.maxGen;
         collectiveDbRecord_t dbRecord = {.fguid.guid = NULL_GUID, .fguid.metaDataPtr = NULL, .dbBackend = NULL};
         while(c < ub) {
@@ -1997,7 +2263,7 @@ static u8 initNewEventHc(ocrEventHc_t * event, ocrEventTypes_t eventType, ocrGui
             contrib->iph = 0;
             contrib->oph = 0;
             contrib->deps = (regNode_t *) (((char *) contrib) + sizeof(contributor_t));
-            contrib->contribs = (((char *) contrib->deps) + (sizeof(regNode_t) * maxGen));
+            contrib->contribs = (((char *) contrib) + colEvtContributorHeaderSize(maxGen));
 #ifdef OCR_ASSERT
             regNode_t regnode;
             regnode.guid = UNINITIALIZED_GUID;
@@ -2105,6 +2371,8 @@ static u8 allocateNewEventHc(ocrGuidKind guidKind, ocrFatGuid_t * resultGuid, u3
         xtraSpace += sizeof(ocrLocation_t) * nbOfDescendants;
         // For backing storage of 'phaseLocalContribCounters'
         xtraSpace += sizeof(u32) * params->EVENT_COLLECTIVE.maxGen;
+        // For backing storage of 'phaseCombineCounters'
+        xtraSpace += sizeof(u32) * params->EVENT_COLLECTIVE.maxGen * params->EVENT_COLLECTIVE.nbContribsPd;
         // For backing storage of 'phaseDbResult'
         xtraSpace += sizeof(collectiveDbRecord_t) * params->EVENT_COLLECTIVE.maxGen;
 #ifdef COLEVT_TREE_CONTRIB
@@ -2113,13 +2381,16 @@ static u8 allocateNewEventHc(ocrGuidKind guidKind, ocrFatGuid_t * resultGuid, u3
         // For backing storage of 'inOrderIdxToArrayIdx'
         xtraSpace += sizeof(u16) * ((nbOfDescendants) ? ((remoteContribCount/2)+1) : 0);
         // Linearized arrays as backing storage for the remote contribution reduction binary tree.
+        // Slack to align the first remote contribution
+        xtraSpace += sizeof(remoteContrib_t);
         xtraSpace += sizeof(remoteContrib_t) * remoteContribCount * params->EVENT_COLLECTIVE.maxGen;
 #endif
         // For backing storage of 'contributors'
         u32 datumSize = REDOP_GET(DATUM_SIZE, params->EVENT_COLLECTIVE.op)+1; // 0 is 1 hence +1
-        u32 sizeContribs = (datumSize * params->EVENT_COLLECTIVE.nbDatum * params->EVENT_COLLECTIVE.maxGen);
-        u32 sizeDeps = (sizeof(regNode_t) * params->EVENT_COLLECTIVE.maxGen);
-        xtraSpace += (sizeof(contributor_t) + sizeContribs + sizeDeps) * params->EVENT_COLLECTIVE.nbContribsPd;
+        u32 contribSize = (datumSize * params->EVENT_COLLECTIVE.nbDatum);
+        // Slack to align the first contributor
+        xtraSpace += COLEVT_CONTRIB_ALIGN;
+        xtraSpace += colEvtContributorStride(contribSize, params->EVENT_COLLECTIVE.maxGen) * params->EVENT_COLLECTIVE.nbContribsPd;
         *sizeofMd = sizeof(ocrEventHcCollective_t) + xtraSpace;
         DPRINTF(DBG_COL_EVT, "ocrEventHcCollective_t size=%"PRIu32" bytes\n", *sizeofMd);
     }
@@ -2682,7 +2953,7 @@ static contributor_t * getContributor(ocrEventHcCollective_t * dself, u32 lslot)
     u16 nbDatum = getNbDatum(dself);
     u16 maxGen = getMaxGen(dself);
     u16 datumSize = getDatumSize(dself);
-    u64 strideSize = (sizeof(contributor_t) + (sizeof(regNode_t) * maxGen) + (datumSize * nbDatum * maxGen));
+    u64 strideSize = colEvtContributorStride(datumSize * nbDatum, maxGen);
     char * rawDst = ((char *) dself->contributors) + (strideSize * lslot);
     DPRINTF(DBG_COL_EVT, "getContributor lslot=%"PRIu32" nbDatum=%"PRIu16" maxGen=%"PRIu16" datumSize=%"PRIu16" strideSize=%"PRIu64" rawDst=%p\n", lslot, nbDatum, maxGen, datumSize, strideSize, rawDst);
     return (contributor_t *) rawDst;
@@ -2691,12 +2962,72 @@ static contributor_t * getContributor(ocrEventHcCollective_t * dself, u32 lslot)
 static void * getContribPhase(ocrEventHcCollective_t * dself, u32 lslot, rph_t ph) {
     contributor_t * contributor = getContributor(dself, lslot);
     char * rawPtr = ((char *)contributor->contribs);
-    u16 nbDatum = getNbDatum(dself);
-    u16 datumSize = getDatumSize(dself);
-    rawPtr += (datumSize * nbDatum * ph);
+    rawPtr += (colEvtPhaseStride(getContribSize(dself)) * ph);
     return (void *) (rawPtr);
 }
 
+static bool isAssociative(ocrEventHcCollective_t * dself) {
+    return ((dself->params.op & REDOP_ASSOCIATIVE) != 0);
+}
+
+// Pairwise combining of the local contributions of an associative operator.
+// Contributor 'lslot' walks up a binary tree over the local slots: the second
+// of two siblings to arrive reduces the right subtree's partial result into
+// the left one's buffer and moves up. The reduction work is spread over the
+// contributing workers and the last contributor only applies the operator
+// log2(nbContribsPd) times instead of nbContribsPd-1.
+// Returns true for the contributor completing the tree, the result is then
+// in the buffer of slot 0.
+static bool combinePhaseContribs(ocrEventHcCollective_t * dself, u32 lslot, rph_t ph) {
+    u32 ub = getMaxContribLocal(dself);
+    u32 * counters = &dself->phaseCombineCounters[ph * ub];
+    u16 nbDatum = getNbDatum(dself);
+    u32 width = 1;
+    while (width < ub) {
+        u32 left, right;
+        if (lslot & width) {
+            left = lslot - width;
+            right = lslot;
+        } else {
+            left = lslot;
+            right = lslot + width;
+            if (right >= ub) { // no sibling at this level
+                width <<= 1;
+                continue;
+            }
+        }
+        // Counters are indexed by the right sibling which is unique per tree node
+        if (hal_xadd32(&counters[right], 1) == 0) {
+            return false; // sibling's subtree not done yet, it will carry on
+        }
+        counters[right] = 0;
+        dself->reduce(getContribPhase(dself, left, ph), getContribPhase(dself, right, ph), nbDatum);
+        lslot = left;
+        width <<= 1;
+    }
+    return true;
+}
+
+// Returns true if the caller completed the reduction of the local contributions for that phase
+static bool reducePhaseContribs(ocrEventHcCollective_t * dself, u32 lslot, rph_t ph) {
+    if (isAssociative(dself)) {
+        return combinePhaseContribs(dself, lslot, ph);
+    }
+    //Atomic incr for that phase, if last to contribute (reaches max contributions), perform the reduction
+    if (incrAndCheckPhaseContribs(dself, ph)) {
+        u32 i = 1, ub = getMaxContribLocal(dself);
+        u16 nbDatum = getNbDatum(dself);
+        void * dst = getContribPhase(dself, 0, ph);
+        for(; i<ub; i++) {
+            void * src = getContribPhase(dself, i, ph);
+            // reduce fct ptr is already typed, just pass in the number of arguments
+            dself->reduce(dst, src, nbDatum);
+        }
+        return true;
+    }
+    return false;
+}
+
 static regNode_t * getRegNodePhase(ocrEventHcCollective_t * dself, u32 lslot, rph_t ph) {
     contributor_t * contributor = getContributor(dself, lslot);
     return &contributor->deps[ph];
@@ -2728,7 +3059,7 @@ static rph_t incrOPhase(ocrEventHcCollective_t * dself, u32 lslot) {
 
 // Remote contribs data-structure has
 static remoteContrib_t * getRemoteContrib(ocrEventHcCollective_t * dself, rph_t rph, u16 cslot) {
-    char * rawDst = (((char *) dself->remoteContribs) + ((sizeof(remoteContrib_t) * getMaxGen(dself) * cslot) + rph));
+    char * rawDst = (((char *) dself->remoteContribs) + (sizeof(remoteContrib_t) * ((getMaxGen(dself) * cslot) + rph)));
     return (remoteContrib_t *) rawDst;
 }
 
@@ -2755,6 +3086,7 @@ static void fctRedInitMdCommMsg(ocrEventHcCollective_t * dself, ocrPolicyMsg_t *
     PD_MSG_FIELD_I(factoryId) = ((ocrEvent_t *) dself)->fctId;
     PD_MSG_FIELD_I(response) = NULL;
     PD_MSG_FIELD_I(mdPtr) = NULL;
+    PD_MSG_FIELD_I(extPayload) = NULL;
     PD_MSG_FIELD_I(sizePayload) = serSize;
 #undef PD_TYPE
 #undef PD_MSG
@@ -2896,6 +3228,10 @@ u8 fctRedProcessUpMsg(ocrEventHcCollective_t * dself, ocrPolicyMsg_t * msg, up_p
     // u8 retCode = 0; // default is to systematically delete 'msg'
     // Walk the binary reduction tree
     u16 nbOfDescendants = dself->nbOfDescendants;
+    // We reduce nbOfDescendants + self contributions. When that count is odd,
+    // the right-most leaf of the tree only receives the last descendant.
+    bool oddContribs = ((nbOfDescendants % 2) == 0);
+    u16 rightMostSlot = (nbOfDescendants) ? dself->inOrderIdxToArrayIdx[nbOfDescendants/2] : 0;
     ocrPolicyDomain_t * pd;
     getCurrentEnv(&pd, NULL, NULL, NULL);
     ocrPolicyMsg_t * deleteMsg =  NULL;
@@ -2906,7 +3242,7 @@ u8 fctRedProcessUpMsg(ocrEventHcCollective_t * dself, ocrPolicyMsg_t * msg, up_p
         up_payload_t * myPayload = fctRedResolvePayload(myMsg);
         up_payload_t * dstPayload;
         // DPRINTF(DBG_COL_EVT, "enter fctRedProcessUpMsg at contribSlot=%"PRIu16" msg=%p phase=%"PRIu16"\n", contribSlot, msg, lph);
-        bool isRightMostOdd = (oddContribs && (contribSlot == nbOfDescendants));
+        bool isRightMostOdd = (oddContribs && (contribSlot == rightMostSlot));
         if (isRightMostOdd) {// just record
             ocrAssert(rcontrib->msg == NULL);
             ocrAssert(deleteMsg == NULL);
@@ -3058,16 +3394,9 @@ u8 satisfyEventHcCollective(ocrEvent_t *base, ocrFatGuid_t db, u32 slot) {
             getIPhase(dself, lslot), gph, dself->phaseLocalContribCounters[lph],
             (u64) ((u64*)contribPtr)[0], (double) ((double*)contribPtr)[0]);
         hal_memCopy(getContribPhase(dself, lslot, lph), contribPtr, getContribSize(dself), false);
-        //Atomic incr for that phase, if last to contribute (reaches max contributions), perform the reduction
-        if (incrAndCheckPhaseContribs(dself, lph)) {
-            u32 i = 1, ub = getMaxContribLocal(dself);
-            u16 nbDatum = getNbDatum(dself);
+        //Reduce local contributions, the contributor completing the reduction carries on
+        if (reducePhaseContribs(dself, lslot, lph)) {
             void * dst = getContribPhase(dself, 0, lph);
-            for(; i<ub; i++) {
-                void * src = getContribPhase(dself, i, lph);
-                // reduce fct ptr is already typed, just pass in the number of arguments
-                dself->reduce(dst, src, nbDatum);
-            }
             //NOTE: Unless when we are both root and leaf, it may make sense to always
             //create a msg and do the accumulation there and avoid copies from dst to that msg
 #ifdef COLEVT_DIST_REDUCE
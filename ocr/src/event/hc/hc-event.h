@@ -33,6 +33,11 @@
 #define HCEVT_WAITER_DYNAMIC_COUNT 4
 #endif
 
+// Maximum number of remote waiters satisfied by a single PD_MSG_DEP_SATISFY_MULTI
+#ifndef HCEVT_SATISFY_BATCH_MAX
+#define HCEVT_SATISFY_BATCH_MAX 256
+#endif
+
 #ifndef ENABLE_EVENT_MDC
 #define ENABLE_EVENT_MDC 0
 #endif
@@ -111,6 +116,8 @@ typedef void (*ocrReduceFct_t)(void*, void*, u32);
 #define COLEVT_DIST_REDUCE  1
 // Control the reduction strategy for local contributions
 #define COLEVT_LAZY_REDUCE  1
+// Alignment of each contribution buffer, in bytes
+#define COLEVT_CONTRIB_ALIGN 64
 
 typedef struct _ocrEventHcCollective_t {
     ocrEventHc_t base;
@@ -122,6 +129,9 @@ typedef struct _ocrEventHcCollective_t {
     ocrLocation_t ancestorLoc;
     ocrLocation_t * descendantsLoc;
     u32 * phaseLocalContribCounters; /*maxGen*/
+    // For associative operators, local contributions are combined pairwise
+    // by the contributors themselves. Arrival counters of the combining tree.
+    u32 * phaseCombineCounters; /*maxGen*nbContribsPd*/
     struct _collectiveDbRecord_t * phaseDbResult; /*maxGen*/
 #ifdef COLEVT_TREE_CONTRIB
     u16 * inOrderIdxToArrayIdx;
@@ -534,6 +534,13 @@ typedef volatile u32 lock_t;
  */
 #define hal_localizeAddr(addr, me) tg_localize(addr, me)
 
+/**
+ * @brief Function attribute requesting per-ISA clones of a kernel
+ *
+ * No runtime dispatch on this platform
+ */
+#define HAL_SIMD_DISPATCH
+
 // Support for abstract load and store macros
 #define IS_REMOTE(addr) (__builtin_clzl(addr) < ((sizeof(u64) - 1) - MAP_AGENT_SHIFT))
 
@@ -584,6 +584,13 @@ typedef volatile u32 lock_t;
  */
 #define hal_localizeAddr(addr) addr
 
+/**
+ * @brief Function attribute requesting per-ISA clones of a kernel
+ *
+ * No runtime dispatch on this platform
+ */
+#define HAL_SIMD_DISPATCH
+
 // Abstraction to do a load operation from any level of the memory hierarchy
 #define GET8(temp, addr)   ((temp) = *((u8*)(addr)))
 #define GET16(temp, addr)  ((temp) = *((u16*)(addr)))
@@ -334,6 +334,21 @@ typedef volatile u32 lock_t;
  */
 #define hal_localizeAddr(addr) addr
 
+/**
+ * @brief Function attribute requesting one clone of the function
+ * per listed instruction set, the best one for the current CPU being
+ * selected when the runtime is loaded
+ *
+ * Meant for small data-parallel kernels written with generic vector
+ * types. Relies on the GNU ifunc support and expands to nothing
+ * when it is not available.
+ */
+#if defined(__GNUC__) && !defined(__clang__) && (__GNUC__ >= 6) && defined(__GLIBC__)
+#define HAL_SIMD_DISPATCH __attribute__((target_clones("avx512f", "avx2", "default")))
+#else
+#define HAL_SIMD_DISPATCH
+#endif
+
 /****************************************************/
 /* SYSTEM DISCOVERY                                 */
 /****************************************************/
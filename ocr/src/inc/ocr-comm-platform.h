@@ -40,6 +40,23 @@ typedef struct _paramListCommPlatformInst_t {
 } paramListCommPlatformInst_t;
 
 
+/****************************************************/
+/* COMMUNICATION SHARDS                             */
+/****************************************************/
+
+// A policy domain may run several communication workers, each one driving
+// its own comm-platform instance (or shard). Requests between two PDs go
+// through the shard of that ordered pair, so that each peer's traffic stays
+// on one channel on both sides. The two directions between two PDs map to
+// different shards, so that two PDs alone still use two shards. Message ids
+// generated by a shard encode its index so that a response goes back through
+// the shard its request came from.
+
+#define COMM_SHARD_MSGID(seq, shardId, shardCount) ((((u64) (seq)) * (shardCount)) + (shardId))
+#define COMM_SHARD_OF_MSGID(msgId, shardCount) ((u32) (((u64) (msgId)) % (shardCount)))
+#define COMM_SHARD_OF_PEERS(src, dest, shardCount) \
+    ((u32) ((((u64) (src)) + ((u64) (dest)) + (((u64) (src)) > ((u64) (dest)))) % (shardCount)))
+
 /****************************************************/
 /* OCR COMMUNICATION PLATFORM                       */
 /****************************************************/
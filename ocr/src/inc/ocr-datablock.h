@@ -191,6 +191,62 @@ typedef struct _ocrDataBlockFcts_t {
      */
     ocrRuntimeHint_t* (*getRuntimeHint)(struct _ocrDataBlock_t* self);
 
+#ifdef ENABLE_EXTENSION_DB_PARTITION
+    /**
+     * @brief Creates data-blocks that are views over slices of this
+     * data-block's payload
+     *
+     * The partitions do not own memory and have their own access modes.
+     * This data-block cannot be destroyed and stays acquired in RW (CONST
+     * if it is currently acquired in CONST) on behalf of the partitions
+     * until each of them has been released or destroyed.
+     *
+     * @param[in] self        Pointer to this data-block
+     * @param[in] partc       Number of partitions to create
+     * @param[in] offsets     Offset of each partition in the payload
+     * @param[in] sizes       Size of each partition
+     * @param[out] partGuids  GUIDs of the partitions created
+     * @return 0 on success or the following error code:
+     *    - OCR_EINVAL if a slice is empty or out of bounds
+     *    - OCR_EACCES if the data-block is acquired in EW
+     *    - OCR_ENOTSUP if this data-block instance cannot be partitioned
+     */
+    u8 (*partition)(struct _ocrDataBlock_t *self, u32 partc, u64 *offsets, u64 *sizes,
+                    ocrGuid_t *partGuids);
+#endif
+
+#ifdef ENABLE_EXTENSION_DB_DIRTY_RANGE
+    /**
+     * @brief Declares a byte range of an acquired data-block as modified
+     *
+     * Implementations that write data-blocks back may use the ranges
+     * to only transfer what was modified. If ranges are declared, all
+     * the modifications made while the data-block is acquired must be
+     * declared.
+     *
+     * @param[in] self        Pointer to this data-block
+     * @param[in] offset      Offset of the range in the payload
+     * @param[in] size        Size of the range
+     * @return 0 on success or OCR_EINVAL if the range is out of bounds
+     */
+    u8 (*markDirty)(struct _ocrDataBlock_t *self, u64 offset, u64 size);
+#endif
+
+#ifdef ENABLE_DB_PREFETCH
+    /**
+     * @brief Brings a copy of the data-block to the current policy domain
+     * ahead of the acquires that will need it
+     *
+     * This call is non-binding: no access is granted, no release is
+     * expected and implementations are free to ignore it.
+     *
+     * @param[in] self        Pointer to this data-block
+     * @param[in] mode        Access mode the copy will be acquired in
+     * @return 0 on success and a non-zero code on failure
+     */
+    u8 (*prefetch)(struct _ocrDataBlock_t *self, ocrDbAccessMode_t mode);
+#endif
+
 #ifdef ENABLE_RESILIENCY
     /**
      * @brief Get the serialization size
@@ -271,6 +327,7 @@ typedef struct _ocrDataBlock_t {
 #define DB_PROP_ASYNC_ACQ           0x20000 // DB Acquire gated on MD being brought in //TODO-MD-DBRTACQ
 #define DB_PROP_NO_RELEASE          0x40000 // Indicate a release is not required
 #define DB_PROP_RT_PD_ACQUIRE       0x80000 // DB acquired by scheduler for whole PD
+#define DB_PROP_PREFETCH            0x100000 // Non-binding acquire, only brings the DB in
 
 #define DB_FLAG_RT_FETCH            0x1000000
 #define DB_FLAG_RT_WRITE_BACK       0x2000000
@@ -308,6 +365,7 @@ typedef struct _ocrDataBlockFactory_t {
                       ocrFatGuid_t allocator, ocrFatGuid_t allocPD, u64 size,
                       void** ptr, ocrHint_t *hint, u32 properties, ocrParamList_t *instanceArg);
     u32 factoryId; /**< Corresponds to fctId in DB */
+    u32 dbProps; /**< DB_PROP_* creation properties this factory is dedicated to, 0 for general-purpose factories */
     ocrDataBlockFcts_t fcts; /**< Function pointers created instances should use */
     u64 *hintPropMap; /**< Mapping hint properties to implementation specific packed array */
 } ocrDataBlockFactory_t;
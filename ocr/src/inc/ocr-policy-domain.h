@@ -228,6 +228,11 @@ typedef struct _paramListPolicyDomainInst_t {
  */
 #define PD_MSG_DEP_SATISFY      0x00104080
 
+/**< Satisfy several waiters located in the same policy domain with the
+ * same payload. The receiving PD satisfies each of the waiters locally
+ */
+#define PD_MSG_DEP_SATISFY_MULTI 0x000c9080
+
 /**< Unregister a signaler on a waiter. This is called internally
  * when an event is destroyed for example */
 #define PD_MSG_DEP_UNREGSIGNALER 0x00085080
@@ -271,6 +276,9 @@ typedef struct _paramListPolicyDomainInst_t {
 /**< Runlevel change notification */
 #define PD_MSG_MGT_RL_NOTIFY        0x00004200
 
+/**< Returns flow-control credits to a peer (between comm-apis, or from the PD to its comm-api) */
+#define PD_MSG_MGT_FLOW_CREDIT      0x00005200
+
 /**< AND with this and if result non-null, hint related operation.
  * Generally, these will be calls to set/get user hints
  */
@@ -764,8 +772,12 @@ typedef struct _ocrPolicyMsg_t {
                     void * mdPtr;      /**< In: The deserialized metadata. This is a placeholder for
                                                 when deserialize has been called on the payload,
                                                 it is NULL otherwise */
+                    void * extPayload; /**< In: If not NULL, the last 'extSize' bytes of the payload are
+                                                not in the message but read from here when the message
+                                                is marshalled or sent. Only for persistent messages */
                     u32 factoryId;     /**< In: The factory ID for the metadata */
                     u32 sizePayload;   /**< In: The serialized metadata payload size */
+                    u32 extSize;       /**< In: Size of the data at 'extPayload' */
                     ocrObjectOperation_t op; /**< In: Operation that triggered the push/pull */
                     u8 direction;       /**< In: Pull or Push message */
                     char payload;      /**< In: Metadata implementation specific serialized data of size 'sizePayload' */
@@ -1016,6 +1028,23 @@ typedef struct _ocrPolicyMsg_t {
             } inOrOut __attribute__ (( aligned(8) ));
         } PD_MSG_STRUCT_NAME(PD_MSG_DEP_SATISFY);
 
+        struct {
+            union {
+                struct {
+                    ocrFatGuid_t satisfierGuid; /**< In: GUID of the "satisfier" (usually an event) */
+                    ocrFatGuid_t payload; /**< In: GUID of the "payload" to satisfy the
+                                           * waiters with (a DB usually). */
+                    ocrFatGuid_t currentEdt;   /**< In: EDT that is satisfying deps */
+                    struct _regNode_t * waiters; /**< In: Waiters to satisfy, each with its slot */
+                    u32 waitersCount;     /**< In: Number of elements in waiters */
+                    u32 properties;       /**< In: Properties for the satisfaction */
+                } in;
+                struct {
+                    u32 returnDetail;     /**< Out: Success or error code */
+                } out;
+            } inOrOut __attribute__ (( aligned(8) ));
+        } PD_MSG_STRUCT_NAME(PD_MSG_DEP_SATISFY_MULTI);
+
         struct {
             union {
                 struct {
@@ -1186,6 +1215,16 @@ typedef struct _ocrPolicyMsg_t {
             } inOrOut __attribute__ (( aligned(8) ));
         } PD_MSG_STRUCT_NAME(PD_MSG_MGT_MONITOR_PROGRESS);
 
+        struct {
+            union {
+                struct {
+                    u32 credits;            /**< In: Number of requests the destination may send again */
+                } in;
+                struct {
+                } out;
+            } inOrOut __attribute__ (( aligned(8) ));
+        } PD_MSG_STRUCT_NAME(PD_MSG_MGT_FLOW_CREDIT);
+
         struct {
             union {
                 struct {
@@ -1818,6 +1857,49 @@ u8 ocrPolicyMsgMarshallMsg(struct _ocrPolicyMsg_t* msg, u64 baseSize, u8* buffer
 u8 ocrPolicyMsgUnMarshallMsg(u8* mainBuffer, u8* addlBuffer,
                              struct _ocrPolicyMsg_t* msg, u32 mode);
 
+// First byte of a message in the compact encoding. A marshalled message starts
+// with the low byte of its msgId: comm-platforms that send both forms never
+// use ids whose low byte is the mark.
+#define POLICY_MSG_COMPACT_MARK 0xFF
+
+/**
+ * @brief Encodes a marshalled message in a compact, variable-length form
+ *
+ * The header and the fields used by the message's type, as described by
+ * the PD_MSG field macros, are encoded as varints, except for the GUIDs of
+ * the message's fat GUIDs. Those and the marshalled data are copied as is.
+ * The encoded message starts with POLICY_MSG_COMPACT_MARK.
+ *
+ * @param[in] msg          Marshalled message (msg->usefulSize is the size to encode)
+ * @param[out] buffer      Buffer to encode to
+ * @param[in] bufferSize   Size of buffer
+ *
+ * @return the size of the encoded message or 0 if it does not fit in bufferSize
+ */
+u64 ocrPolicyMsgCompactEncode(struct _ocrPolicyMsg_t* msg, u8* buffer, u64 bufferSize);
+
+/**
+ * @brief Returns the size of the marshalled message encoded in 'buffer'
+ * or 0 if 'buffer' does not hold a compact message
+ */
+u64 ocrPolicyMsgCompactGetSize(const u8* buffer, u64 size);
+
+/**
+ * @brief Performs the opposite operation to ocrPolicyMsgCompactEncode
+ *
+ * The message is decoded in its marshalled form and still needs to
+ * go through ocrPolicyMsgUnMarshallMsg.
+ *
+ * @param[in] buffer       Compact message
+ * @param[in] size         Size of the data available in buffer
+ * @param[out] msg         Message to decode to
+ * @param[in] msgSize      Size of msg, at least ocrPolicyMsgCompactGetSize(buffer, size).
+ *                         msg->bufferSize is set to msgSize
+ *
+ * @return the number of bytes consumed from buffer or 0 if it is malformed
+ */
+u64 ocrPolicyMsgCompactDecode(const u8* buffer, u64 size, struct _ocrPolicyMsg_t* msg, u64 msgSize);
+
 /**
  * @brief Returns true if the GUID is owned by the policy domain
  *
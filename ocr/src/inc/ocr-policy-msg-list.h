@@ -47,6 +47,7 @@ PER_TYPE(PD_MSG_DEP_ADD)
 PER_TYPE(PD_MSG_DEP_REGSIGNALER)
 PER_TYPE(PD_MSG_DEP_REGWAITER)
 PER_TYPE(PD_MSG_DEP_SATISFY)
+PER_TYPE(PD_MSG_DEP_SATISFY_MULTI)
 PER_TYPE(PD_MSG_DEP_UNREGSIGNALER)
 PER_TYPE(PD_MSG_DEP_UNREGWAITER)
 PER_TYPE(PD_MSG_DEP_DYNADD)
@@ -61,6 +62,7 @@ PER_TYPE(PD_MSG_MGT_REGISTER)
 PER_TYPE(PD_MSG_MGT_UNREGISTER)
 PER_TYPE(PD_MSG_MGT_MONITOR_PROGRESS)
 PER_TYPE(PD_MSG_MGT_RL_NOTIFY)
+PER_TYPE(PD_MSG_MGT_FLOW_CREDIT)
 
 PER_TYPE(PD_MSG_HINT_SET)
 PER_TYPE(PD_MSG_HINT_GET)
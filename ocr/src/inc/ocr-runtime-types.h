@@ -20,7 +20,11 @@
 /* Summary of property flags visible to the user */
 #define EDT_PROP_ALL  ((u16) 0x3)
 #define EVT_PROP_ALL  ((u16) 0x1)
+#ifdef ENABLE_EXTENSION_DB_COPY_ON_WRITE
+#define DB_PROP_ALL   ((u16) 0xF0)
+#else
 #define DB_PROP_ALL   ((u16) 0x70)
+#endif
 #define GUID_PROP_ALL ((u16) 0x700)
 
 // Mask for runtime properties on GUIDs
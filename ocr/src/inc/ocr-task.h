@@ -471,6 +471,9 @@ typedef struct _ocrTask_t {
 #ifdef ENABLE_EXTENSION_PERF
 #define OCR_TASK_FLAG_PERFMON_ME            0x20 /* Identifies if perfmon needs to be carried out for this task */
 #endif
+#ifdef ENABLE_EDT_ANON
+#define OCR_TASK_FLAG_ANON                  0x40 /* Identifies an anonymous task (no GUID, pooled metadata) */
+#endif
 
 /****************************************************/
 /* OCR TASK FACTORY                                 */
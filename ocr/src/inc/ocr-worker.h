@@ -129,6 +129,10 @@ typedef struct _ocrWorker_t {
     u64 computeCount;           /**< Number of compute node(s) associated */
     //TODO-DEFERRED, I don't want this to be volatile
     struct _ocrTask_t * volatile curTask; /**< Currently executing task */
+#ifdef ENABLE_EDT_ANON
+    void * anonEdtPool;         /**< Recycled anonymous EDT metadata (only accessed by this worker) */
+    u32 anonEdtPoolCount;       /**< Number of entries in anonEdtPool */
+#endif
 
     ocrWorkerFcts_t fcts;
 
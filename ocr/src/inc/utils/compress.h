@@ -0,0 +1,47 @@
+/**
+ * @brief Light-weight codec for message payloads
+ *
+ * The codec works on 64-bit words: each word is XOR-ed with the previous
+ * one and only the significant bytes of the difference are kept. A header
+ * byte holds the number of kept bytes for two consecutive words. Trailing
+ * bytes that do not make up a full word are stored as is.
+ *
+ * This favors payloads where neighboring words share their high-order
+ * bytes, such as zero-filled regions, small integers or floating-point
+ * arrays with slowly varying values.
+ */
+
+/*
+ * This file is subject to the license agreement located in the file LICENSE
+ * and cannot be distributed without it. This notice cannot be
+ * removed or modified.
+ */
+
+#ifndef __COMPRESS_H__
+#define __COMPRESS_H__
+
+#include "ocr-types.h"
+
+/**
+ * @brief Encode 'srcSize' bytes of 'src' into 'dst'
+ *
+ * @param[out] dst      Destination buffer
+ * @param[in]  dstSize  Size of the destination buffer
+ * @param[in]  src      Data to encode
+ * @param[in]  srcSize  Size of the data to encode
+ * @return the size of the encoded data or 0 if it does not fit in 'dstSize'
+ */
+u64 xorDeltaEncode(u8 * dst, u64 dstSize, const u8 * src, u64 srcSize);
+
+/**
+ * @brief Decode 'srcSize' bytes of 'src' into the 'dstSize' bytes of 'dst'
+ *
+ * @param[out] dst      Destination buffer, must be the size of the original data
+ * @param[in]  dstSize  Size of the original data
+ * @param[in]  src      Encoded data
+ * @param[in]  srcSize  Size of the encoded data
+ * @return the number of encoded bytes consumed or 0 if 'src' is malformed
+ */
+u64 xorDeltaDecode(u8 * dst, u64 dstSize, const u8 * src, u64 srcSize);
+
+#endif /* __COMPRESS_H__ */
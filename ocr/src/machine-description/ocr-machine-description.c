@@ -239,9 +239,28 @@ char* populate_type(ocrParamList_t **type_param, type_enum index, dictionary *di
     case allocator_type:
         ALLOC_PARAM_LIST(*type_param, paramListAllocatorFact_t);
         break;
-    case commapi_type:
-        ALLOC_PARAM_LIST(*type_param, paramListCommApiFact_t);
+    case commapi_type: {
+        commApiType_t mytype = -1;
+        TO_ENUM (mytype, typestr, commApiType_t, commapi_types, commApiMax_id);
+        switch (mytype) {
+#if defined(ENABLE_COMM_API_SIMPLE) && defined(ENABLE_COMM_API_FLOW_CONTROL)
+        case commApiSimple_id: {
+            s64 value = COMM_API_CREDITS;
+            ALLOC_PARAM_LIST(*type_param, paramListCommApiFactSimple_t);
+            if (key_exists(dict, secname, "credits")) {
+                snprintf(key, MAX_KEY_SZ, "%s:%s", secname, "credits");
+                INI_GET_LONG (key, value, -1);
+            }
+            ((paramListCommApiFactSimple_t *)(*type_param))->credits = (value < 0) ? 0 : (u32) value;
+        }
         break;
+#endif
+        default:
+            ALLOC_PARAM_LIST(*type_param, paramListCommApiFact_t);
+            break;
+        }
+    }
+    break;
     case compplatform_type: {
         compPlatformType_t mytype = -1;
         TO_ENUM (mytype, typestr, compPlatformType_t, compplatform_types, compPlatformMax_id);
@@ -283,15 +302,97 @@ char* populate_type(ocrParamList_t **type_param, type_enum index, dictionary *di
     case tasktemplatefactory_type:
         ALLOC_PARAM_LIST(*type_param, paramListTaskTemplateFact_t);
         break;
-    case datablockfactory_type:
-        ALLOC_PARAM_LIST(*type_param, paramListDataBlockFact_t);
+    case datablockfactory_type: {
+        dataBlockType_t mytype = -1;
+        TO_ENUM (mytype, typestr, dataBlockType_t, dataBlock_types, dataBlockMax_id);
+        switch (mytype) {
+#if defined(ENABLE_DATABLOCK_LOCKABLE) && defined(ENABLE_DB_REPLICA_CACHE)
+        case dataBlockLockable_id: {
+            s64 value = DB_REPLICA_CACHE_SIZE;
+            ALLOC_PARAM_LIST(*type_param, paramListDataBlockFactLockable_t);
+            if (key_exists(dict, secname, "replicacache")) {
+                snprintf(key, MAX_KEY_SZ, "%s:%s", secname, "replicacache");
+                INI_GET_LONG (key, value, -1);
+            }
+            ((paramListDataBlockFactLockable_t *)(*type_param))->replicaCacheSize = (value < 0) ? 0 : value;
+        }
         break;
+#endif
+        default:
+            ALLOC_PARAM_LIST(*type_param, paramListDataBlockFact_t);
+            break;
+        }
+    }
+    break;
     case eventfactory_type:
         ALLOC_PARAM_LIST(*type_param, paramListEventFact_t);
         break;
-    case commplatform_type:
-        ALLOC_PARAM_LIST(*type_param, paramListCommPlatformFact_t);
+    case commplatform_type: {
+        commPlatformType_t mytype = -1;
+        TO_ENUM (mytype, typestr, commPlatformType_t, commplatform_types, commPlatformMax_id);
+        switch (mytype) {
+#if defined(ENABLE_COMM_PLATFORM_MPI) && (defined(ENABLE_MPI_COMPRESSION) || defined(ENABLE_MPI_AGGREGATION) || defined(ENABLE_MPI_LANES))
+        case commPlatformMPI_id: {
+            s64 value;
+            ALLOC_PARAM_LIST(*type_param, paramListCommPlatformFactMPI_t);
+#ifdef ENABLE_MPI_COMPRESSION
+            value = MPI_COMPRESS_THRESHOLD;
+            if (key_exists(dict, secname, "compressthreshold")) {
+                snprintf(key, MAX_KEY_SZ, "%s:%s", secname, "compressthreshold");
+                INI_GET_LONG (key, value, -1);
+            }
+            ((paramListCommPlatformFactMPI_t *)(*type_param))->compressThreshold = (value < 0) ? 0 : value;
+#endif
+#ifdef ENABLE_MPI_AGGREGATION
+            value = MPI_AGG_BUFFER_SZ;
+            if (key_exists(dict, secname, "aggregatesize")) {
+                snprintf(key, MAX_KEY_SZ, "%s:%s", secname, "aggregatesize");
+                INI_GET_LONG (key, value, -1);
+            }
+            ((paramListCommPlatformFactMPI_t *)(*type_param))->aggBufferSize = (value < 0) ? 0 : value;
+#endif
+#ifdef ENABLE_MPI_LANES
+            value = MPI_BULK_MAX_INFLIGHT;
+            if (key_exists(dict, secname, "bulkinflight")) {
+                snprintf(key, MAX_KEY_SZ, "%s:%s", secname, "bulkinflight");
+                INI_GET_LONG (key, value, -1);
+            }
+            ((paramListCommPlatformFactMPI_t *)(*type_param))->bulkMaxInFlight = (value < 0) ? 0 : value;
+#endif
+        }
         break;
+#endif
+#ifdef ENABLE_COMM_PLATFORM_SHM
+        case commPlatformShm_id: {
+            s64 value = SHM_RING_SZ;
+            ALLOC_PARAM_LIST(*type_param, paramListCommPlatformFactShm_t);
+            if (key_exists(dict, secname, "ringsize")) {
+                snprintf(key, MAX_KEY_SZ, "%s:%s", secname, "ringsize");
+                INI_GET_LONG (key, value, -1);
+            }
+            ((paramListCommPlatformFactShm_t *)(*type_param))->ringSize = (value < 1) ? SHM_RING_SZ : value;
+            // Optional link emulation
+            shmLinkModel_t * link = &((paramListCommPlatformFactShm_t *)(*type_param))->link;
+            const char * linkKeys[] = {"latency", "jitter", "bandwidth", "seed"};
+            u64 * linkValues[] = {&link->latency, &link->jitter, &link->bandwidth, &link->seed};
+            u32 k;
+            for (k = 0; k < 4; k++) {
+                value = 0;
+                if (key_exists(dict, secname, (char *) linkKeys[k])) {
+                    snprintf(key, MAX_KEY_SZ, "%s:%s", secname, linkKeys[k]);
+                    INI_GET_LONG (key, value, -1);
+                }
+                *(linkValues[k]) = (value < 0) ? 0 : (u64) value;
+            }
+        }
+        break;
+#endif
+        default:
+            ALLOC_PARAM_LIST(*type_param, paramListCommPlatformFact_t);
+            break;
+        }
+    }
+    break;
     case schedulerObject_type:
         ALLOC_PARAM_LIST(*type_param, paramListSchedulerObjectFact_t);
         break;
@@ -96,6 +96,15 @@ static void setReturnDetail(ocrPolicyMsg_t * msg, u8 returnDetail) {
 #define PD_TYPE PD_MSG_DEP_SATISFY
         PD_MSG_FIELD_O(returnDetail) = returnDetail;
 #undef PD_MSG
+#undef PD_TYPE
+    break;
+    }
+    case PD_MSG_DEP_SATISFY_MULTI:
+    {
+#define PD_MSG (msg)
+#define PD_TYPE PD_MSG_DEP_SATISFY_MULTI
+        PD_MSG_FIELD_O(returnDetail) = returnDetail;
+#undef PD_MSG
 #undef PD_TYPE
     break;
     }
@@ -626,6 +635,17 @@ u8 hcDistProcessMessage(ocrPolicyDomain_t *self, ocrPolicyMsg_t *msg, u8 isBlock
 #endif /*!XP_CHANNEL_EVT_NONFIFO*/
 #endif /*ENABLE_EXTENSION_CHANNEL_EVT*/
 #undef PD_MSG
+#undef PD_TYPE
+        break;
+    }
+    case PD_MSG_DEP_SATISFY_MULTI:
+    {
+#define PD_MSG (msg)
+#define PD_TYPE PD_MSG_DEP_SATISFY_MULTI
+        // The destination is set by the sender: all the waiters live there
+        DPRINTF(DEBUG_LVL_VVERB,"DEP_SATISFY_MULTI: target is %"PRId32" for %"PRIu32" waiters\n",
+                (u32) msg->destLocation, PD_MSG_FIELD_I(waitersCount));
+#undef PD_MSG
 #undef PD_TYPE
         break;
     }
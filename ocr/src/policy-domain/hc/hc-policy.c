@@ -35,6 +35,9 @@
 #include "task/hc/hc-task.h"
 #include "event/hc/hc-event.h"
 #include "workpile/hc/hc-workpile.h"
+#ifdef ENABLE_EDT_ANON
+#include "scheduler-heuristic/scheduler-heuristic-all.h"
+#endif
 
 #ifdef ENABLE_RESILIENCY
 #include "worker/hc/hc-worker.h"
@@ -326,6 +329,38 @@ void hcWorkerCallback(ocrPolicyDomain_t *self, u64 val) {
     }
 }
 
+#ifdef ENABLE_EDT_ANON
+u8 hcPolicyDomainProcessMessage(ocrPolicyDomain_t *self, ocrPolicyMsg_t *msg, u8 isBlocking);
+
+// Anonymous EDTs carry a sentinel GUID and are only known through their
+// metadata pointer. This holds for the HC policy itself but neither for
+// policies layered on top of it (they route messages by GUID) nor for the
+// heuristics that resolve the task from its GUID. Others are left out.
+static bool anonEdtSupported(ocrPolicyDomain_t *policy) {
+    if (policy->fcts.processMessage != FUNC_ADDR(u8(*)(ocrPolicyDomain_t*,ocrPolicyMsg_t*,u8), hcPolicyDomainProcessMessage)) {
+        return false;
+    }
+    u64 i, j;
+    for (i = 0; i < policy->schedulerCount; ++i) {
+        ocrScheduler_t * scheduler = policy->schedulers[i];
+        for (j = 0; j < scheduler->schedulerHeuristicCount; ++j) {
+            u32 heuristicId = scheduler->schedulerHeuristics[j]->factoryId;
+            bool supported = false;
+#ifdef ENABLE_SCHEDULER_HEURISTIC_HC
+            supported |= (heuristicId == schedulerHeuristicHc_id);
+#endif
+#ifdef ENABLE_SCHEDULER_HEURISTIC_STATIC
+            supported |= (heuristicId == schedulerHeuristicStatic_id);
+#endif
+            if (!supported) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+#endif
+
 // Function to cause run-level switches in this PD
 u8 hcPdSwitchRunlevel(ocrPolicyDomain_t *policy, ocrRunlevel_t runlevel, u32 properties) {
     s32 j, k=0;
@@ -465,6 +500,11 @@ u8 hcPdSwitchRunlevel(ocrPolicyDomain_t *policy, ocrRunlevel_t runlevel, u32 pro
             rself->pqrFlags.pausingWorker = -1;
         }
 #endif
+#ifdef ENABLE_EDT_ANON
+        if((!toReturn) && (properties & RL_BRING_UP)) {
+            rself->anonEdt = anonEdtSupported(policy);
+        }
+#endif
 
         if(toReturn) {
             DPRINTF(DEBUG_LVL_WARN, "RL_PD_OK(%"PRId32") phase %"PRId32" failed: %"PRId32"\n", origProperties, curPhase, toReturn);
@@ -1115,6 +1155,44 @@ static u8 createEdtHelper(ocrPolicyDomain_t *self, ocrFatGuid_t *guid,
     return returnCode;
 }
 
+#ifdef ENABLE_EDT_ANON
+// Anonymous EDTs are created locally and must have all their dependences
+// known at creation time, either NULL_GUID or local data blocks.
+static bool canCreateAnonEdt(ocrPolicyDomain_t *self, ocrPolicyMsg_t *msg, u32 properties,
+                             ocrFatGuid_t *depv, u32 depc) {
+    if ((!((ocrPolicyDomainHc_t*)self)->anonEdt) || (msg->srcLocation != self->myLocation) ||
+        (properties & (GUID_PROP_IS_LABELED | EDT_PROP_FINISH)) || (depc == EDT_PARAM_DEF)) {
+        return false;
+    }
+    if (depc == 0) {
+        return true;
+    }
+    if (depv == NULL) {
+        return false;
+    }
+    u32 i;
+    for (i = 0; i < depc; ++i) {
+        if (ocrGuidIsNull(depv[i].guid)) {
+            continue;
+        }
+#if defined(REG_ASYNC) && !defined(REG_ASYNC_SGL)
+        // Data block dependences are registered through the EDT's GUID
+        return false;
+#else
+        ocrGuidKind kind = OCR_GUID_NONE;
+        if (ocrGuidIsUninitialized(depv[i].guid) || !isLocalGuid(self, depv[i].guid)) {
+            return false;
+        }
+        self->guidProviders[0]->fcts.getKind(self->guidProviders[0], depv[i].guid, &kind);
+        if (kind != OCR_GUID_DB) {
+            return false;
+        }
+#endif
+    }
+    return true;
+}
+#endif
+
 static u8 createEdtTemplateHelper(ocrPolicyDomain_t *self, ocrFatGuid_t *guid,
                               ocrEdt_t func, u32 paramc, u32 depc, const char* funcName) {
     ocrTaskTemplate_t *base = ((ocrTaskTemplateFactory_t*)(self->factories[self->taskTemplateFactoryIdx]))->instantiate(
@@ -1124,6 +1202,19 @@ static u8 createEdtTemplateHelper(ocrPolicyDomain_t *self, ocrFatGuid_t *guid,
     return 0;
 }
 
+// Picks the datablock factory dedicated to the DB_PROP_* a DB is created
+// with, if any is configured. Defaults to the first datablock factory.
+static ocrDataBlockFactory_t * resolveDbFactory(ocrPolicyDomain_t *self, u32 properties) {
+    u32 i;
+    for (i = self->datablockFactoryIdx + 1; i < self->eventFactoryIdx; i++) {
+        ocrDataBlockFactory_t * factory = (ocrDataBlockFactory_t*) self->factories[i];
+        if ((factory->dbProps != 0) && ((properties & factory->dbProps) == factory->dbProps)) {
+            return factory;
+        }
+    }
+    return (ocrDataBlockFactory_t*) self->factories[self->datablockFactoryIdx];
+}
+
 static u8 createEventHelper(ocrPolicyDomain_t *self, ocrFatGuid_t *guid,
                         ocrEventTypes_t type, u32 properties, ocrParamList_t * paramList) {
     return ((ocrEventFactory_t*)(self->factories[self->eventFactoryIdx]))->instantiate(
@@ -2023,7 +2114,9 @@ u8 hcPolicyDomainProcessMessage(ocrPolicyDomain_t *self, ocrPolicyMsg_t *msg, u8
         ocrFatGuid_t tEdt = PD_MSG_FIELD_I(edt);
         #define PRESCRIPTION 0x10LL
         //TODO-MD-DBNOACQ: 'no acquire' flag is handled upstream by forwarding the msg directly to the recipient PD
-        ocrDataBlockFactory_t * dbFactory = (ocrDataBlockFactory_t*) self->factories[self->datablockFactoryIdx];
+        // Specialized factories rely on the creation-time acquire
+        ocrDataBlockFactory_t * dbFactory = doNotAcquireDb ? (ocrDataBlockFactory_t*) self->factories[self->datablockFactoryIdx] :
+                                                             resolveDbFactory(self, PD_MSG_FIELD_IO(properties));
         void * ptr = NULL; // request memory to be allocated
         PD_MSG_FIELD_O(returnDetail) = dbFactory->instantiate(dbFactory, &(PD_MSG_FIELD_IO(guid)),
                                                         self->allocators[0]->fguid, self->fguid,
@@ -2043,8 +2136,8 @@ u8 hcPolicyDomainProcessMessage(ocrPolicyDomain_t *self, ocrPolicyMsg_t *msg, u8
                 DPRINTF(DEBUG_LVL_INFO, "Not acquiring DB since disabled by property flags\n");
                 PD_MSG_FIELD_O(ptr) = NULL;
             } else {
-                ocrAssert(db->fctId == ((ocrDataBlockFactory_t*)(self->factories[self->datablockFactoryIdx]))->factoryId);
-                PD_MSG_FIELD_O(returnDetail) = ((ocrDataBlockFactory_t*)(self->factories[self->datablockFactoryIdx]))->fcts.acquire(
+                ocrAssert((db->fctId >= self->datablockFactoryIdx) && (db->fctId < self->eventFactoryIdx));
+                PD_MSG_FIELD_O(returnDetail) = ((ocrDataBlockFactory_t*)(self->factories[db->fctId]))->fcts.acquire(
                     db, &(PD_MSG_FIELD_O(ptr)), tEdt, self->myLocation, EDT_SLOT_NONE, DB_MODE_RW, !!(PD_MSG_FIELD_IO(properties) & DB_PROP_RT_ACQUIRE),
                     (u32) DB_MODE_RW);
                 // Set the default mode in the response message for the caller
@@ -2087,9 +2180,26 @@ u8 hcPolicyDomainProcessMessage(ocrPolicyDomain_t *self, ocrPolicyMsg_t *msg, u8
             ocrDataBlock_t *db = (ocrDataBlock_t*)(PD_MSG_FIELD_IO(guid.metaDataPtr));
             ocrAssert(isDatablockGuid(self, PD_MSG_FIELD_IO(guid)));
             ocrAssert(db != NULL);
-            ocrAssert(db->fctId == ((ocrDataBlockFactory_t*)(self->factories[self->datablockFactoryIdx]))->factoryId);
+            ocrAssert((db->fctId >= self->datablockFactoryIdx) && (db->fctId < self->eventFactoryIdx));
+#ifdef ENABLE_DB_PREFETCH
+            if (PD_MSG_FIELD_IO(properties) & DB_PROP_PREFETCH) {
+                // Non-binding: nothing is granted, there's nothing to respond to
+                ocrDataBlockFactory_t * dbFactory = (ocrDataBlockFactory_t*)(self->factories[db->fctId]);
+                if (dbFactory->fcts.prefetch != NULL) {
+                    dbFactory->fcts.prefetch(db, (ocrDbAccessMode_t) (PD_MSG_FIELD_IO(properties) & (u32)DB_ACCESS_MODE_MASK));
+                }
+                // Re-processed copies only have room for the input fields
+                if (msg->type & PD_MSG_REQ_RESPONSE) {
+                    PD_MSG_FIELD_O(ptr) = NULL;
+                    PD_MSG_FIELD_O(size) = db->size;
+                    PD_MSG_FIELD_O(returnDetail) = 0;
+                    msg->type &= ~PD_MSG_REQUEST;
+                    msg->type |= PD_MSG_RESPONSE;
+                }
+            } else
+#endif
             if (msg->type & PD_MSG_REQ_RESPONSE) {
-                PD_MSG_FIELD_O(returnDetail) = ((ocrDataBlockFactory_t*)(self->factories[self->datablockFactoryIdx]))->fcts.acquire(
+                PD_MSG_FIELD_O(returnDetail) = ((ocrDataBlockFactory_t*)(self->factories[db->fctId]))->fcts.acquire(
                     db, &(PD_MSG_FIELD_O(ptr)), PD_MSG_FIELD_IO(edt), PD_MSG_FIELD_IO(destLoc), PD_MSG_FIELD_IO(edtSlot),
                     (ocrDbAccessMode_t) (PD_MSG_FIELD_IO(properties) & (u32)DB_ACCESS_MODE_MASK),
                     !!(PD_MSG_FIELD_IO(properties) & DB_PROP_RT_ACQUIRE), PD_MSG_FIELD_IO(properties));
@@ -2124,7 +2234,7 @@ u8 hcPolicyDomainProcessMessage(ocrPolicyDomain_t *self, ocrPolicyMsg_t *msg, u8
                 // by the policy-domain.
                 PD_MSG_FIELD_IO(properties) |= DB_PROP_ASYNC_ACQ;
                 void * ptr;
-                ((ocrDataBlockFactory_t*)(self->factories[self->datablockFactoryIdx]))->fcts.acquire(
+                ((ocrDataBlockFactory_t*)(self->factories[db->fctId]))->fcts.acquire(
                     db, &ptr, PD_MSG_FIELD_IO(edt), PD_MSG_FIELD_IO(destLoc), PD_MSG_FIELD_IO(edtSlot),
                     (ocrDbAccessMode_t) (PD_MSG_FIELD_IO(properties) & (u32)DB_ACCESS_MODE_MASK),
                     !!(PD_MSG_FIELD_IO(properties) & DB_PROP_RT_ACQUIRE), PD_MSG_FIELD_IO(properties));
@@ -2166,9 +2276,9 @@ u8 hcPolicyDomainProcessMessage(ocrPolicyDomain_t *self, ocrPolicyMsg_t *msg, u8
         ocrDataBlock_t *db = (ocrDataBlock_t*)(PD_MSG_FIELD_IO(guid.metaDataPtr));
         ocrAssert(isDatablockGuid(self, PD_MSG_FIELD_IO(guid)));
         ocrAssert(db != NULL);
-        ocrAssert(db->fctId == ((ocrDataBlockFactory_t*)(self->factories[self->datablockFactoryIdx]))->factoryId);
+        ocrAssert((db->fctId >= self->datablockFactoryIdx) && (db->fctId < self->eventFactoryIdx));
         ocrGuid_t edtGuid __attribute__((unused)) =  PD_MSG_FIELD_I(edt.guid);
-        PD_MSG_FIELD_O(returnDetail) = ((ocrDataBlockFactory_t*)(self->factories[self->datablockFactoryIdx]))->fcts.release(
+        PD_MSG_FIELD_O(returnDetail) = ((ocrDataBlockFactory_t*)(self->factories[db->fctId]))->fcts.release(
             db, PD_MSG_FIELD_I(edt), PD_MSG_FIELD_I(srcLoc), !!(PD_MSG_FIELD_I(properties) & DB_PROP_RT_ACQUIRE));
         DPRINTF(DEBUG_LVL_INFO, "DB guid "GUIDF" of size %"PRIu64" released by EDT "GUIDF"\n",
                 GUIDA(db->guid), db->size, GUIDA(edtGuid));
@@ -2192,11 +2302,11 @@ u8 hcPolicyDomainProcessMessage(ocrPolicyDomain_t *self, ocrPolicyMsg_t *msg, u8
         ocrDataBlock_t *db = (ocrDataBlock_t*)(PD_MSG_FIELD_I(guid.metaDataPtr));
         ocrAssert(isDatablockGuid(self, PD_MSG_FIELD_I(guid)));
         ocrAssert(db != NULL);
-        ocrAssert(db->fctId == ((ocrDataBlockFactory_t*)(self->factories[self->datablockFactoryIdx]))->factoryId);
+        ocrAssert((db->fctId >= self->datablockFactoryIdx) && (db->fctId < self->eventFactoryIdx));
         ocrAssert(!(msg->type & PD_MSG_REQ_RESPONSE));
         //Save a copy of the DB guid for DPRINTF() and tracing before the free call
         ocrGuid_t dbGuid = PD_MSG_FIELD_I(guid).guid;
-        PD_MSG_FIELD_O(returnDetail) = ((ocrDataBlockFactory_t*)(self->factories[self->datablockFactoryIdx]))->fcts.free(
+        PD_MSG_FIELD_O(returnDetail) = ((ocrDataBlockFactory_t*)(self->factories[db->fctId]))->fcts.free(
             db, PD_MSG_FIELD_I(edt), PD_MSG_FIELD_I(srcLoc), PD_MSG_FIELD_I(properties));
         if(PD_MSG_FIELD_O(returnDetail)!=0)
             DPRINTF(DEBUG_LVL_WARN, "DB Free failed for guid "GUIDF"\n", GUIDA(dbGuid));
@@ -2272,6 +2382,11 @@ u8 hcPolicyDomainProcessMessage(ocrPolicyDomain_t *self, ocrPolicyMsg_t *msg, u8
             u64 val = 0;
             self->guidProviders[0]->fcts.getVal(self->guidProviders[0], guid, &val, NULL, MD_LOCAL, NULL);
             ocrObject_t * mdPtr = (ocrObject_t *) val;             // ASSERT(val != ((u64)0xffffffffffffffff));
+            // Remote PDs address the factory they know of. When the DB exists here, its
+            // own factory is the one to process the request.
+            if ((guidKind == OCR_GUID_DB) && (mdPtr != NULL)) {
+                factory = self->factories[((ocrDataBlock_t *) mdPtr)->fctId];
+            }
             // This is potentially asynchronous as the MD may not be able to carry out the operation immediately
             returnCode = factory->process(factory, guid, mdPtr, msg);
             // If pending we return here as it may indicate the msg is now
@@ -2354,6 +2469,7 @@ u8 hcPolicyDomainProcessMessage(ocrPolicyDomain_t *self, ocrPolicyMsg_t *msg, u8
                 PD_MSG_FIELD_I(sizePayload) = mdSize;
                 PD_MSG_FIELD_I(response) = NULL;
                 PD_MSG_FIELD_I(mdPtr) = NULL;
+                PD_MSG_FIELD_I(extPayload) = NULL;
                 //PD_MSG_FIELD_I(payload) has already been written to by the call to serialize
     #undef PD_MSG
     #undef PD_TYPE
@@ -2473,6 +2589,12 @@ u8 hcPolicyDomainProcessMessage(ocrPolicyDomain_t *self, ocrPolicyMsg_t *msg, u8
         ocrFatGuid_t * depv = PD_MSG_FIELD_I(depv);
         ocrHint_t *hint = PD_MSG_FIELD_I(hint);
         u32 properties = PD_MSG_FIELD_I(properties) | GUID_PROP_TORECORD;
+#ifdef ENABLE_EDT_ANON
+        if ((properties & EDT_PROP_ANON) && !canCreateAnonEdt(self, msg, properties, depv, depc)) {
+            DPRINTF(DEBUG_LVL_VERB, "Creating a regular EDT in place of an anonymous one\n");
+            properties &= ~EDT_PROP_ANON;
+        }
+#endif
         u8 returnCode = createEdtHelper(
                 self, &(PD_MSG_FIELD_IO(guid)), PD_MSG_FIELD_I(templateGuid),
                 &(PD_MSG_FIELD_IO(paramc)), PD_MSG_FIELD_I(paramv), &(PD_MSG_FIELD_IO(depc)),
@@ -2486,6 +2608,26 @@ u8 hcPolicyDomainProcessMessage(ocrPolicyDomain_t *self, ocrPolicyMsg_t *msg, u8
             PD_MSG_FIELD_O(returnDetail) = returnCode;
         }
         ocrAssert((returnCode == 0) || (returnCode == OCR_EGUIDEXISTS));
+#ifdef ENABLE_EDT_ANON
+        if ((properties & EDT_PROP_ANON) && (depv != NULL)) {
+            // Anonymous EDTs are unknown to the GUID provider: satisfy the
+            // slots directly on the metadata. The EDT may start executing
+            // on the last satisfy so it must not be accessed afterwards.
+            ocrAssert(returnCode == 0);
+            ocrTaskFactory_t * taskFactory = (ocrTaskFactory_t*)(self->factories[self->taskFactoryIdx]);
+            ocrTask_t * edt = (ocrTask_t*)(PD_MSG_FIELD_IO(guid.metaDataPtr));
+            u32 i;
+            for (i = 0; i < depc; ++i) {
+                ocrFatGuid_t payload = {.guid = depv[i].guid, .metaDataPtr = NULL};
+#ifdef REG_ASYNC_SGL
+                RESULT_ASSERT(taskFactory->fcts.satisfyWithMode(edt, payload, i, DB_DEFAULT_MODE), ==, 0);
+#else
+                RESULT_ASSERT(taskFactory->fcts.satisfy(edt, payload, i), ==, 0);
+#endif
+            }
+            depv = NULL;
+        }
+#endif
 #ifndef EDT_DEPV_DELAYED
         if ((depv != NULL)) {
             ocrAssert(returnCode == 0);
@@ -2850,7 +2992,7 @@ u8 hcPolicyDomainProcessMessage(ocrPolicyDomain_t *self, ocrPolicyMsg_t *msg, u8
             if (kind == OCR_GUID_DB) {
                 char * readPtr = (char *) &PD_MSG_FIELD_I(addPayload);
                 u32 waitersCount = ((u32*)readPtr)[0];
-                ocrAssert(waitersCount == 1);
+                ocrAssert(waitersCount != 0);
                 readPtr+=sizeof(u32);
                 void * waitersPtr = (void *) readPtr;
                 RESULT_ASSERT(((ocrDataBlockFactory_t *)factory)->fcts.cloneAndSatisfy(factory, fatGuid.guid, NULL, dstLoc,
@@ -3479,9 +3621,9 @@ u8 hcPolicyDomainProcessMessage(ocrPolicyDomain_t *self, ocrPolicyMsg_t *msg, u8
             ocrAssert(dstKind == OCR_GUID_DB);
             // When an EDT want to register to a DB, for instance to get EW access.
             ocrDataBlock_t *db = (ocrDataBlock_t*)(dest.metaDataPtr);
-            ocrAssert(db->fctId == ((ocrDataBlockFactory_t*)(self->factories[self->datablockFactoryIdx]))->factoryId);
+            ocrAssert((db->fctId >= self->datablockFactoryIdx) && (db->fctId < self->eventFactoryIdx));
             // Warning: A counted-event can be destroyed by this call
-            PD_MSG_FIELD_O(returnDetail) = ((ocrDataBlockFactory_t*)(self->factories[self->datablockFactoryIdx]))->fcts.registerWaiter(
+            PD_MSG_FIELD_O(returnDetail) = ((ocrDataBlockFactory_t*)(self->factories[db->fctId]))->fcts.registerWaiter(
                 db, waiter, PD_MSG_FIELD_I(slot), isAddDep);
         }
 #ifdef OCR_ENABLE_STATISTICS
@@ -3507,7 +3649,7 @@ u8 hcPolicyDomainProcessMessage(ocrPolicyDomain_t *self, ocrPolicyMsg_t *msg, u8
         ocrPolicyDomainHc_t *rself = (ocrPolicyDomainHc_t *)self;
 #endif
 #ifdef ENABLE_EXTENSION_PERF
-        if(!ocrGuidIsNull(PD_MSG_FIELD_I(satisfierGuid.guid))) {
+        if(!ocrGuidIsNull(PD_MSG_FIELD_I(satisfierGuid.guid)) && (PD_MSG_FIELD_I(satisfierGuid.metaDataPtr) == NULL)) {
             self->guidProviders[0]->fcts.getVal(
                 self->guidProviders[0], PD_MSG_FIELD_I(satisfierGuid.guid),
                 (u64*)(&(PD_MSG_FIELD_I(satisfierGuid.metaDataPtr))), &dstKind, MD_LOCAL, NULL);
@@ -3565,6 +3707,55 @@ u8 hcPolicyDomainProcessMessage(ocrPolicyDomain_t *self, ocrPolicyMsg_t *msg, u8
         break;
     }
 
+    case PD_MSG_DEP_SATISFY_MULTI: {
+        START_PROFILE(pd_hc_SatisfyMulti);
+#define PD_MSG msg
+#define PD_TYPE PD_MSG_DEP_SATISFY_MULTI
+        // Fan the satisfaction out to each waiter. Go through processMessage
+        // as a waiter's metadata may have moved since the message was sent.
+        ocrFatGuid_t satisfierGuid = PD_MSG_FIELD_I(satisfierGuid);
+        ocrFatGuid_t payload = PD_MSG_FIELD_I(payload);
+        ocrFatGuid_t currentEdt = PD_MSG_FIELD_I(currentEdt);
+        regNode_t * waiters = PD_MSG_FIELD_I(waiters);
+        u32 waitersCount = PD_MSG_FIELD_I(waitersCount);
+        u8 returnDetail = 0;
+        u32 i;
+        PD_MSG_STACK(msgSatisfy);
+        for(i = 0; i < waitersCount; ++i) {
+#undef PD_MSG
+#undef PD_TYPE
+#define PD_MSG (&msgSatisfy)
+#define PD_TYPE PD_MSG_DEP_SATISFY
+            getCurrentEnv(NULL, NULL, NULL, &msgSatisfy);
+            msgSatisfy.type = PD_MSG_DEP_SATISFY | PD_MSG_REQUEST;
+            PD_MSG_FIELD_I(satisfierGuid.guid) = satisfierGuid.guid;
+            PD_MSG_FIELD_I(satisfierGuid.metaDataPtr) = NULL;
+            PD_MSG_FIELD_I(guid.guid) = waiters[i].guid;
+            PD_MSG_FIELD_I(guid.metaDataPtr) = NULL;
+            PD_MSG_FIELD_I(payload) = payload;
+            PD_MSG_FIELD_I(currentEdt) = currentEdt;
+            PD_MSG_FIELD_I(slot) = waiters[i].slot;
+#ifdef REG_ASYNC_SGL
+            PD_MSG_FIELD_I(mode) = waiters[i].mode;
+#endif
+            PD_MSG_FIELD_I(properties) = 0;
+            u8 res = self->fcts.processMessage(self, &msgSatisfy, false);
+            if (res != 0) {
+                returnDetail = res;
+            }
+#undef PD_MSG
+#undef PD_TYPE
+#define PD_MSG msg
+#define PD_TYPE PD_MSG_DEP_SATISFY_MULTI
+        }
+        PD_MSG_FIELD_O(returnDetail) = returnDetail;
+#undef PD_MSG
+#undef PD_TYPE
+        msg->type &= ~PD_MSG_REQUEST;
+        EXIT_PROFILE;
+        break;
+    }
+
     case PD_MSG_DEP_UNREGSIGNALER: {
         //Not implemented: see #521, #522
         ocrAssert(0);
@@ -3718,7 +3909,7 @@ u8 hcPolicyDomainProcessMessage(ocrPolicyDomain_t *self, ocrPolicyMsg_t *msg, u8
             {
                 ocrAssert(kind == OCR_GUID_DB);
                 ocrDataBlock_t *db = (ocrDataBlock_t*)(PD_MSG_FIELD_I(guid.metaDataPtr));
-                PD_MSG_FIELD_O(returnDetail) = ((ocrDataBlockFactory_t*)(self->factories[self->datablockFactoryIdx]))->fcts.setHint(db, PD_MSG_FIELD_I(hint));
+                PD_MSG_FIELD_O(returnDetail) = ((ocrDataBlockFactory_t*)(self->factories[db->fctId]))->fcts.setHint(db, PD_MSG_FIELD_I(hint));
             }
             break;
         case OCR_HINT_EVT_T:
@@ -3767,7 +3958,7 @@ u8 hcPolicyDomainProcessMessage(ocrPolicyDomain_t *self, ocrPolicyMsg_t *msg, u8
             {
                 ocrAssert(kind == OCR_GUID_DB);
                 ocrDataBlock_t *db = (ocrDataBlock_t*)(PD_MSG_FIELD_I(guid.metaDataPtr));
-                PD_MSG_FIELD_O(returnDetail) = ((ocrDataBlockFactory_t*)(self->factories[self->datablockFactoryIdx]))->fcts.getHint(db, PD_MSG_FIELD_IO(hint));
+                PD_MSG_FIELD_O(returnDetail) = ((ocrDataBlockFactory_t*)(self->factories[db->fctId]))->fcts.getHint(db, PD_MSG_FIELD_IO(hint));
             }
             break;
         case OCR_HINT_EVT_T:
@@ -49,6 +49,9 @@ typedef struct {
 #ifdef ENABLE_EXTENSION_PAUSE
     hcPqrFlags pqrFlags;
 #endif
+#ifdef ENABLE_EDT_ANON
+    bool anonEdt; // Whether EDT_PROP_ANON is honored in this PD
+#endif
 #ifdef ENABLE_RESILIENCY
     ocrFaultArgs_t faultArgs;
     volatile u32 shutdownInProgress;
@@ -14,6 +14,8 @@
 
 // This is to resolve sizeof ocrTaskTemplateHc_t and set the hints pointers.
 #include "task/hc/hc-task.h"
+// This is to resolve sizeof regNode_t for multi-satisfy messages.
+#include "hc/hc.h"
 
 #ifdef OCR_MONITOR_NETWORK
 #include "ocr-sal.h"
@@ -138,26 +140,31 @@ ocrPolicyMsg_t * allocPolicyMsg(ocrPolicyDomain_t * pd, u64 * size) {
     return pd->fcts.pdMalloc(pd, msgSize);
 }
 
-u64 ocrPolicyMsgGetMsgBaseSize(ocrPolicyMsg_t *msg, bool isIn) {
-    u64 baseSize = 0;
-#define PD_MSG msg
-    // To make it clean and easy to extend, it
-    // requires two switch statements
-    switch(msg->type & PD_MSG_TYPE_ONLY) {
+// Size of the header and of the fields the message type uses in its
+// in or out direction, as laid out by the PD_MSG field macros
+static u64 getMsgFieldsSize(u32 msgType, bool isIn) {
+    u64 fieldsSize = 0;
+    switch(msgType & PD_MSG_TYPE_ONLY) {
 #define PER_TYPE(type)                                  \
     case type:                                          \
         if(isIn) {                                      \
-            baseSize = _PD_MSG_SIZE_IN(type);           \
+            fieldsSize = _PD_MSG_SIZE_IN(type);         \
         } else {                                        \
-            baseSize = _PD_MSG_SIZE_OUT(type);          \
+            fieldsSize = _PD_MSG_SIZE_OUT(type);        \
         }                                               \
         break;
 #include "ocr-policy-msg-list.h"
 #undef PER_TYPE
     default:
-        DPRINTF(DEBUG_LVL_WARN, "Error: Message type 0x%"PRIx64" not handled in getMsgSize\n", (u64)(msg->type & PD_MSG_TYPE_ONLY));
+        DPRINTF(DEBUG_LVL_WARN, "Error: Message type 0x%"PRIx64" not handled in getMsgSize\n", (u64)(msgType & PD_MSG_TYPE_ONLY));
         ocrAssert(false);
     }
+    return fieldsSize;
+}
+
+u64 ocrPolicyMsgGetMsgBaseSize(ocrPolicyMsg_t *msg, bool isIn) {
+#define PD_MSG msg
+    u64 baseSize = getMsgFieldsSize(msg->type, isIn);
     // The message is already serialized and must account for the payload
     // Note that are few cases where we issue responses too, so discriminate on message's type
     if (((msg->type & PD_MSG_TYPE_ONLY) == PD_MSG_METADATA_COMM) && (msg->type & PD_MSG_REQUEST)) {
@@ -355,6 +362,14 @@ u8 ocrPolicyMsgGetMsgSize(ocrPolicyMsg_t *msg, u64 *baseSize,
         }
         break;
 
+    case PD_MSG_DEP_SATISFY_MULTI:
+#define PD_TYPE PD_MSG_DEP_SATISFY_MULTI
+        if(isIn) {
+            *marshalledSize = sizeof(regNode_t)*PD_MSG_FIELD_I(waitersCount);
+        }
+        break;
+#undef PD_TYPE
+
     case PD_MSG_HINT_SET:
 #define PD_TYPE PD_MSG_HINT_SET
         if(isIn) {
@@ -388,6 +403,18 @@ u8 ocrPolicyMsgGetMsgSize(ocrPolicyMsg_t *msg, u64 *baseSize,
     return 0;
 }
 
+// Size of the payload a metadata communication references instead of holding it
+static u64 mdCommExtSize(ocrPolicyMsg_t *msg) {
+    if (((msg->type & PD_MSG_TYPE_ONLY) != PD_MSG_METADATA_COMM) || !(msg->type & PD_MSG_REQUEST)) {
+        return 0;
+    }
+#define PD_MSG msg
+#define PD_TYPE PD_MSG_METADATA_COMM
+    return (PD_MSG_FIELD_I(extPayload) != NULL) ? PD_MSG_FIELD_I(extSize) : 0;
+#undef PD_MSG
+#undef PD_TYPE
+}
+
 u8 ocrPolicyMsgMarshallMsg(ocrPolicyMsg_t* msg, u64 baseSize, u8* buffer, u32 mode) {
 
     u8* startPtr = NULL;
@@ -435,8 +462,23 @@ u8 ocrPolicyMsgMarshallMsg(ocrPolicyMsg_t* msg, u64 baseSize, u8* buffer, u32 mo
         u32 bufBSize = bufferMsg->bufferSize;
         u32 bufUSize = bufferMsg->usefulSize;
         ocrAssert(((ocrPolicyMsg_t*)buffer)->bufferSize >= baseSize);
-        // Copy msg into the buffer for the common part
-        hal_memCopy(buffer, msg, baseSize, false);
+        u64 extSize = mdCommExtSize(msg);
+        if (extSize != 0) {
+            // Copy what the message holds, then the payload it references
+#define PD_MSG msg
+#define PD_TYPE PD_MSG_METADATA_COMM
+            u64 inlineSize = ((u64) (((u8 *) &PD_MSG_FIELD_I(payload)) - ((u8 *) msg))) + PD_MSG_FIELD_I(sizePayload) - extSize;
+            hal_memCopy(buffer, msg, inlineSize, false);
+            hal_memCopy(buffer + inlineSize, PD_MSG_FIELD_I(extPayload), extSize, false);
+#undef PD_MSG
+#define PD_MSG bufferMsg
+            PD_MSG_FIELD_I(extPayload) = NULL;
+#undef PD_MSG
+#undef PD_TYPE
+        } else {
+            // Copy msg into the buffer for the common part
+            hal_memCopy(buffer, msg, baseSize, false);
+        }
         bufferMsg->bufferSize = bufBSize;
         bufferMsg->usefulSize = bufUSize;
         startPtr = buffer;
@@ -446,6 +488,7 @@ u8 ocrPolicyMsgMarshallMsg(ocrPolicyMsg_t* msg, u64 baseSize, u8* buffer, u32 mo
     }
     case MARSHALL_APPEND:
         ocrAssert((u64)buffer == (u64)msg);
+        ocrAssert(mdCommExtSize(msg) == 0);
         startPtr = (u8*)(msg);
         curPtr = startPtr + baseSize;
         ocrAssert(msg->bufferSize >= baseSize); // Make sure the message is not of zero size
@@ -981,6 +1024,28 @@ u8 ocrPolicyMsgMarshallMsg(ocrPolicyMsg_t* msg, u64 baseSize, u8* buffer, u32 mo
 #undef PD_TYPE
     }
 
+    case PD_MSG_DEP_SATISFY_MULTI: {
+#define PD_TYPE PD_MSG_DEP_SATISFY_MULTI
+        if(isIn) {
+            ocrAssert(PD_MSG_FIELD_I(waitersCount) != 0);
+            u64 s = sizeof(regNode_t)*PD_MSG_FIELD_I(waitersCount);
+            hal_memCopy(curPtr, PD_MSG_FIELD_I(waiters), s, false);
+            // Now fixup the pointer
+            if(fixupPtrs) {
+                DPRINTF(DEBUG_LVL_VVERB, "Converting waiters (%p) to 0x%"PRIx64"\n",
+                        PD_MSG_FIELD_I(waiters), ((u64)(curPtr - startPtr)<<1) + isAddl);
+                PD_MSG_FIELD_I(waiters) = (regNode_t*)((((u64)(curPtr - startPtr))<<1) + isAddl);
+            } else {
+                DPRINTF(DEBUG_LVL_VVERB, "Copying waiters (%p) to %p\n",
+                        PD_MSG_FIELD_I(waiters), curPtr);
+                PD_MSG_FIELD_I(waiters) = (regNode_t*)curPtr;
+            }
+            curPtr += s;
+        }
+        break;
+#undef PD_TYPE
+    }
+
     case PD_MSG_METADATA_COMM: {
 #define PD_TYPE PD_MSG_METADATA_COMM
         // Sometime issues two-way for ordering purposes so it can be in or out
@@ -1431,6 +1496,18 @@ u8 ocrPolicyMsgUnMarshallMsg(u8* mainBuffer, u8* addlBuffer,
 #undef PD_TYPE
     }
 
+    case PD_MSG_DEP_SATISFY_MULTI: {
+#define PD_TYPE PD_MSG_DEP_SATISFY_MULTI
+        if(isIn) {
+            u64 t = (u64)(PD_MSG_FIELD_I(waiters));
+            PD_MSG_FIELD_I(waiters) = (regNode_t*)((t&1?localAddlPtr:localMainPtr) + (t>>1));
+            DPRINTF(DEBUG_LVL_VVERB, "Converted field waiters from 0x%"PRIx64" to 0x%"PRIx64"\n",
+                    t, (u64)PD_MSG_FIELD_I(waiters));
+        }
+        break;
+#undef PD_TYPE
+    }
+
     case PD_MSG_METADATA_COMM: {
 #define PD_TYPE PD_MSG_METADATA_COMM
         // Sometime issues two-way for ordering purposes so it can be in or out
@@ -1573,6 +1650,188 @@ u8 ocrPolicyMsgUnMarshallMsg(u8* mainBuffer, u8* addlBuffer,
     return 0;
 }
 
+// Compact encoding: the words of the header and of the fields the message
+// type uses are stored as LEB128 varints, the marshalled data that follows
+// is copied as is. The buffer size is not part of the encoding. GUIDs use
+// their high bits and would take up to 10 bytes as varints: the GUIDs of the
+// message's fat GUIDs are copied as is too.
+
+#define COMPACT_WORD_IDX(field) (((u64) &(((ocrPolicyMsg_t *) 0)->field)) / sizeof(u64))
+#define COMPACT_WORD_ALIGN(sz) ((((u64) (sz)) + sizeof(u64) - 1) / sizeof(u64))
+
+static u64 compactPutVarint(u8 * buffer, u64 bufferSize, u64 pos, u64 value) {
+    do {
+        if (pos >= bufferSize) {
+            return 0;
+        }
+        u8 byte = (u8) (value & 0x7F);
+        value >>= 7;
+        buffer[pos++] = (value != 0) ? (byte | 0x80) : byte;
+    } while (value != 0);
+    return pos;
+}
+
+static u64 compactGetVarint(const u8 * buffer, u64 size, u64 pos, u64 * value) {
+    u64 result = 0;
+    u32 shift = 0;
+    u8 byte;
+    do {
+        if ((pos >= size) || (shift >= 64)) {
+            return 0;
+        }
+        byte = buffer[pos++];
+        result |= ((u64) (byte & 0x7F)) << shift;
+        shift += 7;
+    } while (byte & 0x80);
+    *value = result;
+    return pos;
+}
+
+// Fat GUIDs are laid out at the start of the arguments (in/out ones) and
+// at the start of the in or out part: words [first, end) of the message
+typedef struct {
+    u64 first[2];
+    u64 end[2];
+} compactGuidWords_t;
+
+static void compactGetGuidWords(ocrPolicyMsg_t * msg, compactGuidWords_t * guidWords) {
+    u32 ioCount = PD_MSG_FG_IO_COUNT_ONLY_GET(msg->type);
+    u32 count = (msg->type & PD_MSG_REQUEST) ? PD_MSG_FG_I_COUNT_ONLY_GET(msg->type) :
+                                                PD_MSG_FG_O_COUNT_ONLY_GET(msg->type);
+    u64 inOrOut = 0;
+    switch(msg->type & PD_MSG_TYPE_ONLY) {
+#define PER_TYPE(type)                                                  \
+    case type:                                                          \
+        inOrOut = (u64) (((u8 *) &(_PD_MSG_INOUT_STRUCT(msg, type))) - ((u8 *) msg)); \
+        break;
+#include "ocr-policy-msg-list.h"
+#undef PER_TYPE
+    default:
+        ocrAssert(0);
+    }
+    guidWords->first[0] = COMPACT_WORD_IDX(args);
+    guidWords->end[0] = guidWords->first[0] + COMPACT_WORD_ALIGN(ioCount * sizeof(ocrFatGuid_t));
+    guidWords->first[1] = inOrOut / sizeof(u64);
+    guidWords->end[1] = guidWords->first[1] + COMPACT_WORD_ALIGN(count * sizeof(ocrFatGuid_t));
+}
+
+static bool compactIsGuidWord(compactGuidWords_t * guidWords, u64 idx) {
+    u32 k;
+    for (k = 0; k < 2; k++) {
+        if ((idx >= guidWords->first[k]) && (idx < guidWords->end[k]) &&
+            ((((idx - guidWords->first[k]) * sizeof(u64)) % sizeof(ocrFatGuid_t)) < sizeof(ocrGuid_t))) {
+            return true;
+        }
+    }
+    return false;
+}
+
+u64 ocrPolicyMsgCompactEncode(ocrPolicyMsg_t * msg, u8 * buffer, u64 bufferSize) {
+    u64 fullSize = msg->usefulSize;
+    u64 nbWords = COMPACT_WORD_ALIGN(getMsgFieldsSize(msg->type, (msg->type & PD_MSG_REQUEST) != 0));
+    ocrAssert((nbWords * sizeof(u64)) <= fullSize);
+    if (bufferSize == 0) {
+        return 0;
+    }
+    buffer[0] = POLICY_MSG_COMPACT_MARK;
+    u64 * words = (u64 *) msg;
+    u64 skipIdx = COMPACT_WORD_IDX(bufferSize);
+    compactGuidWords_t guidWords;
+    compactGetGuidWords(msg, &guidWords);
+    u64 pos = 1;
+    u64 i;
+    for (i = 0; i < nbWords; i++) {
+        if (i == skipIdx) {
+            continue;
+        }
+        if (compactIsGuidWord(&guidWords, i)) {
+            if ((pos + sizeof(u64)) > bufferSize) {
+                return 0;
+            }
+            hal_memCopy(buffer + pos, (u8 *) &words[i], sizeof(u64), false);
+            pos += sizeof(u64);
+        } else {
+            pos = compactPutVarint(buffer, bufferSize, pos, words[i]);
+            if (pos == 0) {
+                return 0;
+            }
+        }
+    }
+    u64 tailSize = fullSize - (nbWords * sizeof(u64));
+    if ((pos + tailSize) > bufferSize) {
+        return 0;
+    }
+    hal_memCopy(buffer + pos, (u8 *) &words[nbWords], tailSize, false);
+    return pos + tailSize;
+}
+
+u64 ocrPolicyMsgCompactGetSize(const u8 * buffer, u64 size) {
+    if ((size == 0) || (buffer[0] != POLICY_MSG_COMPACT_MARK)) {
+        return 0;
+    }
+    u64 skipIdx = COMPACT_WORD_IDX(bufferSize);
+    u64 sizeIdx = COMPACT_WORD_IDX(usefulSize);
+    u64 pos = 1;
+    u64 value = 0;
+    u64 i;
+    for (i = 0; i <= sizeIdx; i++) {
+        if (i != skipIdx) {
+            pos = compactGetVarint(buffer, size, pos, &value);
+            if (pos == 0) {
+                return 0;
+            }
+        }
+    }
+    return value;
+}
+
+u64 ocrPolicyMsgCompactDecode(const u8 * buffer, u64 size, ocrPolicyMsg_t * msg, u64 msgSize) {
+    if ((size == 0) || (buffer[0] != POLICY_MSG_COMPACT_MARK)) {
+        return 0;
+    }
+    u64 * words = (u64 *) msg;
+    u64 skipIdx = COMPACT_WORD_IDX(bufferSize);
+    u64 typeIdx = COMPACT_WORD_IDX(type);
+    ocrAssert((COMPACT_WORD_IDX(usefulSize) < typeIdx) && (skipIdx < typeIdx));
+    // The number of words and where the GUIDs are is known once the
+    // type has been decoded. The header does not hold any GUID.
+    u64 nbWords = typeIdx + 1;
+    compactGuidWords_t guidWords = {{0, 0}, {0, 0}};
+    u64 pos = 1;
+    u64 i;
+    for (i = 0; i < nbWords; i++) {
+        if (i == skipIdx) {
+            continue;
+        }
+        if (compactIsGuidWord(&guidWords, i)) {
+            if ((pos + sizeof(u64)) > size) {
+                return 0;
+            }
+            hal_memCopy((u8 *) &words[i], buffer + pos, sizeof(u64), false);
+            pos += sizeof(u64);
+        } else {
+            pos = compactGetVarint(buffer, size, pos, &words[i]);
+            if (pos == 0) {
+                return 0;
+            }
+        }
+        if (i == typeIdx) {
+            nbWords = COMPACT_WORD_ALIGN(getMsgFieldsSize(msg->type, (msg->type & PD_MSG_REQUEST) != 0));
+            if ((msg->usefulSize > msgSize) || ((nbWords * sizeof(u64)) > msg->usefulSize)) {
+                return 0;
+            }
+            compactGetGuidWords(msg, &guidWords);
+        }
+    }
+    msg->bufferSize = msgSize;
+    u64 tailSize = msg->usefulSize - (nbWords * sizeof(u64));
+    if ((pos + tailSize) > size) {
+        return 0;
+    }
+    hal_memCopy((u8 *) &words[nbWords], buffer + pos, tailSize, false);
+    return pos + tailSize;
+}
+
 // Process incoming message from other policy-domains
 // There are two impl to asynchronously process incoming message based on MT or EDTs
 // The later will be stripped out.
@@ -1649,6 +1908,27 @@ u8 processIncomingMsg(ocrPolicyDomain_t * pd, ocrPolicyMsg_t * msg) {
     return res;
 }
 
+#ifdef ENABLE_COMM_API_FLOW_CONTROL
+// Notes to the comm-api that the processing of a request from 'location'
+// has started so that its flow-control credit can go back to the sender.
+// The comm-api consumes the note and batches the credits.
+void returnFlowCredit(ocrPolicyDomain_t * pd, ocrLocation_t location) {
+    PD_MSG_STACK(msg);
+    getCurrentEnv(NULL, NULL, NULL, &msg);
+#define PD_MSG (&msg)
+#define PD_TYPE PD_MSG_MGT_FLOW_CREDIT
+    msg.type = PD_MSG_MGT_FLOW_CREDIT | PD_MSG_REQUEST;
+    msg.destLocation = location;
+    PD_MSG_FIELD_I(credits) = 1;
+#undef PD_MSG
+#undef PD_TYPE
+    pd->fcts.sendMessage(pd, location, &msg, NULL, 0);
+}
+#endif
+
+// paramv[0] is the message to process. With ENABLE_COMM_API_FLOW_CONTROL,
+// comm-workers pass the location to give the request's credit back to as
+// paramv[1], INVALID_LOCATION if none.
 ocrGuid_t processRequestEdt(u32 paramc, u64* paramv, u32 depc, ocrEdtDep_t depv[]) {
     ocrPolicyMsg_t * msg = (ocrPolicyMsg_t *) paramv[0];
     DPRINTF(DEBUG_LVL_VERB, "processIncomingMsg: Going to process EDT request msg=%p of type=0x%"PRIx32" and msgId=%"PRIu64"\n",
@@ -1659,6 +1939,11 @@ ocrGuid_t processRequestEdt(u32 paramc, u64* paramv, u32 depc, ocrEdtDep_t depv[
     ocrWorker_t *worker = NULL;
     getCurrentEnv(NULL, &worker, NULL, NULL);
     worker->edtDepth++;
+#endif
+#ifdef ENABLE_COMM_API_FLOW_CONTROL
+    if ((paramc > 1) && (paramv[1] != INVALID_LOCATION)) {
+        returnFlowCredit(pd, (ocrLocation_t) paramv[1]);
+    }
 #endif
     processIncomingMsg(pd, msg);
 #ifdef ENABLE_RESILIENCY
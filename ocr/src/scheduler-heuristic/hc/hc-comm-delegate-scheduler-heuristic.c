@@ -11,6 +11,7 @@
 #ifdef ENABLE_SCHEDULER_HEURISTIC_HC_COMM_DELEGATE
 
 #include "debug.h"
+#include "ocr-comm-platform.h"
 #include "ocr-errors.h"
 #include "ocr-policy-domain.h"
 #include "ocr-runtime-types.h"
@@ -36,6 +37,7 @@ static ocrSchedulerHeuristic_t* newSchedulerHeuristicHcCommDelegate(ocrScheduler
     ocrSchedulerHeuristic_t* self = (ocrSchedulerHeuristic_t*) runtimeChunkAlloc(sizeof(ocrSchedulerHeuristicHcCommDelegate_t), PERSISTENT_CHUNK);
     initializeSchedulerHeuristicOcr(factory, self, perInstance);
     ocrSchedulerHeuristicHcCommDelegate_t * dself = (ocrSchedulerHeuristicHcCommDelegate_t *) self;
+    dself->shardCount = 1;
     dself->outboxesCount = 0;
     dself->outboxes = NULL;
     dself->inboxesCount = 0;
@@ -103,11 +105,22 @@ static u8 hcCommDelegateSchedulerHeuristicSwitchRunlevel(ocrSchedulerHeuristic_t
                 hcContext->mySchedulerObject = NULL;
             }
             //Note: pd should have been set in base implementation
-            //Create outbox queues for each worker
+            //Each comm-worker drives a shard of the communications
+            u32 shardCount = 0;
+            while ((shardCount < PD->workerCount) &&
+                   (((ocrWorkerHc_t *) PD->workers[shardCount])->hcType == HC_WORKER_COMM)) {
+                shardCount++;
+            }
+            ocrAssert(shardCount > 0);
+            for(i = shardCount; i < PD->workerCount; ++i) {
+                ocrAssert((((ocrWorkerHc_t *) PD->workers[i])->hcType != HC_WORKER_COMM) && "error: comm-workers must be the first workers");
+            }
+            dself->shardCount = shardCount;
+            //Create outbox queues for each worker and shard
             u64 boxCount = PD->workerCount;
-            dself->outboxesCount = boxCount;
-            dself->outboxes = PD->fcts.pdMalloc(PD, sizeof(deque_t *) * boxCount);
-            for(i = 0; i < boxCount; ++i) {
+            dself->outboxesCount = boxCount * shardCount;
+            dself->outboxes = PD->fcts.pdMalloc(PD, sizeof(deque_t *) * dself->outboxesCount);
+            for(i = 0; i < dself->outboxesCount; ++i) {
                 dself->outboxes[i] = newDeque(PD, NULL, WORK_STEALING_DEQUE);
             }
             //Create inbox queues for each worker
@@ -164,6 +177,22 @@ static ocrSchedulerHeuristicContext_t* hcCommDelegateSchedulerHeuristicGetContex
     return self->contexts[worker->id];
 }
 
+/**
+ * @brief Returns the comm-worker shard an outgoing message must go through
+ *
+ * Responses go back through the shard their request came from, other
+ * messages through the shard of the source and destination pair.
+ */
+static u32 hcCommDelegateShardOf(ocrSchedulerHeuristicHcCommDelegate_t * commSched, ocrPolicyMsg_t * message) {
+    if (commSched->shardCount == 1) {
+        return 0;
+    }
+    if (message->type & PD_MSG_RESPONSE) {
+        return COMM_SHARD_OF_MSGID(message->msgId, commSched->shardCount);
+    }
+    return COMM_SHARD_OF_PEERS(message->srcLocation, message->destLocation, commSched->shardCount);
+}
+
 /**
  * @brief Take communication work
  *
@@ -192,8 +221,10 @@ static inline u8 hcCommDelegateWorkEdtUserInvoke(ocrSchedulerHeuristic_t *self,
         //      the whole worker ID business
         //NOTE: It's debatable whether we should steal a bunch from each outbox
         //      or go over all outboxes
-        deque_t ** outboxes = commSched->outboxes;
-        u64 outboxesCount = commSched->outboxesCount;
+        // A comm-worker only looks at the outboxes of its own shard
+        ocrAssert(wid < commSched->shardCount);
+        u64 outboxesCount = worker->pd->workerCount;
+        deque_t ** outboxes = &(commSched->outboxes[wid * outboxesCount]);
         u32 success = 0;
 
 #ifdef HYBRID_COMM_COMP_WORKER // Experimental see documentation
@@ -347,7 +378,8 @@ static inline u8 hcCommDelegateNotifyCommReadyInvoke(ocrSchedulerHeuristic_t *se
                 // Push to the comm worker outbox
                 DPRINTF(DEBUG_LVL_VVERB,"[%"PRId32"] hc-comm-delegate-scheduler:: Comm-worker pushes outgoing to own outbox %"PRId32"\n",
                     (int) pd->myLocation, worker->id);
-                deque_t * outbox = commSched->outboxes[worker->id];
+                u32 shard = hcCommDelegateShardOf(commSched, message);
+                deque_t * outbox = commSched->outboxes[(shard * pd->workerCount) + worker->id];
                 outbox->pushAtTail(outbox, handle, 0);
             } else {
         #endif
@@ -369,17 +401,16 @@ static inline u8 hcCommDelegateNotifyCommReadyInvoke(ocrSchedulerHeuristic_t *se
         while (i < count) {
             // Set delegate handle's box id.
             delegateMsgHandle_t* delHandle = (delegateMsgHandle_t *) fatHandlers[i].metaDataPtr;
-#ifdef OCR_ASSERT
             ocrPolicyMsg_t * message = (delHandle->handle.status == HDL_RESPONSE_OK) ? delHandle->handle.response : delHandle->handle.msg;
             ocrAssert((message->srcLocation == pd->myLocation) && (message->destLocation != pd->myLocation));
-#endif
             //BUG #587: boxId is defined in del-handle however only the scheduler is using it
             delHandle->boxId = worker->id;
             DPRINTF(DEBUG_LVL_VVERB,"[%"PRIu64"] hc-comm-delegate-scheduler:: Comp-worker pushes at tail of box %"PRIu64"\n",
                 pd->myLocation, delHandle->boxId);
             ocrAssert((delHandle->boxId >= 0) && (delHandle->boxId < pd->workerCount));
-            // Put handle to worker's outbox
-            deque_t * outbox = commSched->outboxes[delHandle->boxId];
+            // Put handle to worker's outbox in the shard the message goes through
+            u32 shard = hcCommDelegateShardOf(commSched, message);
+            deque_t * outbox = commSched->outboxes[(shard * pd->workerCount) + delHandle->boxId];
             outbox->pushAtTail(outbox, (ocrMsgHandle_t *) delHandle, 0);
             i++;
         }
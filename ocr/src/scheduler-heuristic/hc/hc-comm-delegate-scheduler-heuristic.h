@@ -35,8 +35,9 @@ typedef struct _hcCommDelWorkpileIterator_t {
 
 typedef struct _ocrSchedulerHeuristicHcCommDelegate_t {
     ocrSchedulerHeuristic_t base;
+    u32 shardCount;         // Number of comm-workers, they are the PD's first workers
     u64 outboxesCount;
-    deque_t ** outboxes;
+    deque_t ** outboxes;    // One per comm-worker and worker: [shard * workerCount + workerId]
     u64 inboxesCount;
     deque_t ** inboxes;
 } ocrSchedulerHeuristicHcCommDelegate_t;
@@ -142,6 +142,7 @@ u8 deqSchedulerObjectRemove(ocrSchedulerObjectFactory_t *fact, ocrSchedulerObjec
 
     for (i = 0; i < count; i++) {
         ocrGuid_t retGuid = NULL_GUID;
+        ocrTask_t *popTask = NULL;
         switch(properties) {
         case SCHEDULER_OBJECT_REMOVE_TAIL:
             {
@@ -149,7 +150,7 @@ u8 deqSchedulerObjectRemove(ocrSchedulerObjectFactory_t *fact, ocrSchedulerObjec
 
                 void *popVal = deq->popFromTail(deq, 0);
                 if(popVal != NULL){
-                    ocrTask_t *popTask = (ocrTask_t *)popVal;
+                    popTask = (ocrTask_t *)popVal;
                     retGuid = popTask->guid;
                 }
 
@@ -162,7 +163,7 @@ u8 deqSchedulerObjectRemove(ocrSchedulerObjectFactory_t *fact, ocrSchedulerObjec
 
                 void *popVal = deq->popFromHead(deq, 1);
                 if(popVal != NULL){
-                    ocrTask_t *popTask = (ocrTask_t *)popVal;
+                    popTask = (ocrTask_t *)popVal;
                     retGuid = popTask->guid;
                 }
 
@@ -179,9 +180,11 @@ u8 deqSchedulerObjectRemove(ocrSchedulerObjectFactory_t *fact, ocrSchedulerObjec
         if (IS_SCHEDULER_OBJECT_TYPE_SINGLETON(dst->kind)) {
             ocrAssert((ocrGuidIsNull(dst->guid.guid)) && count == 1);
             dst->guid.guid = retGuid;
+            dst->guid.metaDataPtr = popTask;
         } else {
             ocrSchedulerObject_t taken;
             taken.guid.guid = retGuid;
+            taken.guid.metaDataPtr = popTask;
             taken.kind = kind;
             ocrSchedulerObjectFactory_t *dstFactory = fact->pd->schedulerObjectFactories[dst->fctId];
             dstFactory->fcts.insert(dstFactory, dst, &taken, NULL, 0);
@@ -678,6 +678,36 @@ static u8 taskAllDepvSatisfied(ocrTask_t *self) {
 // A slot has been satisfied with a DB
 #define SLOT_SATISFIED_DB               ((u32) -3)
 
+#ifdef ENABLE_EDT_ANON
+// Anonymous EDTs metadata of up to that size is recycled through the worker's pool
+#define EDT_ANON_POOL_ENTRY_SZB (sizeof(ocrTaskHc_t) + 8*sizeof(u64) + 8*sizeof(regNode_t))
+
+static ocrTaskHc_t * allocateAnonTaskHc(ocrPolicyDomain_t *pd, ocrWorker_t *worker, u32 szMd) {
+    if (szMd > EDT_ANON_POOL_ENTRY_SZB) {
+        return (ocrTaskHc_t *) pd->fcts.pdMalloc(pd, szMd);
+    }
+    if ((worker != NULL) && (worker->anonEdtPool != NULL)) {
+        // Entries are chained through their first word
+        void * entry = worker->anonEdtPool;
+        worker->anonEdtPool = *((void **) entry);
+        worker->anonEdtPoolCount--;
+        return (ocrTaskHc_t *) entry;
+    }
+    return (ocrTaskHc_t *) pd->fcts.pdMalloc(pd, EDT_ANON_POOL_ENTRY_SZB);
+}
+
+static void releaseAnonTaskHc(ocrPolicyDomain_t *pd, ocrWorker_t *worker, ocrTask_t *base) {
+    u32 szMd = sizeof(ocrTaskHc_t) + base->paramc*sizeof(u64) + base->depc*sizeof(regNode_t);
+    if ((szMd <= EDT_ANON_POOL_ENTRY_SZB) && (worker != NULL) && (worker->anonEdtPoolCount < EDT_ANON_POOL_MAX)) {
+        *((void **) base) = worker->anonEdtPool;
+        worker->anonEdtPool = (void *) base;
+        worker->anonEdtPoolCount++;
+    } else {
+        pd->fcts.pdFree(pd, base);
+    }
+}
+#endif
+
 u8 destructTaskHc(ocrTask_t* base) {
     DPRINTF(DEBUG_LVL_INFO,
             "Destroy "GUIDF"\n", GUIDA(base->guid));
@@ -803,6 +833,15 @@ u8 destructTaskHc(ocrTask_t* base) {
     }
 #endif
 #endif
+#ifdef ENABLE_EDT_ANON
+    if (base->flags & OCR_TASK_FLAG_ANON) {
+        // No GUID to destroy, recycle the metadata
+        ocrWorker_t * worker = NULL;
+        getCurrentEnv(NULL, &worker, NULL, NULL);
+        releaseAnonTaskHc(pd, worker, base);
+        return 0;
+    }
+#endif
 #define PD_MSG (&msg)
 #define PD_TYPE PD_MSG_GUID_DESTROY
     msg.type = PD_MSG_GUID_DESTROY | PD_MSG_REQUEST;
@@ -840,11 +879,156 @@ static u8 allocateNewTaskHc(ocrPolicyDomain_t *pd, ocrFatGuid_t * resultGuid,
     return 0;
 }
 
+// Creates the EDT's output event if the user requested one
+static u8 createOutputEventHc(ocrPolicyDomain_t *pd, ocrFatGuid_t currentEdt, ocrFatGuid_t *outputEventPtr,
+                              u32 properties, ocrFatGuid_t *outputEvent) {
+#ifdef ENABLE_OCR_API_DEFERRABLE
+    if (!ocrGuidIsNull(outputEventPtr->guid)) {
+        // In deferred the GUID is either null or valid but no instance attached to it
+        ocrAssert(!ocrGuidIsUninitialized(outputEventPtr->guid));
+#else
+    if (ocrGuidIsUninitialized(outputEventPtr->guid)) {
+        // In non-deferred, an unitialized guid indicates the user requested a creation
+#endif
+        PD_MSG_STACK(msg);
+        getCurrentEnv(NULL, NULL, NULL, &msg);
+#define PD_MSG (&msg)
+#define PD_TYPE PD_MSG_EVT_CREATE
+        msg.type = PD_MSG_EVT_CREATE | PD_MSG_REQUEST | PD_MSG_REQ_RESPONSE;
+        PD_MSG_FIELD_IO(guid.guid) = outputEventPtr->guid; // InOut depending on props
+        PD_MSG_FIELD_IO(guid.metaDataPtr) = NULL;
+        PD_MSG_FIELD_I(currentEdt) = currentEdt;
+#ifdef ENABLE_EXTENSION_PARAMS_EVT
+        PD_MSG_FIELD_I(params) = NULL;
+#endif
+        PD_MSG_FIELD_I(properties) = (properties & GUID_RT_PROP_ALL) | GUID_PROP_TORECORD;
+        PD_MSG_FIELD_I(type) = OCR_EVENT_ONCE_T; // Default OE type
+        RESULT_PROPAGATE(pd->fcts.processMessage(pd, &msg, true));
+        *outputEvent = PD_MSG_FIELD_IO(guid);
+        ocrAssert(!ocrGuidIsNull(outputEvent->guid));
+        ocrAssert(!ocrGuidIsUninitialized(outputEvent->guid));
+#undef PD_MSG
+#undef PD_TYPE
+    } else {
+        outputEvent->guid = outputEventPtr->guid;
+    }
+    return 0;
+}
+
+#ifdef ENABLE_EDT_ANON
+// Fast path for anonymous leaf EDTs: no GUID is created for the EDT
+// and all its dependences are expected to be satisfied by the creator
+// through the returned metadata pointer.
+static u8 newAnonTaskHc(ocrTaskFactory_t* factory, ocrFatGuid_t * edtGuid, ocrFatGuid_t edtTemplate,
+                        u32 paramc, u64* paramv, u32 depc, u32 properties,
+                        ocrFatGuid_t * outputEventPtr, ocrTask_t *curEdt, ocrFatGuid_t parentLatch,
+                        ocrParamList_t *perInstance) {
+    ocrPolicyDomain_t *pd = NULL;
+    ocrWorker_t *worker = NULL;
+    ocrTask_t *curTask = NULL;
+    getCurrentEnv(&pd, &worker, &curTask, NULL);
+    ocrFatGuid_t currentEdt = {.guid = ((curTask) ? curTask->guid : NULL_GUID), curTask};
+    u32 szMd = sizeof(ocrTaskHc_t) + paramc*sizeof(u64) + depc*sizeof(regNode_t);
+    ocrTaskHc_t* dself = allocateAnonTaskHc(pd, worker, szMd);
+    ocrTask_t * self = (ocrTask_t*) dself;
+    ocrAssert(dself);
+
+    ocrAssert(outputEventPtr != NULL);
+    ocrFatGuid_t outputEvent = {.guid = NULL_GUID, .metaDataPtr = NULL};
+    RESULT_PROPAGATE2(createOutputEventHc(pd, currentEdt, outputEventPtr, properties, &outputEvent), 1);
+
+    self->base.fctId = factory->factoryId;
+#ifdef ENABLE_RESILIENCY
+    self->base.kind = OCR_GUID_EDT;
+    self->base.size = szMd;
+#endif
+    self->guid = ANON_EDT_GUID;
+    self->templateGuid = edtTemplate.guid;
+    ocrAssert(edtTemplate.metaDataPtr);
+    self->funcPtr = ((ocrTaskTemplate_t*)(edtTemplate.metaDataPtr))->executePtr;
+    self->paramv = (paramc > 0) ? HC_TASK_PARAMV_PTR(self) : NULL;
+#if defined(OCR_ENABLE_EDT_NAMING) || defined(OCR_TRACE_BINARY)
+    hal_memCopy(&(self->name[0]), &(((ocrTaskTemplate_t*)(edtTemplate.metaDataPtr))->name[0]),
+                ocrStrlen(&(((ocrTaskTemplate_t*)(edtTemplate.metaDataPtr))->name[0])) + 1, false);
+#endif
+    self->outputEvent = outputEvent.guid;
+    // Anonymous EDTs are leaves and never open a finish scope
+    self->finishLatch = NULL_GUID;
+    self->parentLatch = parentLatch.guid;
+    u32 i;
+    for(i = 0; i < ELS_SIZE; ++i) {
+        self->els[i] = NULL_GUID;
+    }
+    self->state = CREATED_EDTSTATE;
+    self->paramc = paramc;
+    self->depc = depc;
+    self->flags = OCR_TASK_FLAG_ANON;
+    self->fctId = factory->factoryId;
+    for(i = 0; i < paramc; ++i) {
+        self->paramv[i] = paramv[i];
+    }
+    dself->signalers = HC_TASK_DEPV_PTR(self);
+    for(i = 0; i < depc; ++i) {
+        dself->signalers[i].guid = UNINITIALIZED_GUID;
+        dself->signalers[i].slot = i;
+#ifdef REG_ASYNC_SGL
+        dself->signalers[i].mode = -1; //Systematically set when satisfying
+#else
+        // Dependences are data blocks given at creation, there is no
+        // registration to record their mode
+        dself->signalers[i].mode = DB_DEFAULT_MODE;
+#endif
+    }
+    // No hint storage but typed so that heuristics can query it
+    OCR_RUNTIME_HINT_MASK_INIT(dself->hint.hintMask, OCR_HINT_EDT_T, factory->factoryId);
+    dself->hint.hintVal = NULL;
+#ifdef ENABLE_EXTENSION_PERF
+    self->taskPerfsEntry = ((ocrTaskTemplate_t*)(edtTemplate.metaDataPtr))->taskPerfsEntry;
+#endif
+    if (perInstance != NULL) {
+        paramListTask_t *taskparams = (paramListTask_t*)perInstance;
+        if (taskparams->workType == EDT_RT_WORKTYPE) {
+            self->flags |= OCR_TASK_FLAG_RUNTIME_EDT;
+        }
+    }
+#if ENABLE_EDT_METRICS
+    INIT_EDT_METRIC_STORE((&self->metricStore), ((u64 *) self->funcPtr))
+#endif
+    RESULT_PROPAGATE2(initTaskHcInternal(dself, self->guid, pd, curEdt, outputEvent, parentLatch, properties), 1);
+
+    if (!(ocrGuidIsNull(parentLatch.guid)) && isLocalGuid(pd, parentLatch.guid)) {
+        PD_MSG_STACK(msg);
+        getCurrentEnv(NULL, NULL, NULL, &msg);
+        ocrFatGuid_t edtCheckin = {.guid = self->guid, .metaDataPtr = self};
+        ocrFatGuid_t nullFGuid = {.guid = NULL_GUID, .metaDataPtr = NULL};
+        RESULT_PROPAGATE(doSatisfy(pd, &msg, edtCheckin, parentLatch, nullFGuid, OCR_EVENT_LATCH_INCR_SLOT));
+    }
+
+    if(!ocrGuidIsNull(outputEventPtr->guid)) {
+        outputEventPtr->guid = self->outputEvent;
+    }
+    DPRINTF(DEBUG_LVL_INFO, "Create anonymous EDT %p depc %"PRId32" outputEvent "GUIDF"\n", self, depc, GUIDA(outputEventPtr->guid));
+    edtGuid->guid = self->guid;
+    edtGuid->metaDataPtr = self;
+    OCR_TOOL_TRACE(true, OCR_TRACE_TYPE_EDT, OCR_ACTION_CREATE, traceTaskCreate, edtGuid->guid, depc, paramc, paramv);
+    if(depc == 0) {
+        RESULT_PROPAGATE2(taskAllDepvSatisfied(self), 1);
+    }
+    return 0;
+}
+#endif /* ENABLE_EDT_ANON */
+
 u8 newTaskHc(ocrTaskFactory_t* factory, ocrFatGuid_t * edtGuid, ocrFatGuid_t edtTemplate,
                       u32 paramc, u64* paramv, u32 depc, u32 properties,
                       ocrHint_t *hint, ocrFatGuid_t * outputEventPtr,
                       ocrTask_t *curEdt, ocrFatGuid_t parentLatch,
                       ocrParamList_t *perInstance) {
+#ifdef ENABLE_EDT_ANON
+    if (hasProperty(properties, EDT_PROP_ANON)) {
+        return newAnonTaskHc(factory, edtGuid, edtTemplate, paramc, paramv, depc, properties,
+                             outputEventPtr, curEdt, parentLatch, perInstance);
+    }
+#endif
     ocrPolicyDomain_t *pd = NULL;
     ocrTask_t *curTask = NULL;
     getCurrentEnv(&pd, NULL, &curTask, NULL);
@@ -893,37 +1077,7 @@ u8 newTaskHc(ocrTaskFactory_t* factory, ocrFatGuid_t * edtGuid, ocrFatGuid_t edt
     // This is always initialized and the guid is either uninitialized or null_guid
     ocrAssert(outputEventPtr != NULL);
     ocrFatGuid_t outputEvent = {.guid = NULL_GUID, .metaDataPtr = NULL};
-    // Check if we need an output event created
-#ifdef ENABLE_OCR_API_DEFERRABLE
-    if (!ocrGuidIsNull(outputEventPtr->guid)) {
-        // In deferred the GUID is either null or valid but no instance attached to it
-        ocrAssert(!ocrGuidIsUninitialized(outputEventPtr->guid));
-#else
-    if (ocrGuidIsUninitialized(outputEventPtr->guid)) {
-        // In non-deferred, an unitialized guid indicates the user requested a creation
-#endif
-        PD_MSG_STACK(msg2);
-        getCurrentEnv(NULL, NULL, NULL, &msg2);
-#define PD_MSG (&msg2)
-#define PD_TYPE PD_MSG_EVT_CREATE
-        msg2.type = PD_MSG_EVT_CREATE | PD_MSG_REQUEST | PD_MSG_REQ_RESPONSE;
-        PD_MSG_FIELD_IO(guid.guid) = outputEventPtr->guid; // InOut depending on props
-        PD_MSG_FIELD_IO(guid.metaDataPtr) = NULL;
-        PD_MSG_FIELD_I(currentEdt) = currentEdt;
-#ifdef ENABLE_EXTENSION_PARAMS_EVT
-        PD_MSG_FIELD_I(params) = NULL;
-#endif
-        PD_MSG_FIELD_I(properties) = (properties & GUID_RT_PROP_ALL) | GUID_PROP_TORECORD;
-        PD_MSG_FIELD_I(type) = OCR_EVENT_ONCE_T; // Default OE type
-        RESULT_PROPAGATE2(pd->fcts.processMessage(pd, &msg2, true), 1);
-        outputEvent = PD_MSG_FIELD_IO(guid);
-        ocrAssert(!ocrGuidIsNull(outputEvent.guid));
-        ocrAssert(!ocrGuidIsUninitialized(outputEvent.guid));
-#undef PD_MSG
-#undef PD_TYPE
-    } else {
-        outputEvent.guid = outputEventPtr->guid;
-    }
+    RESULT_PROPAGATE2(createOutputEventHc(pd, currentEdt, outputEventPtr, properties, &outputEvent), 1);
 
     // Set up the base's base
     self->base.fctId = factory->factoryId;
@@ -1145,6 +1299,38 @@ u8 dependenceResolvedTaskHc(ocrTask_t * self, ocrGuid_t dbGuid, void * localDbPt
     return 0;
 }
 
+#ifdef ENABLE_DB_PREFETCH
+/**
+ * @brief Hint the DB satisfying a read slot is needed soon
+ * The frontier acquires DBs one at a time and only once all slots are
+ * satisfied. Fetching read-only copies ahead overlaps their transfers
+ * with the wait for the remaining slots. Nothing is granted or released.
+ */
+static void prefetchDb(ocrGuid_t dbGuid, ocrDbAccessMode_t mode) {
+    if ((mode != DB_MODE_RO) && (mode != DB_MODE_CONST)) {
+        return;
+    }
+    ocrPolicyDomain_t * pd = NULL;
+    PD_MSG_STACK(msg);
+    getCurrentEnv(&pd, NULL, NULL, &msg);
+#define PD_MSG (&msg)
+#define PD_TYPE PD_MSG_DB_ACQUIRE
+    msg.type = PD_MSG_DB_ACQUIRE | PD_MSG_REQUEST | PD_MSG_REQ_RESPONSE;
+    PD_MSG_FIELD_IO(guid.guid) = dbGuid;
+    PD_MSG_FIELD_IO(guid.metaDataPtr) = NULL;
+    // The EDT may be gone by the time the prefetch gets processed
+    PD_MSG_FIELD_IO(edt.guid) = NULL_GUID;
+    PD_MSG_FIELD_IO(edt.metaDataPtr) = NULL;
+    PD_MSG_FIELD_IO(destLoc) = pd->myLocation;
+    PD_MSG_FIELD_IO(edtSlot) = EDT_SLOT_NONE;
+    PD_MSG_FIELD_IO(properties) = mode | DB_PROP_PREFETCH;
+    // Best effort, may complete asynchronously once the DB's metadata is in
+    pd->fcts.processMessage(pd, &msg, false);
+#undef PD_MSG
+#undef PD_TYPE
+}
+#endif
+
 #ifdef REG_ASYNC_SGL
 u8 satisfyTaskHcWithMode(ocrTask_t * base, ocrFatGuid_t data, u32 slot, ocrDbAccessMode_t mode) {
     ocrAssert(((!ocrGuidIsNull(data.guid)) ? (mode != ((ocrDbAccessMode_t)-1)) : 1) && "Mode should alway be provided");
@@ -1170,6 +1356,12 @@ u8 satisfyTaskHcWithMode(ocrTask_t * base, ocrFatGuid_t data, u32 slot, ocrDbAcc
         ocrAssert(self->slotSatisfiedCount = base->depc);
         taskAllDepvSatisfied(base);
     }
+#ifdef ENABLE_DB_PREFETCH
+    else if (!ocrGuidIsNull(data.guid)) {
+        // Other slots pending, the EDT must not be dereferenced here
+        prefetchDb(data.guid, mode);
+    }
+#endif
     return 0;
 }
 
@@ -1855,6 +2047,24 @@ void spadFree(ocrPolicyDomain_t *pd, void *ptr) {
 }
 #endif
 
+#if defined(ENABLE_EDT_ANON) && !defined(ENABLE_OCR_API_DEFERRABLE) && !defined(ENABLE_RESILIENCY)
+// Anonymous EDTs are leaves: they never open a finish scope and do not
+// need a proxy one when their parent latch is local, so the prologue
+// reduces to running the user code.
+static u8 taskExecuteAnon(ocrTask_t * base, ocrPolicyDomain_t *pd, ocrWorker_t * curWorker) {
+    ocrTaskHc_t * derived = (ocrTaskHc_t *) base;
+    ocrAssert(ocrGuidIsNull(base->finishLatch));
+    ocrAssert(derived->unkDbs == NULL);
+    base->state = RUNNING_EDTSTATE;
+    DPRINTF(DEBUG_LVL_VERB, "Execute anonymous EDT %p paramc:%"PRId32" depc:%"PRId32"\n", base, base->paramc, base->depc);
+    OCR_TOOL_TRACE(true, OCR_TRACE_TYPE_EDT, OCR_ACTION_EXECUTE, traceTaskExecute, base->guid, base->funcPtr, base->name, base->depc, base->paramc, base->paramv);
+    START_PROFILE(userCode);
+    ocrGuid_t retGuid = base->funcPtr(base->paramc, base->paramv, base->depc, derived->resolvedDeps);
+    EXIT_PROFILE;
+    return taskEpilogue(base, pd, curWorker, retGuid);
+}
+#endif
+
 u8 taskExecute(ocrTask_t* base) {
     START_PROFILE(ta_hc_execute);
 #if ENABLE_EDT_METRICS
@@ -1870,6 +2080,13 @@ u8 taskExecute(ocrTask_t* base) {
     ocrWorker_t *curWorker = NULL;
     getCurrentEnv(&pd, &curWorker, NULL, NULL);
 
+#if defined(ENABLE_EDT_ANON) && !defined(ENABLE_OCR_API_DEFERRABLE) && !defined(ENABLE_RESILIENCY)
+    if ((base->flags & OCR_TASK_FLAG_ANON) &&
+        (ocrGuidIsNull(base->parentLatch) || isLocalGuid(pd, base->parentLatch))) {
+        RETURN_PROFILE(taskExecuteAnon(base, pd, curWorker));
+    }
+#endif
+
 #if 0 // Debug: Uncomment to enable dumping of DB sizes of all EDTs
     u32 i;
     ocrPrintf("Func %p:\t", base->funcPtr);
@@ -2415,6 +2632,7 @@ u8 cloneTaskFactoryHc(ocrObjectFactory_t * factory, ocrGuid_t guid, ocrObject_t
     PD_MSG_FIELD_I(factoryId) = self->fctId;
     PD_MSG_FIELD_I(response) = NULL;
     PD_MSG_FIELD_I(mdPtr) = NULL;
+    PD_MSG_FIELD_I(extPayload) = NULL;
     DPRINTF(DEBUG_LVL_VVERB, "edt-md: push "GUIDF" in mode=%"PRIu64"\n", GUIDA(guid), mdMode);
     PD_MSG_FIELD_I(sizePayload) = mdSize;
     char * ptr = &(PD_MSG_FIELD_I(payload));
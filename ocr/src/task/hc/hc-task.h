@@ -60,6 +60,21 @@ ocrTaskTemplateFactory_t * newTaskTemplateFactoryHc(ocrParamList_t* perType, u32
 //destruct copies.
 #define MD_STATE_EDT_GHOST    1
 
+#ifdef ENABLE_EDT_ANON
+#ifndef EDT_ANON_POOL_MAX
+#define EDT_ANON_POOL_MAX 64
+#endif
+
+// GUID value carried by all anonymous EDTs (EDT_PROP_ANON). It is never
+// registered with a GUID provider and must not be resolved through one.
+#if GUID_BIT_COUNT == 64
+#define ANON_EDT_GUID_INITIALIZER {.guid = -3}
+#elif GUID_BIT_COUNT == 128
+#define ANON_EDT_GUID_INITIALIZER {.lower = -3, .upper = -3}
+#endif
+#define ANON_EDT_GUID ((ocrGuid_t)ANON_EDT_GUID_INITIALIZER)
+#endif
+
 /*! \brief Event Driven Task(EDT) implementation for OCR Tasks
  */
 typedef struct {
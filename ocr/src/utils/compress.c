@@ -0,0 +1,106 @@
+/**
+ * @brief Light-weight codec for message payloads
+ */
+
+/*
+ * This file is subject to the license agreement located in the file LICENSE
+ * and cannot be distributed without it. This notice cannot be
+ * removed or modified.
+ */
+
+#include "ocr-config.h"
+#include "ocr-types.h"
+#include "utils/ocr-utils.h"
+#include "utils/compress.h"
+
+// Payloads are not necessarily word-aligned in messages, so assemble words byte by byte
+static u64 loadWord(const u8 * src) {
+    u64 word = 0;
+    u32 i;
+    for (i = 0; i < sizeof(u64); i++) {
+        word |= ((u64) src[i]) << (i * 8);
+    }
+    return word;
+}
+
+static void storeWord(u8 * dst, u64 word) {
+    u32 i;
+    for (i = 0; i < sizeof(u64); i++) {
+        dst[i] = (u8) (word >> (i * 8));
+    }
+}
+
+static u32 significantBytes(u64 word) {
+    return (word == 0) ? 0 : ((fls64(word) / 8) + 1);
+}
+
+u64 xorDeltaEncode(u8 * dst, u64 dstSize, const u8 * src, u64 srcSize) {
+    u64 nbWords = srcSize / sizeof(u64);
+    u64 prev = 0;
+    u64 out = 0;
+    u8 * header = NULL;
+    u64 i;
+    for (i = 0; i < nbWords; i++) {
+        u64 word = loadWord(&src[i * sizeof(u64)]);
+        u64 delta = word ^ prev;
+        u32 n = significantBytes(delta);
+        prev = word;
+        // Even words open a new header, odd words use its high nibble
+        if ((i & 1) == 0) {
+            if (out >= dstSize)
+                return 0;
+            header = &dst[out++];
+            *header = (u8) n;
+        } else {
+            *header |= (u8) (n << 4);
+        }
+        if ((out + n) > dstSize)
+            return 0;
+        u32 j;
+        for (j = 0; j < n; j++) {
+            dst[out++] = (u8) (delta >> (j * 8));
+        }
+    }
+    u64 tail = srcSize - (nbWords * sizeof(u64));
+    if ((out + tail) > dstSize)
+        return 0;
+    for (i = 0; i < tail; i++) {
+        dst[out++] = src[(nbWords * sizeof(u64)) + i];
+    }
+    return out;
+}
+
+u64 xorDeltaDecode(u8 * dst, u64 dstSize, const u8 * src, u64 srcSize) {
+    u64 nbWords = dstSize / sizeof(u64);
+    u64 prev = 0;
+    u64 in = 0;
+    u8 header = 0;
+    u64 i;
+    for (i = 0; i < nbWords; i++) {
+        u32 n;
+        if ((i & 1) == 0) {
+            if (in >= srcSize)
+                return 0;
+            header = src[in++];
+            n = header & 0xF;
+        } else {
+            n = header >> 4;
+        }
+        if ((n > sizeof(u64)) || ((in + n) > srcSize))
+            return 0;
+        u64 delta = 0;
+        u32 j;
+        for (j = 0; j < n; j++) {
+            delta |= ((u64) src[in++]) << (j * 8);
+        }
+        prev ^= delta;
+        storeWord(&dst[i * sizeof(u64)], prev);
+    }
+    u64 tail = dstSize - (nbWords * sizeof(u64));
+    if ((in + tail) > srcSize)
+        return 0;
+    for (i = 0; i < tail; i++) {
+        dst[(nbWords * sizeof(u64)) + i] = src[in++];
+    }
+    return in;
+}
@@ -46,11 +46,45 @@
 //BUG #989: MT opportunity
 extern ocrGuid_t processRequestEdt(u32 paramc, u64* paramv, u32 depc, ocrEdtDep_t depv[]);
 extern u8 processIncomingMsg(ocrPolicyDomain_t * pd, ocrPolicyMsg_t * msg);
+#ifdef ENABLE_COMM_API_FLOW_CONTROL
+extern void returnFlowCredit(ocrPolicyDomain_t * pd, ocrLocation_t location);
+// processRequestEdt also gets the location to give the request's credit back to
+#define PROCESS_REQUEST_PARAMC 2
+#else
+#define PROCESS_REQUEST_PARAMC 1
+#endif
 
 /******************************************************/
 /* OCR-HC COMMUNICATION WORKER                        */
 /* Extends regular HC workers                         */
 /******************************************************/
+
+#ifdef ENABLE_COMM_API_FLOW_CONTROL
+/**
+ * @brief Returns where the credit of an incoming message goes back when
+ * its processing starts, INVALID_LOCATION if it did not take one
+ *
+ * Must match what the sending comm-api charges, see simple-comm-api.c
+ */
+static ocrLocation_t creditLocation(ocrPolicyMsg_t * msg) {
+    u32 type = msg->type & PD_MSG_TYPE_ONLY;
+    return ((msg->type & PD_MSG_REQUEST) && (type != PD_MSG_MGT_RL_NOTIFY)) ? msg->srcLocation : INVALID_LOCATION;
+}
+#endif
+
+/**
+ * @brief Processes an incoming request on the comm-worker itself
+ */
+static void processRequestInline(ocrPolicyDomain_t * pd, ocrPolicyMsg_t * message) {
+#ifdef ENABLE_COMM_API_FLOW_CONTROL
+    ocrLocation_t location = creditLocation(message);
+    if (location != INVALID_LOCATION) {
+        returnFlowCredit(pd, location);
+    }
+#endif
+    processIncomingMsg(pd, message);
+}
+
 #ifdef UTASK_COMM
 static u8 createUTask(ocrPolicyDomain_t * pd, ocrPolicyMsg_t * msg) {
     pdEvent_t * pdEvent;
@@ -71,9 +105,14 @@ static u8 createUTask(ocrPolicyDomain_t * pd, ocrPolicyMsg_t * msg) {
 
 #else
 
-static u8 createProcessRequestEdt(ocrPolicyDomain_t * pd, ocrGuid_t templateGuid, u64 * paramv) {
+static u8 createProcessRequestEdt(ocrPolicyDomain_t * pd, ocrGuid_t templateGuid, ocrPolicyMsg_t * message) {
 
-    u32 paramc = 1;
+    u32 paramc = PROCESS_REQUEST_PARAMC;
+    u64 paramv[PROCESS_REQUEST_PARAMC];
+    paramv[0] = (u64) message;
+#ifdef ENABLE_COMM_API_FLOW_CONTROL
+    paramv[1] = (u64) creditLocation(message);
+#endif
     u32 depc = 0;
     u32 properties = GUID_PROP_TORECORD;
     ocrWorkType_t workType = EDT_RT_WORKTYPE;
@@ -314,13 +353,12 @@ static void workerLoopHcCommInternal(ocrWorker_t * worker, ocrPolicyDomain_t *pd
                 // Execute selected 'sterile' messages on the spot
                 if ((message->type & PD_MSG_TYPE_ONLY) == PD_MSG_DB_ACQUIRE) {
                     DPRINTF(DEBUG_LVL_VVERB,"hc-comm-worker: Execute message, msgId: %"PRId64"\n", pd->myLocation, message->msgId);
-                    processIncomingMsg(pd, message);
+                    processRequestInline(pd, message);
                 } else {
                     #ifdef UTASK_COMM
                     createUTask(pd, message);
                     #else
-                    u64 msgParamv = (u64) message;
-                    createProcessRequestEdt(pd, processRequestTemplate, &msgParamv);
+                    createProcessRequestEdt(pd, processRequestTemplate, message);
                     #endif
                 }
             #else
@@ -355,8 +393,7 @@ static void workerLoopHcCommInternal(ocrWorker_t * worker, ocrPolicyDomain_t *pd
                         #ifdef UTASK_COMM
                         createUTask(pd, message);
                         #else
-                        u64 msgParamv = (u64) message;
-                        createProcessRequestEdt(pd, processRequestTemplate, &msgParamv);
+                        createProcessRequestEdt(pd, processRequestTemplate, message);
                         #endif
                         // We do not need the handle anymore
                         handle->destruct(handle);
@@ -398,13 +435,12 @@ static void workerLoopHcCommInternal(ocrWorker_t * worker, ocrPolicyDomain_t *pd
 #endif
 #endif
                     if (isSyncProcess) {
-                        processIncomingMsg(pd, message);
+                        processRequestInline(pd, message);
                     } else {
                         #ifdef UTASK_COMM
                         createUTask(pd, message);
                         #else
-                        u64 msgParamv = (u64) message;
-                        createProcessRequestEdt(pd, processRequestTemplate, &msgParamv);
+                        createProcessRequestEdt(pd, processRequestTemplate, message);
                         #endif
                     }
                 }
@@ -438,7 +474,7 @@ static void workerLoopHcCommInternal(ocrWorker_t * worker, ocrPolicyDomain_t *pd
             ocrAssert(hcPolicy->quiesceComms == 0 && hcPolicy->commStopped == 0);
             if (hcPolicy->stateOfRestart) {
                 ocrWorkerHcComm_t * rworker = (ocrWorkerHcComm_t *) worker;
-                ocrEdtTemplateCreate(&(rworker->processRequestTemplate), &processRequestEdt, 1, 0);
+                ocrEdtTemplateCreate(&(rworker->processRequestTemplate), &processRequestEdt, PROCESS_REQUEST_PARAMC, 0);
             }
             DPRINTF(DEBUG_LVL_VERB, "Resuming comms\n");
         } else {
@@ -544,7 +580,7 @@ static void workerLoopHcComm(ocrWorker_t * worker) {
     ocrAssert(worker->curState == GET_STATE(RL_USER_OK, PHASE_RUN));
     // Setup the template EDT for asynchronous processing of incoming communications
     ocrWorkerHcComm_t * rworker = (ocrWorkerHcComm_t *) worker;
-    ocrEdtTemplateCreate(&(rworker->processRequestTemplate), &processRequestEdt, 1, 0);
+    ocrEdtTemplateCreate(&(rworker->processRequestTemplate), &processRequestEdt, PROCESS_REQUEST_PARAMC, 0);
     rworker->flushOutgoingComm = false;
     do {
         // 'communication' loop: take, send / poll, dispatch, execute
@@ -561,6 +561,15 @@ u8 hcWorkerSwitchRunlevel(ocrWorker_t *self, ocrPolicyDomain_t *PD, ocrRunlevel_
         } else if((properties & RL_TEAR_DOWN) && (RL_IS_LAST_PHASE_DOWN(PD, RL_GUID_OK, phase))) {
 #ifdef ENABLE_EXTENSION_PERF
             PD->fcts.pdFree(PD, hcWorker->perfCtrs);
+#endif
+#ifdef ENABLE_EDT_ANON
+            // Release cached anonymous EDT metadata, chained through their first word
+            while(self->anonEdtPool != NULL) {
+                void * entry = self->anonEdtPool;
+                self->anonEdtPool = *((void **) entry);
+                PD->fcts.pdFree(PD, entry);
+            }
+            self->anonEdtPoolCount = 0;
 #endif
         }
         break;
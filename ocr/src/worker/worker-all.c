@@ -75,6 +75,10 @@ void initializeWorkerOcr(ocrWorkerFactory_t * factory, ocrWorker_t * self, ocrPa
     self->pd = NULL;
     self->location = 0;
     self->curTask = NULL;
+#ifdef ENABLE_EDT_ANON
+    self->anonEdtPool = NULL;
+    self->anonEdtPoolCount = 0;
+#endif
     self->fcts = factory->workerFcts;
     self->curState = self->desiredState = GET_STATE(RL_CONFIG_PARSE, 0);
     self->callback = NULL;
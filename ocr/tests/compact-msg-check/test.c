@@ -0,0 +1,155 @@
+/*
+ * This file is subject to the license agreement located in the file LICENSE
+ * and cannot be distributed without it. This notice cannot be
+ * removed or modified.
+ */
+
+/**
+ * Round trip of policy messages through ocrPolicyMsgCompactEncode/Decode
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "ocr-config.h"
+#include "ocr-types.h"
+#include "ocr-policy-domain.h"
+
+#define CHECK(cond) do {                                                \
+        if (!(cond)) {                                                  \
+            printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond); \
+            exit(1);                                                    \
+        }                                                               \
+    } while(0)
+
+#define MSG_BUFFER_SZ 1024
+#define TAIL_SZ 24
+
+// GUIDs as the COUNTED_MAP provider makes them: the location in the high bits
+#define COUNTED_GUID(loc, kind, counter) \
+    ((((u64) (loc)) << (64 - GUID_PROVIDER_LOCID_SIZE)) | (((u64) (kind)) << 40) | ((u64) (counter)))
+
+static u64 msgBuffer[MSG_BUFFER_SZ / sizeof(u64)];
+static u64 decodedBuffer[MSG_BUFFER_SZ / sizeof(u64)];
+static u8 compact[MSG_BUFFER_SZ];
+
+static ocrPolicyMsg_t * newMsg(u32 type, u64 fieldsSize, u64 tailSize) {
+    ocrPolicyMsg_t * msg = (ocrPolicyMsg_t *) msgBuffer;
+    memset(msgBuffer, 0, sizeof(msgBuffer));
+    msg->msgId = 0x1200;
+    msg->bufferSize = MSG_BUFFER_SZ;
+    msg->srcLocation = 1;
+    msg->destLocation = 0;
+    msg->type = type;
+    msg->usefulSize = fieldsSize + tailSize;
+    // Marshalled data, copied as is
+    u8 * tail = ((u8 *) msg) + fieldsSize;
+    u64 i;
+    for (i = 0; i < tailSize; i++) {
+        tail[i] = (u8) (0xFF - i);
+    }
+    return msg;
+}
+
+static void setGuid(ocrFatGuid_t * fatGuid, u64 value) {
+#ifdef OCR_ENABLE_128_BIT_GUID
+    fatGuid->guid.lower = (intptr_t) value;
+    fatGuid->guid.upper = (intptr_t) ~value;
+#else
+    fatGuid->guid.guid = (intptr_t) value;
+#endif
+    fatGuid->metaDataPtr = NULL;
+}
+
+/**
+ * Encodes 'msg', checks the encoding and decodes it back.
+ * Returns the encoded size.
+ */
+static u64 roundTrip(ocrPolicyMsg_t * msg) {
+    u64 size = msg->usefulSize;
+    u64 encodedSize = ocrPolicyMsgCompactEncode(msg, compact, sizeof(compact));
+    CHECK(encodedSize != 0);
+    CHECK(compact[0] == POLICY_MSG_COMPACT_MARK);
+    CHECK(ocrPolicyMsgCompactGetSize(compact, encodedSize) == size);
+    // Too small a buffer is reported
+    CHECK(ocrPolicyMsgCompactEncode(msg, compact, encodedSize - 1) == 0);
+    CHECK(ocrPolicyMsgCompactEncode(msg, compact, sizeof(compact)) == encodedSize);
+
+    ocrPolicyMsg_t * decoded = (ocrPolicyMsg_t *) decodedBuffer;
+    memset(decodedBuffer, 0xA5, sizeof(decodedBuffer));
+    CHECK(ocrPolicyMsgCompactDecode(compact, encodedSize, decoded, size) == encodedSize);
+    CHECK(decoded->bufferSize == size);
+    decoded->bufferSize = msg->bufferSize;
+    CHECK(memcmp(decoded, msg, size) == 0);
+    // Truncated data or a too small message are rejected
+    CHECK(ocrPolicyMsgCompactDecode(compact, encodedSize - 1, decoded, size) == 0);
+    CHECK(ocrPolicyMsgCompactDecode(compact, encodedSize, decoded, size - 1) == 0);
+    return encodedSize;
+}
+
+#define PD_MSG msg
+
+static void checkSatisfy() {
+#define PD_TYPE PD_MSG_DEP_SATISFY
+    ocrPolicyMsg_t * msg = newMsg(PD_MSG_DEP_SATISFY | PD_MSG_REQUEST, sizeof(ocrPolicyMsg_t), 0);
+    msg->usefulSize = ((u8 *) &PD_MSG_FIELD_I(properties)) - ((u8 *) msg) + sizeof(u32);
+    msg->usefulSize = (msg->usefulSize + sizeof(u64) - 1) & ~(sizeof(u64) - 1);
+    setGuid(&PD_MSG_FIELD_I(satisfierGuid), 0);
+    setGuid(&PD_MSG_FIELD_I(guid), 0);
+    setGuid(&PD_MSG_FIELD_I(payload), 0);
+    setGuid(&PD_MSG_FIELD_I(currentEdt), 0);
+    PD_MSG_FIELD_I(slot) = 3;
+    PD_MSG_FIELD_I(properties) = 0;
+    u64 nullSize = roundTrip(msg);
+
+    // GUIDs keep their width whatever their value
+    setGuid(&PD_MSG_FIELD_I(satisfierGuid), COUNTED_GUID(1, 5, 1));
+    setGuid(&PD_MSG_FIELD_I(guid), COUNTED_GUID((1 << GUID_PROVIDER_LOCID_SIZE) - 1, 0xFF, 0xFFFFFFFFFFULL));
+    setGuid(&PD_MSG_FIELD_I(payload), ~0ULL);
+    setGuid(&PD_MSG_FIELD_I(currentEdt), COUNTED_GUID(3, 2, 0x7F));
+    CHECK(roundTrip(msg) == nullSize);
+#undef PD_TYPE
+}
+
+static void checkAcquireResponse() {
+#define PD_TYPE PD_MSG_DB_ACQUIRE
+    ocrPolicyMsg_t * msg = newMsg(PD_MSG_DB_ACQUIRE | PD_MSG_RESPONSE, sizeof(ocrPolicyMsg_t), 0);
+    u64 fieldsSize = ((u8 *) &PD_MSG_FIELD_O(returnDetail)) - ((u8 *) msg) + sizeof(u32);
+    fieldsSize = (fieldsSize + sizeof(u64) - 1) & ~(sizeof(u64) - 1);
+    msg = newMsg(PD_MSG_DB_ACQUIRE | PD_MSG_RESPONSE, fieldsSize, TAIL_SZ);
+    setGuid(&PD_MSG_FIELD_IO(guid), COUNTED_GUID(2, 9, 42));
+    setGuid(&PD_MSG_FIELD_IO(edt), COUNTED_GUID(1, 4, 7));
+    PD_MSG_FIELD_IO(destLoc) = 1;
+    PD_MSG_FIELD_IO(edtSlot) = EDT_SLOT_NONE;
+    PD_MSG_FIELD_IO(properties) = 0xFF;
+    // Varints of every width, including the widest ones
+    PD_MSG_FIELD_O(ptr) = (void *) ~0ULL;
+    PD_MSG_FIELD_O(size) = 1ULL << 63;
+    PD_MSG_FIELD_O(returnDetail) = 0;
+    roundTrip(msg);
+    u32 shift;
+    for (shift = 0; shift < 64; shift += 7) {
+        PD_MSG_FIELD_O(size) = (1ULL << shift) - 1;
+        roundTrip(msg);
+        PD_MSG_FIELD_O(size) = 1ULL << shift;
+        roundTrip(msg);
+    }
+    // Only the low byte of the msgId is the first byte of a marshalled
+    // message: ids avoiding the mark are not taken for compact messages
+    msg->msgId = 0x1FE;
+    CHECK(ocrPolicyMsgCompactGetSize((u8 *) msg, msg->usefulSize) == 0);
+    CHECK(ocrPolicyMsgCompactDecode((u8 *) msg, msg->usefulSize, (ocrPolicyMsg_t *) decodedBuffer, MSG_BUFFER_SZ) == 0);
+    msg->msgId = 0xFF00;
+    roundTrip(msg);
+#undef PD_TYPE
+}
+
+#undef PD_MSG
+
+int main(int argc, char ** argv) {
+    checkSatisfy();
+    checkAcquireResponse();
+    printf("Everything went OK\n");
+    return 0;
+}
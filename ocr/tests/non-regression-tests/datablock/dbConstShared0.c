@@ -0,0 +1,95 @@
+/*
+ * This file is subject to the license agreement located in the file LICENSE
+ * and cannot be distributed without it. This notice cannot be
+ * removed or modified.
+ */
+
+#include "ocr.h"
+
+/**
+ * DESC: Many concurrent CONST readers interleaved with RW writers on the same
+ * datablock. Readers must never observe a write in progress.
+ */
+
+#define NB_ROUNDS 32
+#define NB_READERS 16
+#define SPIN 1000
+
+ocrGuid_t readerEdt(u32 paramc, u64* paramv, u32 depc, ocrEdtDep_t depv[]) {
+    volatile u64 * data = (u64 *) depv[0].ptr;
+    u32 i;
+    for (i = 0; i < SPIN; i++) {
+        ocrAssert(data[0] == data[1]);
+    }
+    return NULL_GUID;
+}
+
+ocrGuid_t writerEdt(u32 paramc, u64* paramv, u32 depc, ocrEdtDep_t depv[]) {
+    volatile u64 * data = (u64 *) depv[0].ptr;
+    data[0]++;
+    u32 i;
+    for (i = 0; i < SPIN; i++) {
+        ocrAssert(data[0] == (data[1] + 1));
+    }
+    data[1]++;
+    return NULL_GUID;
+}
+
+ocrGuid_t checkEdt(u32 paramc, u64* paramv, u32 depc, ocrEdtDep_t depv[]) {
+    u64 * data = (u64 *) depv[1].ptr;
+    ocrAssert(data[0] == NB_ROUNDS);
+    ocrAssert(data[1] == NB_ROUNDS);
+    ocrDbDestroy(depv[1].guid);
+    ocrPrintf("Everything went OK\n");
+    ocrShutdown();
+    return NULL_GUID;
+}
+
+ocrGuid_t rootEdt(u32 paramc, u64* paramv, u32 depc, ocrEdtDep_t depv[]) {
+    ocrGuid_t dataGuid = *((ocrGuid_t *) paramv);
+    ocrGuid_t readerTpl, writerTpl;
+    ocrEdtTemplateCreate(&readerTpl, readerEdt, 0, 1);
+    ocrEdtTemplateCreate(&writerTpl, writerEdt, 0, 1);
+    u32 r, i;
+    for (r = 0; r < NB_ROUNDS; r++) {
+        for (i = 0; i < NB_READERS; i++) {
+            ocrGuid_t edtGuid;
+            ocrEdtCreate(&edtGuid, readerTpl, 0, NULL, 1, NULL,
+                         EDT_PROP_NONE, NULL_HINT, NULL);
+            ocrAddDependence(dataGuid, edtGuid, 0, DB_MODE_CONST);
+        }
+        ocrGuid_t edtGuid;
+        ocrEdtCreate(&edtGuid, writerTpl, 0, NULL, 1, NULL,
+                     EDT_PROP_NONE, NULL_HINT, NULL);
+        ocrAddDependence(dataGuid, edtGuid, 0, DB_MODE_RW);
+    }
+    ocrEdtTemplateDestroy(readerTpl);
+    ocrEdtTemplateDestroy(writerTpl);
+    return NULL_GUID;
+}
+
+ocrGuid_t mainEdt(u32 paramc, u64* paramv, u32 depc, ocrEdtDep_t depv[]) {
+    u64 * data;
+    ocrGuid_t dataGuid;
+    ocrDbCreate(&dataGuid, (void **) &data, sizeof(u64) * 2, DB_PROP_NONE, NULL_HINT, NO_ALLOC);
+    data[0] = 0;
+    data[1] = 0;
+    ocrDbRelease(dataGuid);
+
+    ocrGuid_t rootTpl, rootGuid, rootOut;
+    ocrEdtTemplateCreate(&rootTpl, rootEdt, 1, 1);
+    ocrEdtCreate(&rootGuid, rootTpl, 1, (u64 *) &dataGuid, 1, NULL,
+                 EDT_PROP_FINISH, NULL_HINT, &rootOut);
+    ocrEdtTemplateDestroy(rootTpl);
+
+    ocrGuid_t checkTpl, checkGuid;
+    ocrEdtTemplateCreate(&checkTpl, checkEdt, 0, 2);
+    ocrEdtCreate(&checkGuid, checkTpl, 0, NULL, 2, NULL,
+                 EDT_PROP_NONE, NULL_HINT, NULL);
+    ocrEdtTemplateDestroy(checkTpl);
+    ocrAddDependence(rootOut, checkGuid, 0, DB_MODE_NULL);
+    ocrAddDependence(dataGuid, checkGuid, 1, DB_MODE_CONST);
+    // Hold the root until the check EDT is set up
+    ocrAddDependence(NULL_GUID, rootGuid, 0, DB_MODE_NULL);
+    return NULL_GUID;
+}
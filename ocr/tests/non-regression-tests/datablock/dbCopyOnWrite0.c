@@ -0,0 +1,116 @@
+/*
+ * This file is subject to the license agreement located in the file LICENSE
+ * and cannot be distributed without it. This notice cannot be
+ * removed or modified.
+ */
+
+#include "ocr.h"
+
+/**
+ * DESC: A reader holds a copy-on-write DB in CONST and lets a writer go,
+ * then waits for the writer to be done. The reader must still see the
+ * previous version and the next reader the writer's version.
+ */
+
+#ifdef ENABLE_EXTENSION_DB_COPY_ON_WRITE
+
+#include "extensions/ocr-affinity.h"
+
+#define N 64
+
+// The reader and the writer run in the current PD, so that the
+// writer's acquire is local to the DB
+static volatile u64 writerDone = 0;
+
+static void checkData(u64 * data, u64 offset) {
+    u64 i;
+    for (i = 0; i < N; i++) {
+        ocrAssert(data[i] == (i + offset));
+    }
+}
+
+ocrGuid_t writerEdt(u32 paramc, u64* paramv, u32 depc, ocrEdtDep_t depv[]) {
+    u64 * data = (u64 *) depv[0].ptr;
+    checkData(data, 0);
+    u64 i;
+    for (i = 0; i < N; i++) {
+        data[i] += N;
+    }
+    __sync_synchronize();
+    writerDone = 1;
+    return NULL_GUID;
+}
+
+ocrGuid_t readerEdt(u32 paramc, u64* paramv, u32 depc, ocrEdtDep_t depv[]) {
+    u64 * data = (u64 *) depv[0].ptr;
+    ocrGuid_t writerGoEvt = *((ocrGuid_t *) paramv);
+    // The writer acquires while the DB is held here
+    ocrEventSatisfy(writerGoEvt, NULL_GUID);
+    while (!writerDone);
+    checkData(data, 0);
+    return NULL_GUID;
+}
+
+ocrGuid_t checkEdt(u32 paramc, u64* paramv, u32 depc, ocrEdtDep_t depv[]) {
+    checkData((u64 *) depv[2].ptr, N);
+    ocrDbDestroy(depv[2].guid);
+    ocrPrintf("Everything went OK\n");
+    ocrShutdown();
+    return NULL_GUID;
+}
+
+ocrGuid_t mainEdt(u32 paramc, u64* paramv, u32 depc, ocrEdtDep_t depv[]) {
+    u64 * data;
+    ocrGuid_t dataGuid;
+    ocrDbCreate(&dataGuid, (void **) &data, sizeof(u64) * N, DB_PROP_COPY_ON_WRITE, NULL_HINT, NO_ALLOC);
+    u64 i;
+    for (i = 0; i < N; i++) {
+        data[i] = i;
+    }
+    ocrDbRelease(dataGuid);
+
+    ocrGuid_t writerGoEvt;
+    ocrEventCreate(&writerGoEvt, OCR_EVENT_ONCE_T, EVT_PROP_NONE);
+
+    ocrGuid_t currentAffinity;
+    ocrAffinityGetCurrent(&currentAffinity);
+    ocrHint_t edtHint;
+    ocrHintInit(&edtHint, OCR_HINT_EDT_T);
+    ocrSetHintValue(&edtHint, OCR_HINT_EDT_AFFINITY, ocrAffinityToHintValue(currentAffinity));
+
+    ocrGuid_t writerTpl, writerGuid, writerOut;
+    ocrEdtTemplateCreate(&writerTpl, writerEdt, 0, 2);
+    ocrEdtCreate(&writerGuid, writerTpl, 0, NULL, 2, NULL,
+                 EDT_PROP_NONE, &edtHint, &writerOut);
+    ocrEdtTemplateDestroy(writerTpl);
+
+    ocrGuid_t readerTpl, readerGuid, readerOut;
+    ocrEdtTemplateCreate(&readerTpl, readerEdt, sizeof(ocrGuid_t)/sizeof(u64), 1);
+    ocrEdtCreate(&readerGuid, readerTpl, sizeof(ocrGuid_t)/sizeof(u64), (u64 *) &writerGoEvt, 1, NULL,
+                 EDT_PROP_NONE, &edtHint, &readerOut);
+    ocrEdtTemplateDestroy(readerTpl);
+
+    ocrGuid_t checkTpl, checkGuid;
+    ocrEdtTemplateCreate(&checkTpl, checkEdt, 0, 3);
+    ocrEdtCreate(&checkGuid, checkTpl, 0, NULL, 3, NULL,
+                 EDT_PROP_NONE, NULL_HINT, NULL);
+    ocrEdtTemplateDestroy(checkTpl);
+
+    ocrAddDependence(readerOut, checkGuid, 0, DB_MODE_NULL);
+    ocrAddDependence(writerOut, checkGuid, 1, DB_MODE_NULL);
+    ocrAddDependence(dataGuid, checkGuid, 2, DB_MODE_CONST);
+    ocrAddDependence(writerGoEvt, writerGuid, 1, DB_MODE_NULL);
+    ocrAddDependence(dataGuid, writerGuid, 0, DB_MODE_RW);
+    ocrAddDependence(dataGuid, readerGuid, 0, DB_MODE_CONST);
+    return NULL_GUID;
+}
+
+#else
+
+ocrGuid_t mainEdt(u32 paramc, u64* paramv, u32 depc, ocrEdtDep_t depv[]) {
+    ocrPrintf("Test disabled - ENABLE_EXTENSION_DB_COPY_ON_WRITE not defined\n");
+    ocrShutdown();
+    return NULL_GUID;
+}
+
+#endif
@@ -0,0 +1,118 @@
+/*
+ * This file is subject to the license agreement located in the file LICENSE
+ * and cannot be distributed without it. This notice cannot be
+ * removed or modified.
+ */
+
+#include "ocr.h"
+
+/**
+ * DESC: Two EDTs, placed on the last policy domain, modify and declare
+ * sparse ranges of a DB in turn. Check modified and untouched data at home.
+ */
+
+#ifdef ENABLE_EXTENSION_DB_DIRTY_RANGE
+
+#include "extensions/ocr-affinity.h"
+#include "extensions/ocr-db-dirty-range.h"
+
+#define N 1024
+
+static void writeRange(u64 * data, ocrGuid_t db, u64 start, u64 end) {
+    u64 i;
+    for (i = start; i < end; i++) {
+        data[i] += N;
+    }
+    ocrAssert(ocrDbMarkDirty(db, start * sizeof(u64), (end - start) * sizeof(u64)) == 0);
+}
+
+ocrGuid_t writer1Edt(u32 paramc, u64* paramv, u32 depc, ocrEdtDep_t depv[]) {
+    u64 * data = (u64 *) depv[0].ptr;
+    ocrGuid_t db = depv[0].guid;
+    ocrAssert(ocrDbMarkDirty(db, N * sizeof(u64), 1) == OCR_EINVAL);
+    // Overlapping and adjacent ranges end up merged
+    writeRange(data, db, 10, 20);
+    writeRange(data, db, 20, 30);
+    writeRange(data, db, 512, 520);
+    writeRange(data, db, 256, 300);
+    // Re-declaring a range must not add it twice
+    ocrAssert(ocrDbMarkDirty(db, 12 * sizeof(u64), 4 * sizeof(u64)) == 0);
+    return NULL_GUID;
+}
+
+ocrGuid_t writer2Edt(u32 paramc, u64* paramv, u32 depc, ocrEdtDep_t depv[]) {
+    u64 * data = (u64 *) depv[0].ptr;
+    writeRange(data, depv[0].guid, N - 1, N);
+    return NULL_GUID;
+}
+
+static bool isModified(u64 i) {
+    return ((i >= 10) && (i < 30)) || ((i >= 256) && (i < 300)) ||
+           ((i >= 512) && (i < 520)) || (i == (N - 1));
+}
+
+ocrGuid_t checkEdt(u32 paramc, u64* paramv, u32 depc, ocrEdtDep_t depv[]) {
+    u64 * data = (u64 *) depv[1].ptr;
+    u64 i;
+    for (i = 0; i < N; i++) {
+        ocrAssert(data[i] == (isModified(i) ? (i + N) : i));
+    }
+    ocrDbDestroy(depv[1].guid);
+    ocrPrintf("Everything went OK\n");
+    ocrShutdown();
+    return NULL_GUID;
+}
+
+ocrGuid_t mainEdt(u32 paramc, u64* paramv, u32 depc, ocrEdtDep_t depv[]) {
+    u64 * data;
+    ocrGuid_t dataGuid;
+    ocrDbCreate(&dataGuid, (void **) &data, sizeof(u64) * N, DB_PROP_NONE, NULL_HINT, NO_ALLOC);
+    u64 i;
+    for (i = 0; i < N; i++) {
+        data[i] = i;
+    }
+    ocrDbRelease(dataGuid);
+
+    u64 affinityCount;
+    ocrAffinityCount(AFFINITY_PD, &affinityCount);
+    ocrGuid_t affinities[affinityCount];
+    ocrAffinityGet(AFFINITY_PD, &affinityCount, affinities);
+    ocrHint_t edtHint;
+    ocrHintInit(&edtHint, OCR_HINT_EDT_T);
+    ocrSetHintValue(&edtHint, OCR_HINT_EDT_AFFINITY, ocrAffinityToHintValue(affinities[affinityCount-1]));
+
+    ocrGuid_t writer1Tpl, writer1Guid, writer1Out;
+    ocrEdtTemplateCreate(&writer1Tpl, writer1Edt, 0, 1);
+    ocrEdtCreate(&writer1Guid, writer1Tpl, 0, NULL, 1, NULL,
+                 EDT_PROP_NONE, &edtHint, &writer1Out);
+    ocrEdtTemplateDestroy(writer1Tpl);
+
+    ocrGuid_t writer2Tpl, writer2Guid, writer2Out;
+    ocrEdtTemplateCreate(&writer2Tpl, writer2Edt, 0, 2);
+    ocrEdtCreate(&writer2Guid, writer2Tpl, 0, NULL, 2, NULL,
+                 EDT_PROP_NONE, &edtHint, &writer2Out);
+    ocrEdtTemplateDestroy(writer2Tpl);
+
+    ocrGuid_t checkTpl, checkGuid;
+    ocrEdtTemplateCreate(&checkTpl, checkEdt, 0, 2);
+    ocrEdtCreate(&checkGuid, checkTpl, 0, NULL, 2, NULL,
+                 EDT_PROP_NONE, NULL_HINT, NULL);
+    ocrEdtTemplateDestroy(checkTpl);
+
+    ocrAddDependence(writer2Out, checkGuid, 0, DB_MODE_NULL);
+    ocrAddDependence(dataGuid, checkGuid, 1, DB_MODE_CONST);
+    ocrAddDependence(writer1Out, writer2Guid, 1, DB_MODE_NULL);
+    ocrAddDependence(dataGuid, writer2Guid, 0, DB_MODE_RW);
+    ocrAddDependence(dataGuid, writer1Guid, 0, DB_MODE_RW);
+    return NULL_GUID;
+}
+
+#else
+
+ocrGuid_t mainEdt(u32 paramc, u64* paramv, u32 depc, ocrEdtDep_t depv[]) {
+    ocrPrintf("Test disabled - ENABLE_EXTENSION_DB_DIRTY_RANGE not defined\n");
+    ocrShutdown();
+    return NULL_GUID;
+}
+
+#endif
@@ -0,0 +1,93 @@
+/*
+ * This file is subject to the license agreement located in the file LICENSE
+ * and cannot be distributed without it. This notice cannot be
+ * removed or modified.
+ */
+
+#include "ocr.h"
+#include "extensions/ocr-affinity.h"
+
+/**
+ * DESC: Broadcast an eager DB through a sticky event to many consumers on every PD
+ */
+
+#define NB_ELEMS 100
+#define NB_CONS_PER_PD 8
+
+ocrGuid_t consEdt(u32 paramc, u64* paramv, u32 depc, ocrEdtDep_t depv[]) {
+    u32 * dbPtr = (u32 *) depv[0].ptr;
+    u32 i;
+    for (i = 0; i < NB_ELEMS; i++) {
+        ocrAssert(dbPtr[i] == (i+1));
+    }
+    return NULL_GUID;
+}
+
+ocrGuid_t checkEdt(u32 paramc, u64* paramv, u32 depc, ocrEdtDep_t depv[]) {
+    ocrGuid_t * guids = (ocrGuid_t *) paramv;
+    ocrEventDestroy(guids[1]);
+    ocrDbDestroy(guids[0]);
+    ocrPrintf("Everything went OK\n");
+    ocrShutdown();
+    return NULL_GUID;
+}
+
+ocrGuid_t rootEdt(u32 paramc, u64* paramv, u32 depc, ocrEdtDep_t depv[]) {
+    ocrGuid_t * guids = (ocrGuid_t *) paramv;
+    ocrGuid_t dbGuid = guids[0];
+    ocrGuid_t evtGuid = guids[1];
+    u64 affinityCount;
+    ocrAffinityCount(AFFINITY_PD, &affinityCount);
+    ocrGuid_t affinities[affinityCount];
+    ocrAffinityGet(AFFINITY_PD, &affinityCount, affinities);
+    ocrGuid_t consTpl;
+    ocrEdtTemplateCreate(&consTpl, consEdt, 0, 1);
+    u64 a;
+    for (a = 0; a < affinityCount; a++) {
+        ocrHint_t edtHint;
+        ocrHintInit(&edtHint, OCR_HINT_EDT_T);
+        ocrSetHintValue(&edtHint, OCR_HINT_EDT_AFFINITY, ocrAffinityToHintValue(affinities[a]));
+        u32 i;
+        for (i = 0; i < NB_CONS_PER_PD; i++) {
+            ocrGuid_t edtGuid;
+            ocrEdtCreate(&edtGuid, consTpl, 0, NULL, 1, NULL,
+                         EDT_PROP_NONE, &edtHint, NULL);
+            ocrAddDependence(evtGuid, edtGuid, 0, DB_MODE_RO);
+        }
+    }
+    ocrEdtTemplateDestroy(consTpl);
+    // All the consumers are registered, push the DB
+    ocrEventSatisfy(evtGuid, dbGuid);
+    return NULL_GUID;
+}
+
+ocrGuid_t mainEdt(u32 paramc, u64* paramv, u32 depc, ocrEdtDep_t depv[]) {
+    ocrHint_t dbHint;
+    ocrHintInit(&dbHint, OCR_HINT_DB_T);
+    ocrSetHintValue(&dbHint, OCR_HINT_DB_EAGER, 1);
+    ocrGuid_t dbGuid;
+    u32 * dbPtr;
+    ocrDbCreate(&dbGuid, (void **)&dbPtr, sizeof(u32)*NB_ELEMS, 0, &dbHint, NO_ALLOC);
+    u32 i;
+    for (i = 0; i < NB_ELEMS; i++) {
+        dbPtr[i] = i+1;
+    }
+    ocrDbRelease(dbGuid);
+
+    ocrGuid_t guids[2];
+    guids[0] = dbGuid;
+    ocrEventCreate(&guids[1], OCR_EVENT_STICKY_T, EVT_PROP_TAKES_ARG);
+
+    ocrGuid_t rootTpl, rootGuid, rootOut;
+    ocrEdtTemplateCreate(&rootTpl, rootEdt, (sizeof(ocrGuid_t)/sizeof(u64))*2, 0);
+    ocrEdtCreate(&rootGuid, rootTpl, EDT_PARAM_DEF, (u64 *) guids, 0, NULL,
+                 EDT_PROP_FINISH, NULL_HINT, &rootOut);
+    ocrEdtTemplateDestroy(rootTpl);
+
+    ocrGuid_t checkTpl, checkGuid;
+    ocrEdtTemplateCreate(&checkTpl, checkEdt, (sizeof(ocrGuid_t)/sizeof(u64))*2, 1);
+    ocrEdtCreate(&checkGuid, checkTpl, EDT_PARAM_DEF, (u64 *) guids, 1, &rootOut,
+                 EDT_PROP_NONE, NULL_HINT, NULL);
+    ocrEdtTemplateDestroy(checkTpl);
+    return NULL_GUID;
+}
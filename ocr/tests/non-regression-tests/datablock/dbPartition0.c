@@ -0,0 +1,111 @@
+/*
+ * This file is subject to the license agreement located in the file LICENSE
+ * and cannot be distributed without it. This notice cannot be
+ * removed or modified.
+ */
+
+#include "ocr.h"
+
+/**
+ * DESC: Partition a DB, write each partition from a different EDT and
+ * check the writes are visible from the parent once partitions are destroyed
+ */
+
+#ifdef ENABLE_EXTENSION_DB_PARTITION
+
+#include "extensions/ocr-db-partition.h"
+
+#define N 1024
+#define NB_PARTS 8
+
+ocrGuid_t writerEdt(u32 paramc, u64* paramv, u32 depc, ocrEdtDep_t depv[]) {
+    u64 base = paramv[0];
+    u64 * data = (u64 *) depv[0].ptr;
+    u64 i;
+    for (i = 0; i < (N / NB_PARTS); i++) {
+        // The partition views the parent's payload
+        ocrAssert(data[i] == (base + i));
+        data[i] += N;
+    }
+    ocrDbDestroy(depv[0].guid);
+    return NULL_GUID;
+}
+
+ocrGuid_t checkEdt(u32 paramc, u64* paramv, u32 depc, ocrEdtDep_t depv[]) {
+    u64 * data = (u64 *) depv[1].ptr;
+    u64 i;
+    for (i = 0; i < N; i++) {
+        ocrAssert(data[i] == (i + N));
+    }
+    ocrDbDestroy(depv[1].guid);
+    ocrPrintf("Everything went OK\n");
+    ocrShutdown();
+    return NULL_GUID;
+}
+
+ocrGuid_t rootEdt(u32 paramc, u64* paramv, u32 depc, ocrEdtDep_t depv[]) {
+    ocrGuid_t dataGuid = *((ocrGuid_t *) paramv);
+    u64 offsets[NB_PARTS];
+    u64 sizes[NB_PARTS];
+    ocrGuid_t parts[NB_PARTS];
+    u32 i;
+    for (i = 0; i < NB_PARTS; i++) {
+        offsets[i] = i * (N / NB_PARTS) * sizeof(u64);
+        sizes[i] = (N / NB_PARTS) * sizeof(u64);
+    }
+    // Out of bounds slice
+    sizes[NB_PARTS-1] += sizeof(u64);
+    ocrAssert(ocrDbPartition(dataGuid, NB_PARTS, offsets, sizes, parts) == OCR_EINVAL);
+    sizes[NB_PARTS-1] -= sizeof(u64);
+    ocrAssert(ocrDbPartition(dataGuid, NB_PARTS, offsets, sizes, parts) == 0);
+
+    ocrGuid_t writerTpl;
+    ocrEdtTemplateCreate(&writerTpl, writerEdt, 1, 1);
+    for (i = 0; i < NB_PARTS; i++) {
+        u64 base = i * (N / NB_PARTS);
+        ocrGuid_t edtGuid;
+        ocrEdtCreate(&edtGuid, writerTpl, 1, &base, 1, NULL,
+                     EDT_PROP_NONE, NULL_HINT, NULL);
+        ocrAddDependence(parts[i], edtGuid, 0, DB_MODE_RW);
+    }
+    ocrEdtTemplateDestroy(writerTpl);
+    return NULL_GUID;
+}
+
+ocrGuid_t mainEdt(u32 paramc, u64* paramv, u32 depc, ocrEdtDep_t depv[]) {
+    u64 * data;
+    ocrGuid_t dataGuid;
+    ocrDbCreate(&dataGuid, (void **) &data, sizeof(u64) * N, DB_PROP_NONE, NULL_HINT, NO_ALLOC);
+    u64 i;
+    for (i = 0; i < N; i++) {
+        data[i] = i;
+    }
+    ocrDbRelease(dataGuid);
+
+    ocrGuid_t rootTpl, rootGuid, rootOut;
+    ocrEdtTemplateCreate(&rootTpl, rootEdt, 1, 1);
+    ocrEdtCreate(&rootGuid, rootTpl, 1, (u64 *) &dataGuid, 1, NULL,
+                 EDT_PROP_FINISH, NULL_HINT, &rootOut);
+    ocrEdtTemplateDestroy(rootTpl);
+
+    // The parent is only acquired once all partitions are destroyed
+    ocrGuid_t checkTpl, checkGuid;
+    ocrEdtTemplateCreate(&checkTpl, checkEdt, 0, 2);
+    ocrEdtCreate(&checkGuid, checkTpl, 0, NULL, 2, NULL,
+                 EDT_PROP_NONE, NULL_HINT, NULL);
+    ocrEdtTemplateDestroy(checkTpl);
+    ocrAddDependence(rootOut, checkGuid, 0, DB_MODE_NULL);
+    ocrAddDependence(dataGuid, checkGuid, 1, DB_MODE_CONST);
+    ocrAddDependence(NULL_GUID, rootGuid, 0, DB_MODE_NULL);
+    return NULL_GUID;
+}
+
+#else
+
+ocrGuid_t mainEdt(u32 paramc, u64* paramv, u32 depc, ocrEdtDep_t depv[]) {
+    ocrPrintf("Test disabled - ENABLE_EXTENSION_DB_PARTITION not defined\n");
+    ocrShutdown();
+    return NULL_GUID;
+}
+
+#endif
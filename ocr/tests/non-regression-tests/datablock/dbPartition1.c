@@ -0,0 +1,108 @@
+/*
+ * This file is subject to the license agreement located in the file LICENSE
+ * and cannot be distributed without it. This notice cannot be
+ * removed or modified.
+ */
+
+#include "ocr.h"
+
+/**
+ * DESC: Partition a DB held in CONST, read and destroy the partitions and
+ * check the parent can only be written once every partition is destroyed
+ */
+
+#ifdef ENABLE_EXTENSION_DB_PARTITION
+
+#include "extensions/ocr-db-partition.h"
+
+#define N 1024
+#define NB_PARTS 4
+
+ocrGuid_t readerEdt(u32 paramc, u64* paramv, u32 depc, ocrEdtDep_t depv[]) {
+    u64 base = paramv[0];
+    u64 * data = (u64 *) depv[0].ptr;
+    u64 i;
+    for (i = 0; i < (N / NB_PARTS); i++) {
+        ocrAssert(data[i] == (base + i));
+    }
+    ocrDbDestroy(depv[0].guid);
+    return NULL_GUID;
+}
+
+ocrGuid_t writerEdt(u32 paramc, u64* paramv, u32 depc, ocrEdtDep_t depv[]) {
+    u64 * data = (u64 *) depv[0].ptr;
+    u64 i;
+    for (i = 0; i < N; i++) {
+        ocrAssert(data[i] == i);
+        data[i] += N;
+    }
+    ocrDbDestroy(depv[0].guid);
+    ocrPrintf("Everything went OK\n");
+    ocrShutdown();
+    return NULL_GUID;
+}
+
+ocrGuid_t rootEdt(u32 paramc, u64* paramv, u32 depc, ocrEdtDep_t depv[]) {
+    ocrGuid_t dataGuid = depv[0].guid;
+    ocrGuid_t parts[NB_PARTS];
+    u64 offsets[NB_PARTS];
+    u64 sizes[NB_PARTS];
+    u32 i;
+    for (i = 0; i < NB_PARTS; i++) {
+        offsets[i] = i * (N / NB_PARTS) * sizeof(u64);
+        sizes[i] = (N / NB_PARTS) * sizeof(u64);
+    }
+    // The parent is held in CONST by this EDT
+    ocrAssert(ocrDbPartition(dataGuid, NB_PARTS, offsets, sizes, parts) == 0);
+
+    // The writer acquires the parent in RW: it is only granted once this
+    // EDT is done and all the partitions are destroyed, so the readers
+    // never see its writes
+    ocrGuid_t writerTpl, writerGuid;
+    ocrEdtTemplateCreate(&writerTpl, writerEdt, 0, 1);
+    ocrEdtCreate(&writerGuid, writerTpl, 0, NULL, 1, NULL,
+                 EDT_PROP_NONE, NULL_HINT, NULL);
+    ocrEdtTemplateDestroy(writerTpl);
+    ocrAddDependence(dataGuid, writerGuid, 0, DB_MODE_RW);
+
+    ocrGuid_t readerTpl;
+    ocrEdtTemplateCreate(&readerTpl, readerEdt, 1, 1);
+    for (i = 0; i < NB_PARTS; i++) {
+        u64 base = i * (N / NB_PARTS);
+        ocrGuid_t edtGuid;
+        ocrEdtCreate(&edtGuid, readerTpl, 1, &base, 1, NULL,
+                     EDT_PROP_NONE, NULL_HINT, NULL);
+        ocrAddDependence(parts[i], edtGuid, 0, DB_MODE_CONST);
+    }
+    ocrEdtTemplateDestroy(readerTpl);
+    return NULL_GUID;
+}
+
+ocrGuid_t mainEdt(u32 paramc, u64* paramv, u32 depc, ocrEdtDep_t depv[]) {
+    u64 * data;
+    ocrGuid_t dataGuid;
+    ocrDbCreate(&dataGuid, (void **) &data, sizeof(u64) * N, DB_PROP_NONE, NULL_HINT, NO_ALLOC);
+    u64 i;
+    for (i = 0; i < N; i++) {
+        data[i] = i;
+    }
+    ocrDbRelease(dataGuid);
+
+    ocrGuid_t rootTpl, rootGuid;
+    ocrEdtTemplateCreate(&rootTpl, rootEdt, 0, 1);
+    ocrEdtCreate(&rootGuid, rootTpl, 0, NULL, 1, NULL,
+                 EDT_PROP_NONE, NULL_HINT, NULL);
+    ocrEdtTemplateDestroy(rootTpl);
+    ocrAddDependence(dataGuid, rootGuid, 0, DB_MODE_CONST);
+    return NULL_GUID;
+}
+
+#else
+
+ocrGuid_t mainEdt(u32 paramc, u64* paramv, u32 depc, ocrEdtDep_t depv[]) {
+    ocrPrintf("Test disabled - ENABLE_EXTENSION_DB_PARTITION not defined\n");
+    ocrShutdown();
+    return NULL_GUID;
+}
+
+#endif
@@ -0,0 +1,116 @@
+/*
+ * This file is subject to the license agreement located in the file LICENSE
+ * and cannot be distributed without it. This notice cannot be
+ * removed or modified.
+ */
+
+#include "ocr.h"
+
+/**
+ * DESC: Destroy the parent of partitions before they are acquired and
+ * check they still view the parent's data, written through them once
+ * and read back after the first users have released them
+ */
+
+#ifdef ENABLE_EXTENSION_DB_PARTITION
+
+#include "extensions/ocr-db-partition.h"
+
+#define N 1024
+#define NB_PARTS 8
+
+ocrGuid_t readerEdt(u32 paramc, u64* paramv, u32 depc, ocrEdtDep_t depv[]) {
+    u64 base = paramv[0];
+    u64 * data = (u64 *) depv[1].ptr;
+    u64 i;
+    for (i = 0; i < (N / NB_PARTS); i++) {
+        ocrAssert(data[i] == (base + i + N));
+    }
+    ocrDbDestroy(depv[1].guid);
+    return NULL_GUID;
+}
+
+ocrGuid_t writerEdt(u32 paramc, u64* paramv, u32 depc, ocrEdtDep_t depv[]) {
+    u64 base = paramv[0];
+    u64 * data = (u64 *) depv[0].ptr;
+    u64 i;
+    for (i = 0; i < (N / NB_PARTS); i++) {
+        ocrAssert(data[i] == (base + i));
+        data[i] += N;
+    }
+    return NULL_GUID;
+}
+
+ocrGuid_t shutdownEdt(u32 paramc, u64* paramv, u32 depc, ocrEdtDep_t depv[]) {
+    ocrPrintf("Everything went OK\n");
+    ocrShutdown();
+    return NULL_GUID;
+}
+
+ocrGuid_t rootEdt(u32 paramc, u64* paramv, u32 depc, ocrEdtDep_t depv[]) {
+    ocrGuid_t dataGuid = depv[0].guid;
+    ocrGuid_t parts[NB_PARTS];
+    u64 offsets[NB_PARTS];
+    u64 sizes[NB_PARTS];
+    u32 i;
+    for (i = 0; i < NB_PARTS; i++) {
+        offsets[i] = i * (N / NB_PARTS) * sizeof(u64);
+        sizes[i] = (N / NB_PARTS) * sizeof(u64);
+    }
+    ocrAssert(ocrDbPartition(dataGuid, NB_PARTS, offsets, sizes, parts) == 0);
+    // The partitions keep the parent's memory
+    ocrDbDestroy(dataGuid);
+
+    ocrGuid_t writerTpl, readerTpl;
+    ocrEdtTemplateCreate(&writerTpl, writerEdt, 1, 1);
+    ocrEdtTemplateCreate(&readerTpl, readerEdt, 1, 2);
+    for (i = 0; i < NB_PARTS; i++) {
+        u64 base = i * (N / NB_PARTS);
+        ocrGuid_t writerGuid, writerOut, readerGuid;
+        ocrEdtCreate(&writerGuid, writerTpl, 1, &base, 1, NULL,
+                     EDT_PROP_NONE, NULL_HINT, &writerOut);
+        ocrEdtCreate(&readerGuid, readerTpl, 1, &base, 2, NULL,
+                     EDT_PROP_NONE, NULL_HINT, NULL);
+        ocrAddDependence(writerOut, readerGuid, 0, DB_MODE_NULL);
+        ocrAddDependence(parts[i], readerGuid, 1, DB_MODE_CONST);
+        ocrAddDependence(parts[i], writerGuid, 0, DB_MODE_RW);
+    }
+    ocrEdtTemplateDestroy(writerTpl);
+    ocrEdtTemplateDestroy(readerTpl);
+    return NULL_GUID;
+}
+
+ocrGuid_t mainEdt(u32 paramc, u64* paramv, u32 depc, ocrEdtDep_t depv[]) {
+    u64 * data;
+    ocrGuid_t dataGuid;
+    ocrDbCreate(&dataGuid, (void **) &data, sizeof(u64) * N, DB_PROP_NONE, NULL_HINT, NO_ALLOC);
+    u64 i;
+    for (i = 0; i < N; i++) {
+        data[i] = i;
+    }
+    ocrDbRelease(dataGuid);
+
+    ocrGuid_t rootTpl, rootGuid, rootOut;
+    ocrEdtTemplateCreate(&rootTpl, rootEdt, 0, 1);
+    ocrEdtCreate(&rootGuid, rootTpl, 0, NULL, 1, NULL,
+                 EDT_PROP_FINISH, NULL_HINT, &rootOut);
+    ocrEdtTemplateDestroy(rootTpl);
+
+    ocrGuid_t shutdownTpl, shutdownGuid;
+    ocrEdtTemplateCreate(&shutdownTpl, shutdownEdt, 0, 1);
+    ocrEdtCreate(&shutdownGuid, shutdownTpl, 0, NULL, 1, &rootOut,
+                 EDT_PROP_NONE, NULL_HINT, NULL);
+    ocrEdtTemplateDestroy(shutdownTpl);
+    ocrAddDependence(dataGuid, rootGuid, 0, DB_MODE_RW);
+    return NULL_GUID;
+}
+
+#else
+
+ocrGuid_t mainEdt(u32 paramc, u64* paramv, u32 depc, ocrEdtDep_t depv[]) {
+    ocrPrintf("Test disabled - ENABLE_EXTENSION_DB_PARTITION not defined\n");
+    ocrShutdown();
+    return NULL_GUID;
+}
+
+#endif
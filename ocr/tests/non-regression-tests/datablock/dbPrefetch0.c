@@ -0,0 +1,124 @@
+/*
+ * This file is subject to the license agreement located in the file LICENSE
+ * and cannot be distributed without it. This notice cannot be
+ * removed or modified.
+ */
+
+#include "ocr.h"
+#include "extensions/ocr-affinity.h"
+
+/**
+ * DESC: EDTs placed on the last PD have their read DB slots satisfied
+ * before their last slot, then a writer on the same PD modifies one of
+ * the DBs. Readers and the final check at home must see consistent data.
+ */
+
+#define N 256
+#define NB_READERS 4
+
+static ocrHint_t * getRemoteHint(ocrHint_t * hint) {
+    u64 affinityCount;
+    ocrAffinityCount(AFFINITY_PD, &affinityCount);
+    ocrGuid_t affinities[affinityCount];
+    ocrAffinityGet(AFFINITY_PD, &affinityCount, affinities);
+    ocrHintInit(hint, OCR_HINT_EDT_T);
+    ocrSetHintValue(hint, OCR_HINT_EDT_AFFINITY, ocrAffinityToHintValue(affinities[affinityCount-1]));
+    return hint;
+}
+
+static void checkData(u64 * data, u64 offset) {
+    u64 i;
+    for (i = 0; i < N; i++) {
+        ocrAssert(data[i] == (i + offset));
+    }
+}
+
+ocrGuid_t readerEdt(u32 paramc, u64* paramv, u32 depc, ocrEdtDep_t depv[]) {
+    checkData((u64 *) depv[0].ptr, 0);
+    checkData((u64 *) depv[1].ptr, 0);
+    return NULL_GUID;
+}
+
+ocrGuid_t writerEdt(u32 paramc, u64* paramv, u32 depc, ocrEdtDep_t depv[]) {
+    u64 * data = (u64 *) depv[0].ptr;
+    u64 i;
+    for (i = 0; i < N; i++) {
+        data[i] += N;
+    }
+    return NULL_GUID;
+}
+
+ocrGuid_t checkEdt(u32 paramc, u64* paramv, u32 depc, ocrEdtDep_t depv[]) {
+    checkData((u64 *) depv[1].ptr, 0);
+    checkData((u64 *) depv[2].ptr, N);
+    ocrDbDestroy(depv[1].guid);
+    ocrDbDestroy(depv[2].guid);
+    ocrPrintf("Everything went OK\n");
+    ocrShutdown();
+    return NULL_GUID;
+}
+
+// Satisfies the readers' last slot after their DB slots
+ocrGuid_t triggerEdt(u32 paramc, u64* paramv, u32 depc, ocrEdtDep_t depv[]) {
+    ocrEventSatisfy(*((ocrGuid_t *) paramv), NULL_GUID);
+    return NULL_GUID;
+}
+
+static ocrGuid_t createDb(void) {
+    u64 * data;
+    ocrGuid_t dbGuid;
+    ocrDbCreate(&dbGuid, (void **) &data, sizeof(u64) * N, DB_PROP_NONE, NULL_HINT, NO_ALLOC);
+    u64 i;
+    for (i = 0; i < N; i++) {
+        data[i] = i;
+    }
+    ocrDbRelease(dbGuid);
+    return dbGuid;
+}
+
+ocrGuid_t mainEdt(u32 paramc, u64* paramv, u32 depc, ocrEdtDep_t depv[]) {
+    ocrGuid_t constDb = createDb();
+    ocrGuid_t rwDb = createDb();
+    ocrHint_t hint;
+
+    ocrGuid_t startEvt;
+    ocrEventCreate(&startEvt, OCR_EVENT_STICKY_T, EVT_PROP_NONE);
+
+    ocrGuid_t writerTpl, writerGuid, writerOut;
+    ocrEdtTemplateCreate(&writerTpl, writerEdt, 0, NB_READERS+1);
+    ocrEdtCreate(&writerGuid, writerTpl, 0, NULL, NB_READERS+1, NULL,
+                 EDT_PROP_NONE, getRemoteHint(&hint), &writerOut);
+    ocrEdtTemplateDestroy(writerTpl);
+
+    ocrGuid_t checkTpl, checkGuid;
+    ocrEdtTemplateCreate(&checkTpl, checkEdt, 0, 3);
+    ocrEdtCreate(&checkGuid, checkTpl, 0, NULL, 3, NULL,
+                 EDT_PROP_NONE, NULL_HINT, NULL);
+    ocrEdtTemplateDestroy(checkTpl);
+    ocrAddDependence(writerOut, checkGuid, 0, DB_MODE_NULL);
+
+    ocrGuid_t readerTpl;
+    ocrEdtTemplateCreate(&readerTpl, readerEdt, 0, 3);
+    u32 i;
+    for (i = 0; i < NB_READERS; i++) {
+        ocrGuid_t readerGuid, readerOut;
+        ocrEdtCreate(&readerGuid, readerTpl, 0, NULL, 3, NULL,
+                     EDT_PROP_NONE, getRemoteHint(&hint), &readerOut);
+        ocrAddDependence(readerOut, writerGuid, i+1, DB_MODE_NULL);
+        ocrAddDependence(constDb, readerGuid, 0, DB_MODE_CONST);
+        ocrAddDependence(rwDb, readerGuid, 1, DB_MODE_RO);
+        ocrAddDependence(startEvt, readerGuid, 2, DB_MODE_NULL);
+    }
+    ocrEdtTemplateDestroy(readerTpl);
+
+    ocrGuid_t triggerTpl, triggerGuid;
+    ocrEdtTemplateCreate(&triggerTpl, triggerEdt, sizeof(ocrGuid_t)/sizeof(u64), 0);
+    ocrEdtCreate(&triggerGuid, triggerTpl, sizeof(ocrGuid_t)/sizeof(u64), (u64 *) &startEvt, 0, NULL,
+                 EDT_PROP_NONE, NULL_HINT, NULL);
+    ocrEdtTemplateDestroy(triggerTpl);
+
+    ocrAddDependence(rwDb, writerGuid, 0, DB_MODE_RW);
+    ocrAddDependence(constDb, checkGuid, 1, DB_MODE_CONST);
+    ocrAddDependence(rwDb, checkGuid, 2, DB_MODE_CONST);
+    return NULL_GUID;
+}
@@ -0,0 +1,105 @@
+/*
+ * This file is subject to the license agreement located in the file LICENSE
+ * and cannot be distributed without it. This notice cannot be
+ * removed or modified.
+ */
+
+#include "ocr.h"
+#include "extensions/ocr-affinity.h"
+
+/**
+ * DESC: A remote EDT acquires in RW a DB mixing a slowly varying
+ * floating-point region, a zero region and random bytes, checks and
+ * modifies it. The home PD checks the written back data.
+ */
+
+#define N 8192
+#define NB_DOUBLES (N/2)
+#define NB_ZEROS (N/4)
+
+static u64 randomWord(u64 i) {
+    return (i * 6364136223846793005ULL) + 1442695040888963407ULL;
+}
+
+static void checkData(u8 * ptr, double offset) {
+    double * doubles = (double *) ptr;
+    u64 * words = (u64 *) ptr;
+    u64 i;
+    for (i = 0; i < NB_DOUBLES; i++) {
+        ocrAssert(doubles[i] == ((i * 0.5) + offset));
+    }
+    for (i = NB_DOUBLES; i < (NB_DOUBLES + NB_ZEROS); i++) {
+        ocrAssert(words[i] == 0);
+    }
+    for (i = NB_DOUBLES + NB_ZEROS; i < N; i++) {
+        ocrAssert(words[i] == randomWord(i));
+    }
+    // Trailing bytes that do not make a full word
+    ocrAssert(ptr[N * sizeof(u64)] == 0xAB);
+    ocrAssert(ptr[(N * sizeof(u64)) + 1] == 0xCD);
+}
+
+ocrGuid_t remoteEdt(u32 paramc, u64* paramv, u32 depc, ocrEdtDep_t depv[]) {
+    u8 * ptr = (u8 *) depv[0].ptr;
+    checkData(ptr, 0.0);
+    double * doubles = (double *) ptr;
+    u64 i;
+    for (i = 0; i < NB_DOUBLES; i++) {
+        doubles[i] += 1.0;
+    }
+    return NULL_GUID;
+}
+
+ocrGuid_t checkEdt(u32 paramc, u64* paramv, u32 depc, ocrEdtDep_t depv[]) {
+    checkData((u8 *) depv[1].ptr, 1.0);
+    ocrDbDestroy(depv[1].guid);
+    ocrPrintf("Everything went OK\n");
+    ocrShutdown();
+    return NULL_GUID;
+}
+
+ocrGuid_t mainEdt(u32 paramc, u64* paramv, u32 depc, ocrEdtDep_t depv[]) {
+    u8 * ptr;
+    ocrGuid_t dataGuid;
+    ocrDbCreate(&dataGuid, (void **) &ptr, (N * sizeof(u64)) + 2, DB_PROP_NONE, NULL_HINT, NO_ALLOC);
+    double * doubles = (double *) ptr;
+    u64 * words = (u64 *) ptr;
+    u64 i;
+    for (i = 0; i < NB_DOUBLES; i++) {
+        doubles[i] = i * 0.5;
+    }
+    for (i = NB_DOUBLES; i < (NB_DOUBLES + NB_ZEROS); i++) {
+        words[i] = 0;
+    }
+    for (i = NB_DOUBLES + NB_ZEROS; i < N; i++) {
+        words[i] = randomWord(i);
+    }
+    ptr[N * sizeof(u64)] = 0xAB;
+    ptr[(N * sizeof(u64)) + 1] = 0xCD;
+    ocrDbRelease(dataGuid);
+
+    u64 affinityCount;
+    ocrAffinityCount(AFFINITY_PD, &affinityCount);
+    ocrGuid_t affinities[affinityCount];
+    ocrAffinityGet(AFFINITY_PD, &affinityCount, affinities);
+    ocrHint_t edtHint;
+    ocrHintInit(&edtHint, OCR_HINT_EDT_T);
+    ocrSetHintValue(&edtHint, OCR_HINT_EDT_AFFINITY, ocrAffinityToHintValue(affinities[affinityCount-1]));
+
+    ocrGuid_t remoteTpl, remoteGuid, remoteOut;
+    ocrEdtTemplateCreate(&remoteTpl, remoteEdt, 0, 1);
+    ocrEdtCreate(&remoteGuid, remoteTpl, 0, NULL, 1, NULL,
+                 EDT_PROP_NONE, &edtHint, &remoteOut);
+    ocrEdtTemplateDestroy(remoteTpl);
+
+    ocrGuid_t checkTpl, checkGuid;
+    ocrEdtTemplateCreate(&checkTpl, checkEdt, 0, 2);
+    ocrEdtCreate(&checkGuid, checkTpl, 0, NULL, 2, NULL,
+                 EDT_PROP_NONE, NULL_HINT, NULL);
+    ocrEdtTemplateDestroy(checkTpl);
+
+    ocrAddDependence(remoteOut, checkGuid, 0, DB_MODE_NULL);
+    ocrAddDependence(dataGuid, checkGuid, 1, DB_MODE_CONST);
+    ocrAddDependence(dataGuid, remoteGuid, 0, DB_MODE_RW);
+    return NULL_GUID;
+}
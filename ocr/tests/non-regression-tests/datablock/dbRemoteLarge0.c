@@ -0,0 +1,97 @@
+/*
+ * This file is subject to the license agreement located in the file LICENSE
+ * and cannot be distributed without it. This notice cannot be
+ * removed or modified.
+ */
+
+#include "ocr.h"
+#include "extensions/ocr-affinity.h"
+
+/**
+ * DESC: A large DB of random words is acquired in RW by an EDT on the
+ * last PD, then in RO by an EDT on the first remote PD. The home PD
+ * checks the written back data. The DB does not compress and is over the
+ * zero-copy threshold so that its payload is sent from the DB's memory.
+ */
+
+#define N (1<<15)
+
+static u64 randomWord(u64 i) {
+    return (i * 6364136223846793005ULL) + 1442695040888963407ULL;
+}
+
+static void checkData(u64 * words, u64 offset) {
+    u64 i;
+    for (i = 0; i < N; i++) {
+        ocrAssert(words[i] == (randomWord(i) + offset));
+    }
+}
+
+ocrGuid_t writerEdt(u32 paramc, u64* paramv, u32 depc, ocrEdtDep_t depv[]) {
+    u64 * words = (u64 *) depv[0].ptr;
+    checkData(words, 0);
+    u64 i;
+    for (i = 0; i < N; i++) {
+        words[i] += 1;
+    }
+    return NULL_GUID;
+}
+
+ocrGuid_t readerEdt(u32 paramc, u64* paramv, u32 depc, ocrEdtDep_t depv[]) {
+    checkData((u64 *) depv[1].ptr, 1);
+    return NULL_GUID;
+}
+
+ocrGuid_t checkEdt(u32 paramc, u64* paramv, u32 depc, ocrEdtDep_t depv[]) {
+    checkData((u64 *) depv[1].ptr, 1);
+    ocrDbDestroy(depv[1].guid);
+    ocrPrintf("Everything went OK\n");
+    ocrShutdown();
+    return NULL_GUID;
+}
+
+ocrGuid_t mainEdt(u32 paramc, u64* paramv, u32 depc, ocrEdtDep_t depv[]) {
+    u64 * words;
+    ocrGuid_t dataGuid;
+    ocrDbCreate(&dataGuid, (void **) &words, N * sizeof(u64), DB_PROP_NONE, NULL_HINT, NO_ALLOC);
+    u64 i;
+    for (i = 0; i < N; i++) {
+        words[i] = randomWord(i);
+    }
+    ocrDbRelease(dataGuid);
+
+    u64 affinityCount;
+    ocrAffinityCount(AFFINITY_PD, &affinityCount);
+    ocrGuid_t affinities[affinityCount];
+    ocrAffinityGet(AFFINITY_PD, &affinityCount, affinities);
+    ocrHint_t writerHint, readerHint;
+    ocrHintInit(&writerHint, OCR_HINT_EDT_T);
+    ocrSetHintValue(&writerHint, OCR_HINT_EDT_AFFINITY, ocrAffinityToHintValue(affinities[affinityCount-1]));
+    ocrHintInit(&readerHint, OCR_HINT_EDT_T);
+    ocrSetHintValue(&readerHint, OCR_HINT_EDT_AFFINITY, ocrAffinityToHintValue(affinities[(affinityCount > 1) ? 1 : 0]));
+
+    ocrGuid_t writerTpl, writerGuid, writerOut;
+    ocrEdtTemplateCreate(&writerTpl, writerEdt, 0, 1);
+    ocrEdtCreate(&writerGuid, writerTpl, 0, NULL, 1, NULL,
+                 EDT_PROP_NONE, &writerHint, &writerOut);
+    ocrEdtTemplateDestroy(writerTpl);
+
+    ocrGuid_t readerTpl, readerGuid, readerOut;
+    ocrEdtTemplateCreate(&readerTpl, readerEdt, 0, 2);
+    ocrEdtCreate(&readerGuid, readerTpl, 0, NULL, 2, NULL,
+                 EDT_PROP_NONE, &readerHint, &readerOut);
+    ocrEdtTemplateDestroy(readerTpl);
+
+    ocrGuid_t checkTpl, checkGuid;
+    ocrEdtTemplateCreate(&checkTpl, checkEdt, 0, 2);
+    ocrEdtCreate(&checkGuid, checkTpl, 0, NULL, 2, NULL,
+                 EDT_PROP_NONE, NULL_HINT, NULL);
+    ocrEdtTemplateDestroy(checkTpl);
+
+    ocrAddDependence(readerOut, checkGuid, 0, DB_MODE_NULL);
+    ocrAddDependence(dataGuid, checkGuid, 1, DB_MODE_CONST);
+    ocrAddDependence(writerOut, readerGuid, 0, DB_MODE_NULL);
+    ocrAddDependence(dataGuid, readerGuid, 1, DB_MODE_RO);
+    ocrAddDependence(dataGuid, writerGuid, 0, DB_MODE_RW);
+    return NULL_GUID;
+}
@@ -0,0 +1,69 @@
+/*
+ * This file is subject to the license agreement located in the file LICENSE
+ * and cannot be distributed without it. This notice cannot be
+ * removed or modified.
+ */
+
+#include "ocr.h"
+#include "extensions/ocr-affinity.h"
+
+/**
+ * DESC: DBs of sizes around the lockable zero-copy threshold, some not a
+ * multiple of a word, are read by an EDT on the last PD. Checks every byte
+ * of the payload arrives whether or not it is sent from the DB's memory.
+ */
+
+#define NB_DBS 6
+
+static u64 dbSizes[NB_DBS] = {
+    (16*1024) - 1, (16*1024), (16*1024) + 3,
+    (48*1024) + 5, (64*1024) + 7, 1
+};
+
+static u8 randomByte(u64 db, u64 i) {
+    return (u8) (((i + db) * 2654435761ULL) >> 13);
+}
+
+ocrGuid_t readerEdt(u32 paramc, u64* paramv, u32 depc, ocrEdtDep_t depv[]) {
+    u64 db;
+    for (db = 0; db < NB_DBS; db++) {
+        u8 * bytes = (u8 *) depv[db].ptr;
+        u64 i;
+        for (i = 0; i < dbSizes[db]; i++) {
+            ocrAssert(bytes[i] == randomByte(db, i));
+        }
+    }
+    ocrPrintf("Everything went OK\n");
+    ocrShutdown();
+    return NULL_GUID;
+}
+
+ocrGuid_t mainEdt(u32 paramc, u64* paramv, u32 depc, ocrEdtDep_t depv[]) {
+    u64 affinityCount;
+    ocrAffinityCount(AFFINITY_PD, &affinityCount);
+    ocrGuid_t affinities[affinityCount];
+    ocrAffinityGet(AFFINITY_PD, &affinityCount, affinities);
+    ocrHint_t edtHint;
+    ocrHintInit(&edtHint, OCR_HINT_EDT_T);
+    ocrSetHintValue(&edtHint, OCR_HINT_EDT_AFFINITY, ocrAffinityToHintValue(affinities[affinityCount-1]));
+
+    ocrGuid_t readerTpl, readerGuid;
+    ocrEdtTemplateCreate(&readerTpl, readerEdt, 0, NB_DBS);
+    ocrEdtCreate(&readerGuid, readerTpl, 0, NULL, NB_DBS, NULL,
+                 EDT_PROP_NONE, &edtHint, NULL);
+    ocrEdtTemplateDestroy(readerTpl);
+
+    u64 db;
+    for (db = 0; db < NB_DBS; db++) {
+        u8 * bytes;
+        ocrGuid_t dataGuid;
+        ocrDbCreate(&dataGuid, (void **) &bytes, dbSizes[db], DB_PROP_NONE, NULL_HINT, NO_ALLOC);
+        u64 i;
+        for (i = 0; i < dbSizes[db]; i++) {
+            bytes[i] = randomByte(db, i);
+        }
+        ocrDbRelease(dataGuid);
+        ocrAddDependence(dataGuid, readerGuid, db, DB_MODE_RO);
+    }
+    return NULL_GUID;
+}
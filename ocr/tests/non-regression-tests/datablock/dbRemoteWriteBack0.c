@@ -0,0 +1,111 @@
+/*
+ * This file is subject to the license agreement located in the file LICENSE
+ * and cannot be distributed without it. This notice cannot be
+ * removed or modified.
+ */
+
+#include "ocr.h"
+#include "extensions/ocr-affinity.h"
+
+/**
+ * DESC: Rounds of a remote writer updating a large and a small DB followed
+ * by a check on the DBs' home. The write-backs and their acknowledgements
+ * travel with the DBs' other traffic while the writer's completion does
+ * not: the check must observe both writes of every round.
+ */
+
+#define N (64*1024)
+#define NB_ROUNDS 8
+
+typedef struct {
+    ocrGuid_t home;
+    ocrGuid_t large;
+    ocrGuid_t small;
+    u64 round;
+} roundParams_t;
+
+#define ROUND_PARAMC (sizeof(roundParams_t)/sizeof(u64))
+
+ocrGuid_t writerEdt(u32 paramc, u64* paramv, u32 depc, ocrEdtDep_t depv[]) {
+    u64 * large = (u64 *) depv[0].ptr;
+    u64 * small = (u64 *) depv[1].ptr;
+    u64 i;
+    for (i = 0; i < N; i++) {
+        large[i]++;
+    }
+    small[0]++;
+    return NULL_GUID;
+}
+
+ocrGuid_t roundEdt(u32 paramc, u64* paramv, u32 depc, ocrEdtDep_t depv[]) {
+    roundParams_t params = *((roundParams_t *) paramv);
+    u64 * large = (u64 *) depv[0].ptr;
+    u64 * small = (u64 *) depv[1].ptr;
+    u64 i;
+    for (i = 0; i < N; i++) {
+        ocrAssert(large[i] == (i + params.round));
+    }
+    ocrAssert(small[0] == params.round);
+    if (params.round == NB_ROUNDS) {
+        ocrDbDestroy(params.large);
+        ocrDbDestroy(params.small);
+        ocrPrintf("Everything went OK\n");
+        ocrShutdown();
+        return NULL_GUID;
+    }
+
+    u64 affinityCount;
+    ocrAffinityCount(AFFINITY_PD, &affinityCount);
+    ocrGuid_t affinities[affinityCount];
+    ocrAffinityGet(AFFINITY_PD, &affinityCount, affinities);
+    ocrHint_t hint;
+    ocrHintInit(&hint, OCR_HINT_EDT_T);
+    ocrSetHintValue(&hint, OCR_HINT_EDT_AFFINITY, ocrAffinityToHintValue(affinities[affinityCount-1]));
+    ocrGuid_t writerTpl, writerGuid, writerOut;
+    ocrEdtTemplateCreate(&writerTpl, writerEdt, 0, 2);
+    ocrEdtCreate(&writerGuid, writerTpl, 0, NULL, 2, NULL, EDT_PROP_NONE,
+                 &hint, &writerOut);
+    ocrEdtTemplateDestroy(writerTpl);
+
+    // The next round runs on the home once the writer is done
+    params.round++;
+    ocrHintInit(&hint, OCR_HINT_EDT_T);
+    ocrSetHintValue(&hint, OCR_HINT_EDT_AFFINITY, ocrAffinityToHintValue(params.home));
+    ocrGuid_t nextTpl, nextGuid;
+    ocrEdtTemplateCreate(&nextTpl, roundEdt, ROUND_PARAMC, 3);
+    ocrEdtCreate(&nextGuid, nextTpl, ROUND_PARAMC, (u64 *) &params, 3, NULL,
+                 EDT_PROP_NONE, &hint, NULL);
+    ocrEdtTemplateDestroy(nextTpl);
+    ocrAddDependence(params.large, nextGuid, 0, DB_MODE_RO);
+    ocrAddDependence(params.small, nextGuid, 1, DB_MODE_RO);
+    ocrAddDependence(writerOut, nextGuid, 2, DB_MODE_NULL);
+    ocrAddDependence(params.large, writerGuid, 0, DB_MODE_RW);
+    ocrAddDependence(params.small, writerGuid, 1, DB_MODE_RW);
+    return NULL_GUID;
+}
+
+ocrGuid_t mainEdt(u32 paramc, u64* paramv, u32 depc, ocrEdtDep_t depv[]) {
+    roundParams_t params;
+    ocrAffinityGetCurrent(&params.home);
+    u64 * large;
+    ocrDbCreate(&params.large, (void **) &large, sizeof(u64) * N, DB_PROP_NONE, NULL_HINT, NO_ALLOC);
+    u64 i;
+    for (i = 0; i < N; i++) {
+        large[i] = i;
+    }
+    ocrDbRelease(params.large);
+    u64 * small;
+    ocrDbCreate(&params.small, (void **) &small, sizeof(u64), DB_PROP_NONE, NULL_HINT, NO_ALLOC);
+    small[0] = 0;
+    ocrDbRelease(params.small);
+    params.round = 0;
+
+    ocrGuid_t roundTpl, roundGuid;
+    ocrEdtTemplateCreate(&roundTpl, roundEdt, ROUND_PARAMC, 2);
+    ocrEdtCreate(&roundGuid, roundTpl, ROUND_PARAMC, (u64 *) &params, 2, NULL,
+                 EDT_PROP_NONE, NULL_HINT, NULL);
+    ocrEdtTemplateDestroy(roundTpl);
+    ocrAddDependence(params.large, roundGuid, 0, DB_MODE_RO);
+    ocrAddDependence(params.small, roundGuid, 1, DB_MODE_RO);
+    return NULL_GUID;
+}
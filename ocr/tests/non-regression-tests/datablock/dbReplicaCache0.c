@@ -0,0 +1,111 @@
+/*
+ * This file is subject to the license agreement located in the file LICENSE
+ * and cannot be distributed without it. This notice cannot be
+ * removed or modified.
+ */
+
+#include "ocr.h"
+#include "extensions/ocr-affinity.h"
+
+/**
+ * DESC: Rounds of remote CONST readers of a DB, each round followed by
+ * a writer alternatively placed at home and on the readers' PD. Readers
+ * must observe the last write even if their PD kept a read-only copy.
+ */
+
+#define NB_ROUNDS 8
+#define NB_READERS 16
+
+typedef struct {
+    ocrGuid_t db;
+    u64 round;
+} roundParams_t;
+
+#define ROUND_PARAMC (sizeof(roundParams_t)/sizeof(u64))
+
+static ocrHint_t * getRemoteHint(ocrHint_t * hint) {
+    u64 affinityCount;
+    ocrAffinityCount(AFFINITY_PD, &affinityCount);
+    ocrGuid_t affinities[affinityCount];
+    ocrAffinityGet(AFFINITY_PD, &affinityCount, affinities);
+    ocrHintInit(hint, OCR_HINT_EDT_T);
+    ocrSetHintValue(hint, OCR_HINT_EDT_AFFINITY, ocrAffinityToHintValue(affinities[affinityCount-1]));
+    return hint;
+}
+
+ocrGuid_t checkEdt(u32 paramc, u64* paramv, u32 depc, ocrEdtDep_t depv[]) {
+    u64 * data = (u64 *) depv[0].ptr;
+    ocrAssert(data[0] == NB_ROUNDS);
+    ocrDbDestroy(depv[0].guid);
+    ocrPrintf("Everything went OK\n");
+    ocrShutdown();
+    return NULL_GUID;
+}
+
+ocrGuid_t readerEdt(u32 paramc, u64* paramv, u32 depc, ocrEdtDep_t depv[]) {
+    u64 * data = (u64 *) depv[0].ptr;
+    ocrAssert(data[0] == paramv[0]);
+    return NULL_GUID;
+}
+
+ocrGuid_t writerEdt(u32 paramc, u64* paramv, u32 depc, ocrEdtDep_t depv[]) {
+    u64 * data = (u64 *) depv[0].ptr;
+    data[0]++;
+    return NULL_GUID;
+}
+
+ocrGuid_t roundEdt(u32 paramc, u64* paramv, u32 depc, ocrEdtDep_t depv[]) {
+    roundParams_t params = *((roundParams_t *) paramv);
+    if (params.round == NB_ROUNDS) {
+        ocrGuid_t checkTpl, checkGuid;
+        ocrEdtTemplateCreate(&checkTpl, checkEdt, 0, 1);
+        ocrEdtCreate(&checkGuid, checkTpl, 0, NULL, 1, &params.db,
+                     EDT_PROP_NONE, NULL_HINT, NULL);
+        ocrEdtTemplateDestroy(checkTpl);
+        return NULL_GUID;
+    }
+    // The writer waits for all the readers, odd rounds write from the readers' PD
+    ocrHint_t hint;
+    ocrGuid_t writerTpl, writerGuid, writerOut;
+    ocrEdtTemplateCreate(&writerTpl, writerEdt, 0, NB_READERS+1);
+    ocrEdtCreate(&writerGuid, writerTpl, 0, NULL, NB_READERS+1, NULL, EDT_PROP_NONE,
+                 (params.round & 1) ? getRemoteHint(&hint) : NULL_HINT, &writerOut);
+    ocrEdtTemplateDestroy(writerTpl);
+
+    ocrGuid_t readerTpl;
+    ocrEdtTemplateCreate(&readerTpl, readerEdt, 1, 1);
+    u32 i;
+    for (i = 0; i < NB_READERS; i++) {
+        ocrGuid_t readerGuid, readerOut;
+        ocrEdtCreate(&readerGuid, readerTpl, 1, &params.round, 1, NULL,
+                     EDT_PROP_NONE, getRemoteHint(&hint), &readerOut);
+        ocrAddDependence(readerOut, writerGuid, i+1, DB_MODE_NULL);
+        ocrAddDependence(params.db, readerGuid, 0, DB_MODE_CONST);
+    }
+    ocrEdtTemplateDestroy(readerTpl);
+
+    params.round++;
+    ocrGuid_t nextTpl, nextGuid;
+    ocrEdtTemplateCreate(&nextTpl, roundEdt, ROUND_PARAMC, 1);
+    ocrEdtCreate(&nextGuid, nextTpl, ROUND_PARAMC, (u64 *) &params, 1, NULL,
+                 EDT_PROP_NONE, NULL_HINT, NULL);
+    ocrEdtTemplateDestroy(nextTpl);
+    ocrAddDependence(writerOut, nextGuid, 0, DB_MODE_NULL);
+    ocrAddDependence(params.db, writerGuid, 0, DB_MODE_RW);
+    return NULL_GUID;
+}
+
+ocrGuid_t mainEdt(u32 paramc, u64* paramv, u32 depc, ocrEdtDep_t depv[]) {
+    u64 * data;
+    roundParams_t params;
+    ocrDbCreate(&params.db, (void **) &data, sizeof(u64), DB_PROP_NONE, NULL_HINT, NO_ALLOC);
+    data[0] = 0;
+    ocrDbRelease(params.db);
+    params.round = 0;
+    ocrGuid_t roundTpl, roundGuid;
+    ocrEdtTemplateCreate(&roundTpl, roundEdt, ROUND_PARAMC, 0);
+    ocrEdtCreate(&roundGuid, roundTpl, ROUND_PARAMC, (u64 *) &params, 0, NULL,
+                 EDT_PROP_NONE, NULL_HINT, NULL);
+    ocrEdtTemplateDestroy(roundTpl);
+    return NULL_GUID;
+}
@@ -0,0 +1,109 @@
+/*
+ * This file is subject to the license agreement located in the file LICENSE
+ * and cannot be distributed without it. This notice cannot be
+ * removed or modified.
+ */
+
+#include "ocr.h"
+#include "extensions/ocr-affinity.h"
+
+/**
+ * DESC: Rounds of a remote reader followed by a remote writer on another
+ * PD (when there are more than two). The writer must be granted while the
+ * reader's PD keeps its read-only copy, and the next round's reader must
+ * observe the write.
+ */
+
+#define NB_ROUNDS 8
+
+typedef struct {
+    ocrGuid_t db;
+    u64 round;
+} roundParams_t;
+
+#define ROUND_PARAMC (sizeof(roundParams_t)/sizeof(u64))
+
+static ocrHint_t * getPdHint(ocrHint_t * hint, u64 offset) {
+    u64 affinityCount;
+    ocrAffinityCount(AFFINITY_PD, &affinityCount);
+    ocrGuid_t affinities[affinityCount];
+    ocrAffinityGet(AFFINITY_PD, &affinityCount, affinities);
+    ocrHintInit(hint, OCR_HINT_EDT_T);
+    ocrSetHintValue(hint, OCR_HINT_EDT_AFFINITY, ocrAffinityToHintValue(affinities[affinityCount-offset]));
+    return hint;
+}
+
+ocrGuid_t checkEdt(u32 paramc, u64* paramv, u32 depc, ocrEdtDep_t depv[]) {
+    u64 * data = (u64 *) depv[0].ptr;
+    ocrAssert(data[0] == NB_ROUNDS);
+    ocrDbDestroy(depv[0].guid);
+    ocrPrintf("Everything went OK\n");
+    ocrShutdown();
+    return NULL_GUID;
+}
+
+ocrGuid_t readerEdt(u32 paramc, u64* paramv, u32 depc, ocrEdtDep_t depv[]) {
+    u64 * data = (u64 *) depv[0].ptr;
+    ocrAssert(data[0] == paramv[0]);
+    return NULL_GUID;
+}
+
+ocrGuid_t writerEdt(u32 paramc, u64* paramv, u32 depc, ocrEdtDep_t depv[]) {
+    u64 * data = (u64 *) depv[0].ptr;
+    data[0]++;
+    return NULL_GUID;
+}
+
+ocrGuid_t roundEdt(u32 paramc, u64* paramv, u32 depc, ocrEdtDep_t depv[]) {
+    roundParams_t params = *((roundParams_t *) paramv);
+    if (params.round == NB_ROUNDS) {
+        ocrGuid_t checkTpl, checkGuid;
+        ocrEdtTemplateCreate(&checkTpl, checkEdt, 0, 1);
+        ocrEdtCreate(&checkGuid, checkTpl, 0, NULL, 1, &params.db,
+                     EDT_PROP_NONE, NULL_HINT, NULL);
+        ocrEdtTemplateDestroy(checkTpl);
+        return NULL_GUID;
+    }
+    u64 affinityCount;
+    ocrAffinityCount(AFFINITY_PD, &affinityCount);
+    ocrHint_t hint;
+    // The writer runs once the reader is done
+    ocrGuid_t writerTpl, writerGuid, writerOut;
+    ocrEdtTemplateCreate(&writerTpl, writerEdt, 0, 2);
+    ocrEdtCreate(&writerGuid, writerTpl, 0, NULL, 2, NULL, EDT_PROP_NONE,
+                 getPdHint(&hint, (affinityCount > 2) ? 2 : 1), &writerOut);
+    ocrEdtTemplateDestroy(writerTpl);
+
+    ocrGuid_t readerTpl, readerGuid, readerOut;
+    ocrEdtTemplateCreate(&readerTpl, readerEdt, 1, 1);
+    ocrEdtCreate(&readerGuid, readerTpl, 1, &params.round, 1, NULL,
+                 EDT_PROP_NONE, getPdHint(&hint, 1), &readerOut);
+    ocrEdtTemplateDestroy(readerTpl);
+    ocrAddDependence(readerOut, writerGuid, 1, DB_MODE_NULL);
+    ocrAddDependence(params.db, readerGuid, 0, DB_MODE_RO);
+
+    params.round++;
+    ocrGuid_t nextTpl, nextGuid;
+    ocrEdtTemplateCreate(&nextTpl, roundEdt, ROUND_PARAMC, 1);
+    ocrEdtCreate(&nextGuid, nextTpl, ROUND_PARAMC, (u64 *) &params, 1, NULL,
+                 EDT_PROP_NONE, NULL_HINT, NULL);
+    ocrEdtTemplateDestroy(nextTpl);
+    ocrAddDependence(writerOut, nextGuid, 0, DB_MODE_NULL);
+    ocrAddDependence(params.db, writerGuid, 0, DB_MODE_RW);
+    return NULL_GUID;
+}
+
+ocrGuid_t mainEdt(u32 paramc, u64* paramv, u32 depc, ocrEdtDep_t depv[]) {
+    u64 * data;
+    roundParams_t params;
+    ocrDbCreate(&params.db, (void **) &data, sizeof(u64), DB_PROP_NONE, NULL_HINT, NO_ALLOC);
+    data[0] = 0;
+    ocrDbRelease(params.db);
+    params.round = 0;
+    ocrGuid_t roundTpl, roundGuid;
+    ocrEdtTemplateCreate(&roundTpl, roundEdt, ROUND_PARAMC, 0);
+    ocrEdtCreate(&roundGuid, roundTpl, ROUND_PARAMC, (u64 *) &params, 0, NULL,
+                 EDT_PROP_NONE, NULL_HINT, NULL);
+    ocrEdtTemplateDestroy(roundTpl);
+    return NULL_GUID;
+}
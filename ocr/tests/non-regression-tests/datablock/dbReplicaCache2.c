@@ -0,0 +1,143 @@
+/*
+ * This file is subject to the license agreement located in the file LICENSE
+ * and cannot be distributed without it. This notice cannot be
+ * removed or modified.
+ */
+
+#include "ocr.h"
+#include "extensions/ocr-affinity.h"
+
+/**
+ * DESC: Rounds of remote CONST readers of more DBs than a small replica
+ * cache holds, each DB read twice, followed by a writer of all the DBs
+ * placed alternatively at home and on the readers' PD. Readers must
+ * observe the last write whether their copy was kept, evicted or fetched
+ * again.
+ */
+
+#define NB_ROUNDS 6
+#define NB_DBS 16
+#define NB_ELEMS (64*1024/sizeof(u64))
+
+typedef struct {
+    ocrGuid_t dbs[NB_DBS];
+    u64 round;
+} roundParams_t;
+
+#define ROUND_PARAMC (sizeof(roundParams_t)/sizeof(u64))
+
+static ocrHint_t * getRemoteHint(ocrHint_t * hint) {
+    u64 affinityCount;
+    ocrAffinityCount(AFFINITY_PD, &affinityCount);
+    ocrGuid_t affinities[affinityCount];
+    ocrAffinityGet(AFFINITY_PD, &affinityCount, affinities);
+    ocrHintInit(hint, OCR_HINT_EDT_T);
+    ocrSetHintValue(hint, OCR_HINT_EDT_AFFINITY, ocrAffinityToHintValue(affinities[affinityCount-1]));
+    return hint;
+}
+
+static void checkData(u64 * data, u64 value) {
+    u64 i;
+    for (i = 0; i < NB_ELEMS; i++) {
+        ocrAssert(data[i] == value);
+    }
+}
+
+ocrGuid_t checkEdt(u32 paramc, u64* paramv, u32 depc, ocrEdtDep_t depv[]) {
+    u32 i;
+    for (i = 0; i < NB_DBS; i++) {
+        checkData((u64 *) depv[i].ptr, NB_ROUNDS);
+        ocrDbDestroy(depv[i].guid);
+    }
+    ocrPrintf("Everything went OK\n");
+    ocrShutdown();
+    return NULL_GUID;
+}
+
+ocrGuid_t readerEdt(u32 paramc, u64* paramv, u32 depc, ocrEdtDep_t depv[]) {
+    u32 i;
+    for (i = 0; i < NB_DBS; i++) {
+        checkData((u64 *) depv[i].ptr, paramv[0]);
+    }
+    return NULL_GUID;
+}
+
+ocrGuid_t writerEdt(u32 paramc, u64* paramv, u32 depc, ocrEdtDep_t depv[]) {
+    u32 i;
+    for (i = 0; i < NB_DBS; i++) {
+        u64 * data = (u64 *) depv[i].ptr;
+        u64 j;
+        for (j = 0; j < NB_ELEMS; j++) {
+            data[j]++;
+        }
+    }
+    return NULL_GUID;
+}
+
+ocrGuid_t roundEdt(u32 paramc, u64* paramv, u32 depc, ocrEdtDep_t depv[]) {
+    roundParams_t params = *((roundParams_t *) paramv);
+    u32 i;
+    if (params.round == NB_ROUNDS) {
+        ocrGuid_t checkTpl, checkGuid;
+        ocrEdtTemplateCreate(&checkTpl, checkEdt, 0, NB_DBS);
+        ocrEdtCreate(&checkGuid, checkTpl, 0, NULL, NB_DBS, params.dbs,
+                     EDT_PROP_NONE, NULL_HINT, NULL);
+        ocrEdtTemplateDestroy(checkTpl);
+        return NULL_GUID;
+    }
+    // The second reader comes once the first one has released all the
+    // DBs, only some of them fit in the cache. The writer waits for it,
+    // odd rounds write from the readers' PD.
+    ocrHint_t hint;
+    ocrGuid_t writerTpl, writerGuid, writerOut;
+    ocrEdtTemplateCreate(&writerTpl, writerEdt, 0, NB_DBS+1);
+    ocrEdtCreate(&writerGuid, writerTpl, 0, NULL, NB_DBS+1, NULL, EDT_PROP_NONE,
+                 (params.round & 1) ? getRemoteHint(&hint) : NULL_HINT, &writerOut);
+    ocrEdtTemplateDestroy(writerTpl);
+
+    ocrGuid_t readerTpl, firstGuid, firstOut, secondGuid, secondOut;
+    ocrEdtTemplateCreate(&readerTpl, readerEdt, 1, EDT_PARAM_UNK);
+    ocrEdtCreate(&secondGuid, readerTpl, 1, &params.round, NB_DBS+1, NULL,
+                 EDT_PROP_NONE, getRemoteHint(&hint), &secondOut);
+    ocrEdtCreate(&firstGuid, readerTpl, 1, &params.round, NB_DBS, NULL,
+                 EDT_PROP_NONE, getRemoteHint(&hint), &firstOut);
+    ocrEdtTemplateDestroy(readerTpl);
+
+    params.round++;
+    ocrGuid_t nextTpl, nextGuid;
+    ocrEdtTemplateCreate(&nextTpl, roundEdt, ROUND_PARAMC, 1);
+    ocrEdtCreate(&nextGuid, nextTpl, ROUND_PARAMC, (u64 *) &params, 1, NULL,
+                 EDT_PROP_NONE, NULL_HINT, NULL);
+    ocrEdtTemplateDestroy(nextTpl);
+
+    ocrAddDependence(writerOut, nextGuid, 0, DB_MODE_NULL);
+    ocrAddDependence(secondOut, writerGuid, NB_DBS, DB_MODE_NULL);
+    ocrAddDependence(firstOut, secondGuid, NB_DBS, DB_MODE_NULL);
+    for (i = 0; i < NB_DBS; i++) {
+        ocrAddDependence(params.dbs[i], writerGuid, i, DB_MODE_RW);
+        ocrAddDependence(params.dbs[i], secondGuid, i, DB_MODE_CONST);
+        ocrAddDependence(params.dbs[i], firstGuid, i, DB_MODE_CONST);
+    }
+    return NULL_GUID;
+}
+
+ocrGuid_t mainEdt(u32 paramc, u64* paramv, u32 depc, ocrEdtDep_t depv[]) {
+    roundParams_t params;
+    u32 i;
+    for (i = 0; i < NB_DBS; i++) {
+        u64 * data;
+        ocrDbCreate(&params.dbs[i], (void **) &data, NB_ELEMS*sizeof(u64), DB_PROP_NONE, NULL_HINT, NO_ALLOC);
+        u64 j;
+        for (j = 0; j < NB_ELEMS; j++) {
+            data[j] = 0;
+        }
+        ocrDbRelease(params.dbs[i]);
+    }
+    params.round = 0;
+    ocrGuid_t roundTpl, roundGuid;
+    ocrEdtTemplateCreate(&roundTpl, roundEdt, ROUND_PARAMC, 0);
+    ocrEdtCreate(&roundGuid, roundTpl, ROUND_PARAMC, (u64 *) &params, 0, NULL,
+                 EDT_PROP_NONE, NULL_HINT, NULL);
+    ocrEdtTemplateDestroy(roundTpl);
+    return NULL_GUID;
+}
@@ -0,0 +1,78 @@
+/*
+ * This file is subject to the license agreement located in the file LICENSE
+ * and cannot be distributed without it. This notice cannot be
+ * removed or modified.
+ */
+
+#include "ocr.h"
+#include "extensions/ocr-affinity.h"
+
+/**
+ * DESC: Readers of a single-assignment DB, local and on the last PD, are
+ * set up before the creator has written the DB. They must all observe the
+ * data as it is when the creator releases the DB.
+ */
+
+#define N 64
+#define NB_READERS 16
+
+static void checkData(u64 * data) {
+    u64 i;
+    for (i = 0; i < N; i++) {
+        ocrAssert(data[i] == (i * i));
+    }
+}
+
+ocrGuid_t readerEdt(u32 paramc, u64* paramv, u32 depc, ocrEdtDep_t depv[]) {
+    checkData((u64 *) depv[0].ptr);
+    return NULL_GUID;
+}
+
+ocrGuid_t checkEdt(u32 paramc, u64* paramv, u32 depc, ocrEdtDep_t depv[]) {
+    checkData((u64 *) depv[NB_READERS].ptr);
+    ocrDbDestroy(depv[NB_READERS].guid);
+    ocrPrintf("Everything went OK\n");
+    ocrShutdown();
+    return NULL_GUID;
+}
+
+ocrGuid_t mainEdt(u32 paramc, u64* paramv, u32 depc, ocrEdtDep_t depv[]) {
+    u64 * data;
+    ocrGuid_t dataGuid;
+    ocrDbCreate(&dataGuid, (void **) &data, sizeof(u64) * N, DB_PROP_SINGLE_ASSIGNMENT, NULL_HINT, NO_ALLOC);
+
+    u64 affinityCount;
+    ocrAffinityCount(AFFINITY_PD, &affinityCount);
+    ocrGuid_t affinities[affinityCount];
+    ocrAffinityGet(AFFINITY_PD, &affinityCount, affinities);
+    ocrHint_t remoteHint;
+    ocrHintInit(&remoteHint, OCR_HINT_EDT_T);
+    ocrSetHintValue(&remoteHint, OCR_HINT_EDT_AFFINITY, ocrAffinityToHintValue(affinities[affinityCount-1]));
+
+    ocrGuid_t checkTpl, checkGuid;
+    ocrEdtTemplateCreate(&checkTpl, checkEdt, 0, NB_READERS+1);
+    ocrEdtCreate(&checkGuid, checkTpl, 0, NULL, NB_READERS+1, NULL,
+                 EDT_PROP_NONE, NULL_HINT, NULL);
+    ocrEdtTemplateDestroy(checkTpl);
+
+    // Half of the readers are remote when there is more than one PD
+    ocrGuid_t readerTpl;
+    ocrEdtTemplateCreate(&readerTpl, readerEdt, 0, 1);
+    u32 i;
+    for (i = 0; i < NB_READERS; i++) {
+        ocrGuid_t readerGuid, readerOut;
+        ocrEdtCreate(&readerGuid, readerTpl, 0, NULL, 1, NULL,
+                     EDT_PROP_NONE, (i & 1) ? &remoteHint : NULL_HINT, &readerOut);
+        ocrAddDependence(readerOut, checkGuid, i, DB_MODE_NULL);
+        ocrAddDependence(dataGuid, readerGuid, 0, (i & 2) ? DB_MODE_RO : DB_MODE_CONST);
+    }
+    ocrEdtTemplateDestroy(readerTpl);
+    ocrAddDependence(dataGuid, checkGuid, NB_READERS, DB_MODE_CONST);
+
+    // Readers may already be waiting on the DB
+    for (i = 0; i < N; i++) {
+        data[i] = i * i;
+    }
+    ocrDbRelease(dataGuid);
+    return NULL_GUID;
+}
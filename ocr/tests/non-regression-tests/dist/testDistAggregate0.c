@@ -0,0 +1,60 @@
+/*
+ * This file is subject to the license agreement located in the file LICENSE
+ * and cannot be distributed without it. This notice cannot be
+ * removed or modified.
+ */
+
+#include "ocr.h"
+#include "extensions/ocr-affinity.h"
+
+/**
+ * DESC: OCR-DIST: Burst of small one-way satisfy messages to a remote EDT
+ * interleaved with a DB dependence that needs a two-way exchange.
+ */
+
+#define NB_SLOTS 48
+#define NB_ELEM_DB 16
+
+ocrGuid_t sinkEdt(u32 paramc, u64* paramv, u32 depc, ocrEdtDep_t depv[]) {
+    ocrAssert(depc == (NB_SLOTS+1));
+    u64 * data = (u64 *) depv[NB_SLOTS].ptr;
+    u32 i;
+    for (i = 0; i < NB_ELEM_DB; i++) {
+        ocrAssert(data[i] == i);
+    }
+    ocrDbDestroy(depv[NB_SLOTS].guid);
+    ocrPrintf("Everything went OK\n");
+    ocrShutdown();
+    return NULL_GUID;
+}
+
+ocrGuid_t mainEdt(u32 paramc, u64* paramv, u32 depc, ocrEdtDep_t depv[]) {
+    u64 affinityCount;
+    ocrAffinityCount(AFFINITY_PD, &affinityCount);
+    ocrGuid_t affinities[affinityCount];
+    ocrAffinityGet(AFFINITY_PD, &affinityCount, affinities);
+    ocrHint_t edtHint;
+    ocrHintInit(&edtHint, OCR_HINT_EDT_T);
+    ocrSetHintValue(&edtHint, OCR_HINT_EDT_AFFINITY, ocrAffinityToHintValue(affinities[affinityCount-1]));
+
+    u64 * data;
+    ocrGuid_t dbGuid;
+    ocrDbCreate(&dbGuid, (void **) &data, sizeof(u64) * NB_ELEM_DB, DB_PROP_NONE, NULL_HINT, NO_ALLOC);
+    u32 i;
+    for (i = 0; i < NB_ELEM_DB; i++) {
+        data[i] = i;
+    }
+    ocrDbRelease(dbGuid);
+
+    ocrGuid_t sinkTpl, sinkGuid;
+    ocrEdtTemplateCreate(&sinkTpl, sinkEdt, 0, NB_SLOTS+1);
+    ocrEdtCreate(&sinkGuid, sinkTpl, 0, NULL, NB_SLOTS+1, NULL, EDT_PROP_NONE, &edtHint, NULL);
+    ocrEdtTemplateDestroy(sinkTpl);
+    for (i = 0; i < NB_SLOTS; i++) {
+        ocrAddDependence(NULL_GUID, sinkGuid, i, DB_MODE_NULL);
+        if (i == (NB_SLOTS/2)) {
+            ocrAddDependence(dbGuid, sinkGuid, NB_SLOTS, DB_MODE_RO);
+        }
+    }
+    return NULL_GUID;
+}
@@ -0,0 +1,59 @@
+/*
+ * This file is subject to the license agreement located in the file LICENSE
+ * and cannot be distributed without it. This notice cannot be
+ * removed or modified.
+ */
+
+#include "ocr.h"
+#include "extensions/ocr-affinity.h"
+
+/**
+ * DESC: OCR-DIST: Bursts of one-way satisfy messages, more than a PD has
+ * credits for a peer, from the first PD to an EDT on the last one and back.
+ */
+
+// Well over the credits of the regression job run with a small window
+#define NB_SLOTS 256
+
+ocrGuid_t finalEdt(u32 paramc, u64* paramv, u32 depc, ocrEdtDep_t depv[]) {
+    ocrAssert(depc == NB_SLOTS);
+    ocrPrintf("Everything went OK\n");
+    ocrShutdown();
+    return NULL_GUID;
+}
+
+ocrGuid_t remoteEdt(u32 paramc, u64* paramv, u32 depc, ocrEdtDep_t depv[]) {
+    ocrAssert(depc == NB_SLOTS);
+    ocrGuid_t finalGuid = *((ocrGuid_t *) paramv);
+    u32 i;
+    for (i = 0; i < NB_SLOTS; i++) {
+        ocrAddDependence(NULL_GUID, finalGuid, i, DB_MODE_NULL);
+    }
+    return NULL_GUID;
+}
+
+ocrGuid_t mainEdt(u32 paramc, u64* paramv, u32 depc, ocrEdtDep_t depv[]) {
+    u64 affinityCount;
+    ocrAffinityCount(AFFINITY_PD, &affinityCount);
+    ocrGuid_t affinities[affinityCount];
+    ocrAffinityGet(AFFINITY_PD, &affinityCount, affinities);
+    ocrHint_t edtHint;
+    ocrHintInit(&edtHint, OCR_HINT_EDT_T);
+    ocrSetHintValue(&edtHint, OCR_HINT_EDT_AFFINITY, ocrAffinityToHintValue(affinities[affinityCount-1]));
+
+    ocrGuid_t finalTpl, finalGuid;
+    ocrEdtTemplateCreate(&finalTpl, finalEdt, 0, NB_SLOTS);
+    ocrEdtCreate(&finalGuid, finalTpl, 0, NULL, NB_SLOTS, NULL, EDT_PROP_NONE, NULL_HINT, NULL);
+    ocrEdtTemplateDestroy(finalTpl);
+
+    ocrGuid_t remoteTpl, remoteGuid;
+    ocrEdtTemplateCreate(&remoteTpl, remoteEdt, sizeof(ocrGuid_t)/sizeof(u64), NB_SLOTS);
+    ocrEdtCreate(&remoteGuid, remoteTpl, EDT_PARAM_DEF, (u64 *) &finalGuid, NB_SLOTS, NULL,
+                 EDT_PROP_NONE, &edtHint, NULL);
+    ocrEdtTemplateDestroy(remoteTpl);
+    u32 i;
+    for (i = 0; i < NB_SLOTS; i++) {
+        ocrAddDependence(NULL_GUID, remoteGuid, i, DB_MODE_NULL);
+    }
+    return NULL_GUID;
+}
@@ -0,0 +1,76 @@
+/*
+ * This file is subject to the license agreement located in the file LICENSE
+ * and cannot be distributed without it. This notice cannot be
+ * removed or modified.
+ */
+
+#include "ocr.h"
+#include "extensions/ocr-affinity.h"
+
+/**
+ * DESC: OCR-DIST: Satisfy a sticky event with many waiters spread over
+ * all PDs. Each EDT checks it got the DB on the slot it registered.
+ */
+
+#define NB_CONSUMERS 96
+#define NB_ELEM_DB 16
+
+ocrGuid_t sinkEdt(u32 paramc, u64* paramv, u32 depc, ocrEdtDep_t depv[]) {
+    ocrPrintf("Everything went OK\n");
+    ocrShutdown();
+    return NULL_GUID;
+}
+
+ocrGuid_t consumerEdt(u32 paramc, u64* paramv, u32 depc, ocrEdtDep_t depv[]) {
+    ocrAssert(paramc == 1);
+    ocrAssert(depc == 2);
+    u32 slot = (u32) paramv[0];
+    ocrAssert(depv[1-slot].ptr == NULL);
+    u64 * data = (u64 *) depv[slot].ptr;
+    u32 i;
+    for (i = 0; i < NB_ELEM_DB; i++) {
+        ocrAssert(data[i] == i);
+    }
+    return NULL_GUID;
+}
+
+ocrGuid_t mainEdt(u32 paramc, u64* paramv, u32 depc, ocrEdtDep_t depv[]) {
+    u64 affinityCount;
+    ocrAffinityCount(AFFINITY_PD, &affinityCount);
+    ocrGuid_t affinities[affinityCount];
+    ocrAffinityGet(AFFINITY_PD, &affinityCount, affinities);
+
+    u64 * data;
+    ocrGuid_t dbGuid;
+    ocrDbCreate(&dbGuid, (void **) &data, sizeof(u64) * NB_ELEM_DB, DB_PROP_NONE, NULL_HINT, NO_ALLOC);
+    u32 i;
+    for (i = 0; i < NB_ELEM_DB; i++) {
+        data[i] = i;
+    }
+    ocrDbRelease(dbGuid);
+
+    ocrGuid_t evtGuid;
+    ocrEventCreate(&evtGuid, OCR_EVENT_STICKY_T, EVT_PROP_TAKES_ARG);
+
+    ocrGuid_t sinkTpl, sinkGuid;
+    ocrEdtTemplateCreate(&sinkTpl, sinkEdt, 0, NB_CONSUMERS);
+    ocrEdtCreate(&sinkGuid, sinkTpl, 0, NULL, NB_CONSUMERS, NULL, EDT_PROP_NONE, NULL_HINT, NULL);
+    ocrEdtTemplateDestroy(sinkTpl);
+
+    ocrGuid_t consumerTpl;
+    ocrEdtTemplateCreate(&consumerTpl, consumerEdt, 1, 2);
+    ocrHint_t edtHint;
+    ocrHintInit(&edtHint, OCR_HINT_EDT_T);
+    for (i = 0; i < NB_CONSUMERS; i++) {
+        u64 slot = i % 2;
+        ocrSetHintValue(&edtHint, OCR_HINT_EDT_AFFINITY, ocrAffinityToHintValue(affinities[i % affinityCount]));
+        ocrGuid_t consumerGuid, outputGuid;
+        ocrEdtCreate(&consumerGuid, consumerTpl, 1, &slot, 2, NULL, EDT_PROP_NONE, &edtHint, &outputGuid);
+        ocrAddDependence(outputGuid, sinkGuid, i, DB_MODE_NULL);
+        ocrAddDependence(NULL_GUID, consumerGuid, 1-slot, DB_MODE_NULL);
+        ocrAddDependence(evtGuid, consumerGuid, slot, DB_MODE_RO);
+    }
+    ocrEdtTemplateDestroy(consumerTpl);
+    ocrEventSatisfy(evtGuid, dbGuid);
+    return NULL_GUID;
+}
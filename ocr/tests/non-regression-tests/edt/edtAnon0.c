@@ -0,0 +1,113 @@
+/*
+ * This file is subject to the license agreement located in the file LICENSE
+ * and cannot be distributed without it. This notice cannot be
+ * removed or modified.
+ */
+#include "ocr.h"
+#ifdef ENABLE_EXTENSION_RTITF
+#include "extensions/ocr-runtime-itf.h"
+#endif
+
+/**
+ * DESC: Create anonymous EDTs within a finish scope: datablock dependences,
+ * no dependences, output event and event dependences (regular EDT fallback).
+ * When the runtime honors the property the anonymous ones have no GUID.
+ */
+
+#define N 64
+
+// Layout of the data block: one value per leaf followed by whether the
+// leaf ran as an anonymous EDT. Leaf N is the one with an event dependence.
+#define VAL(data, i) (data[i])
+#define ANON(data, i) (data[N + 1 + (i)])
+#define DATA_SZ (sizeof(u64) * 2 * (N + 1))
+
+ocrGuid_t leafEdt(u32 paramc, u64* paramv, u32 depc, ocrEdtDep_t depv[]) {
+    if (depc != 0) {
+        u64 * data = (u64 *) depv[0].ptr;
+        VAL(data, paramv[0]) = paramv[0] + 1;
+#ifdef ENABLE_EXTENSION_RTITF
+        ocrGuid_t curEdt;
+        ocrCurrentEdtGet(&curEdt);
+        ANON(data, paramv[0]) = ocrGuidIsNull(curEdt);
+#endif
+    }
+    return NULL_GUID;
+}
+
+ocrGuid_t spawnEdt(u32 paramc, u64* paramv, u32 depc, ocrEdtDep_t depv[]) {
+    ocrGuid_t dataGuid = depv[0].guid;
+    ocrGuid_t leafTpl;
+    ocrEdtTemplateCreate(&leafTpl, leafEdt, 1, EDT_PARAM_UNK);
+    u64 i;
+    for (i = 0; i < N; i++) {
+        ocrGuid_t edtGuid = UNINITIALIZED_GUID;
+        ocrEdtCreate(&edtGuid, leafTpl, 1, &i, 1, &dataGuid,
+                     EDT_PROP_ANON, NULL_HINT, NULL);
+#ifdef ENABLE_EDT_ANON
+        ocrAssert(ocrGuidIsNull(edtGuid));
+#endif
+        ocrEdtCreate(NULL, leafTpl, 1, &i, 0, NULL,
+                     EDT_PROP_ANON, NULL_HINT, NULL);
+    }
+    // Anonymous EDT with an output event
+    ocrGuid_t outEvt;
+    i = 0;
+    ocrEdtCreate(NULL, leafTpl, 1, &i, 1, &dataGuid,
+                 EDT_PROP_ANON, NULL_HINT, &outEvt);
+    ocrAssert(!ocrGuidIsNull(outEvt));
+    // Event dependences cannot be resolved by an anonymous EDT
+    ocrGuid_t evt;
+    ocrEventCreate(&evt, OCR_EVENT_ONCE_T, EVT_PROP_NONE);
+    ocrGuid_t deps[2] = {dataGuid, evt};
+    i = N;
+    ocrEdtCreate(NULL, leafTpl, 1, &i, 2, deps,
+                 EDT_PROP_ANON, NULL_HINT, NULL);
+    ocrEventSatisfy(evt, NULL_GUID);
+    ocrEdtTemplateDestroy(leafTpl);
+    return NULL_GUID;
+}
+
+ocrGuid_t checkEdt(u32 paramc, u64* paramv, u32 depc, ocrEdtDep_t depv[]) {
+    u64 * data = (u64 *) depv[1].ptr;
+    u64 i;
+    for (i = 0; i <= N; i++) {
+        ocrAssert(VAL(data, i) == (i + 1));
+    }
+#ifdef ENABLE_EXTENSION_RTITF
+    for (i = 0; i < N; i++) {
+#ifdef ENABLE_EDT_ANON
+        ocrAssert(ANON(data, i));
+#else
+        ocrAssert(!ANON(data, i));
+#endif
+    }
+    ocrAssert(!ANON(data, N));
+#endif
+    ocrPrintf("Everything went OK\n");
+    ocrShutdown();
+    return NULL_GUID;
+}
+
+ocrGuid_t mainEdt(u32 paramc, u64* paramv, u32 depc, ocrEdtDep_t depv[]) {
+    u64 * data;
+    ocrGuid_t dataGuid;
+    ocrDbCreate(&dataGuid, (void **) &data, DATA_SZ, DB_PROP_NONE, NULL_HINT, NO_ALLOC);
+    u64 i;
+    for (i = 0; i < 2 * (N + 1); i++) {
+        data[i] = 0;
+    }
+    ocrDbRelease(dataGuid);
+
+    ocrGuid_t spawnTpl, checkTpl, checkGuid, spawnGuid, spawnOutEvt;
+    ocrEdtTemplateCreate(&checkTpl, checkEdt, 0, 2);
+    ocrEdtCreate(&checkGuid, checkTpl, 0, NULL, 2, NULL,
+                 EDT_PROP_NONE, NULL_HINT, NULL);
+    ocrEdtTemplateCreate(&spawnTpl, spawnEdt, 0, 1);
+    ocrEdtCreate(&spawnGuid, spawnTpl, 0, NULL, 1, NULL,
+                 EDT_PROP_FINISH, NULL_HINT, &spawnOutEvt);
+    ocrAddDependence(spawnOutEvt, checkGuid, 0, DB_MODE_NULL);
+    ocrAddDependence(dataGuid, checkGuid, 1, DB_MODE_CONST);
+    ocrAddDependence(dataGuid, spawnGuid, 0, DB_MODE_RW);
+    return NULL_GUID;
+}
@@ -0,0 +1,94 @@
+/*
+ * This file is subject to the license agreement located in the file LICENSE
+ * and cannot be distributed without it. This notice cannot be
+ * removed or modified.
+ */
+
+#include "ocr.h"
+
+/**
+ * DESC: Parallel-for over a data block, default and minimal grain sizes
+ */
+
+#ifdef ENABLE_EXTENSION_PARALLEL_FOR
+
+#include "extensions/ocr-parallel-for.h"
+
+#define N 10000
+#define OFFSET 3
+
+ocrGuid_t bodyEdt(u32 paramc, u64* paramv, u32 depc, ocrEdtDep_t depv[]) {
+    ocrAssert(paramc == 3);
+    ocrAssert(depc == 1);
+    ocrAssert(paramv[0] < paramv[1]);
+    u64 * data = (u64 *) depv[0].ptr;
+    u64 i;
+    for (i = paramv[0]; i < paramv[1]; i++) {
+        data[i] += i + paramv[2];
+    }
+    return NULL_GUID;
+}
+
+ocrGuid_t checkEdt(u32 paramc, u64* paramv, u32 depc, ocrEdtDep_t depv[]) {
+    u64 * data = (u64 *) depv[1].ptr;
+    u64 i;
+    for (i = 0; i < N; i++) {
+        ocrAssert(data[i] == (2 * (i + OFFSET)));
+    }
+    ocrPrintf("Everything went OK\n");
+    ocrShutdown();
+    return NULL_GUID;
+}
+
+// Runs the loop a second time with the smallest grain size
+ocrGuid_t secondLoopEdt(u32 paramc, u64* paramv, u32 depc, ocrEdtDep_t depv[]) {
+    ocrGuid_t dataGuid = depv[1].guid;
+    ocrGuid_t loopEvt;
+    u64 offset = OFFSET;
+    ocrParallelFor(&loopEvt, bodyEdt, 0, N, 1, 1, &offset, 1, &dataGuid);
+
+    ocrGuid_t checkTpl, checkGuid;
+    ocrEdtTemplateCreate(&checkTpl, checkEdt, 0, 2);
+    ocrEdtCreate(&checkGuid, checkTpl, 0, NULL, 2, NULL,
+                 EDT_PROP_NONE, NULL_HINT, NULL);
+    ocrAddDependence(loopEvt, checkGuid, 0, DB_MODE_NULL);
+    ocrAddDependence(dataGuid, checkGuid, 1, DB_MODE_CONST);
+    ocrEdtTemplateDestroy(checkTpl);
+    return NULL_GUID;
+}
+
+ocrGuid_t mainEdt(u32 paramc, u64* paramv, u32 depc, ocrEdtDep_t depv[]) {
+    u64 * data;
+    ocrGuid_t dataGuid;
+    ocrDbCreate(&dataGuid, (void **) &data, sizeof(u64) * N, DB_PROP_NONE, NULL_HINT, NO_ALLOC);
+    u64 i;
+    for (i = 0; i < N; i++) {
+        data[i] = 0;
+    }
+    ocrDbRelease(dataGuid);
+
+    // Each loop visits every iteration exactly once so running
+    // it twice must double the value written by a single run.
+    ocrGuid_t loopEvt;
+    u64 offset = OFFSET;
+    ocrParallelFor(&loopEvt, bodyEdt, 0, N, 0, 1, &offset, 1, &dataGuid);
+
+    ocrGuid_t loopTpl, loopGuid;
+    ocrEdtTemplateCreate(&loopTpl, secondLoopEdt, 0, 2);
+    ocrEdtCreate(&loopGuid, loopTpl, 0, NULL, 2, NULL,
+                 EDT_PROP_NONE, NULL_HINT, NULL);
+    ocrAddDependence(loopEvt, loopGuid, 0, DB_MODE_NULL);
+    ocrAddDependence(dataGuid, loopGuid, 1, DB_MODE_CONST);
+    ocrEdtTemplateDestroy(loopTpl);
+    return NULL_GUID;
+}
+
+#else
+
+ocrGuid_t mainEdt(u32 paramc, u64* paramv, u32 depc, ocrEdtDep_t depv[]) {
+    ocrPrintf("Test disabled - ENABLE_EXTENSION_PARALLEL_FOR not defined\n");
+    ocrShutdown();
+    return NULL_GUID;
+}
+
+#endif
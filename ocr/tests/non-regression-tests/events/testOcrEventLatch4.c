@@ -0,0 +1,83 @@
+/*
+ * This file is subject to the license agreement located in the file LICENSE
+ * and cannot be distributed without it. This notice cannot be
+ * removed or modified.
+ */
+
+#include "ocr.h"
+
+/**
+ * DESC: latch-event fan-in, increments and matching decrements done by different EDTs
+ */
+
+#define N 64
+#define NB_CONTRIB 16
+
+ocrGuid_t terminateEDT(u32 paramc, u64* paramv, u32 depc, ocrEdtDep_t depv[]) {
+    ocrPrintf("Everything went OK\n");
+    ocrShutdown();
+    return NULL_GUID;
+}
+
+ocrGuid_t decrEDT(u32 paramc, u64* paramv, u32 depc, ocrEdtDep_t depv[]) {
+    ocrGuid_t latchGuid = *((ocrGuid_t*) depv[0].ptr);
+    u32 i;
+    for (i = 0; i < NB_CONTRIB; i++) {
+        ocrEventSatisfySlot(latchGuid, NULL_GUID, OCR_EVENT_LATCH_DECR_SLOT);
+    }
+    return NULL_GUID;
+}
+
+ocrGuid_t incrEDT(u32 paramc, u64* paramv, u32 depc, ocrEdtDep_t depv[]) {
+    ocrGuid_t dbLatchGuid = depv[0].guid;
+    ocrGuid_t latchGuid = *((ocrGuid_t*) depv[0].ptr);
+    u32 i;
+    for (i = 0; i < NB_CONTRIB; i++) {
+        ocrEventSatisfySlot(latchGuid, NULL_GUID, OCR_EVENT_LATCH_INCR_SLOT);
+    }
+    // Check out from another EDT, likely to run on a different worker
+    ocrGuid_t decrTpl, decrGuid;
+    ocrEdtTemplateCreate(&decrTpl, decrEDT, 0, 1);
+    ocrEdtCreate(&decrGuid, decrTpl, 0, NULL, 1, &dbLatchGuid,
+                 EDT_PROP_NONE, NULL_HINT, NULL);
+    ocrEdtTemplateDestroy(decrTpl);
+    // Release the check-in done by the parent
+    ocrEventSatisfySlot(latchGuid, NULL_GUID, OCR_EVENT_LATCH_DECR_SLOT);
+    return NULL_GUID;
+}
+
+ocrGuid_t mainEdt(u32 paramc, u64* paramv, u32 depc, ocrEdtDep_t depv[]) {
+    ocrGuid_t latchGuid;
+    ocrEventCreate(&latchGuid, OCR_EVENT_LATCH_T, false);
+
+    ocrGuid_t *dbLatchPtr;
+    ocrGuid_t dbLatchGuid;
+    ocrDbCreate(&dbLatchGuid,(void **)&dbLatchPtr, sizeof(ocrGuid_t), DB_PROP_NONE, NULL_HINT, NO_ALLOC);
+    *dbLatchPtr = latchGuid;
+    ocrDbRelease(dbLatchGuid);
+
+    ocrGuid_t terminateEDTGuid;
+    ocrGuid_t terminateEdtTemplateGuid;
+    ocrEdtTemplateCreate(&terminateEdtTemplateGuid, terminateEDT, 0, 1);
+    ocrEdtCreate(&terminateEDTGuid, terminateEdtTemplateGuid, 0, NULL, 1, NULL,
+                 EDT_PROP_NONE, NULL_HINT, NULL);
+    ocrAddDependence(latchGuid, terminateEDTGuid, 0, DB_MODE_CONST);
+    ocrEdtTemplateDestroy(terminateEdtTemplateGuid);
+
+    // Hold the latch while spawning
+    ocrEventSatisfySlot(latchGuid, NULL_GUID, OCR_EVENT_LATCH_INCR_SLOT);
+
+    ocrGuid_t incrTpl;
+    ocrEdtTemplateCreate(&incrTpl, incrEDT, 0, 1);
+    u32 i;
+    for (i = 0; i < N; i++) {
+        ocrEventSatisfySlot(latchGuid, NULL_GUID, OCR_EVENT_LATCH_INCR_SLOT);
+        ocrGuid_t incrGuid;
+        ocrEdtCreate(&incrGuid, incrTpl, 0, NULL, 1, &dbLatchGuid,
+                     EDT_PROP_NONE, NULL_HINT, NULL);
+    }
+    ocrEdtTemplateDestroy(incrTpl);
+
+    ocrEventSatisfySlot(latchGuid, NULL_GUID, OCR_EVENT_LATCH_DECR_SLOT);
+    return NULL_GUID;
+}
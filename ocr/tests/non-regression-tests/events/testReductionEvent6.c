@@ -0,0 +1,52 @@
+/*
+ * This file is subject to the license agreement located in the file LICENSE
+ * and cannot be distributed without it. This notice cannot be
+ * removed or modified.
+ */
+
+#include "ocr.h"
+
+/**
+ * DESC: Collective event reducing a multi-datum F8_ADD (associative) contribution
+ *       from an odd number of contributors per PD. The datum count is not a
+ *       multiple of the vector block so that the scalar tail is exercised too.
+ */
+
+#define TEST_MAXGEN 1
+#define TEST_IT_MAX 2
+#define TEST_NBCONTRIBSPD 7
+#define TEST_NBDATUM 37
+#define TEST_OP REDOP_F8_ADD
+
+#include "testReductionEventBasic.ctpl"
+
+#ifdef ENABLE_EXTENSION_COLLECTIVE_EVT
+
+void test(ocrGuid_t evtGuid, ocrEventParams_t params, u64 rankId, u64 it, ocrGuid_t edtCont) {
+    ocrAddDependenceSlot(evtGuid, rankId, edtCont, 0, DB_MODE_RO);
+    double contrib[TEST_NBDATUM];
+    u32 d = 0;
+    while (d < TEST_NBDATUM) {
+        contrib[d] = (double) (rankId + (d * (it+1)));
+        d++;
+    }
+    ocrEventCollectiveSatisfySlot(evtGuid, contrib, rankId);
+}
+
+void testCheck(u32 it, ocrEventParams_t params, u32 valueCount, void ** values) {
+    ASSERT(valueCount == TEST_MAXGEN); // got all contributions
+    u64 nbContribs = params.EVENT_COLLECTIVE.nbContribs;
+    double * res = (double *) values[0];
+    u32 d = 0;
+    while (d < TEST_NBDATUM) {
+        // Sum of rankIds plus each rank's datum contribution
+        double expected = (double) (((nbContribs * (nbContribs-1)) / 2) + (nbContribs * d * (it+1)));
+        if (res[d] != expected) {
+            PRINTF("it=%"PRIu32" datum=%"PRIu32" reducedValue=%f expected=%f\n", it, d, res[d], expected);
+        }
+        ASSERT(res[d] == expected);
+        d++;
+    }
+}
+
+#endif
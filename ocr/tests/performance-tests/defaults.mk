@@ -14,6 +14,8 @@ PARAMC_SZ ?= 2
 DEPV_SZ ?= 10
 # Fan out of EDTs
 FAN_OUT ?= 100
+# Fan in on events (satisfactions per EDT)
+FAN_IN ?= 100
 
 # Run Information set by the driver
 # Nb of OCR workers
@@ -40,7 +42,7 @@ DB_TYPE ?= u64
 
 C_DEFINES := -DENABLE_EXTENSION_AFFINITY -DENABLE_EXTENSION_RTITF -DENABLE_EXTENSION_PARAMS_EVT -DENABLE_EXTENSION_COUNTED_EVT -DENABLE_EXTENSION_CHANNEL_EVT\
              -DDB_NBS=$(DB_NBS) -DNB_EVT_COUNTED_DEPS=$(NB_EVT_COUNTED_DEPS) -DNB_ITERS=$(NB_ITERS) -DNB_INSTANCES=$(NB_INSTANCES)\
-             -DDEPV_SZ=$(DEPV_SZ) -DPARAMC_SZ=$(PARAMC_SZ) -DFAN_OUT=$(FAN_OUT)\
+             -DDEPV_SZ=$(DEPV_SZ) -DPARAMC_SZ=$(PARAMC_SZ) -DFAN_OUT=$(FAN_OUT) -DFAN_IN=$(FAN_IN)\
              -DDB_SZ=$(DB_SZ) -DNODE_FANOUT=$(NODE_FANOUT)\
              -DLEAF_FANOUT=$(LEAF_FANOUT) -DTREE_DEPTH=$(TREE_DEPTH) -DDB_NB_ELT=$(DB_NB_ELT)\
              -DDB_TYPE=$(DB_TYPE) -DNB_WORKERS=$(NB_WORKERS) -DNB_NODES=$(NB_NODES) -DOCR_TYPE_H=$(OCR_TYPE).h
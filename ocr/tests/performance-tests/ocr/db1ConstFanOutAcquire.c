@@ -0,0 +1,70 @@
+#include "perfs.h"
+#include "ocr.h"
+
+// DESC: Massive fan-out on a single DB. 'NB_INSTANCES' EDTs
+//       acquire the same DB in CONST mode and execute concurrently.
+// TIME: From the first task creation to the last EDT releasing the DB
+// FREQ: Create 'NB_INSTANCES' EDTs once
+//
+// VARIABLES:
+// - NB_INSTANCES
+
+ocrGuid_t terminateEdt(u32 paramc, u64* paramv, u32 depc, ocrEdtDep_t depv[]) {
+    timestamp_t * timers = (timestamp_t *) depv[1].ptr;
+    get_time(&timers[1]);
+    summary_throughput_timer(&timers[0], &timers[1], NB_INSTANCES);
+    ocrShutdown(); // This is the last EDT to execute, terminate
+    return NULL_GUID;
+}
+
+ocrGuid_t workEdt(u32 paramc, u64* paramv, u32 depc, ocrEdtDep_t depv[]) {
+    return NULL_GUID;
+}
+
+ocrGuid_t rootEdt(u32 paramc, u64* paramv, u32 depc, ocrEdtDep_t depv[]) {
+    ocrGuid_t dataGuid = *((ocrGuid_t *) paramv);
+    ocrGuid_t workEdtTemplateGuid;
+    ocrEdtTemplateCreate(&workEdtTemplateGuid, workEdt, 0, 1);
+    int i = 0;
+    while (i < NB_INSTANCES) {
+        ocrGuid_t workEdtGuid;
+        ocrEdtCreate(&workEdtGuid, workEdtTemplateGuid,
+                     0, NULL, 1, NULL, EDT_PROP_NONE, NULL_HINT, NULL);
+        ocrAddDependence(dataGuid, workEdtGuid, 0, DB_MODE_CONST);
+        i++;
+    }
+    ocrEdtTemplateDestroy(workEdtTemplateGuid);
+    return NULL_GUID;
+}
+
+ocrGuid_t mainEdt(u32 paramc, u64* paramv, u32 depc, ocrEdtDep_t depv[]) {
+    ocrGuid_t dataGuid;
+    u64 * dataPtr;
+    ocrDbCreate(&dataGuid, (void **)&dataPtr, sizeof(u64), 0, NULL_HINT, NO_ALLOC);
+    ocrDbRelease(dataGuid);
+
+    timestamp_t * dbPtr;
+    ocrGuid_t dbGuid;
+    ocrDbCreate(&dbGuid, (void **)&dbPtr, (sizeof(timestamp_t)*2), 0, NULL_HINT, NO_ALLOC);
+
+    ocrGuid_t terminateEdtTemplateGuid;
+    ocrEdtTemplateCreate(&terminateEdtTemplateGuid, terminateEdt, 0, 2);
+    ocrGuid_t terminateEdtGuid;
+    ocrEdtCreate(&terminateEdtGuid, terminateEdtTemplateGuid,
+                 0, NULL, 2, NULL, EDT_PROP_NONE, NULL_HINT, NULL);
+    ocrEdtTemplateDestroy(terminateEdtTemplateGuid);
+
+    get_time(&dbPtr[0]);
+
+    ocrGuid_t rootEdtTemplateGuid;
+    ocrEdtTemplateCreate(&rootEdtTemplateGuid, rootEdt, 1, 0);
+    ocrGuid_t rootEdtGuid, rootOutGuid;
+    ocrEdtCreate(&rootEdtGuid, rootEdtTemplateGuid,
+                 1, (u64 *) &dataGuid, 0, NULL, EDT_PROP_FINISH, NULL_HINT, &rootOutGuid);
+    ocrEdtTemplateDestroy(rootEdtTemplateGuid);
+
+    ocrAddDependence(rootOutGuid, terminateEdtGuid, 0, DB_MODE_NULL);
+    ocrDbRelease(dbGuid);
+    ocrAddDependence(dbGuid, terminateEdtGuid, 1, DB_MODE_CONST);
+    return NULL_GUID;
+}
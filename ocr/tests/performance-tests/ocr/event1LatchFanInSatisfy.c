@@ -0,0 +1,74 @@
+#include "perfs.h"
+#include "ocr.h"
+
+// DESC: Massive fan-in on a single latch event. 'NB_INSTANCES' EDTs
+//       execute concurrently and each one satisfies the latch's
+//       decrement slot 'FAN_IN' times.
+// TIME: From the first task creation to the latch being satisfied
+// FREQ: Create 'NB_INSTANCES' EDTs once
+//
+// VARIABLES:
+// - NB_INSTANCES
+// - FAN_IN
+
+ocrGuid_t terminateEdt(u32 paramc, u64* paramv, u32 depc, ocrEdtDep_t depv[]) {
+    timestamp_t * timers = (timestamp_t *) depv[1].ptr;
+    get_time(&timers[1]);
+    summary_throughput_timer(&timers[0], &timers[1], ((u64) NB_INSTANCES) * FAN_IN);
+    ocrShutdown(); // This is the last EDT to execute, terminate
+    return NULL_GUID;
+}
+
+ocrGuid_t workEdt(u32 paramc, u64* paramv, u32 depc, ocrEdtDep_t depv[]) {
+    ocrGuid_t evLchGuid = *((ocrGuid_t *) paramv);
+    u32 i;
+    for (i = 0; i < FAN_IN; i++) {
+        ocrEventSatisfySlot(evLchGuid, NULL_GUID, OCR_EVENT_LATCH_DECR_SLOT);
+    }
+    return NULL_GUID;
+}
+
+ocrGuid_t mainEdt(u32 paramc, u64* paramv, u32 depc, ocrEdtDep_t depv[]) {
+    ocrGuid_t terminateEdtTemplateGuid;
+    // Latch events to synchronize + timer DB
+    ocrEdtTemplateCreate(&terminateEdtTemplateGuid, terminateEdt, 0, 2);
+
+    ocrGuid_t terminateEdtGuid;
+    ocrEdtCreate(&terminateEdtGuid, terminateEdtTemplateGuid,
+                 0, NULL, 2, NULL, EDT_PROP_NONE, NULL_HINT, NULL);
+
+    ocrGuid_t evLchGuid;
+    ocrEventCreate(&evLchGuid, OCR_EVENT_LATCH_T, false);
+    ocrAddDependence(evLchGuid, terminateEdtGuid, 0, DB_MODE_CONST);
+
+    u64 k = 0;
+    while (k < (((u64) NB_INSTANCES) * FAN_IN + 1)) {
+        // incr for all contributions + mainEdt
+        ocrEventSatisfySlot(evLchGuid, NULL_GUID, OCR_EVENT_LATCH_INCR_SLOT);
+        k++;
+    }
+
+    timestamp_t * dbPtr;
+    ocrGuid_t dbGuid;
+    ocrDbCreate(&dbGuid, (void **)&dbPtr, (sizeof(timestamp_t)*2), 0, NULL_HINT, NO_ALLOC);
+
+    get_time(&dbPtr[0]);
+
+    ocrGuid_t workEdtTemplateGuid;
+    ocrEdtTemplateCreate(&workEdtTemplateGuid, workEdt, 1, 0);
+
+    int i = 0;
+    while (i < NB_INSTANCES) {
+        ocrGuid_t workEdtGuid;
+        ocrEdtCreate(&workEdtGuid, workEdtTemplateGuid,
+                     1, (u64 *) &evLchGuid, 0, NULL, EDT_PROP_NONE, NULL_HINT, NULL);
+        i++;
+    }
+    ocrEdtTemplateDestroy(workEdtTemplateGuid);
+
+    ocrDbRelease(dbGuid);
+    ocrAddDependence(dbGuid, terminateEdtGuid, 1, DB_MODE_CONST);
+
+    ocrEventSatisfySlot(evLchGuid, NULL_GUID, OCR_EVENT_LATCH_DECR_SLOT);
+    return NULL_GUID;
+}